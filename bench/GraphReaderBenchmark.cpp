@@ -0,0 +1,82 @@
+// This toolbox is licensed under the Academic Free License 3.0.
+// Instituto Tecnológico de Buenos Aires (ITBA).
+
+// Loading throughput, in edges per second, of GraphReader and ParallelGraphReader.
+//
+// Usage: graphReaderBenchmark [-t threads] [-m] [graph_file]...
+// -m loads into multigraphs, as the command line tool does. Without graph files the
+// unweighted fixtures of graph/ are used.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "GraphReader.h"
+#include "ParallelGraphReader.h"
+#include "typedefs.h"
+
+using namespace graphpp;
+
+namespace
+{
+const char* const Fixtures[] = {"BarabasiAlbert-m0_4-m_2-n_1000-clique",
+                                "Erdos-n_1000-p_0.3-clique",
+                                "k10-clique",
+                                "shell_test.txt"};
+const unsigned int Repetitions = 3;
+
+// best throughput of Repetitions loads, as measured by the reader
+template <class Reader>
+double bestEdgesPerSecond(Reader& reader, const std::string& file, bool multigraph)
+{
+    double best = 0.0;
+    for (unsigned int r = 0; r < Repetitions; ++r)
+    {
+        Graph g(false, multigraph);
+        reader.read(g, file);
+        best = std::max(best, reader.getEdgesPerSecond());
+    }
+    return best;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    unsigned int threads = 0;
+    bool multigraph = false;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            threads = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "-m") == 0)
+            multigraph = true;
+        else
+            files.push_back(argv[i]);
+    }
+    if (files.empty())
+        for (const char* fixture : Fixtures)
+            files.push_back(std::string(GRAPH_FIXTURES_DIR) + "/" + fixture);
+
+    std::printf(
+        "threads: %u\n%-40s %10s %14s %14s %8s\n", workerCount(threads, ~0u), "graph", "edges",
+        "seq (edges/s)", "par (edges/s)", "speedup");
+
+    for (const auto& file : files)
+    {
+        GraphReader<Graph, Vertex> sequential;
+        ParallelGraphReader<Graph, Vertex> parallel(threads);
+        const double sequentialRate = bestEdgesPerSecond(sequential, file, multigraph);
+        const double parallelRate = bestEdgesPerSecond(parallel, file, multigraph);
+
+        std::printf(
+            "%-40s %10zu %14.0f %14.0f %7.2fx\n",
+            file.substr(file.find_last_of('/') + 1).c_str(), parallel.getEdgesCount(),
+            sequentialRate, parallelRate, sequentialRate > 0 ? parallelRate / sequentialRate : 0.0);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+// This toolbox is licensed under the Academic Free License 3.0.
+// Instituto Tecnológico de Buenos Aires (ITBA).
+
+// Compares the sequential ShellIndex with ParallelShellIndex on the graph/ fixtures and on
+// synthetic Barabasi-Albert graphs, and checks that both give the same shell indexes.
+//
+// Usage: shellIndexBenchmark [-t threads] [-n ba_vertices]... [graph_file]...
+// Without graph files the unweighted fixtures of graph/ are used; without -n, Barabasi-Albert
+// graphs of 10^4, 10^5 and 10^6 vertices (m = 4) are generated.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "GraphGenerator.h"
+#include "GraphReader.h"
+#include "ParallelShellIndex.h"
+#include "ShellIndex.h"
+#include "typedefs.h"
+
+using namespace graphpp;
+
+namespace
+{
+const char* const Fixtures[] = {"BarabasiAlbert-m0_4-m_2-n_1000-clique",
+                                "Erdos-n_1000-p_0.3-clique",
+                                "k10-clique",
+                                "shellIndexTest.txt",
+                                "shellIndexTest2.txt",
+                                "shellIndexTest4.txt",
+                                "shellIndexTest5.txt",
+                                "shell_test.txt"};
+const unsigned int Repetitions = 3;
+
+typedef IShellIndex<Graph, Vertex>::ShellIndexContainer ShellIndexContainer;
+
+ShellIndexContainer collect(IShellIndex<Graph, Vertex>& shellIndex)
+{
+    ShellIndexContainer ret;
+    auto it = shellIndex.iterator();
+    while (!it.end())
+    {
+        ret.insert(*it);
+        ++it;
+    }
+    return ret;
+}
+
+// best of Repetitions runs, in seconds; result keeps the shell indexes of the last run
+template <class Run>
+double bestTime(Run run, ShellIndexContainer& result)
+{
+    double best = 0.0;
+    for (unsigned int r = 0; r < Repetitions; ++r)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        result = run();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (r == 0 || elapsed.count() < best)
+            best = elapsed.count();
+    }
+    return best;
+}
+
+unsigned int edgesCount(Graph& g)
+{
+    unsigned int degrees = 0;
+    auto it = g.verticesIterator();
+    while (!it.end())
+    {
+        degrees += (*it)->degree();
+        ++it;
+    }
+    return degrees / 2;
+}
+
+bool compare(const std::string& name, Graph& g, unsigned int threads)
+{
+    ShellIndexContainer sequential, parallel;
+    const double sequentialTime = bestTime(
+        [&g]() {
+            ShellIndex<Graph, Vertex> shellIndex(g, ShellIndexTypeSimple);
+            return collect(shellIndex);
+        },
+        sequential);
+    const double parallelTime = bestTime(
+        [&g, threads]() {
+            ParallelShellIndex<Graph, Vertex> shellIndex(g, threads);
+            return collect(shellIndex);
+        },
+        parallel);
+
+    const bool same = sequential == parallel;
+    std::printf(
+        "%-40s %9zu %10u %10.4f %10.4f %7.2fx %s\n", name.c_str(), sequential.size(),
+        edgesCount(g), sequentialTime, parallelTime,
+        parallelTime > 0 ? sequentialTime / parallelTime : 0.0, same ? "ok" : "MISMATCH");
+    return same;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    unsigned int threads = 0;
+    std::vector<unsigned int> baSizes;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            threads = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            baSizes.push_back(std::strtoul(argv[++i], nullptr, 10));
+        else
+            files.push_back(argv[i]);
+    }
+    if (files.empty())
+        for (const char* fixture : Fixtures)
+            files.push_back(std::string(GRAPH_FIXTURES_DIR) + "/" + fixture);
+    if (baSizes.empty())
+        baSizes = {10000, 100000, 1000000};
+
+    std::printf(
+        "threads: %u\n%-40s %9s %10s %10s %10s %8s\n", workerCount(threads, ~0u), "graph",
+        "vertices", "edges", "seq (s)", "par (s)", "speedup");
+
+    bool ok = true;
+    for (const auto& file : files)
+    {
+        Graph g;
+        GraphReader<Graph, Vertex> reader;
+        reader.read(g, file);
+        ok = compare(file.substr(file.find_last_of('/') + 1), g, threads) && ok;
+    }
+
+    srand(1);
+    for (const unsigned int n : baSizes)
+    {
+        Graph* g = GraphGenerator::getInstance()->generateBarabasiAlbertGraph(5, 4, n);
+        ok = compare("barabasi-albert n=" + std::to_string(n) + " m=4", *g, threads) && ok;
+        delete g;
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -4,12 +4,17 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include "PropertyMap.h"
 #include "typedefs.h"
 
 #include "AdjacencyListGraph.h"
 #include "AdjacencyListVertex.h"
+#include "EdgeListParser.h"
+#include "Ensemble.h"
 #include "IGraphFactory.h"
+#include "MetricCache.h"
 
 using namespace graphpp;
 
@@ -18,11 +23,26 @@ class ProgramState
 private:
     bool weighted;
     bool digraph;
+    // the set*Graph methods only keep the model, for exportEnsemble
+    bool modelOnly;
     WeightedGraph weightedGraph;
     DirectedGraph directedGraph;
     Graph graph;
     bool directed_out;
     bool directed_in;
+    unsigned int betweennessSamples;
+    std::uint64_t seed;
+    // the model of the last generated graph, to draw more realizations for an ensemble
+    Ensemble<Graph, Vertex>::Model model;
+    // the metrics computed on the current graphs, shared by the queries and the exports
+    MetricCache metrics;
+
+    // the cache key of a metric of the current graph, with the given parameters
+    MetricCache::Key metricKey(const std::string& metric, const std::string& parameters);
+    // the properties compute fills in, from the cache
+    PropertyMap& cachedProperties(
+        const std::string& metric, const std::string& parameters,
+        void (ProgramState::*compute)(PropertyMap&));
 
     void computeBetweenness(PropertyMap& propertyMap);
     void computeDegreeDistribution(PropertyMap& propertyMap);
@@ -39,6 +59,12 @@ public:
 
     void setWeighted(bool weighted);
     void setDigraph(bool digraph);
+    void setBetweennessSamples(unsigned int samples);
+    // whether the models are only kept for ensembles, without generating a graph
+    void setModelOnly(bool modelOnly);
+    // seed of the generated models; by default it comes from rand()
+    void setSeed(std::uint64_t seed);
+    std::uint64_t getSeed();
 
     bool isWeighted();
     bool isDigraph();
@@ -46,7 +72,8 @@ public:
     DirectedGraph getDirectedGraph();
     Graph getGraph();
 
-    void readGraphFromFile(std::string path);
+    // returns the edges read and the time taken; empty for snapshots
+    graphpp::ReadThroughput readGraphFromFile(std::string path);
     void setErdosRenyiGraph(unsigned int n, float p);
     void setBarabasiAlbertGraph(unsigned int m_0, unsigned int m, unsigned int n);
     void setExtendedHotGraph(
@@ -77,6 +104,12 @@ public:
         std::string outputPath, unsigned int log_bin_given = false, unsigned int binsAmount = -1);
     void exportClusteringVsDegree(std::string outputPath);
     void exportNearestNeighborsDegreeVsDegree(std::string outputPath);
+    // metric: an Ensemble<Graph, Vertex>::Metric; writes degree, mean, deviation, samples.
+    // With log_bin_given the degree distribution is written as exportDegreeDistribution does,
+    // over the vertices of all the realizations.
+    void exportEnsemble(
+        std::string outputPath, unsigned int realizations, unsigned int metric,
+        unsigned int log_bin_given = false, unsigned int binsAmount = -1);
     void exportShellIndexVsDegree(std::string outputPath);
     void exportCCBoxplot(std::string outputPath);
 
@@ -180,6 +180,27 @@ struct gengetopt_args_info
     const char *output_file_help; /**< @brief Save the result in an output file help description. */
     const char
         *print_deg_help; /**< @brief Print node degree for power law regression help description. */
+    int betweenness_approx_arg; /**< @brief Estimate betweenness from a number of sampled pivot
+                                   vertices.  */
+    char *betweenness_approx_orig; /**< @brief Estimate betweenness from a number of sampled pivot
+                                      vertices original value given at command line.  */
+    const char *betweenness_approx_help; /**< @brief Estimate betweenness from a number of sampled
+                                            pivot vertices help description.  */
+    char *seed_arg; /**< @brief Seed of the random generators, so a generated network can be
+                       repeated..  */
+    char *seed_orig; /**< @brief Seed of the random generators, so a generated network can be
+                        repeated. original value given at command line.  */
+    const char *seed_help; /**< @brief Seed of the random generators, so a generated network can
+                              be repeated. help description.  */
+    int ensemble_arg; /**< @brief Export the degree distribution, clustering coefficient or
+                         nearest neighbors degree averaged over a number of realizations of the
+                         generated model.  */
+    char *ensemble_orig; /**< @brief Export the degree distribution, clustering coefficient or
+                            nearest neighbors degree averaged over a number of realizations of
+                            the generated model original value given at command line.  */
+    const char *ensemble_help; /**< @brief Export the degree distribution, clustering coefficient
+                                  or nearest neighbors degree averaged over a number of
+                                  realizations of the generated model help description.  */
 
     unsigned int help_given;               /**< @brief Whether help was given.  */
     unsigned int version_given;            /**< @brief Whether version was given.  */
@@ -222,6 +243,9 @@ struct gengetopt_args_info
         maxCliqueAprox_output_given; /**< @brief Whether maxCliqueAprox-output was given.  */
     unsigned int output_file_given;  /**< @brief Whether output-file was given.  */
     unsigned int print_deg_given;    /**< @brief Whether print-deg was given.  */
+    unsigned int betweenness_approx_given; /**< @brief Whether betweenness-approx was given.  */
+    unsigned int seed_given;               /**< @brief Whether seed was given.  */
+    unsigned int ensemble_given;           /**< @brief Whether ensemble was given.  */
 
     int analysis_group_counter;     /**< @brief Counter for group analysis */
     int directed_group_counter;     /**< @brief Counter for group directed */
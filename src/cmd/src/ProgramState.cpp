@@ -3,11 +3,14 @@
 // Last modification: December 19th, 2012.
 
 #include "ProgramState.h"
+#include <algorithm>
 #include "DegreeDistribution.h"
 #include "DirectedDegreeDistribution.h"
 #include "DirectedGraphFactory.h"
+#include "Ensemble.h"
 #include "GraphFactory.h"
 #include "GraphGenerator.h"
+#include "GraphSnapshot.h"
 #include "GraphWriter.h"
 #include "IBetweenness.h"
 #include "IClusteringCoefficient.h"
@@ -15,6 +18,8 @@
 #include "INearestNeighborsDegree.h"
 #include "IShellIndex.h"
 #include "PropertyMap.h"
+#include "Random.h"
+#include "TriangleCounter.h"
 #include "WeightedGraphFactory.h"
 #include "GrapherUtils.h"
 #include "LogBinningPolicy.h"
@@ -22,9 +27,27 @@
 using namespace graphpp;
 using namespace ComplexNetsGui;
 
+namespace
+{
+// Exact betweenness, or the sampled estimate when a number of pivots was requested.
+template <class G, class V>
+IBetweenness<G, V>* createBetweenness(IGraphFactory<G, V>* factory, G& g, unsigned int samples)
+{
+    if (samples == 0)
+        return factory->createBetweenness(g);
+    return factory->createApproximateBetweenness(
+        g, BetweennessSample<typename V::VertexId>::fromCount(g, samples));
+}
+}  // namespace
+
 ProgramState::ProgramState()
 {
     setWeighted(false);
+    setDigraph(false);
+    setDirectedInOut(false, false);
+    setBetweennessSamples(0);
+    setSeed(Random::seedFromRand());
+    setModelOnly(false);
 }
 
 void ProgramState::setWeighted(bool weighted)
@@ -37,6 +60,26 @@ bool ProgramState::isWeighted()
     return this->weighted;
 }
 
+void ProgramState::setBetweennessSamples(unsigned int samples)
+{
+    this->betweennessSamples = samples;
+}
+
+void ProgramState::setSeed(std::uint64_t seed)
+{
+    this->seed = seed;
+}
+
+std::uint64_t ProgramState::getSeed()
+{
+    return this->seed;
+}
+
+void ProgramState::setModelOnly(bool modelOnly)
+{
+    this->modelOnly = modelOnly;
+}
+
 void ProgramState::setDigraph(bool digraph)
 {
     this->digraph = digraph;
@@ -62,99 +105,115 @@ Graph ProgramState::getGraph()
     return this->graph;
 }
 
-void ProgramState::readGraphFromFile(std::string path)
+ReadThroughput ProgramState::readGraphFromFile(std::string path)
 {
+    ReadThroughput throughput;
     if (isWeighted())
     {
-        this->weightedGraph =
-            *(GraphGenerator::getInstance()->generateWeightedGraphFromFile(path, false, true));
+        this->weightedGraph = *(GraphGenerator::getInstance()->generateWeightedGraphFromFile(
+            path, false, true, 0, &throughput));
     }
     else if (isDigraph())
     {
-        this->directedGraph =
-            *(GraphGenerator::getInstance()->generateDirectedGraphFromFile(path, false));
+        this->directedGraph = *(GraphGenerator::getInstance()->generateDirectedGraphFromFile(
+            path, false, 0, &throughput));
     }
     else
     {
-        this->graph = *(GraphGenerator::getInstance()->generateGraphFromFile(path, false, true));
+        this->graph = *(GraphGenerator::getInstance()->generateGraphFromFile(
+            path, false, true, 0, &throughput));
     }
+    return throughput;
 }
 
 void ProgramState::setErdosRenyiGraph(unsigned int n, float p)
 {
     setWeighted(false);
-    this->graph = *GraphGenerator::getInstance()->generateErdosRenyiGraph(n, p);
+    GraphGenerator* generator = GraphGenerator::getInstance();
+    // ensembles run the realizations in parallel, each one with a single thread
+    model = [=](std::uint64_t seed) {
+        return generator->generateErdosRenyiGraph(n, p, true, 1, seed);
+    };
+    if (!modelOnly)
+        this->graph = *generator->generateErdosRenyiGraph(n, p, true, 0, seed);
 }
 
 void ProgramState::setBarabasiAlbertGraph(unsigned int m_0, unsigned int m, unsigned int n)
 {
     setWeighted(false);
-    this->graph = *GraphGenerator::getInstance()->generateBarabasiAlbertGraph(m_0, m, n);
+    GraphGenerator* generator = GraphGenerator::getInstance();
+    model = [=](std::uint64_t seed) {
+        return generator->generateBarabasiAlbertGraph(m_0, m, n, seed);
+    };
+    if (!modelOnly)
+        this->graph = *model(seed);
 }
 
 void ProgramState::setExtendedHotGraph(
     unsigned int m, unsigned int n, float xi, unsigned int q, float r, unsigned int t)
 {
     setWeighted(false);
-    this->graph = *GraphGenerator::getInstance()->generateHotExtendedGraph(m, n, xi, q, r, t);
+    GraphGenerator* generator = GraphGenerator::getInstance();
+    model = [=](std::uint64_t seed) {
+        return generator->generateHotExtendedGraph(m, n, xi, q, r, t, seed);
+    };
+    if (!modelOnly)
+        this->graph = *model(seed);
 }
 
 void ProgramState::setMolloyReedGraph(std::string path)
 {
     setWeighted(false);
-    this->graph = *GraphGenerator::getInstance()->generateMolloyReedGraph(path);
+    GraphGenerator* generator = GraphGenerator::getInstance();
+    model = [=](std::uint64_t seed) {
+        return generator->generateMolloyReedGraph(path, false, seed);
+    };
+    if (!modelOnly)
+        this->graph = *model(seed);
 }
 
 void ProgramState::setHiperbolicGraph(unsigned int n, float a, float c)
 {
     setWeighted(false);
+    GraphGenerator* generator = GraphGenerator::getInstance();
     std::cout << "Generating hyperbolic graph. Expected avg degree: "
-              << GraphGenerator::getInstance()->getExpectedAvgNodeDeg(n, a, c) << std::endl;
-    this->graph = *GraphGenerator::getInstance()->generateHiperbolicGraph(n, a, c);
+              << generator->getExpectedAvgNodeDeg(n, a, c) << std::endl;
+    // ensembles run the realizations in parallel, each one with a single thread
+    model = [=](std::uint64_t seed) {
+        return generator->generateHiperbolicGraph(n, a, c, 1, seed);
+    };
+    if (!modelOnly)
+        this->graph = *generator->generateHiperbolicGraph(n, a, c, 0, seed);
 }
 
-double ProgramState::betweenness(unsigned int vertex_id)
+MetricCache::Key ProgramState::metricKey(const std::string& metric, const std::string& parameters)
 {
-    if (this->weighted)
-    {
-        auto wfactory = new WeightedGraphFactory<WeightedGraph, WeightedVertex>();
-        auto wbetweenness = wfactory->createBetweenness(this->weightedGraph);
-        auto wit = wbetweenness->iterator();
+    // The flags choose the graph a metric reads, and some metrics read more than one of them,
+    // so the key takes the flags and the latest version of the three graphs.
+    const std::string graphKind = weighted ? "weighted" : digraph ? "digraph" : "graph";
+    const std::uint64_t version = std::max(
+        {graph.getVersion(), weightedGraph.getVersion(), directedGraph.getVersion()});
+    return MetricCache::Key{
+        metric, graphKind + " " + parameters, directed_out, directed_in, version};
+}
 
-        double ret = -1;
-        while (!wit.end())
-        {
-            if (wit->first == vertex_id)
-            {
-                ret = wit->second;
-                break;
-            }
-            ++wit;
-        }
-        delete wbetweenness;
-        delete wfactory;
-        return ret;
-    }
-    else
-    {
-        auto factory = new GraphFactory<Graph, Vertex>();
-        auto betweenness = factory->createBetweenness(this->graph);
-        auto it = betweenness->iterator();
+PropertyMap& ProgramState::cachedProperties(
+    const std::string& metric, const std::string& parameters,
+    void (ProgramState::*compute)(PropertyMap&))
+{
+    return metrics.get<PropertyMap>(
+        metricKey(metric, parameters),
+        [this, compute](PropertyMap& propertyMap) { (this->*compute)(propertyMap); });
+}
 
-        double ret = -1;
-        while (!it.end())
-        {
-            if (it->first == vertex_id)
-            {
-                ret = it->second;
-                break;
-            }
-            ++it;
-        }
-        delete betweenness;
-        delete factory;
-        return ret;
-    }
+double ProgramState::betweenness(unsigned int vertex_id)
+{
+    const VertexProperty<double>& betweenness =
+        cachedProperties(
+            "betweenness", to_string<unsigned int>(betweennessSamples),
+            &ProgramState::computeBetweenness)
+            .vertexProperty<double>("betweenness");
+    return betweenness.contains(vertex_id) ? betweenness.get(vertex_id) : -1;
 }
 
 std::list<int> ProgramState::maxCliqueAprox()
@@ -276,9 +335,6 @@ double ProgramState::knn(unsigned int vertex_id)
 
 double ProgramState::shellIndex(unsigned int vertex_id)
 {
-    double ret = -1;
-    auto factory = new GraphFactory<Graph, Vertex>();
-
     ShellIndexType type = ShellIndexTypeSimple;
     if(this->isWeighted()){
         type = ShellIndexTypeWeightedEqualPopulation;
@@ -286,21 +342,22 @@ double ProgramState::shellIndex(unsigned int vertex_id)
         type = ShellIndexTypeInDegree;
     }
 
-    auto shellIndex = factory->createShellIndex(graph, type);
-    auto it = shellIndex->iterator();
+    const VertexProperty<unsigned int>& shellIndexes = metrics.get<VertexProperty<unsigned int>>(
+        metricKey("shellIndexForVertex", to_string<int>(type)),
+        [this, type](VertexProperty<unsigned int>& shellIndexForVertex) {
+            auto factory = new GraphFactory<Graph, Vertex>();
+            auto shellIndex = factory->createShellIndex(graph, type);
+            auto it = shellIndex->iterator();
 
-    while (!it.end())
-    {
-        if (it->first == vertex_id)
-        {
-            ret = it->second;
-            break;
-        }
-        ++it;
-    }
-    delete shellIndex;
-    delete factory;
-    return ret;
+            while (!it.end())
+            {
+                shellIndexForVertex.set(it->first, it->second);
+                ++it;
+            }
+            delete shellIndex;
+            delete factory;
+        });
+    return shellIndexes.contains(vertex_id) ? shellIndexes.get(vertex_id) : -1;
 }
 
 double ProgramState::degreeDistribution(unsigned int vertex_id)
@@ -399,18 +456,22 @@ double ProgramState::outDegreeDistribution(unsigned int vertex_id)
 
 void ProgramState::computeBetweenness(PropertyMap& propertyMap)
 {
+    VertexProperty<double>& betweenness = propertyMap.vertexProperty<double>("betweenness");
+    PropertySeries<unsigned int>& degreeDistribution =
+        propertyMap.series<unsigned int>("degreeDistribution");
+    PropertySeries<double>& degreeDistributionProbability =
+        propertyMap.series<double>("degreeDistributionProbability");
+
     // Calculate betweenness.
     if (this->weighted)
     {
         auto wfactory = new WeightedGraphFactory<WeightedGraph, WeightedVertex>();
-        auto wbetweenness = wfactory->createBetweenness(this->weightedGraph);
+        auto wbetweenness = createBetweenness(wfactory, this->weightedGraph, betweennessSamples);
         auto betweennessIterator = wbetweenness->iterator();
 
         while (!betweennessIterator.end())
         {
-            propertyMap.addProperty<double>(
-                "betweenness", to_string<unsigned int>(betweennessIterator->first),
-                betweennessIterator->second);
+            betweenness.set(betweennessIterator->first, betweennessIterator->second);
             ++betweennessIterator;
         }
         delete wbetweenness;
@@ -420,12 +481,9 @@ void ProgramState::computeBetweenness(PropertyMap& propertyMap)
 
         while (!degreeIterator.end())
         {
-            propertyMap.addProperty<double>(
-                "degreeDistribution", to_string<unsigned int>(degreeIterator->first),
-                degreeIterator->second);
-            propertyMap.addProperty<double>(
-                "degreeDistributionProbability", to_string<unsigned int>(degreeIterator->first),
-                degreeIterator->second / (double)graph.verticesCount());
+            degreeDistribution.set(degreeIterator->first, degreeIterator->second);
+            degreeDistributionProbability.set(
+                degreeIterator->first, degreeIterator->second / (double)graph.verticesCount());
             ++degreeIterator;
         }
         delete wdegreeDistribution;
@@ -434,74 +492,46 @@ void ProgramState::computeBetweenness(PropertyMap& propertyMap)
     else
     {
         auto factory = new GraphFactory<Graph, Vertex>();
-        auto betweenness = factory->createBetweenness(this->graph);
-        auto betweennessIterator = betweenness->iterator();
+        auto betweennessMetric = createBetweenness(factory, this->graph, betweennessSamples);
+        auto betweennessIterator = betweennessMetric->iterator();
 
         while (!betweennessIterator.end())
         {
-            propertyMap.addProperty<double>(
-                "betweenness", to_string<unsigned int>(betweennessIterator->first),
-                betweennessIterator->second);
+            betweenness.set(betweennessIterator->first, betweennessIterator->second);
             ++betweennessIterator;
         }
-        delete betweenness;
+        delete betweennessMetric;
 
-        auto degreeDistribution = factory->createDegreeDistribution(graph);
-        auto degreeIterator = degreeDistribution->iterator();
+        auto degreeDistributionMetric = factory->createDegreeDistribution(graph);
+        auto degreeIterator = degreeDistributionMetric->iterator();
 
         while (!degreeIterator.end())
         {
-            propertyMap.addProperty<double>(
-                "degreeDistribution", to_string<unsigned int>(degreeIterator->first),
-                degreeIterator->second);
-            propertyMap.addProperty<double>(
-                "degreeDistributionProbability", to_string<unsigned int>(degreeIterator->first),
-                degreeIterator->second / (double)graph.verticesCount());
+            degreeDistribution.set(degreeIterator->first, degreeIterator->second);
+            degreeDistributionProbability.set(
+                degreeIterator->first, degreeIterator->second / (double)graph.verticesCount());
             ++degreeIterator;
         }
-        delete degreeDistribution;
+        delete degreeDistributionMetric;
         delete factory;
     }
 
-    double betweennessAuxAcum;
-    unsigned int degreeAmount;
-    VariantsSet betweennessVsDegree;
-    VariantsSet& betweennessSet = propertyMap.getPropertySet("betweenness");
-    VariantsSet& degreeDistributionSet = propertyMap.getPropertySet("degreeDistribution");
-    VariantsSet::const_iterator it = degreeDistributionSet.begin();
-    VariantsSet::const_iterator betwennessIt = betweennessSet.begin();
-    VariantsSet::const_iterator betweennessVsDegreeIt;
-    while (it != degreeDistributionSet.end())
-    {
-        betweennessVsDegree.insert<double>(it->first, 0.0);
-        ++it;
-    }
-    while (betwennessIt != betweennessSet.end())
-    {
-        unsigned int vertedId = from_string<unsigned int>(betwennessIt->first);
-        // Vertex* v = graph.getVertexById(vertedId);
-        Vertex* v =
-            this->weighted ? weightedGraph.getVertexById(vertedId) : graph.getVertexById(vertedId);
-        betweennessAuxAcum =
-            betweennessVsDegree.get_element<double>(to_string<unsigned int>(v->degree()));
-        betweennessVsDegree.insert<double>(
-            to_string<unsigned int>(v->degree()),
-            betweennessAuxAcum + from_string<unsigned int>(betwennessIt->second));
-
-        ++betwennessIt;
-    }
+    // Sum the betweenness of the vertices of every degree, then divide by their amount.
+    PropertySeries<double>& betweennessVsDegree =
+        propertyMap.series<double>("betweennessVsDegree");
+    betweennessVsDegree.clear();
+    betweennessVsDegree.reserve(degreeDistribution.size());
+    for (const auto& degree : degreeDistribution)
+        betweennessVsDegree.set(degree.first, 0.0);
 
-    betweennessVsDegreeIt = betweennessVsDegree.begin();
-    while (betweennessVsDegreeIt != betweennessVsDegree.end())
-    {
-        std::string degree = betweennessVsDegreeIt->first;
-        betweennessAuxAcum = from_string<double>(betweennessVsDegreeIt->second);
-        degreeAmount = degreeDistributionSet.get_element<unsigned int>(degree);
+    betweenness.forEach([&](unsigned int vertexId, double value) {
+        Vertex* v =
+            this->weighted ? weightedGraph.getVertexById(vertexId) : graph.getVertexById(vertexId);
+        betweennessVsDegree[v->degree()] += value;
+    });
 
-        propertyMap.addProperty<double>(
-            "betweennessVsDegree", degree, betweennessAuxAcum / (double)degreeAmount);
-        ++betweennessVsDegreeIt;
-    }
+    for (auto& degree : betweennessVsDegree)
+        degree.second /= (double)degreeDistribution.get(degree.first);
 }
 
 void ProgramState::computeDegreeDistribution(PropertyMap& propertyMap)
@@ -514,13 +544,15 @@ void ProgramState::computeDegreeDistribution(PropertyMap& propertyMap)
         auto degreeDistribution = weightedFactory->createDegreeDistribution(this->weightedGraph);
         auto it = degreeDistribution->iterator();
 
+        PropertySeries<unsigned int>& counts =
+            propertyMap.series<unsigned int>("degreeDistribution");
+        PropertySeries<double>& probabilities =
+            propertyMap.series<double>("degreeDistributionProbability");
+
         while (!it.end())
         {
-            propertyMap.addProperty<double>(
-                "degreeDistribution", to_string<unsigned int>(it->first), it->second);
-            propertyMap.addProperty<double>(
-                "degreeDistributionProbability", to_string<unsigned int>(it->first),
-                it->second / (double)this->weightedGraph.verticesCount());
+            counts.set(it->first, it->second);
+            probabilities.set(it->first, it->second / (double)this->weightedGraph.verticesCount());
             ++it;
         }
 
@@ -537,33 +569,37 @@ void ProgramState::computeDegreeDistribution(PropertyMap& propertyMap)
         auto it2 = degreeDistribution->outDegreeIterator();
         auto it3 = degreeDistribution->inOutDegreeIterator();
 
+        const double vertices = directedGraph.verticesCount();
+        PropertySeries<unsigned int>& in = propertyMap.series<unsigned int>("inDegreeDistribution");
+        PropertySeries<double>& inProbability =
+            propertyMap.series<double>("inDegreeDistributionProbability");
+        PropertySeries<unsigned int>& out =
+            propertyMap.series<unsigned int>("outDegreeDistribution");
+        PropertySeries<double>& outProbability =
+            propertyMap.series<double>("outDegreeDistributionProbability");
+        PropertySeries<unsigned int>& inOut =
+            propertyMap.series<unsigned int>("inOutDegreeDistribution");
+        PropertySeries<double>& inOutProbability =
+            propertyMap.series<double>("inOutDegreeDistributionProbability");
+
         while (!it.end() || !it2.end())
         {
             if (!it.end())
             {
-                propertyMap.addProperty<double>(
-                    "inDegreeDistribution", to_string<unsigned int>(it->first), it->second);
-                propertyMap.addProperty<double>(
-                    "inDegreeDistributionProbability", to_string<unsigned int>(it->first),
-                    it->second / (double)directedGraph.verticesCount());
+                in.set(it->first, it->second);
+                inProbability.set(it->first, it->second / vertices);
                 ++it;
             }
             if (!it2.end())
             {
-                propertyMap.addProperty<double>(
-                    "outDegreeDistribution", to_string<unsigned int>(it2->first), it2->second);
-                propertyMap.addProperty<double>(
-                    "outDegreeDistributionProbability", to_string<unsigned int>(it2->first),
-                    it2->second / (double)directedGraph.verticesCount());
+                out.set(it2->first, it2->second);
+                outProbability.set(it2->first, it2->second / vertices);
                 ++it2;
             }
             if (!it3.end())
             {
-                propertyMap.addProperty<double>(
-                    "inOutDegreeDistribution", to_string<unsigned int>(it3->first), it3->second);
-                propertyMap.addProperty<double>(
-                    "inOutDegreeDistributionProbability", to_string<unsigned int>(it3->first),
-                    it3->second / (double)directedGraph.verticesCount());
+                inOut.set(it3->first, it3->second);
+                inOutProbability.set(it3->first, it3->second / vertices);
                 ++it3;
             }
         }
@@ -577,13 +613,15 @@ void ProgramState::computeDegreeDistribution(PropertyMap& propertyMap)
         auto degreeDistribution = factory->createDegreeDistribution(this->graph);
         auto it = degreeDistribution->iterator();
 
+        PropertySeries<unsigned int>& counts =
+            propertyMap.series<unsigned int>("degreeDistribution");
+        PropertySeries<double>& probabilities =
+            propertyMap.series<double>("degreeDistributionProbability");
+
         while (!it.end())
         {
-            propertyMap.addProperty<double>(
-                "degreeDistribution", to_string<unsigned int>(it->first), it->second);
-            propertyMap.addProperty<double>(
-                "degreeDistributionProbability", to_string<unsigned int>(it->first),
-                it->second / (double)this->graph.verticesCount());
+            counts.set(it->first, it->second);
+            probabilities.set(it->first, it->second / (double)this->graph.verticesCount());
             ++it;
         }
 
@@ -616,8 +654,10 @@ void ProgramState::computeClusteringCoefficient(PropertyMap& propertyMap)
         }
     }
 
-    VariantsSet& degrees = propertyMap.getPropertySet(key);
-    VariantsSet::const_iterator it = degrees.begin();
+    const PropertySeries<unsigned int>& degrees = propertyMap.series<unsigned int>(key);
+    PropertySeries<double>& clusteringForDegree =
+        propertyMap.series<double>("clusteringCoeficientForDegree" + getDirectedPostfix());
+    clusteringForDegree.reserve(degrees.size());
 
     double cc = 0;
 
@@ -626,12 +666,10 @@ void ProgramState::computeClusteringCoefficient(PropertyMap& propertyMap)
         auto weightedFactory = new WeightedGraphFactory<WeightedGraph, WeightedVertex>();
         auto clusteringCoefficient = weightedFactory->createClusteringCoefficient();
 
-        while (it != degrees.end())
+        for (const auto& degree : degrees)
         {
-            cc = clusteringCoefficient->clusteringCoefficient(
-                weightedGraph, from_string<unsigned int>(it->first));
-            propertyMap.addProperty<double>("clusteringCoeficientForDegree", it->first, cc);
-            ++it;
+            cc = clusteringCoefficient->clusteringCoefficient(weightedGraph, degree.first);
+            clusteringForDegree.set(degree.first, cc);
         }
 
         delete clusteringCoefficient;
@@ -642,13 +680,11 @@ void ProgramState::computeClusteringCoefficient(PropertyMap& propertyMap)
         auto directedFactory = new DirectedGraphFactory<DirectedGraph, DirectedVertex>();
         auto clusteringCoefficient = directedFactory->createClusteringCoefficient();
 
-        while (it != degrees.end())
+        for (const auto& degree : degrees)
         {
             cc = clusteringCoefficient->clusteringCoefficient(
-                directedGraph, from_string<unsigned int>(it->first), directed_out, directed_in);
-            propertyMap.addProperty<double>(
-                "clusteringCoeficientForDegree" + getDirectedPostfix(), it->first, cc);
-            ++it;
+                directedGraph, degree.first, directed_out, directed_in);
+            clusteringForDegree.set(degree.first, cc);
         }
 
         delete clusteringCoefficient;
@@ -659,12 +695,10 @@ void ProgramState::computeClusteringCoefficient(PropertyMap& propertyMap)
         auto factory = new GraphFactory<Graph, Vertex>();
         auto clusteringCoefficient = factory->createClusteringCoefficient();
 
-        while (it != degrees.end())
+        for (const auto& degree : degrees)
         {
-            cc = clusteringCoefficient->clusteringCoefficient(
-                graph, from_string<unsigned int>(it->first));
-            propertyMap.addProperty<double>("clusteringCoeficientForDegree", it->first, cc);
-            ++it;
+            cc = clusteringCoefficient->clusteringCoefficient(graph, degree.first);
+            clusteringForDegree.set(degree.first, cc);
         }
 
         delete clusteringCoefficient;
@@ -696,8 +730,10 @@ void ProgramState::computeNearestNeighborsDegree(PropertyMap& propertyMap)
         }
     }
 
-    VariantsSet& degrees = propertyMap.getPropertySet(key);
-    VariantsSet::const_iterator it = degrees.begin();
+    const PropertySeries<unsigned int>& degrees = propertyMap.series<unsigned int>(key);
+    PropertySeries<double>& nearestNeighborDegreeForDegree =
+        propertyMap.series<double>("nearestNeighborDegreeForDegree" + getDirectedPostfix());
+    nearestNeighborDegreeForDegree.reserve(degrees.size());
 
     double knn = 0;
 
@@ -706,12 +742,10 @@ void ProgramState::computeNearestNeighborsDegree(PropertyMap& propertyMap)
         auto weightedFactory = new WeightedGraphFactory<WeightedGraph, WeightedVertex>();
         auto nearestNeighborDegree = weightedFactory->createNearestNeighborsDegree();
 
-        while (it != degrees.end())
+        for (const auto& degree : degrees)
         {
-            knn = nearestNeighborDegree->meanDegree(
-                weightedGraph, from_string<unsigned int>(it->first));
-            propertyMap.addProperty<double>("nearestNeighborDegreeForDegree", it->first, knn);
-            ++it;
+            knn = nearestNeighborDegree->meanDegree(weightedGraph, degree.first);
+            nearestNeighborDegreeForDegree.set(degree.first, knn);
         }
 
         delete nearestNeighborDegree;
@@ -722,13 +756,11 @@ void ProgramState::computeNearestNeighborsDegree(PropertyMap& propertyMap)
         auto directedFactory = new DirectedGraphFactory<DirectedGraph, DirectedVertex>();
         auto nearestNeighborDegree = directedFactory->createNearestNeighborsDegree();
 
-        while (it != degrees.end())
+        for (const auto& degree : degrees)
         {
             knn = nearestNeighborDegree->meanDegree(
-                directedGraph, from_string<unsigned int>(it->first), directed_out, directed_in);
-            propertyMap.addProperty<double>(
-                "nearestNeighborDegreeForDegree" + getDirectedPostfix(), it->first, knn);
-            ++it;
+                directedGraph, degree.first, directed_out, directed_in);
+            nearestNeighborDegreeForDegree.set(degree.first, knn);
         }
 
         delete nearestNeighborDegree;
@@ -739,11 +771,10 @@ void ProgramState::computeNearestNeighborsDegree(PropertyMap& propertyMap)
         auto factory = new GraphFactory<Graph, Vertex>();
         auto nearestNeighborDegree = factory->createNearestNeighborsDegree();
 
-        while (it != degrees.end())
+        for (const auto& degree : degrees)
         {
-            knn = nearestNeighborDegree->meanDegree(graph, from_string<unsigned int>(it->first));
-            propertyMap.addProperty<double>("nearestNeighborDegreeForDegree", it->first, knn);
-            ++it;
+            knn = nearestNeighborDegree->meanDegree(graph, degree.first);
+            nearestNeighborDegreeForDegree.set(degree.first, knn);
         }
 
         delete nearestNeighborDegree;
@@ -756,11 +787,12 @@ void ProgramState::computeShellIndex(PropertyMap& propertyMap)
     auto factory = new GraphFactory<Graph, Vertex>();
     auto shellIndex = factory->createShellIndex(graph, ShellIndexTypeSimple);
     auto it = shellIndex->iterator();
+    VertexProperty<unsigned int>& shellIndexForVertex =
+        propertyMap.vertexProperty<unsigned int>("shellIndex");
 
     while (!it.end())
     {
-        propertyMap.addProperty<unsigned int>(
-            "shellIndex", to_string<unsigned int>(it->first), it->second);
+        shellIndexForVertex.set(it->first, it->second);
         ++it;
     }
 
@@ -780,12 +812,12 @@ bool ProgramState::computeMaxCliqueDistr(
 
     if (maxClique->finished())
     {
+        PropertySeries<double>& distribution = propertyMap.series<double>(
+            exact ? "maxCliqueExactDistribution" : "maxCliqueAproxDistribution");
         DistributionIterator it = maxClique->distIterator();
         while (!it.end())
         {
-            propertyMap.addProperty<double>(
-                exact ? "maxCliqueExactDistribution" : "maxCliqueAproxDistribution",
-                to_string<int>(it->first), it->second);
+            distribution.set(it->first, it->second);
             it++;
         }
     }
@@ -798,8 +830,7 @@ bool ProgramState::exportMaxCliqueExact(std::string outputPath, unsigned int max
     if (computeMaxCliqueDistr(propertyMap, true, max_time))
     {
         GrapherUtils utils;
-        utils.exportPropertySet(
-            propertyMap.getPropertySet("maxCliqueExactDistribution"), outputPath);
+        utils.exportSeries(propertyMap.series<double>("maxCliqueExactDistribution"), outputPath);
         return true;
     }
     return false;
@@ -810,7 +841,7 @@ void ProgramState::exportMaxCliqueAprox(std::string outputPath)
     PropertyMap propertyMap;
     computeMaxCliqueDistr(propertyMap, false, 0);
     GrapherUtils utils;
-    utils.exportPropertySet(propertyMap.getPropertySet("maxCliqueAproxDistribution"), outputPath);
+    utils.exportSeries(propertyMap.series<double>("maxCliqueAproxDistribution"), outputPath);
 }
 
 void ProgramState::printDegrees()
@@ -830,10 +861,11 @@ void ProgramState::printDegrees()
 
 void ProgramState::exportBetweennessVsDegree(std::string outputPath)
 {
-    PropertyMap propertyMap;
-    computeBetweenness(propertyMap);
+    PropertyMap& propertyMap = cachedProperties(
+        "betweenness", to_string<unsigned int>(betweennessSamples),
+        &ProgramState::computeBetweenness);
     GrapherUtils utils;
-    utils.exportPropertySet(propertyMap.getPropertySet("betweennessVsDegree"), outputPath);
+    utils.exportSeries(propertyMap.series<double>("betweennessVsDegree"), outputPath);
 }
 
 void ProgramState::exportDegreeDistribution(
@@ -869,18 +901,18 @@ void ProgramState::exportDegreeDistribution(
     {
         if (!isDigraph())
         {
-            VariantsSet& set = propertyMap.getPropertySet("degreeDistributionProbability");
-            grapherUtils.exportPropertySet(set, outputPath);
+            grapherUtils.exportSeries(
+                propertyMap.series<double>("degreeDistributionProbability"), outputPath);
         }
         else
         {
             std::string outputPath1 = outputPath;
             std::string outputPath2 = outputPath;
-            grapherUtils.exportPropertySet(
-                propertyMap.getPropertySet("inDegreeDistributionProbability"),
+            grapherUtils.exportSeries(
+                propertyMap.series<double>("inDegreeDistributionProbability"),
                 outputPath1.append("_in_degree"));
-            grapherUtils.exportPropertySet(
-                propertyMap.getPropertySet("outDegreeDistributionProbability"),
+            grapherUtils.exportSeries(
+                propertyMap.series<double>("outDegreeDistributionProbability"),
                 outputPath2.append("_out_degree"));
         }
     }
@@ -891,8 +923,8 @@ void ProgramState::exportClusteringVsDegree(std::string outputPath)
     PropertyMap propertyMap;
     computeClusteringCoefficient(propertyMap);
     GrapherUtils grapherUtils;
-    grapherUtils.exportPropertySet(
-        propertyMap.getPropertySet("clusteringCoeficientForDegree" + getDirectedPostfix()),
+    grapherUtils.exportSeries(
+        propertyMap.series<double>("clusteringCoeficientForDegree" + getDirectedPostfix()),
         outputPath);
 }
 
@@ -915,75 +947,100 @@ void ProgramState::exportNearestNeighborsDegreeVsDegree(std::string outputPath)
     PropertyMap propertyMap;
     computeNearestNeighborsDegree(propertyMap);
     GrapherUtils grapherUtils;
-    grapherUtils.exportPropertySet(
-        propertyMap.getPropertySet("nearestNeighborDegreeForDegree" + getDirectedPostfix()),
+    grapherUtils.exportSeries(
+        propertyMap.series<double>("nearestNeighborDegreeForDegree" + getDirectedPostfix()),
         outputPath);
 }
 
-void ProgramState::exportShellIndexVsDegree(std::string outputPath)
+void ProgramState::exportEnsemble(
+    std::string outputPath, unsigned int realizations, unsigned int metric,
+    unsigned int log_bin_given, unsigned int binsAmount)
 {
-    PropertyMap propertyMap;
-    computeShellIndex(propertyMap);
-    computeDegreeDistribution(propertyMap);
-
-    double shellAuxAcum;
-    unsigned int degreeAmount, vertexId;
+    Ensemble<Graph, Vertex> ensemble(model, metric);
+    ensemble.run(realizations, seed);
 
-    VariantsSet shellIndexVsDegree;
-    VariantsSet& shellIndex = propertyMap.getPropertySet("shellIndex");
-    VariantsSet& degreeDistribution = propertyMap.getPropertySet("degreeDistribution");
-    VariantsSet::const_iterator it = degreeDistribution.begin();
-    VariantsSet::const_iterator shellIt = shellIndex.begin();
-    VariantsSet::const_iterator shellVsDegreeIt;
-
-    while (it != degreeDistribution.end())
+    GrapherUtils grapherUtils;
+    if (log_bin_given && metric == Ensemble<Graph, Vertex>::DegreeDistribution)
     {
-        shellIndexVsDegree.insert<double>(it->first, 0);
-        ++it;
+        // the vertices of all the realizations, binned as exportDegreeDistribution does
+        VariantsSet set;
+        for (const auto& entry : ensemble.degreeCounts())
+            set.insert<std::uint64_t>(to_string<unsigned int>(entry.first), entry.second);
+        LogBinningPolicy policy;
+        grapherUtils.exportPropertySet(policy.transform(set, binsAmount), outputPath);
+        return;
     }
 
-    while (shellIt != shellIndex.end())
+    const DegreeSeries& series =
+        metric == Ensemble<Graph, Vertex>::DegreeDistribution
+            ? ensemble.degreeDistribution()
+            : metric == Ensemble<Graph, Vertex>::ClusteringVsDegree
+                  ? ensemble.clusteringVsDegree()
+                  : ensemble.nearestNeighborsDegreeVsDegree();
+    std::vector<double> degrees, means, deviations, samples;
+    for (const auto& entry : series)
     {
-        vertexId = from_string<unsigned int>(shellIt->first);
-        Vertex* v = graph.getVertexById(vertexId);
-        shellAuxAcum = shellIndexVsDegree.get_element<double>(to_string<unsigned int>(v->degree()));
-        shellIndexVsDegree.insert<double>(
-            to_string<unsigned int>(v->degree()),
-            shellAuxAcum + from_string<unsigned int>(shellIt->second));
-
-        ++shellIt;
+        degrees.push_back(entry.first);
+        means.push_back(entry.second.mean());
+        deviations.push_back(entry.second.standardDeviation());
+        samples.push_back(entry.second.count());
     }
+    grapherUtils.exportFourVectors(degrees, means, deviations, samples, outputPath);
+}
 
-    shellVsDegreeIt = shellIndexVsDegree.begin();
-    while (shellVsDegreeIt != shellIndexVsDegree.end())
-    {
-        std::string degree = shellVsDegreeIt->first;
-        shellAuxAcum = from_string<double>(shellVsDegreeIt->second);
-        degreeAmount = degreeDistribution.get_element<unsigned int>(degree);
+void ProgramState::exportShellIndexVsDegree(std::string outputPath)
+{
+    PropertyMap propertyMap;
+    computeShellIndex(propertyMap);
+    computeDegreeDistribution(propertyMap);
 
-        shellIndexVsDegree.insert<double>(degree, shellAuxAcum / (double)degreeAmount);
-        ++shellVsDegreeIt;
-    }
+    const VertexProperty<unsigned int>& shellIndex =
+        propertyMap.vertexProperty<unsigned int>("shellIndex");
+    const PropertySeries<unsigned int>& degreeDistribution =
+        propertyMap.series<unsigned int>("degreeDistribution");
+
+    // Sum the shell index of the vertices of every degree, then divide by their amount.
+    PropertySeries<double>& shellIndexVsDegree = propertyMap.series<double>("shellIndexVsDegree");
+    shellIndexVsDegree.reserve(degreeDistribution.size());
+    for (const auto& degree : degreeDistribution)
+        shellIndexVsDegree.set(degree.first, 0.0);
+
+    shellIndex.forEach([&](unsigned int vertexId, unsigned int value) {
+        shellIndexVsDegree[graph.getVertexById(vertexId)->degree()] += value;
+    });
+
+    for (auto& degree : shellIndexVsDegree)
+        degree.second /= (double)degreeDistribution.get(degree.first);
 
     GrapherUtils grapherUtils;
-    grapherUtils.exportPropertySet(shellIndexVsDegree, outputPath);
+    grapherUtils.exportSeries(shellIndexVsDegree, outputPath);
 }
 
 void ProgramState::exportCurrentGraph(std::string outputPath)
 {
     GraphWriter* graphWriter = new GraphWriter();
+    const bool snapshot = GraphSnapshot::hasExtension(outputPath);
 
     if (isWeighted())
     {
-        graphWriter->writeWeightedGraph(&(this->weightedGraph), outputPath);
+        if (snapshot)
+            graphWriter->writeWeightedGraphSnapshot(&(this->weightedGraph), outputPath);
+        else
+            graphWriter->writeWeightedGraph(&(this->weightedGraph), outputPath);
     }
     else if (isDigraph())
     {
-        graphWriter->writeDirectedGraph(&(this->directedGraph), outputPath);
+        if (snapshot)
+            graphWriter->writeDirectedGraphSnapshot(&(this->directedGraph), outputPath);
+        else
+            graphWriter->writeDirectedGraph(&(this->directedGraph), outputPath);
     }
     else
     {
-        graphWriter->writeGraph(&(this->graph), outputPath);
+        if (snapshot)
+            graphWriter->writeGraphSnapshot(&(this->graph), outputPath);
+        else
+            graphWriter->writeGraph(&(this->graph), outputPath);
     }
 
     delete graphWriter;
@@ -994,8 +1051,8 @@ void ProgramState::exportCCBoxplot(std::string outputPath)
     PropertyMap propertyMap;
     computeNearestNeighborsDegree(propertyMap);
     GrapherUtils grapherUtils;
-    grapherUtils.exportPropertySet(
-        propertyMap.getPropertySet("nearestNeighborDegreeForDegree"), outputPath);
+    grapherUtils.exportSeries(
+        propertyMap.series<double>("nearestNeighborDegreeForDegree"), outputPath);
 }
 
 void ProgramState::setDirectedInOut(bool o, bool i)
@@ -1047,8 +1104,9 @@ graphpp::Boxplotentry ProgramState::computeTotalBpEntriesShellIndex()
     Graph& g = graph;
     Graph::VerticesIterator vit = g.verticesIterator();
     std::vector<double> bCoefs;
-    PropertyMap propertyMap;
-    computeShellIndex(propertyMap);
+    PropertyMap& propertyMap = cachedProperties("shellIndex", "", &ProgramState::computeShellIndex);
+    const VertexProperty<unsigned int>& shellIndex =
+        propertyMap.vertexProperty<unsigned int>("shellIndex");
     // IShellIndex<Graph, Vertex>* betweenness = factory->createShellIndex(g);
     double coefSums = 0.0;
     unsigned int count = 0;
@@ -1056,8 +1114,7 @@ graphpp::Boxplotentry ProgramState::computeTotalBpEntriesShellIndex()
     while (!vit.end())
     {
         Vertex* v = *vit;
-        int c =
-            propertyMap.getProperty<int>("shellIndex", to_string<unsigned int>(v->getVertexId()));
+        int c = shellIndex.get(v->getVertexId());
         bCoefs.push_back(c);
         coefSums += c;
         ++vit;
@@ -1088,8 +1145,10 @@ graphpp::Boxplotentry ProgramState::computeTotalBpEntriesBetweenness()
     Graph& g = graph;
     Graph::VerticesIterator vit = g.verticesIterator();
     std::vector<double> bCoefs;
-    PropertyMap propertyMap;
-    computeBetweenness(propertyMap);
+    PropertyMap& propertyMap = cachedProperties(
+        "betweenness", to_string<unsigned int>(betweennessSamples),
+        &ProgramState::computeBetweenness);
+    const VertexProperty<double>& betweenness = propertyMap.vertexProperty<double>("betweenness");
     // IBetweenness<Graph, Vertex>* betweenness = factory->createBetweenness(g);
     double coefSums = 0.0;
     unsigned int count = 0;
@@ -1097,8 +1156,7 @@ graphpp::Boxplotentry ProgramState::computeTotalBpEntriesBetweenness()
     while (!vit.end())
     {
         Vertex* v = *vit;
-        double c = propertyMap.getProperty<double>(
-            "betweenness", to_string<unsigned int>(v->getVertexId()));
+        double c = betweenness.get(v->getVertexId());
         bCoefs.push_back(c);
         coefSums += c;
         ++vit;
@@ -1138,30 +1196,21 @@ graphpp::Boxplotentry ProgramState::computeTotalBpEntriesKnn()
 
     delete factory;
 
-    double oldCoef;
     int degree_exists = propertyMap.containsPropertySet("nearestNeighborDegreeForDegreeO") ? 1 : 0;
+    const PropertySeries<unsigned int>& degrees =
+        propertyMap.series<unsigned int>("degreeDistribution");
+    PropertySeries<double>& knnForDegree =
+        propertyMap.series<double>("nearestNeighborDegreeForDegreeO");
+    VertexProperty<double>& knnForVertex =
+        propertyMap.vertexProperty<double>("nearestNeighborDegreeForVertex");
 
     while (!vit.end())
     {
         Vertex* v = *vit;
-        if (!propertyMap.containsProperty(
-                "nearestNeighborDegreeForDegreeO", to_string<unsigned int>(v->degree())))
-        {
-            oldCoef = 0;
-        }
-        else
-        {
-            oldCoef = propertyMap.getProperty<double>(
-                "nearestNeighborDegreeForDegreeO", to_string<unsigned int>(v->degree()));
-        }
         double c = nearestNeighborDegree->meanDegreeForVertex(v);
-        propertyMap.addProperty<double>(
-            "nearestNeighborDegreeForVertex", to_string<unsigned int>(v->getVertexId()), c);
+        knnForVertex.set(v->getVertexId(), c);
         if (degree_exists == 0)
-            propertyMap.addProperty<double>(
-                "nearestNeighborDegreeForDegreeO", to_string<unsigned int>(v->degree()),
-                oldCoef + (c / propertyMap.getProperty<double>(
-                                   "degreeDistribution", to_string<unsigned int>(v->degree()))));
+            knnForDegree[v->degree()] += c / degrees.get(v->degree());
         nnCoefs.push_back(c);
         coefSums += c;
         ++vit;
@@ -1195,37 +1244,25 @@ graphpp::Boxplotentry ProgramState::computeTotalBpEntries()
     PropertyMap propertyMap;
     computeDegreeDistribution(propertyMap);
 
-    auto factory = new GraphFactory<Graph, Vertex>();
-    auto clusteringCoefficient = factory->createClusteringCoefficient();
-
-    delete factory;
+    const TriangleCounter triangles(g);
 
     double coefSums = 0.0;
     unsigned int count = 0;
-    double oldCoef;
     int degree_exists = propertyMap.containsPropertySet("clusteringCoeficientForDegreeO") ? 1 : 0;
+    const PropertySeries<unsigned int>& degrees =
+        propertyMap.series<unsigned int>("degreeDistribution");
+    PropertySeries<double>& clusteringForDegree =
+        propertyMap.series<double>("clusteringCoeficientForDegreeO");
+    VertexProperty<double>& clusteringForVertex =
+        propertyMap.vertexProperty<double>("clusteringCoeficientForVertex");
 
     while (!vit.end())
     {
         Vertex* v = *vit;
-        if (!propertyMap.containsProperty(
-                "clusteringCoeficientForDegreeO", to_string<unsigned int>(v->degree())))
-        {
-            oldCoef = 0;
-        }
-        else
-        {
-            oldCoef = propertyMap.getProperty<double>(
-                "clusteringCoeficientForDegreeO", to_string<unsigned int>(v->degree()));
-        }
-        double c = clusteringCoefficient->vertexClusteringCoefficient(v);
-        propertyMap.addProperty<double>(
-            "clusteringCoeficientForVertex", to_string<unsigned int>(v->getVertexId()), c);
+        double c = triangles.clustering(v->getVertexId());
+        clusteringForVertex.set(v->getVertexId(), c);
         if (degree_exists == 0)
-            propertyMap.addProperty<double>(
-                "clusteringCoeficientForDegreeO", to_string<unsigned int>(v->degree()),
-                oldCoef + (c / propertyMap.getProperty<double>(
-                                   "degreeDistribution", to_string<unsigned int>(v->degree()))));
+            clusteringForDegree[v->degree()] += c / degrees.get(v->degree());
         clusteringCoefs.push_back(c);
         coefSums += c;
         ++vit;
@@ -76,6 +76,9 @@ const char *gengetopt_args_info_help[] = {
   "      --maxCliqueAprox-output   ",
   "  -o, --output-file=<filename>  Save the result in an output file",
   "      --print-deg               Print node degree for power law regression",
+  "      --betweenness-approx=<samples>\n                                Estimate betweenness from a number of sampled\n                                  pivot vertices.",
+  "      --seed=<number>           Seed of the random generators, so a generated\n                                  network can be repeated.",
+  "      --ensemble=<realizations>\n                                Export the degree distribution, clustering\n                                  coefficient or nearest neighbors degree\n                                  averaged over a number of realizations of the\n                                  generated model",
     0
 };
 
@@ -143,6 +146,9 @@ void clear_given (struct gengetopt_args_info *args_info)
   args_info->maxCliqueAprox_output_given = 0 ;
   args_info->output_file_given = 0 ;
   args_info->print_deg_given = 0 ;
+  args_info->betweenness_approx_given = 0 ;
+  args_info->seed_given = 0 ;
+  args_info->ensemble_given = 0 ;
   args_info->analysis_group_counter = 0 ;
   args_info->directed_group_counter = 0 ;
   args_info->model_group_counter = 0 ;
@@ -182,6 +188,10 @@ void clear_args (struct gengetopt_args_info *args_info)
   args_info->maxCliqueExact_output_orig = NULL;
   args_info->output_file_arg = NULL;
   args_info->output_file_orig = NULL;
+  args_info->betweenness_approx_orig = NULL;
+  args_info->seed_arg = NULL;
+  args_info->seed_orig = NULL;
+  args_info->ensemble_orig = NULL;
   
 }
 
@@ -229,6 +239,9 @@ void init_args_info(struct gengetopt_args_info *args_info)
   args_info->maxCliqueAprox_output_help = gengetopt_args_info_help[39] ;
   args_info->output_file_help = gengetopt_args_info_help[40] ;
   args_info->print_deg_help = gengetopt_args_info_help[41] ;
+  args_info->betweenness_approx_help = gengetopt_args_info_help[42] ;
+  args_info->seed_help = gengetopt_args_info_help[43] ;
+  args_info->ensemble_help = gengetopt_args_info_help[44] ;
   
 }
 
@@ -335,6 +348,10 @@ cmdline_parser_release (struct gengetopt_args_info *args_info)
   free_string_field (&(args_info->maxCliqueExact_output_orig));
   free_string_field (&(args_info->output_file_arg));
   free_string_field (&(args_info->output_file_orig));
+  free_string_field (&(args_info->betweenness_approx_orig));
+  free_string_field (&(args_info->seed_arg));
+  free_string_field (&(args_info->seed_orig));
+  free_string_field (&(args_info->ensemble_orig));
   
   
 
@@ -443,6 +460,12 @@ cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
     write_into_file(outfile, "output-file", args_info->output_file_orig, 0);
   if (args_info->print_deg_given)
     write_into_file(outfile, "print-deg", 0, 0 );
+  if (args_info->betweenness_approx_given)
+    write_into_file(outfile, "betweenness-approx", args_info->betweenness_approx_orig, 0);
+  if (args_info->seed_given)
+    write_into_file(outfile, "seed", args_info->seed_orig, 0);
+  if (args_info->ensemble_given)
+    write_into_file(outfile, "ensemble", args_info->ensemble_orig, 0);
   
 
   i = EXIT_SUCCESS;
@@ -697,6 +720,11 @@ cmdline_parser_required2 (struct gengetopt_args_info *args_info, const char *pro
       fprintf (stderr, "%s: '--maxCliqueAprox-output' option depends on option 'output-file'%s\n", prog_name, (additional_error ? additional_error : ""));
       error_occurred = 1;
     }
+  if (args_info->ensemble_given && ! args_info->output_file_given)
+    {
+      fprintf (stderr, "%s: '--ensemble' option depends on option 'output-file'%s\n", prog_name, (additional_error ? additional_error : ""));
+      error_occurred = 1;
+    }
 
   return error_occurred;
 }
@@ -898,6 +926,9 @@ cmdline_parser_internal (
         { "maxCliqueAprox-output",	0, NULL, 0 },
         { "output-file",	1, NULL, 'o' },
         { "print-deg",	0, NULL, 0 },
+        { "betweenness-approx",	1, NULL, 0 },
+        { "seed",	1, NULL, 0 },
+        { "ensemble",	1, NULL, 0 },
         { 0,  0, 0, 0 }
       };
 
@@ -1447,6 +1478,48 @@ cmdline_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* Estimate betweenness from a number of sampled pivot vertices.  */
+          else if (strcmp (long_options[option_index].name, "betweenness-approx") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->betweenness_approx_arg), 
+                 &(args_info->betweenness_approx_orig), &(args_info->betweenness_approx_given),
+                &(local_args_info.betweenness_approx_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "betweenness-approx", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Seed of the random generators, so a generated network can be repeated.  */
+          else if (strcmp (long_options[option_index].name, "seed") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->seed_arg), 
+                 &(args_info->seed_orig), &(args_info->seed_given),
+                &(local_args_info.seed_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "seed", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Export the degree distribution, clustering coefficient or nearest neighbors degree averaged over a number of realizations of the generated model.  */
+          else if (strcmp (long_options[option_index].name, "ensemble") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->ensemble_arg), 
+                 &(args_info->ensemble_orig), &(args_info->ensemble_given),
+                &(local_args_info.ensemble_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "ensemble", '-',
+                additional_error))
+              goto failure;
+          
           }
           
           break;
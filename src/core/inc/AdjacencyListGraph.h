@@ -5,9 +5,14 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <climits>
+#include <cstdint>
 #include <iostream>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "GraphExceptions.h"
 #include "mili/mili.h"
 
@@ -71,6 +76,125 @@ public:
     }
 };
 
+/**
+ * Class: VertexIndex
+ * ------------------
+ * Description: id -> vertex lookup table kept next to the vertex container. Compact ids
+ * live in a flat vector indexed by id; ids far beyond the number of vertices go to a
+ * hash map so that a few large ids don't blow up the vector. Neither lookup allocates.
+ */
+template <class Vertex>
+class VertexIndex
+{
+public:
+    using VertexId = typename Vertex::VertexId;
+
+    /**
+     * Method: find
+     * ------------
+     * Description: looks up a vertex by id
+     * @param id the vertex id
+     * @returns the indexed vertex or nullptr if the id is not indexed
+     */
+    Vertex* find(VertexId id) const
+    {
+        if (id < dense.size() && dense[id] != nullptr)
+            return dense[id];
+
+        if (!sparse.empty())
+        {
+            auto it = sparse.find(id);
+            if (it != sparse.end())
+                return it->second;
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * Method: insert
+     * --------------
+     * Description: indexes a vertex. If its id is already indexed the previous vertex is
+     * kept, which matches what the finders return for containers holding repeated ids.
+     * @param v the vertex to index
+     */
+    void insert(Vertex* v)
+    {
+        const VertexId id = v->getVertexId();
+
+        if (find(id) != nullptr)
+            return;
+
+        ++count;
+        if (id < dense.size() || id < denseLimit())
+        {
+            if (id >= dense.size())
+                dense.resize(std::max<std::size_t>(std::size_t(id) + 1, dense.size() * 2));
+            dense[id] = v;
+        }
+        else
+        {
+            sparse[id] = v;
+        }
+    }
+
+    /**
+     * Method: erase
+     * -------------
+     * Description: removes a vertex from the index, if it is the one indexed for its id
+     * @param v the vertex to remove
+     * @returns true if v was indexed
+     */
+    bool erase(Vertex* v)
+    {
+        const VertexId id = v->getVertexId();
+
+        if (id < dense.size() && dense[id] == v)
+        {
+            dense[id] = nullptr;
+            --count;
+            return true;
+        }
+
+        auto it = sparse.find(id);
+        if (it != sparse.end() && it->second == v)
+        {
+            sparse.erase(it);
+            --count;
+            return true;
+        }
+
+        return false;
+    }
+
+private:
+    // ids below this bound are stored densely; it grows with the number of indexed vertices
+    std::size_t denseLimit() const
+    {
+        const std::size_t minDenseLimit = 1024;
+        return std::max(minDenseLimit, count * 4);
+    }
+
+    std::vector<Vertex*> dense;
+    std::unordered_map<VertexId, Vertex*> sparse;
+    std::size_t count = 0;
+};
+
+/**
+ * Function: nextGraphVersion
+ * --------------------------
+ * Description: draws a graph version from a counter shared by the whole process. A graph
+ * takes a new version when it is created and on every change, so equal versions mean the same
+ * graph in the same state (or a copy of it), and a graph that changes gets a version larger
+ * than any other graph holds: the largest version of several graphs changes whenever any of
+ * them does.
+ */
+inline std::uint64_t nextGraphVersion()
+{
+    static std::atomic<std::uint64_t> counter(0);
+    return ++counter;
+}
+
 /**
  * Class: Graph
  * ------------
@@ -117,6 +241,8 @@ public:
     {
         // insert the vertex in the vertices container
         insert_into(vertices, v);
+        index.insert(v);
+        touch();
     }
 
     /**
@@ -127,16 +253,72 @@ public:
      */
     void removeVertex(Vertex* v)
     {
-        auto it = v->neighborsIterator();
-
-        while (!it.end())
+        // removeEdge shrinks v's neighbour list, so always take the first one left
+        while (v->degree() > 0)
         {
-            Vertex* neighbour = *it;
-            removeEdge(neighbour, v);
-            it++;
+            Vertex* neighbour = *v->neighborsIterator();
+            removeEdge(v, neighbour);
         }
         // removes the vertex from the vertices container
         remove_first_from(vertices, v);
+
+        // another vertex with the same id may still be in the container
+        if (index.erase(v))
+        {
+            Vertex* other = VertexFinder<Vertex, VertexContainer>::find(v->getVertexId(), vertices);
+            if (other != nullptr)
+                index.insert(other);
+        }
+        touch();
+    }
+
+    /**
+     * Method: removeVerticesIf
+     * ------------------------
+     * Description: Removes, in one pass, the vertices for which remove returns true, and
+     * deletes them. Only the edges between a kept and a removed vertex are taken out one by
+     * one, so cutting the graph along components costs O(n + m) instead of a removeVertex per
+     * vertex. remove is called once per vertex, before anything changes.
+     * @param remove predicate on a vertex
+     */
+    template <class Predicate>
+    void removeVerticesIf(Predicate remove)
+    {
+        std::unordered_set<const Vertex*> removed;
+        for (Vertex* v : vertices)
+            if (remove(static_cast<const Vertex*>(v)))
+                removed.insert(v);
+        if (removed.empty())
+            return;
+
+        std::vector<Vertex*> cut;
+        VertexContainer kept;
+        for (Vertex* v : vertices)
+        {
+            const bool removing = removed.count(v) > 0;
+            auto it = v->neighborsIterator();
+            while (!it.end())
+            {
+                Vertex* neighbour = static_cast<Vertex*>(*it);
+                if ((removed.count(neighbour) > 0) != removing)
+                    cut.push_back(neighbour);
+                ++it;
+            }
+            for (Vertex* neighbour : cut)
+                removeEdge(v, neighbour);
+            cut.clear();
+
+            if (!removing)
+                kept.insert(kept.end(), v);
+        }
+
+        vertices.swap(kept);
+        index = VertexIndex<Vertex>();
+        for (Vertex* v : vertices)
+            index.insert(v);
+        for (const Vertex* v : removed)
+            delete v;
+        touch();
     }
 
     /**
@@ -153,6 +335,7 @@ public:
         s->addEdge(d);
         if (!this->isDigraph())
             d->addEdge(s);
+        touch();
         // Since by default this isn't multigraph, duplicate edges are not allowed
         /*if (s->isNeighbourOf(d))
             throw DuplicateEdge();
@@ -160,6 +343,22 @@ public:
         d->addEdge(s);*/
     }
 
+    /**
+     * Method: addEdgeUnchecked
+     * ------------------------
+     * Description: Like addEdge, without looking for an existing edge between s and d, which
+     * costs the degree of s. For loaders that already removed the repeated edges.
+     * @param s a vertex to connect
+     * @param d a vertex to connect
+     */
+    void addEdgeUnchecked(Vertex* s, Vertex* d)
+    {
+        s->addEdge(d);
+        if (!this->isDigraph())
+            d->addEdge(s);
+        touch();
+    }
+
     /**
      * Method: removeEdge
      * ---------------
@@ -174,18 +373,19 @@ public:
         s->removeEdge(d);
         if (!this->isDigraph())
             d->removeEdge(s);
+        touch();
     }
 
     /**
      * Method: getVertexById
      * ---------------------
-     * Description: informs the number of vertices currently in the graph
+     * Description: finds a vertex by its id in constant time, using the id index
      * @param id the vertex id
      * @returns the vertex with the specified id or nullptr if no vertex has the specified id
      */
     Vertex* getVertexById(VertexId id) const
     {
-        return VertexFinder<Vertex, VertexContainer>::find(id, vertices);
+        return index.find(id);
     }
 
     /**
@@ -283,9 +483,31 @@ public:
         return this->_isMultigraph;
     }
 
+    /**
+     * Method: getVersion
+     * ------------------
+     * Description: the version of the graph, see nextGraphVersion. addVertex, removeVertex,
+     * removeVerticesIf, addEdge and removeEdge change it; edges added or removed straight on
+     * the vertices do not, so that is only for graphs being built.
+     * @returns the version of the graph
+     */
+    std::uint64_t getVersion() const
+    {
+        return version;
+    }
+
+protected:
+    // gives the graph a new version; for the aspects that change the graph
+    void touch()
+    {
+        version = nextGraphVersion();
+    }
+
 private:
     bool _isDigraph;
     bool _isMultigraph;
     VertexContainer vertices;
+    VertexIndex<Vertex> index;
+    std::uint64_t version = nextGraphVersion();
 };
 }
@@ -40,6 +40,18 @@ public:
         insert_into(neighbors, other);
     }
 
+    /**
+     * Method: reserveEdges
+     * --------------------
+     * Description: Makes room for the given number of neighbours, so generators that know
+     * the final degrees fill the list without reallocations
+     * @param count number of neighbours the vertex will have
+     */
+    void reserveEdges(Degree count)
+    {
+        neighbors.reserve(count);
+    }
+
     /**
      * Method: removeEdge
      * --------------------------
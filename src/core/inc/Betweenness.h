@@ -1,26 +1,72 @@
 #pragma once
 
-#include <list>
-#include <queue>
-#include <stack>
 #include <vector>
 
+#include "BetweennessSample.h"
+#include "CompressedGraph.h"
 #include "IBetweenness.h"
+#include "Parallel.h"
 #include "mili/mili.h"
 
 namespace graphpp
 {
+/**
+ * Class: Betweenness
+ * ------------------
+ * Description: Brandes' algorithm, one BFS per source. Sources are handed out to a pool of
+ * threads; each thread keeps dense scratch arrays indexed by vertex position in a
+ * compressed copy of the graph, reuses them between sources and accumulates its own
+ * partial centralities, which are added up once every source is done.
+ * When built from a BetweennessSample only the pivots are used as sources and the result
+ * is an estimate.
+ */
 template <class Graph, class Vertex>
 class Betweenness : public IBetweenness<Graph, Vertex>
 {
 public:
     typedef typename IBetweenness<Graph, Vertex>::BetweennessContainer BetweennessContainer;
     typedef typename IBetweenness<Graph, Vertex>::BetweennessIterator BetweennessIterator;
+    typedef BetweennessSample<typename Vertex::VertexId> Sample;
+
+    /**
+     * Constructor
+     * -----------
+     * @param g the graph
+     * @param threads number of worker threads; 0 uses the hardware concurrency
+     */
+    Betweenness(Graph& g, unsigned int threads = 0)
+    {
+        const CompressedGraph csr(g);
+        std::vector<Index> sources(csr.verticesCount());
+        for (Index i = 0; i < sources.size(); ++i)
+            sources[i] = i;
+
+        initMap(g, 1, betweenness, 0.0, 0.0);
+        calculateBetweenness(csr, sources, 1.0, threads);
+    }
 
-    Betweenness(Graph& g)
+    /**
+     * Constructor
+     * -----------
+     * Description: approximate betweenness, using only the sampled pivots as sources
+     * @param g the graph
+     * @param sample the pivots and the scale to apply
+     * @param threads number of worker threads; 0 uses the hardware concurrency
+     */
+    Betweenness(Graph& g, const Sample& sample, unsigned int threads = 0)
     {
+        const CompressedGraph csr(g);
+        std::vector<Index> sources;
+        sources.reserve(sample.getPivots().size());
+        for (const auto id : sample.getPivots())
+        {
+            const Index index = csr.indexOf(id);
+            if (index < csr.verticesCount())
+                sources.push_back(index);
+        }
+
         initMap(g, 1, betweenness, 0.0, 0.0);
-        calculateBetweenness(g);
+        calculateBetweenness(csr, sources, sample.getScale(), threads);
     }
 
     virtual BetweennessIterator iterator()
@@ -29,78 +75,111 @@ public:
     }
 
 private:
-    void calculateBetweenness(Graph& g)
+    typedef CompressedGraph::Index Index;
+
+    /**
+     * Struct: Scratch
+     * ---------------
+     * Description: per-thread state. Only the entries touched by the last BFS are reset.
+     */
+    struct Scratch
     {
-        auto iter = g.verticesIterator();
-
-        while (!iter.end())
+        explicit Scratch(Index n) : sigma(n, 0.0), delta(n, 0.0), distance(n, -1), partial(n, 0.0)
         {
-            Vertex* s = *iter;
-            std::stack<Vertex*> stack;
-            std::queue<Vertex*> queue;
-            std::map<typename Vertex::VertexId, std::list<typename Vertex::VertexId>> p;
-            std::map<typename Vertex::VertexId, double> sigma;
-            std::map<typename Vertex::VertexId, double> d;
-            std::map<typename Vertex::VertexId, double> delta;
-
-            initMap(g, s->getVertexId(), sigma, 0.0, 1.0);
-            initMap(g, s->getVertexId(), d, -1.0, 0.0);
-            initMap(g, s->getVertexId(), delta, 0.0, 0.0);
+            order.reserve(n);
+        }
 
-            queue.push(s);
+        std::vector<double> sigma;
+        std::vector<double> delta;
+        std::vector<int> distance;
+        std::vector<Index> order;
+        std::vector<double> partial;
+    };
+
+    void calculateBetweenness(
+        const CompressedGraph& csr,
+        const std::vector<Index>& sources,
+        double scale,
+        unsigned int threads)
+    {
+        const Index n = csr.verticesCount();
+        threads = workerCount(threads, sources.size());
 
-            while (!queue.empty())
-            {
-                Vertex* v = queue.front();
-                queue.pop();
-                stack.push(v);
+        std::vector<Scratch> scratch;
+        scratch.reserve(threads);
+        for (unsigned int t = 0; t < threads; ++t)
+            scratch.emplace_back(n);
 
-                // iterate through v's neighbors
-                auto neighbourIter = v->neighborsIterator();
+        parallelFor(sources.size(), threads, [&](unsigned int worker, std::size_t i) {
+            accumulate(csr, sources[i], scratch[worker]);
+        });
 
-                while (!neighbourIter.end())
-                {
-                    Vertex* w = *neighbourIter;
-                    // w found for the first time?
-                    double wValue = d[w->getVertexId()];
-                    // double vValue = d[v->getVertexId()];
-                    if (wValue < 0)
-                    {
-                        queue.push(w);
-                        d[w->getVertexId()] = d[v->getVertexId()] + 1;
-                    }
-                    // shortest path to w via v?
-                    if (d[w->getVertexId()] == (d[v->getVertexId()] + 1))
-                    {
-                        sigma[w->getVertexId()] = sigma[w->getVertexId()] + sigma[v->getVertexId()];
-                        p[w->getVertexId()].push_back(v->getVertexId());
-                    }
-
-                    ++neighbourIter;
-                }
-            }
+        const auto& ids = csr.getIds();
+        for (Index v = 0; v < n; ++v)
+        {
+            double total = 0.0;
+            for (const auto& s : scratch)
+                total += s.partial[v];
+            betweenness[ids[v]] += total * scale;
+        }
+    }
 
-            // S returns vertices in order of non-increasing distance from s
-            while (!stack.empty())
-            {
-                Vertex* w = stack.top();
-                stack.pop();
+    /**
+     * Method: accumulate
+     * ------------------
+     * Description: single source step of Brandes' algorithm. The BFS order doubles as the
+     * stack, and predecessors are found again from the adjacency during the backward pass
+     * (w is a successor of v iff distance[w] == distance[v] + 1), so no lists are built.
+     */
+    static void accumulate(const CompressedGraph& csr, Index source, Scratch& s)
+    {
+        const auto& offsets = csr.getOffsets();
+        const auto& neighbors = csr.getNeighbors();
 
-                std::list<typename Vertex::VertexId> vertices = p[w->getVertexId()];
+        s.order.clear();
+        s.order.push_back(source);
+        s.sigma[source] = 1.0;
+        s.distance[source] = 0;
 
-                for (const auto& v : vertices)
+        for (std::size_t head = 0; head < s.order.size(); ++head)
+        {
+            const Index v = s.order[head];
+            const int next = s.distance[v] + 1;
+            for (auto e = offsets[v]; e < offsets[v + 1]; ++e)
+            {
+                const Index w = neighbors[e];
+                if (s.distance[w] < 0)
                 {
-                    delta[v] = delta[v] + ((1 + delta[w->getVertexId()]) *
-                                           (sigma[v] / sigma[w->getVertexId()]));
+                    s.distance[w] = next;
+                    s.order.push_back(w);
                 }
+                if (s.distance[w] == next)
+                    s.sigma[w] += s.sigma[v];
+            }
+        }
 
-                if (w->getVertexId() != s->getVertexId())
-                {
-                    betweenness[w->getVertexId()] += delta[w->getVertexId()];
-                }
+        for (std::size_t i = s.order.size(); i-- > 0;)
+        {
+            const Index v = s.order[i];
+            const int next = s.distance[v] + 1;
+            double dependency = 0.0;
+            for (auto e = offsets[v]; e < offsets[v + 1]; ++e)
+            {
+                const Index w = neighbors[e];
+                if (s.distance[w] == next)
+                    dependency += (1 + s.delta[w]) / s.sigma[w];
             }
+            s.delta[v] = s.sigma[v] * dependency;
 
-            ++iter;
+            if (v != source)
+                s.partial[v] += s.delta[v];
+        }
+
+        for (const Index v : s.order)
+        {
+            s.sigma[v] = 0.0;
+            s.delta[v] = 0.0;
+            s.distance[v] = -1;
         }
     }
 
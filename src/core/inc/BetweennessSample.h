@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Random.h"
+
+namespace graphpp
+{
+/**
+ * Class: BetweennessSample
+ * ------------------------
+ * Description: set of pivot vertices for approximate betweenness (Brandes & Pich). Only the
+ * pivots are used as BFS sources and every accumulated dependency is multiplied by
+ * n / pivots, which gives an unbiased estimate of the exact value. Pivots are drawn
+ * uniformly without replacement from a seeded generator, so a given graph, sample size
+ * and seed always give the same pivots.
+ */
+template <class VertexId>
+class BetweennessSample
+{
+public:
+    typedef uint64_t Seed;
+
+    static const Seed DefaultSeed = 0x5eed;
+
+    /**
+     * Method: fromCount
+     * -----------------
+     * Description: draws a fixed number of pivots
+     * @param g the graph
+     * @param samples amount of pivots; clamped to the number of vertices
+     * @param seed generator seed
+     */
+    template <class Graph>
+    static BetweennessSample fromCount(Graph& g, unsigned int samples, Seed seed = DefaultSeed)
+    {
+        std::vector<VertexId> ids;
+        ids.reserve(g.verticesCount());
+        auto it = g.verticesIterator();
+        while (!it.end())
+        {
+            ids.push_back((*it)->getVertexId());
+            ++it;
+        }
+        // container order differs between graph types, the draw must not
+        std::sort(ids.begin(), ids.end());
+
+        const std::size_t n = ids.size();
+        const std::size_t k = std::min<std::size_t>(samples, n);
+        Random generator(seed);
+        for (std::size_t i = 0; i < k; ++i)
+            std::swap(ids[i], ids[i + generator.below(n - i)]);
+        ids.resize(k);
+        std::sort(ids.begin(), ids.end());
+
+        return BetweennessSample(ids, k == 0 ? 0.0 : double(n) / double(k));
+    }
+
+    /**
+     * Method: fromAccuracy
+     * --------------------
+     * Description: draws as many pivots as needed so that, with probability at least
+     * 1 - delta, every normalized betweenness (divided by (n-1)(n-2)) is within epsilon
+     * of the exact one.
+     * @param g the graph
+     * @param epsilon additive error on the normalized betweenness, in (0, 1)
+     * @param delta failure probability, in (0, 1)
+     * @param seed generator seed
+     */
+    template <class Graph>
+    static BetweennessSample fromAccuracy(
+        Graph& g, double epsilon, double delta, Seed seed = DefaultSeed)
+    {
+        return fromCount(g, samplesFor(epsilon, delta, g.verticesCount()), seed);
+    }
+
+    /**
+     * Method: samplesFor
+     * ------------------
+     * Description: Hoeffding bound for one vertex plus a union bound over the n vertices.
+     * Each pivot contributes a dependency in [0, n-2] (normalized to [0, 1]), so
+     * k >= ln(2n / delta) / (2 epsilon^2) pivots are enough.
+     */
+    static unsigned int samplesFor(double epsilon, double delta, unsigned int n)
+    {
+        if (n == 0)
+            return 0;
+        const double k = std::log(2.0 * n / delta) / (2.0 * epsilon * epsilon);
+        return (unsigned int)std::min<double>(n, std::ceil(k));
+    }
+
+    const std::vector<VertexId>& getPivots() const
+    {
+        return pivots;
+    }
+
+    double getScale() const
+    {
+        return scale;
+    }
+
+private:
+    BetweennessSample(const std::vector<VertexId>& pivots, double scale)
+        : pivots(pivots), scale(scale)
+    {
+    }
+
+    std::vector<VertexId> pivots;
+    double scale;
+};
+}  // namespace graphpp
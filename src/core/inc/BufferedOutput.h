@@ -0,0 +1,193 @@
+// This toolbox is licensed under the Academic Free License 3.0.
+// Instituto Tecnológico de Buenos Aires (ITBA).
+
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef COMPLEXNETS_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace graphpp
+{
+/**
+ * Class: BufferedOutput
+ * ---------------------
+ * Description: output file for the exporters. Text is formatted straight into a large buffer
+ * which is handed to an unbuffered stdio file (or to zlib) only when full, instead of
+ * flushing every line as std::endl does. Paths ending in ".gz" are written gzip compressed
+ * when the build has zlib (COMPLEXNETS_HAVE_ZLIB), and as plain text otherwise.
+ * Numbers are written as ostream writes them by default: integers in decimal, doubles with
+ * %g. Like the ofstream it replaces, a file that cannot be opened is silently not written;
+ * see isOpen.
+ */
+class BufferedOutput
+{
+public:
+    static const std::size_t BufferSize = 1 << 20;
+
+    explicit BufferedOutput(const std::string& path) : file(nullptr)
+    {
+        buffer.reserve(BufferSize);
+#ifdef COMPLEXNETS_HAVE_ZLIB
+        if (isCompressedPath(path))
+        {
+            gz = gzopen(path.c_str(), "wb");
+            if (gz != nullptr)
+                gzbuffer(gz, BufferSize);
+            return;
+        }
+#endif
+        file = std::fopen(path.c_str(), "wb");
+        // the buffer of this class is the only one
+        if (file != nullptr)
+            std::setvbuf(file, nullptr, _IONBF, 0);
+    }
+
+    BufferedOutput(const BufferedOutput&) = delete;
+    BufferedOutput& operator=(const BufferedOutput&) = delete;
+
+    ~BufferedOutput()
+    {
+        close();
+    }
+
+    /**
+     * Method: isCompressedPath
+     * ------------------------
+     * @returns whether writing to the path compresses, that is, whether it ends in ".gz"
+     * and the build has zlib
+     */
+    static bool isCompressedPath(const std::string& path)
+    {
+#ifdef COMPLEXNETS_HAVE_ZLIB
+        return path.size() >= 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+#else
+        return false;
+#endif
+    }
+
+    bool isOpen() const
+    {
+#ifdef COMPLEXNETS_HAVE_ZLIB
+        if (gz != nullptr)
+            return true;
+#endif
+        return file != nullptr;
+    }
+
+    BufferedOutput& operator<<(char c)
+    {
+        reserve(1);
+        buffer.push_back(c);
+        return *this;
+    }
+
+    BufferedOutput& operator<<(const char* text)
+    {
+        const std::size_t length = std::strlen(text);
+        reserve(length);
+        buffer.insert(buffer.end(), text, text + length);
+        return *this;
+    }
+
+    BufferedOutput& operator<<(const std::string& text)
+    {
+        reserve(text.size());
+        buffer.insert(buffer.end(), text.begin(), text.end());
+        return *this;
+    }
+
+    BufferedOutput& operator<<(unsigned long long value)
+    {
+        char digits[20];
+        std::size_t length = 0;
+        do
+        {
+            digits[length++] = '0' + value % 10;
+            value /= 10;
+        } while (value != 0);
+
+        reserve(length);
+        while (length > 0)
+            buffer.push_back(digits[--length]);
+        return *this;
+    }
+
+    BufferedOutput& operator<<(unsigned int value)
+    {
+        return *this << (unsigned long long)value;
+    }
+
+    BufferedOutput& operator<<(unsigned long value)
+    {
+        return *this << (unsigned long long)value;
+    }
+
+    BufferedOutput& operator<<(int value)
+    {
+        if (value < 0)
+            return *this << '-' << (unsigned long long)(-(long long)value);
+        return *this << (unsigned long long)value;
+    }
+
+    BufferedOutput& operator<<(double value)
+    {
+        char text[32];
+        const int length = std::snprintf(text, sizeof(text), "%g", value);
+        reserve(length);
+        buffer.insert(buffer.end(), text, text + length);
+        return *this;
+    }
+
+    /**
+     * Method: close
+     * -------------
+     * Description: writes what is left in the buffer and closes the file
+     */
+    void close()
+    {
+        flush();
+#ifdef COMPLEXNETS_HAVE_ZLIB
+        if (gz != nullptr)
+        {
+            gzclose(gz);
+            gz = nullptr;
+        }
+#endif
+        if (file != nullptr)
+        {
+            std::fclose(file);
+            file = nullptr;
+        }
+    }
+
+private:
+    void reserve(std::size_t length)
+    {
+        if (buffer.size() + length > BufferSize)
+            flush();
+    }
+
+    void flush()
+    {
+#ifdef COMPLEXNETS_HAVE_ZLIB
+        if (gz != nullptr && !buffer.empty())
+            gzwrite(gz, buffer.data(), buffer.size());
+#endif
+        if (file != nullptr && !buffer.empty())
+            std::fwrite(buffer.data(), 1, buffer.size(), file);
+        buffer.clear();
+    }
+
+    std::FILE* file;
+#ifdef COMPLEXNETS_HAVE_ZLIB
+    gzFile gz = nullptr;
+#endif
+    std::vector<char> buffer;
+};
+}  // namespace graphpp
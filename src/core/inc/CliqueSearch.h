@@ -0,0 +1,370 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "CompressedGraph.h"
+#include "JobControl.h"
+
+namespace graphpp
+{
+/**
+ * Class: CliqueSearch
+ * -------------------
+ * Description: exact maximum cliques of a CompressedGraph: the size of the largest clique
+ * containing each vertex, and one largest clique of the whole graph.
+ * The vertices are taken from the dense end of a degeneracy ordering. For each one, the
+ * largest clique of its neighbourhood is found by a branch and bound in the style of
+ * MCQ/MCS (Tomita et al.): a greedy colouring of the candidates bounds the clique a branch
+ * can still reach, and branches that cannot beat the best clique known for the vertex are
+ * cut. The neighbourhood is relabelled to 0..k-1 and its adjacency and candidate sets are
+ * rows of 64-bit words (as in BBMC, San Segundo et al.), so intersecting candidates and
+ * colouring work a word at a time. A clique found raises the bound of all of its vertices,
+ * and a vertex whose bound is its core number plus one needs no search.
+ * The search gives up at a deadline, read from the clock once per vertex and every
+ * checkInterval branches, and at the checkpoints of the current job (see JobControl).
+ */
+class CliqueSearch
+{
+public:
+    using Index = CompressedGraph::Index;
+    using Clock = std::chrono::steady_clock;
+
+    CliqueSearch(const CompressedGraph& g, Clock::time_point deadline)
+        : graph(g), deadline(deadline), timedOut(false), branches(0)
+    {
+        const Index n = g.verticesCount();
+        cliqueSize.assign(n, n == 0 ? 0 : 1);
+        position.assign(n, Index(none));
+        degeneracyOrder();
+
+        // the vertex of the last core is the largest clique until one is found
+        if (n > 0)
+            maximum.push_back(order.back());
+        for (Index i = n; i-- > 0 && !timedOut;)
+        {
+            JobControl::progress(n - 1 - i, n);
+            if (Clock::now() > deadline)
+                timedOut = true;
+            else
+                searchAround(order[i]);
+        }
+    }
+
+    /**
+     * Method: finished
+     * ----------------
+     * @returns false if the deadline passed before the search was over; the sizes and the
+     * clique are then only the largest found so far
+     */
+    bool finished() const
+    {
+        return !timedOut;
+    }
+
+    /**
+     * Method: maximumClique
+     * ---------------------
+     * @returns the indices of a largest clique of the graph
+     */
+    const std::vector<Index>& maximumClique() const
+    {
+        return maximum;
+    }
+
+    /**
+     * Method: cliqueSizeOf
+     * --------------------
+     * @returns the size of the largest clique containing the vertex of index v
+     */
+    unsigned int cliqueSizeOf(Index v) const
+    {
+        return cliqueSize[v];
+    }
+
+private:
+    typedef std::uint64_t Word;
+    static const unsigned int wordBits = 64;
+    static const unsigned int checkInterval = 1024;
+    static const Index none = std::numeric_limits<Index>::max();
+
+    // the candidates of a depth of the search, and their colouring
+    struct Level
+    {
+        std::vector<Word> candidates;
+        std::vector<Word> uncoloured;
+        std::vector<Word> colourable;
+        std::vector<Index> order;
+        std::vector<unsigned int> colours;
+    };
+
+    static unsigned int lowestBit(Word word)
+    {
+#if defined(__GNUC__)
+        return __builtin_ctzll(word);
+#else
+        unsigned int bit = 0;
+        while ((word & 1) == 0)
+        {
+            word >>= 1;
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    static bool empty(const std::vector<Word>& set)
+    {
+        for (const Word word : set)
+            if (word != 0)
+                return false;
+        return true;
+    }
+
+    /**
+     * Method: degeneracyOrder
+     * -----------------------
+     * Description: fills order with the vertices in the order they are peeled off by
+     * repeatedly removing one of minimum degree, rank with the position of each vertex in
+     * it, and core with their core numbers (Batagelj and Zaversnik)
+     */
+    void degeneracyOrder()
+    {
+        const Index n = graph.verticesCount();
+        std::vector<unsigned int> degree(n);
+        unsigned int maxDegree = 0;
+        for (Index v = 0; v < n; ++v)
+        {
+            degree[v] = graph.degree(v);
+            maxDegree = std::max(maxDegree, degree[v]);
+        }
+
+        std::vector<Index> binStart(maxDegree + 2, 0);
+        for (Index v = 0; v < n; ++v)
+            ++binStart[degree[v] + 1];
+        for (unsigned int d = 0; d <= maxDegree; ++d)
+            binStart[d + 1] += binStart[d];
+        order.resize(n);
+        rank.resize(n);
+        std::vector<Index> next(binStart.begin(), binStart.end() - 1);
+        for (Index v = 0; v < n; ++v)
+        {
+            rank[v] = next[degree[v]]++;
+            order[rank[v]] = v;
+        }
+
+        const auto& offsets = graph.getOffsets();
+        const auto& neighbors = graph.getNeighbors();
+        for (Index i = 0; i < n; ++i)
+        {
+            const Index v = order[i];
+            for (auto e = offsets[v]; e < offsets[v + 1]; ++e)
+            {
+                const Index u = neighbors[e];
+                if (degree[u] <= degree[v])
+                    continue;
+                // move u to the front of its bin, then to the end of the bin below
+                const Index first = binStart[degree[u]];
+                const Index w = order[first];
+                std::swap(order[rank[u]], order[first]);
+                std::swap(rank[u], rank[w]);
+                ++binStart[degree[u]];
+                --degree[u];
+            }
+        }
+        core.swap(degree);
+    }
+
+    /**
+     * Method: searchAround
+     * --------------------
+     * Description: looks for a clique containing v larger than the one known for it, among
+     * its neighbours that may be in such a clique
+     */
+    void searchAround(Index v)
+    {
+        const unsigned int known = cliqueSize[v];
+        if (known > core[v])
+            return;
+
+        // a clique of known + 1 vertices lies in the known-core
+        local.clear();
+        const auto& offsets = graph.getOffsets();
+        const auto& neighbors = graph.getNeighbors();
+        for (auto e = offsets[v]; e < offsets[v + 1]; ++e)
+        {
+            const Index u = neighbors[e];
+            if (u != v && core[u] >= known)
+                local.push_back(u);
+        }
+        if (local.size() < known)
+            return;
+
+        // the dense end of the ordering first, so the greedy colouring starts from it
+        // (a multigraph repeats neighbours)
+        std::sort(local.begin(), local.end(), [this](Index a, Index b) {
+            return rank[a] > rank[b];
+        });
+        local.erase(std::unique(local.begin(), local.end()), local.end());
+        if (local.size() < known)
+            return;
+        const Index k = local.size();
+        words = (k + wordBits - 1) / wordBits;
+        for (Index i = 0; i < k; ++i)
+            position[local[i]] = i;
+        adjacency.assign(std::size_t(k) * words, 0);
+        for (Index i = 0; i < k; ++i)
+        {
+            Word* row = &adjacency[std::size_t(i) * words];
+            for (auto e = offsets[local[i]]; e < offsets[local[i] + 1]; ++e)
+            {
+                const Index j = position[neighbors[e]];
+                if (j != none && j != i)
+                    row[j / wordBits] |= Word(1) << (j % wordBits);
+            }
+        }
+
+        if (levels.size() < core[v] + 2)
+            levels.resize(core[v] + 2);
+        Level& root = levels[0];
+        root.candidates.assign(words, ~Word(0));
+        if (k % wordBits != 0)
+            root.candidates.back() = (Word(1) << (k % wordBits)) - 1;
+        bestLocal = known - 1;
+        found.clear();
+        current.clear();
+        expand(0);
+
+        for (const Index u : local)
+            position[u] = none;
+
+        if (!found.empty())
+        {
+            std::vector<Index> clique(1, v);
+            for (const Index i : found)
+                clique.push_back(local[i]);
+            const unsigned int size = clique.size();
+            for (const Index u : clique)
+                cliqueSize[u] = std::max(cliqueSize[u], size);
+            if (size > maximum.size())
+                maximum.swap(clique);
+        }
+    }
+
+    /**
+     * Method: colourSort
+     * ------------------
+     * Description: colours the candidates of a level greedily, a colour class at a time,
+     * taking the vertices in label order. Only the vertices whose colour is at least
+     * minColour are listed in order, by increasing colour: the others cannot lead to a
+     * larger clique, so they are not branched on (they stay candidates of the deeper
+     * levels).
+     */
+    void colourSort(Level& level, unsigned int minColour)
+    {
+        level.order.clear();
+        level.colours.clear();
+        level.uncoloured = level.candidates;
+        level.colourable.resize(words);
+        unsigned int colour = 0;
+        Index first = 0;
+        while (first < words)
+        {
+            if (level.uncoloured[first] == 0)
+            {
+                ++first;
+                continue;
+            }
+            ++colour;
+            std::copy(level.uncoloured.begin(), level.uncoloured.end(), level.colourable.begin());
+            for (Index w = first; w < words; ++w)
+            {
+                while (level.colourable[w] != 0)
+                {
+                    const Index j = w * wordBits + lowestBit(level.colourable[w]);
+                    const Word bit = Word(1) << (j % wordBits);
+                    level.uncoloured[w] &= ~bit;
+                    level.colourable[w] &= ~bit;
+                    const Word* row = &adjacency[std::size_t(j) * words];
+                    for (Index x = w; x < words; ++x)
+                        level.colourable[x] &= ~row[x];
+                    if (colour >= minColour)
+                    {
+                        level.order.push_back(j);
+                        level.colours.push_back(colour);
+                    }
+                }
+            }
+        }
+    }
+
+    void expand(std::size_t depth)
+    {
+        Level& level = levels[depth];
+        const unsigned int depthSize = current.size();
+        colourSort(level, bestLocal >= depthSize ? bestLocal - depthSize + 1 : 1);
+
+        for (std::size_t i = level.order.size(); i-- > 0;)
+        {
+            if (depthSize + level.colours[i] <= bestLocal)
+                return;
+            if (++branches % checkInterval == 0)
+            {
+                JobControl::checkpoint();
+                if (Clock::now() > deadline)
+                {
+                    timedOut = true;
+                    return;
+                }
+            }
+
+            const Index j = level.order[i];
+            const Word* row = &adjacency[std::size_t(j) * words];
+            Level& next = levels[depth + 1];
+            next.candidates.resize(words);
+            for (Index x = 0; x < words; ++x)
+                next.candidates[x] = level.candidates[x] & row[x];
+
+            current.push_back(j);
+            if (empty(next.candidates))
+            {
+                if (current.size() > bestLocal)
+                {
+                    bestLocal = current.size();
+                    found = current;
+                }
+            }
+            else
+                expand(depth + 1);
+            current.pop_back();
+            if (timedOut)
+                return;
+
+            level.candidates[j / wordBits] &= ~(Word(1) << (j % wordBits));
+        }
+    }
+
+    const CompressedGraph& graph;
+    const Clock::time_point deadline;
+    bool timedOut;
+    unsigned long branches;
+
+    std::vector<Index> order;
+    std::vector<Index> rank;
+    std::vector<unsigned int> core;
+    std::vector<unsigned int> cliqueSize;
+    std::vector<Index> maximum;
+
+    // the neighbourhood being searched: its vertices, their labels and adjacency rows
+    std::vector<Index> local;
+    std::vector<Index> position;
+    std::vector<Word> adjacency;
+    Index words;
+    std::vector<Level> levels;
+    std::vector<Index> current;
+    std::vector<Index> found;
+    unsigned int bestLocal;
+};
+}  // namespace graphpp
@@ -1,69 +1,81 @@
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include "IClusteringCoefficient.h"
+#include "TriangleCounter.h"
 
 namespace graphpp
 {
+/**
+ * Class: ClusteringCoefficient
+ * ----------------------------
+ * Description: clustering coefficient of undirected graphs. The first call to
+ * clusteringCoefficient(g, d) counts the triangles of the whole graph with a TriangleCounter;
+ * later calls for other degrees, and vertexClusteringCoefficient on vertices of g, read that
+ * result. It is a snapshot: use a new instance after modifying the graph.
+ * The triangles are counted with the given number of threads; 0 uses the hardware concurrency.
+ */
 template <class Graph, class Vertex>
 class ClusteringCoefficient : public IClusteringCoefficient<Graph, Vertex>
 {
 public:
+    explicit ClusteringCoefficient(unsigned int threads = 0) : graph(nullptr), threads(threads) {}
+
     virtual double clusteringCoefficient(Graph& g, unsigned int d)
     {
-        auto it = g.verticesIterator();
-        unsigned int count = 0;
-        double clusteringCoefSums = 0.0;
-
-        while (!it.end())
-        {
-            Vertex* v = *it;
-
-            if (v->degree() == d)
-            {
-                count++;
-                clusteringCoefSums += vertexClusteringCoefficient(v);
-            }
-
-            ++it;
-        }
-
-        return count == 0 ? 0 : clusteringCoefSums / count;
+        return trianglesOf(g).meanClustering(d);
     }
 
     virtual double vertexClusteringCoefficient(Vertex* vertex)
     {
-        double links = 0.0;
-        auto it = vertex->neighborsIterator();
-        double ret;
+        if (triangles && graph->getVertexById(vertex->getVertexId()) == vertex)
+            return triangles->clustering(vertex->getVertexId());
 
+        // A single vertex: count the links among its neighbours on a sorted copy of them.
+        std::vector<Vertex*> neighbours;
+        auto it = vertex->neighborsIterator();
         while (!it.end())
         {
-            Vertex* n = *it;
+            neighbours.push_back(*it);
+            ++it;
+        }
+        std::sort(neighbours.begin(), neighbours.end());
 
+        double links = 0.0;
+        for (Vertex* n : neighbours)
+        {
             auto innerIter = n->neighborsIterator();
-
             while (!innerIter.end())
             {
-                Vertex* i = *innerIter;
                 // if i is neighbour of vertex, we close a triangle
-                if (i->isNeighbourOf(vertex))
-                {
+                if (std::binary_search(neighbours.begin(), neighbours.end(), *innerIter))
                     links += 1.0;
-                }
-
                 ++innerIter;
             }
-
-            ++it;
         }
 
         // This is to avoid division by cero
         if (vertex->degree() == 0 || vertex->degree() == 1)
-            ret = 0;
-        else
-            ret = links / (vertex->degree() * (vertex->degree() - 1));
+            return 0;
+        return links / (vertex->degree() * (vertex->degree() - 1));
+    }
 
-        return ret;
+private:
+    const TriangleCounter& trianglesOf(Graph& g)
+    {
+        if (!triangles || graph != &g)
+        {
+            triangles.reset(new TriangleCounter(g, threads));
+            graph = &g;
+        }
+        return *triangles;
     }
+
+    Graph* graph;
+    const unsigned int threads;
+    std::unique_ptr<TriangleCounter> triangles;
 };
 }  // namespace graphpp
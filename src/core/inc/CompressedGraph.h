@@ -0,0 +1,617 @@
+// This toolbox is licensed under the Academic Free License 3.0.
+// Instituto Tecnológico de Buenos Aires (ITBA).
+
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace graphpp
+{
+class CompressedGraph;
+
+/**
+ * Class: CompressedVertex
+ * -----------------------
+ * Description: Vertex handle of a CompressedGraph. It does not own its adjacency: the
+ * neighbours live in the contiguous arrays of the graph and are addressed by the dense
+ * index of the vertex (0..n-1). Provides the same interface the metric templates use on
+ * AdjacencyListVertex, so a CompressedGraph can be passed as their Graph/Vertex arguments.
+ */
+class CompressedVertex
+{
+public:
+    using VertexId = unsigned int;
+    using Degree = unsigned int;
+    using Index = unsigned int;
+    using Weight = double;
+
+    /**
+     * Class: NeighborsIterator
+     * ------------------------
+     * Description: Forward iterator over a slice of the neighbour array of the graph,
+     * with the same end(), ++ and dereference as mili's AutonomousIterator.
+     */
+    class NeighborsIterator
+    {
+    public:
+        NeighborsIterator(CompressedVertex* vertices, const Index* current, const Index* last)
+            : vertices(vertices), current(current), last(last)
+        {
+        }
+
+        bool end() const
+        {
+            return current == last;
+        }
+
+        NeighborsIterator& operator++()
+        {
+            ++current;
+            return *this;
+        }
+
+        NeighborsIterator operator++(int)
+        {
+            NeighborsIterator ret(*this);
+            ++current;
+            return ret;
+        }
+
+        CompressedVertex* operator*() const
+        {
+            return vertices + *current;
+        }
+
+    private:
+        CompressedVertex* vertices;
+        const Index* current;
+        const Index* last;
+    };
+
+    using VerticesIterator = NeighborsIterator;
+    using VerticesConstIterator = NeighborsIterator;
+
+    CompressedVertex(const CompressedGraph* graph, Index index, VertexId id)
+        : graph(graph), index(index), vertexId(id), visited(false)
+    {
+    }
+
+    /**
+     * Method: neighborsIterator
+     * -------------------------
+     * Description: Provides an iterator over the neighbours of the vertex, in increasing
+     * order of their dense index (and therefore of their id).
+     * @returns NeighborsIterator for iterating neighbors
+     */
+    inline NeighborsIterator neighborsIterator() const;
+
+    NeighborsIterator neighborsConstIterator() const
+    {
+        return neighborsIterator();
+    }
+
+    /**
+     * Method: isNeighbourOf
+     * ---------------------
+     * Description: Indicates whether the other vertex is a neighbour. Adjacency slices are
+     * sorted, so this is a binary search instead of a linear scan.
+     * @param other Vertex that we want to test if is a neighbour
+     * @returns True if the vertex is a neighbour, and false otherwise
+     */
+    inline bool isNeighbourOf(const CompressedVertex* other) const;
+
+    inline Degree degree() const;
+
+    /**
+     * Method: edgeWeight
+     * ------------------
+     * Description: weight of the edge to a neighbour, for weighted graphs
+     * @param neighbour a neighbour of this vertex
+     * @returns the edge weight, or 0 if the vertex is not a neighbour
+     */
+    inline Weight edgeWeight(const CompressedVertex* neighbour) const;
+
+    VertexId getVertexId() const
+    {
+        return vertexId;
+    }
+
+    /**
+     * Method: getIndex
+     * ----------------
+     * Description: returns the dense index of the vertex inside its graph.
+     * @returns vertex's index, in the range [0, verticesCount())
+     */
+    Index getIndex() const
+    {
+        return index;
+    }
+
+    bool getVisited() const
+    {
+        return visited;
+    }
+
+    void setVisited(bool v)
+    {
+        visited = v;
+    }
+
+private:
+    friend class CompressedGraph;
+
+    const CompressedGraph* graph;
+    Index index;
+    VertexId vertexId;
+    bool visited;
+};
+
+/**
+ * Class: CompressedGraph
+ * ----------------------
+ * Description: Immutable compressed-sparse-row graph. Vertices are renumbered densely as
+ * 0..n-1 in increasing order of their original id; the neighbours of vertex i are
+ * neighbors[offsets[i] .. offsets[i + 1]), sorted. The original ids are kept in an id-remap
+ * table. It is built once, either from any graph exposing verticesIterator() and
+ * neighborsIterator() (e.g. AdjacencyListGraph) or from an edge list, and it can be used as
+ * the Graph template argument of the metric classes, with CompressedVertex as the Vertex.
+ * For digraphs the stored adjacency is the out-adjacency. Weighted graphs also keep a
+ * weights array parallel to the neighbours.
+ */
+class CompressedGraph
+{
+public:
+    using Vertex = CompressedVertex;
+    using VertexId = Vertex::VertexId;
+    using Index = Vertex::Index;
+    using Weight = Vertex::Weight;
+    using Offset = unsigned long;
+    using Edge = std::pair<VertexId, VertexId>;
+    using NeighborsIterator = Vertex::NeighborsIterator;
+
+    /**
+     * Class: VerticesIterator
+     * -----------------------
+     * Description: Forward iterator over the vertices of the graph, in dense index order.
+     */
+    class VerticesIterator
+    {
+    public:
+        VerticesIterator(Vertex* current, Vertex* last) : current(current), last(last) {}
+
+        bool end() const
+        {
+            return current == last;
+        }
+
+        VerticesIterator& operator++()
+        {
+            ++current;
+            return *this;
+        }
+
+        VerticesIterator operator++(int)
+        {
+            VerticesIterator ret(*this);
+            ++current;
+            return ret;
+        }
+
+        Vertex* operator*() const
+        {
+            return current;
+        }
+
+    private:
+        Vertex* current;
+        Vertex* last;
+    };
+
+    using VerticesConstIterator = VerticesIterator;
+
+    CompressedGraph(const bool isDigraph = false, const bool isMultigraph = false)
+        : offsets(1, 0), _isDigraph(isDigraph), _isMultigraph(isMultigraph)
+    {
+    }
+
+    /**
+     * Constructor
+     * -----------
+     * Description: Freezes the current state of another graph.
+     * @param g source graph; it is only read
+     */
+    template <
+        class SourceGraph,
+        class = typename std::enable_if<!std::is_same<SourceGraph, CompressedGraph>::value>::type>
+    explicit CompressedGraph(SourceGraph& g)
+        : _isDigraph(g.isDigraph()), _isMultigraph(g.isMultigraph())
+    {
+        auto it = g.verticesIterator();
+        while (!it.end())
+        {
+            ids.push_back((*it)->getVertexId());
+            ++it;
+        }
+        std::sort(ids.begin(), ids.end());
+
+        using SourceVertexPtr = typename std::decay<decltype(*g.verticesIterator())>::type;
+        using SourceVertex = typename std::remove_pointer<SourceVertexPtr>::type;
+
+        std::vector<Edge> edges;
+        std::vector<Weight> edgeWeights;
+        auto edgesIt = g.verticesIterator();
+        while (!edgesIt.end())
+        {
+            auto neighborsIt = (*edgesIt)->neighborsIterator();
+            while (!neighborsIt.end())
+            {
+                edges.push_back(Edge((*edgesIt)->getVertexId(), (*neighborsIt)->getVertexId()));
+                addWeight(edgeWeights, *edgesIt, static_cast<SourceVertex*>(*neighborsIt), 0);
+                ++neighborsIt;
+            }
+            ++edgesIt;
+        }
+
+        // The source adjacency already holds both directions of undirected edges.
+        build(edges, true, edgeWeights);
+    }
+
+    CompressedGraph(const CompressedGraph& other)
+        : offsets(other.offsets),
+          neighbors(other.neighbors),
+          ids(other.ids),
+          weights(other.weights),
+          vertices(other.vertices),
+          _isDigraph(other._isDigraph),
+          _isMultigraph(other._isMultigraph)
+    {
+        bindVertices();
+    }
+
+    CompressedGraph(CompressedGraph&& other)
+        : offsets(std::move(other.offsets)),
+          neighbors(std::move(other.neighbors)),
+          ids(std::move(other.ids)),
+          weights(std::move(other.weights)),
+          vertices(std::move(other.vertices)),
+          _isDigraph(other._isDigraph),
+          _isMultigraph(other._isMultigraph)
+    {
+        bindVertices();
+    }
+
+    CompressedGraph& operator=(CompressedGraph other)
+    {
+        offsets.swap(other.offsets);
+        neighbors.swap(other.neighbors);
+        ids.swap(other.ids);
+        weights.swap(other.weights);
+        vertices.swap(other.vertices);
+        _isDigraph = other._isDigraph;
+        _isMultigraph = other._isMultigraph;
+        bindVertices();
+        return *this;
+    }
+
+    /**
+     * Method: fromEdges
+     * -----------------
+     * Description: Builds a graph from an edge list. Every endpoint becomes a vertex. Unless
+     * the graph is a digraph each edge is stored in both directions, and unless it is a
+     * multigraph repeated edges are stored once.
+     * @param edges list of (source, destination) pairs of vertex ids
+     * @param isolated ids of vertices that have no edges, they may be repeated in edges
+     * @returns the compressed graph
+     */
+    static CompressedGraph fromEdges(
+        const std::vector<Edge>& edges,
+        const std::vector<VertexId>& isolated,
+        const bool isDigraph = false,
+        const bool isMultigraph = false)
+    {
+        return fromWeightedEdges(edges, std::vector<Weight>(), isolated, isDigraph, isMultigraph);
+    }
+
+    /**
+     * Method: fromWeightedEdges
+     * -------------------------
+     * Description: Same as fromEdges, with a weight per edge. When repeated edges are merged
+     * the weight of the first one is kept.
+     * @param edges list of (source, destination) pairs of vertex ids
+     * @param edgeWeights weight of each edge, parallel to edges; empty for unweighted graphs
+     * @param isolated ids of vertices that have no edges, they may be repeated in edges
+     * @returns the compressed graph
+     */
+    static CompressedGraph fromWeightedEdges(
+        const std::vector<Edge>& edges,
+        const std::vector<Weight>& edgeWeights,
+        const std::vector<VertexId>& isolated,
+        const bool isDigraph = false,
+        const bool isMultigraph = false)
+    {
+        CompressedGraph g(isDigraph, isMultigraph);
+        g.ids = isolated;
+        for (const auto& e : edges)
+        {
+            g.ids.push_back(e.first);
+            g.ids.push_back(e.second);
+        }
+        std::sort(g.ids.begin(), g.ids.end());
+        g.ids.erase(std::unique(g.ids.begin(), g.ids.end()), g.ids.end());
+        g.build(edges, isDigraph, edgeWeights);
+        return g;
+    }
+
+    VerticesIterator verticesIterator()
+    {
+        return VerticesIterator(vertices.data(), vertices.data() + vertices.size());
+    }
+
+    VerticesConstIterator verticesConstIterator() const
+    {
+        Vertex* first = const_cast<Vertex*>(vertices.data());
+        return VerticesConstIterator(first, first + vertices.size());
+    }
+
+    /**
+     * Method: getVertexById
+     * ---------------------
+     * Description: looks up a vertex by its original id through the id-remap table.
+     * @param id the vertex id
+     * @returns the vertex with the specified id or nullptr if no vertex has the specified id
+     */
+    Vertex* getVertexById(VertexId id) const
+    {
+        Index i = indexOf(id);
+        return i == verticesCount() ? nullptr : const_cast<Vertex*>(&vertices[i]);
+    }
+
+    /**
+     * Method: indexOf
+     * ---------------
+     * Description: maps an original vertex id to its dense index.
+     * @param id the vertex id
+     * @returns the dense index, or verticesCount() if the id is not in the graph
+     */
+    Index indexOf(VertexId id) const
+    {
+        auto it = std::lower_bound(ids.begin(), ids.end(), id);
+        if (it == ids.end() || *it != id)
+            return verticesCount();
+        return it - ids.begin();
+    }
+
+    Vertex* vertexAt(Index i)
+    {
+        return &vertices[i];
+    }
+
+    unsigned int verticesCount() const
+    {
+        return ids.size();
+    }
+
+    /**
+     * Method: edgesCount
+     * ------------------
+     * Description: number of stored adjacency entries. For undirected graphs every edge is
+     * stored twice.
+     */
+    Offset edgesCount() const
+    {
+        return neighbors.size();
+    }
+
+    NeighborsIterator neighborsIterator(Index i) const
+    {
+        Vertex* first = const_cast<Vertex*>(vertices.data());
+        return NeighborsIterator(
+            first, neighbors.data() + offsets[i], neighbors.data() + offsets[i + 1]);
+    }
+
+    unsigned int degree(Index i) const
+    {
+        return offsets[i + 1] - offsets[i];
+    }
+
+    // Raw CSR arrays, for algorithms that work on dense indices.
+    const std::vector<Offset>& getOffsets() const
+    {
+        return offsets;
+    }
+
+    const std::vector<Index>& getNeighbors() const
+    {
+        return neighbors;
+    }
+
+    const std::vector<VertexId>& getIds() const
+    {
+        return ids;
+    }
+
+    // Edge weights, parallel to getNeighbors(); empty if the graph is not weighted.
+    const std::vector<Weight>& getWeights() const
+    {
+        return weights;
+    }
+
+    bool isWeighted() const
+    {
+        return !weights.empty();
+    }
+
+    bool isDigraph() const
+    {
+        return _isDigraph;
+    }
+
+    bool isMultigraph() const
+    {
+        return _isMultigraph;
+    }
+
+private:
+    template <class SourceVertex>
+    static auto addWeight(std::vector<Weight>& w, SourceVertex* s, SourceVertex* d, int)
+        -> decltype(s->edgeWeight(d), void())
+    {
+        w.push_back(s->edgeWeight(d));
+    }
+
+    template <class SourceVertex>
+    static void addWeight(std::vector<Weight>&, SourceVertex*, SourceVertex*, long)
+    {
+    }
+
+    /**
+     * Builds offsets and neighbours from an edge list whose endpoints are all in ids.
+     * If oneWay is false every edge is also stored reversed. edgeWeights is either empty
+     * or parallel to edges.
+     */
+    void build(
+        const std::vector<Edge>& edges, const bool oneWay, const std::vector<Weight>& edgeWeights)
+    {
+        const bool weighted = !edgeWeights.empty();
+        const Index n = ids.size();
+        offsets.assign(n + 1, 0);
+        for (const auto& e : edges)
+        {
+            ++offsets[indexOf(e.first) + 1];
+            if (!oneWay)
+                ++offsets[indexOf(e.second) + 1];
+        }
+        for (Index i = 0; i < n; ++i)
+            offsets[i + 1] += offsets[i];
+
+        neighbors.resize(offsets[n]);
+        weights.assign(weighted ? offsets[n] : 0, 0.0);
+        std::vector<Offset> next(offsets.begin(), offsets.end() - 1);
+        for (std::size_t k = 0; k < edges.size(); ++k)
+        {
+            Index s = indexOf(edges[k].first);
+            Index d = indexOf(edges[k].second);
+            if (weighted)
+                weights[next[s]] = edgeWeights[k];
+            neighbors[next[s]++] = d;
+            if (!oneWay)
+            {
+                if (weighted)
+                    weights[next[d]] = edgeWeights[k];
+                neighbors[next[d]++] = s;
+            }
+        }
+
+        if (weighted)
+            sortWeightedSlices();
+        else
+            for (Index i = 0; i < n; ++i)
+                std::sort(neighbors.begin() + offsets[i], neighbors.begin() + offsets[i + 1]);
+
+        if (!_isMultigraph)
+            removeRepeatedNeighbors();
+
+        vertices.clear();
+        vertices.reserve(n);
+        for (Index i = 0; i < n; ++i)
+            vertices.push_back(Vertex(this, i, ids[i]));
+    }
+
+    void sortWeightedSlices()
+    {
+        std::vector<std::pair<Index, Weight>> slice;
+        for (Index i = 0; i + 1 < offsets.size(); ++i)
+        {
+            slice.clear();
+            for (Offset j = offsets[i]; j < offsets[i + 1]; ++j)
+                slice.push_back(std::make_pair(neighbors[j], weights[j]));
+            // stable, so the first of a run of repeated edges keeps its weight
+            std::stable_sort(
+                slice.begin(), slice.end(),
+                [](const std::pair<Index, Weight>& a, const std::pair<Index, Weight>& b) {
+                    return a.first < b.first;
+                });
+            for (Offset j = offsets[i]; j < offsets[i + 1]; ++j)
+            {
+                neighbors[j] = slice[j - offsets[i]].first;
+                weights[j] = slice[j - offsets[i]].second;
+            }
+        }
+    }
+
+    void removeRepeatedNeighbors()
+    {
+        const Index n = ids.size();
+        Offset write = 0;
+        Offset begin = 0;
+        for (Index i = 0; i < n; ++i)
+        {
+            Offset end = offsets[i + 1];
+            Offset first = write;
+            for (Offset j = begin; j < end; ++j)
+            {
+                if (write == first || neighbors[j] != neighbors[write - 1])
+                {
+                    if (!weights.empty())
+                        weights[write] = weights[j];
+                    neighbors[write++] = neighbors[j];
+                }
+            }
+            begin = end;
+            offsets[i + 1] = write;
+        }
+        neighbors.resize(write);
+        if (!weights.empty())
+            weights.resize(write);
+    }
+
+    void bindVertices()
+    {
+        for (auto& v : vertices)
+            v.graph = this;
+    }
+
+    std::vector<Offset> offsets;
+    std::vector<Index> neighbors;
+    std::vector<VertexId> ids;
+    std::vector<Weight> weights;
+    std::vector<Vertex> vertices;
+    bool _isDigraph;
+    bool _isMultigraph;
+};
+
+inline CompressedVertex::NeighborsIterator CompressedVertex::neighborsIterator() const
+{
+    return graph->neighborsIterator(index);
+}
+
+inline bool CompressedVertex::isNeighbourOf(const CompressedVertex* other) const
+{
+    const auto& offsets = graph->getOffsets();
+    const auto& neighbors = graph->getNeighbors();
+    return std::binary_search(
+        neighbors.begin() + offsets[index], neighbors.begin() + offsets[index + 1],
+        other->index);
+}
+
+inline CompressedVertex::Degree CompressedVertex::degree() const
+{
+    return graph->degree(index);
+}
+
+inline CompressedVertex::Weight CompressedVertex::edgeWeight(
+    const CompressedVertex* neighbour) const
+{
+    const auto& offsets = graph->getOffsets();
+    const auto& neighbors = graph->getNeighbors();
+    auto first = neighbors.begin() + offsets[index];
+    auto last = neighbors.begin() + offsets[index + 1];
+    auto it = std::lower_bound(first, last, neighbour->index);
+    if (it == last || *it != neighbour->index || !graph->isWeighted())
+        return 0.0;
+    return graph->getWeights()[it - neighbors.begin()];
+}
+}  // namespace graphpp
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "CompressedGraph.h"
+#include "EdgeListParser.h"
+#include "GraphExceptions.h"
+#include "IGraphReader.h"
+#include "MappedFile.h"
+
+namespace graphpp
+{
+/**
+ * Class: CompressedGraphReader
+ * ----------------------------
+ * Description: Reads an edge list file (same format as GraphReader) straight into a
+ * CompressedGraph, without building an AdjacencyListGraph first. The edges are collected
+ * in a flat list and the graph is frozen once at the end of the file.
+ */
+template <class Graph, class Vertex>
+class CompressedGraphReader : public IGraphReader<Graph, Vertex>
+{
+public:
+    typedef unsigned int LineNumber;
+
+    virtual void read(Graph& g, std::string source)
+    {
+        const MappedFile file(source);
+        EdgeListParser parser(file.begin(), file.end(), false);
+
+        std::vector<typename Graph::Edge> edges;
+        std::vector<typename Vertex::VertexId> isolated;
+        EdgeListParser::Line line;
+        while (parser.next(line))
+        {
+            if (line.isEdge)
+                edges.push_back(typename Graph::Edge(line.source, line.destination));
+            else
+                isolated.push_back(line.source);
+        }
+        currentLineNumber = parser.getLineNumber();
+
+        g = Graph::fromEdges(edges, isolated, g.isDigraph(), g.isMultigraph());
+    }
+
+    LineNumber getLineNumber() const
+    {
+        return currentLineNumber;
+    }
+
+private:
+    LineNumber currentLineNumber;
+};
+}  // namespace graphpp
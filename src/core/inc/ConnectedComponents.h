@@ -0,0 +1,156 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "DisjointSets.h"
+
+namespace graphpp
+{
+/**
+ * Class: ConnectedComponents
+ * --------------------------
+ * Description: connected components of a graph, found with union-find over the neighbour
+ * lists in O(m α(n)) and without touching the vertices' visited flags. Vertices get a dense
+ * index in the order of the vertex container, and components a dense label in the order of
+ * their first vertex, so the result only depends on the graph. For digraphs the neighbour
+ * lists hold the out-neighbours, which gives the weakly connected components.
+ * The labels describe the graph as it was built; they go stale when the graph changes.
+ */
+template <class Graph, class Vertex>
+class ConnectedComponents
+{
+public:
+    typedef unsigned int Index;
+    typedef unsigned int Label;
+    typedef typename Vertex::VertexId VertexId;
+
+    explicit ConnectedComponents(Graph& g)
+    {
+        std::vector<Vertex*> vertices;
+        auto it = g.verticesConstIterator();
+        while (!it.end())
+        {
+            Vertex* v = *it;
+            indexById.insert({v->getVertexId(), (Index)vertices.size()});
+            vertices.push_back(v);
+            ++it;
+        }
+
+        DisjointSets sets(vertices.size());
+        for (Index v = 0; v < vertices.size(); ++v)
+        {
+            auto neighbours = vertices[v]->neighborsConstIterator();
+            while (!neighbours.end())
+            {
+                sets.join(v, index((*neighbours)->getVertexId()));
+                ++neighbours;
+            }
+        }
+
+        const Label NoLabel = Label(-1);
+        std::vector<Label> labelOfRoot(vertices.size(), NoLabel);
+        labels.resize(vertices.size());
+        for (Index v = 0; v < vertices.size(); ++v)
+        {
+            const Index root = sets.find(v);
+            if (labelOfRoot[root] == NoLabel)
+            {
+                labelOfRoot[root] = sizes.size();
+                sizes.push_back(0);
+            }
+            labels[v] = labelOfRoot[root];
+            sizes[labels[v]]++;
+        }
+
+        giant = 0;
+        for (Label c = 1; c < sizes.size(); ++c)
+            if (sizes[c] > sizes[giant])
+                giant = c;
+    }
+
+    /**
+     * Method: componentsCount
+     * -----------------------
+     * @returns the number of connected components, isolated vertices included
+     */
+    unsigned int componentsCount() const
+    {
+        return sizes.size();
+    }
+
+    /**
+     * Method: componentLabels
+     * -----------------------
+     * @returns the label of every vertex, indexed by position in the vertex container
+     */
+    const std::vector<Label>& componentLabels() const
+    {
+        return labels;
+    }
+
+    /**
+     * Method: componentSizes
+     * ----------------------
+     * @returns the number of vertices of every component, indexed by label
+     */
+    const std::vector<unsigned int>& componentSizes() const
+    {
+        return sizes;
+    }
+
+    /**
+     * Method: component
+     * -----------------
+     * @returns the label of the component of a vertex of the graph
+     */
+    Label component(const Vertex* v) const
+    {
+        return labels[index(v->getVertexId())];
+    }
+
+    /**
+     * Method: giantComponent
+     * ----------------------
+     * @returns the label of the biggest component; on ties the one with the lowest label.
+     * Meaningless for an empty graph.
+     */
+    Label giantComponent() const
+    {
+        return giant;
+    }
+
+    /**
+     * Method: giantComponentSize
+     * --------------------------
+     * @returns the number of vertices of the biggest component, 0 for an empty graph
+     */
+    unsigned int giantComponentSize() const
+    {
+        return sizes.empty() ? 0 : sizes[giant];
+    }
+
+    /**
+     * Method: keepGiantComponent
+     * --------------------------
+     * Description: turns the graph into the subgraph induced by the biggest component,
+     * removing and deleting every other vertex in a single pass. g must be the graph these
+     * components were computed for, unchanged since.
+     */
+    void keepGiantComponent(Graph& g) const
+    {
+        g.removeVerticesIf([this](const Vertex* v) { return component(v) != giant; });
+    }
+
+private:
+    Index index(VertexId id) const
+    {
+        return indexById.find(id)->second;
+    }
+
+    std::unordered_map<VertexId, Index> indexById;
+    std::vector<Label> labels;
+    std::vector<unsigned int> sizes;
+    Label giant;
+};
+}  // namespace graphpp
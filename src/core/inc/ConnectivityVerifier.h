@@ -4,17 +4,18 @@
 
 #pragma once
 
-#include <math.h>
-#include <algorithm>
-#include <vector>
-#include "TraverserBFS.h"
+#include <list>
+#include "ConnectedComponents.h"
 #include "mili/mili.h"
 
 namespace graphpp
 {
-template <class Graph, class Vertex>
-class ConnectivityVisitor;
-
+/**
+ * Class: ConnectivityVerifier
+ * ---------------------------
+ * Description: keeps the biggest connected component of a graph. The components come from
+ * ConnectedComponents; vertexesInComponent holds the ids that were kept, in container order.
+ */
 template <class Graph, class Vertex>
 class ConnectivityVerifier
 {
@@ -32,58 +33,18 @@ public:
 
     void getBiggestComponent(Graph* graph)
     {
+        vertexesLeft.clear();
+        vertexesInComponent.clear();
+
+        ConnectedComponents<Graph, Vertex> components(*graph);
+        components.keepGiantComponent(*graph);
+
         auto it = graph->verticesConstIterator();
         while (!it.end())
         {
-            vertexesLeft.push_back((*it)->getVertexId());
+            vertexesInComponent.push_back((*it)->getVertexId());
             ++it;
         }
-
-        ConnectivityVisitor<Graph, Vertex> visitor(this);
-        do
-        {
-            vertexesInComponent.clear();
-            Vertex* source = graph->getVertexById(vertexesLeft.back());
-            vertexesLeft.pop_back();
-            TraverserBFS<Graph, Vertex, ConnectivityVisitor<Graph, Vertex>>::traverse(
-                source, visitor);
-        } while (!vertexesLeft.empty() && vertexesInComponent.size() < graph->verticesCount() / 2);
-
-        auto it2 = graph->verticesConstIterator();
-        while (!it2.end())
-        {
-            auto id = (*it2)->getVertexId();
-            auto found = std::find(begin(vertexesInComponent), end(vertexesInComponent), id) !=
-                         end(vertexesInComponent);
-
-            if (!found)
-                graph->removeVertex(*it2);
-
-            ++it2;
-        }
-    }
-};
-
-template <class Graph, class Vertex>
-class ConnectivityVisitor
-{
-public:
-    ConnectivityVisitor(ConnectivityVerifier<Graph, Vertex>* observer) : observer(observer) {}
-
-    /**
-     * Method: visitVertex
-     * -------------------
-     * Description: Action invoked by Traverser when a node is reached. The goal of
-     * the visitVertex method is to notify the ConnectivityVerifier class about the vertex/
-     * @returns true if iterator should keep traversing
-     */
-    bool visitVertex(Vertex* vertex)
-    {
-        observer->visited(vertex->getVertexId());
-        return true;
     }
-
-private:
-    ConnectivityVerifier<Graph, Vertex>* observer;
 };
 }  // namespace graphpp
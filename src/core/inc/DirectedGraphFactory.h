@@ -5,7 +5,9 @@
 #include "DirectedNearestNeighborsDegree.h"
 #include "GraphReader.h"
 #include "IGraphFactory.h"
+#include "ParallelGraphReader.h"
 #include "ShellIndex.h"
+#include "SnapshotGraphReader.h"
 
 namespace graphpp
 {
@@ -17,12 +19,27 @@ public:
     {
         return new GraphReader<Graph, Vertex>();
     }
+    virtual IGraphReader<Graph, Vertex>* createGraphReader(unsigned int threads)
+    {
+        if (threads != 1)
+            return new ParallelGraphReader<Graph, Vertex>(threads);
+        return new GraphReader<Graph, Vertex>();
+    }
+    virtual IGraphReader<Graph, Vertex>* createSnapshotReader()
+    {
+        return new SnapshotGraphReader<Graph, Vertex>();
+    }
     virtual IBetweenness<Graph, Vertex>* createBetweenness(Graph&)
     {
         // TODO Implement this
         // return new DirectedBetweenness<Graph,Vertex>();
         return nullptr;
     }
+    virtual IBetweenness<Graph, Vertex>* createApproximateBetweenness(
+        Graph&, const BetweennessSample<typename Vertex::VertexId>&)
+    {
+        return nullptr;
+    }
     virtual IClusteringCoefficient<Graph, Vertex>* createClusteringCoefficient()
     {
         return new DirectedClusteringCoefficient<Graph, Vertex>();
@@ -35,6 +52,12 @@ public:
     {
         return new ShellIndex<Graph,Vertex>(g, type);
     }
+    virtual IShellIndex<Graph, Vertex>* createShellIndex(
+        Graph& g, ShellIndexType type, unsigned int)
+    {
+        // the directed variants only have the sequential decomposition
+        return new ShellIndex<Graph, Vertex>(g, type);
+    }
     virtual IDegreeDistribution<Graph, Vertex>* createDegreeDistribution(Graph& g)
     {
         return new DirectedDegreeDistribution<Graph, Vertex>(g);
@@ -101,6 +101,7 @@ private:
 
             ++it;
         }
+        return false;
     }
 
 };
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+namespace graphpp
+{
+/**
+ * Class: DisjointSets
+ * -------------------
+ * Description: union-find over the items 0..count-1, with union by size and path halving,
+ * so a sequence of m joins and finds costs O(m α(n)). The root of a set knows its size.
+ */
+class DisjointSets
+{
+public:
+    typedef unsigned int Item;
+
+    explicit DisjointSets(Item count) : parent(count), sizes(count, 1)
+    {
+        for (Item i = 0; i < count; ++i)
+            parent[i] = i;
+    }
+
+    Item count() const
+    {
+        return parent.size();
+    }
+
+    /**
+     * Method: find
+     * ------------
+     * Description: root of the set of an item, halving the path on the way
+     */
+    Item find(Item item)
+    {
+        while (parent[item] != item)
+        {
+            parent[item] = parent[parent[item]];
+            item = parent[item];
+        }
+        return item;
+    }
+
+    /**
+     * Method: join
+     * ------------
+     * Description: merges the sets of two items, the smaller under the bigger
+     * @returns false if they were already in the same set
+     */
+    bool join(Item a, Item b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a == b)
+            return false;
+        if (sizes[a] < sizes[b])
+            std::swap(a, b);
+        parent[b] = a;
+        sizes[a] += sizes[b];
+        return true;
+    }
+
+    /**
+     * Method: size
+     * ------------
+     * @returns the number of items in the set of an item
+     */
+    Item size(Item item)
+    {
+        return sizes[find(item)];
+    }
+
+private:
+    std::vector<Item> parent;
+    std::vector<Item> sizes;
+};
+}  // namespace graphpp
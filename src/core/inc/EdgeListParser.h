@@ -0,0 +1,298 @@
+// This toolbox is licensed under the Academic Free License 3.0.
+// Instituto Tecnológico de Buenos Aires (ITBA).
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+#include "IGraphReader.h"
+
+namespace graphpp
+{
+/**
+ * Class: EdgeListParser
+ * ---------------------
+ * Description: parses an edge list held in memory (usually a MappedFile) one line at a time,
+ * without copying lines or building strings. Each non empty line is "source [destination]"
+ * or, for weighted lists, "source [destination weight]", separated by spaces or tabs; a
+ * trailing '\r' is ignored. Errors are the GraphLoadException of the line readers, with the
+ * same "Line: N" text.
+ * Works on any [begin, end) range, so a big file can be split and parsed by pieces.
+ */
+class EdgeListParser
+{
+public:
+    typedef unsigned int VertexId;
+    typedef unsigned int LineNumber;
+    typedef double Weight;
+
+    /**
+     * Struct: Line
+     * ------------
+     * Description: a parsed line. A line with a single vertex has isEdge == false.
+     */
+    struct Line
+    {
+        LineNumber number;
+        VertexId source;
+        VertexId destination;
+        Weight weight;
+        bool isEdge;
+    };
+
+    /**
+     * Constructor
+     * -----------
+     * @param begin first character to parse
+     * @param end one past the last character
+     * @param weighted whether edges carry a weight column
+     * @param firstLine line number of the line starting at begin, for error messages
+     */
+    EdgeListParser(const char* begin, const char* end, bool weighted, LineNumber firstLine = 1)
+        : current(begin), last(end), weighted(weighted), lineNumber(firstLine)
+    {
+    }
+
+    /**
+     * Method: next
+     * ------------
+     * Description: parses up to the next non empty line
+     * @param line where the parsed line is stored
+     * @returns false when there are no more lines
+     */
+    bool next(Line& line)
+    {
+        while (current != last)
+        {
+            const char* eol = static_cast<const char*>(std::memchr(current, '\n', last - current));
+            if (eol == nullptr)
+                eol = last;
+            const char* lineEnd = eol;
+            if (lineEnd != current && lineEnd[-1] == '\r')
+                --lineEnd;
+
+            const bool parsed = parseLine(current, lineEnd, line);
+            current = eol == last ? last : eol + 1;
+            ++lineNumber;
+            if (parsed)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * Method: getLineNumber
+     * ---------------------
+     * @returns the number of the line that will be parsed next
+     */
+    LineNumber getLineNumber() const
+    {
+        return lineNumber;
+    }
+
+    /**
+     * Method: edgeKey
+     * ---------------
+     * @returns a key identifying the edge of the line; for undirected graphs it does not
+     * depend on the order of the two ends
+     */
+    static std::uint64_t edgeKey(const Line& line, bool digraph)
+    {
+        std::uint64_t a = line.source, b = line.destination;
+        if (!digraph && b < a)
+            std::swap(a, b);
+        return a << 32 | b;
+    }
+
+private:
+    // false for empty lines
+    bool parseLine(const char* p, const char* end, Line& line) const
+    {
+        consumeWhitespace(p, end);
+        if (p == end)
+            return false;
+
+        line.number = lineNumber;
+        line.source = readUnsignedInt(p, end);
+        line.isEdge = false;
+        line.weight = 0.0;
+        consumeWhitespace(p, end);
+        if (p != end)
+        {
+            line.destination = readUnsignedInt(p, end);
+            line.isEdge = true;
+            consumeWhitespace(p, end);
+            if (weighted)
+            {
+                line.weight = readWeight(p, end);
+                consumeWhitespace(p, end);
+            }
+            if (p != end)
+                throw MalformedLineException(lineNumberText());
+        }
+        return true;
+    }
+
+    static void consumeWhitespace(const char*& p, const char* end)
+    {
+        while (p != end && (*p == ' ' || *p == '\t'))
+            ++p;
+    }
+
+    unsigned int readUnsignedInt(const char*& p, const char* end) const
+    {
+        if (p == end || *p < '0' || *p > '9')
+            throw UnsignedIntegerMalformedException(lineNumberText());
+
+        unsigned long long value = 0;
+        while (p != end && *p >= '0' && *p <= '9')
+        {
+            value = value * 10 + (*p - '0');
+            if (value > 0xFFFFFFFFull)
+                throw UnsignedIntegerMalformedException(lineNumberText());
+            ++p;
+        }
+        return (unsigned int)value;
+    }
+
+    /**
+     * Method: readWeight
+     * ------------------
+     * Description: digits and dots, optionally followed by e/E, a sign and an unsigned
+     * exponent, like WeightedGraphReader always accepted. A missing weight reads as 0.
+     */
+    Weight readWeight(const char*& p, const char* end) const
+    {
+        const char* first = p;
+        while (p != end && ((*p >= '0' && *p <= '9') || *p == '.'))
+            ++p;
+        Weight ret = parseMantissa(first, p);
+
+        if (p != end && (*p == 'e' || *p == 'E'))
+        {
+            ++p;
+            bool positive = true;
+            if (p != end && (*p == '+' || *p == '-'))
+            {
+                positive = *p == '+';
+                ++p;
+            }
+            else if (p == end || *p < '0' || *p > '9')
+                throw MalformedDoubleException(lineNumberText());
+
+            const double scale = std::pow(10.0, readUnsignedInt(p, end));
+            ret = positive ? ret * scale : ret / scale;
+        }
+        return ret;
+    }
+
+    // strtod on a small stack copy, since the input is not null terminated
+    static Weight parseMantissa(const char* first, const char* last)
+    {
+        const std::size_t length = last - first;
+        if (length == 0)
+            return 0.0;
+
+        char buffer[64];
+        if (length < sizeof(buffer))
+        {
+            std::memcpy(buffer, first, length);
+            buffer[length] = '\0';
+            return std::strtod(buffer, nullptr);
+        }
+        return std::strtod(std::string(first, last).c_str(), nullptr);
+    }
+
+    std::string lineNumberText() const
+    {
+        std::stringstream s;
+        s << "Line: " << lineNumber;
+        return s.str();
+    }
+
+    const char* current;
+    const char* last;
+    bool weighted;
+    LineNumber lineNumber;
+};
+
+/**
+ * Class: ReadThroughput
+ * ---------------------
+ * Description: what the edge list readers report about their last read: the edge lines
+ * parsed, repeated ones included, and the wall clock time of read, from opening the file to
+ * the last edge added to the graph.
+ */
+class ReadThroughput
+{
+public:
+    ReadThroughput() : edgesCount(0), seconds(0)
+    {
+    }
+
+    std::size_t getEdgesCount() const
+    {
+        return edgesCount;
+    }
+
+    double getSeconds() const
+    {
+        return seconds;
+    }
+
+    /**
+     * Method: getEdgesPerSecond
+     * -------------------------
+     * @returns the edge lines over the time of the read, 0 before any read
+     */
+    double getEdgesPerSecond() const
+    {
+        return seconds > 0 ? edgesCount / seconds : 0.0;
+    }
+
+protected:
+    std::size_t edgesCount;
+    double seconds;
+};
+
+/**
+ * Class: RepeatedEdgeFilter
+ * -------------------------
+ * Description: the edges already read from a file, so the sequential readers find a
+ * repeated line with one hash lookup instead of scanning the neighbours of its source.
+ */
+class RepeatedEdgeFilter
+{
+public:
+    explicit RepeatedEdgeFilter(bool digraph) : digraph(digraph)
+    {
+    }
+
+    // makes room for count more edges
+    void reserve(std::size_t count)
+    {
+        keys.reserve(keys.size() + count);
+    }
+
+    /**
+     * Method: firstTime
+     * -----------------
+     * @returns true if no earlier line had the edge of this one
+     */
+    bool firstTime(const EdgeListParser::Line& line)
+    {
+        return keys.insert(EdgeListParser::edgeKey(line, digraph)).second;
+    }
+
+private:
+    const bool digraph;
+    std::unordered_set<std::uint64_t> keys;
+};
+}  // namespace graphpp
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "ClusteringCoefficient.h"
+#include "DegreeDistribution.h"
+#include "NearestNeighborsDegree.h"
+#include "Parallel.h"
+#include "Random.h"
+
+namespace graphpp
+{
+/**
+ * Class: RunningStatistics
+ * ------------------------
+ * Description: count, mean and variance of a stream of values, updated one value at a time
+ * with Welford's recurrence, so nothing but three numbers is kept and the variance does not
+ * suffer from the cancellation of the sum of squares. Two accumulators merge exactly (Chan et
+ * al.), which lets every thread keep its own and combine them at the end.
+ */
+class RunningStatistics
+{
+public:
+    RunningStatistics(std::uint64_t count = 0, double mean = 0.0, double squares = 0.0)
+        : n(count), m(mean), m2(squares)
+    {
+    }
+
+    void add(double value)
+    {
+        ++n;
+        const double delta = value - m;
+        m += delta / n;
+        m2 += delta * (value - m);
+    }
+
+    void merge(const RunningStatistics& other)
+    {
+        if (other.n == 0)
+            return;
+        const double total = double(n) + double(other.n);
+        const double delta = other.m - m;
+        m += delta * other.n / total;
+        m2 += other.m2 + delta * delta * (double(n) * other.n / total);
+        n += other.n;
+    }
+
+    /**
+     * Method: padWithZeros
+     * --------------------
+     * Description: adds as many zeros as needed for the count to reach total, at once
+     */
+    void padWithZeros(std::uint64_t total)
+    {
+        if (total > n)
+            merge(RunningStatistics(total - n));
+    }
+
+    std::uint64_t count() const
+    {
+        return n;
+    }
+
+    double mean() const
+    {
+        return m;
+    }
+
+    /**
+     * Method: variance
+     * ----------------
+     * @returns the sample variance, 0 with less than two values
+     */
+    double variance() const
+    {
+        return n < 2 ? 0.0 : m2 / (n - 1);
+    }
+
+    double standardDeviation() const
+    {
+        return std::sqrt(variance());
+    }
+
+private:
+    std::uint64_t n;
+    double m;
+    double m2;
+};
+
+// statistics of a per-degree metric, keyed by degree
+typedef std::map<unsigned int, RunningStatistics> DegreeSeries;
+// vertices of every degree, summed over the realizations
+typedef std::map<unsigned int, std::uint64_t> DegreeCounts;
+
+inline void mergeSeries(DegreeSeries& into, const DegreeSeries& from)
+{
+    for (const auto& entry : from)
+        into[entry.first].merge(entry.second);
+}
+
+/**
+ * Class: Ensemble
+ * ---------------
+ * Description: per-degree metrics averaged over many realizations of a random graph model.
+ * The realizations are generated concurrently, one per worker thread; each one is measured
+ * and deleted before the worker takes the next, so memory is bounded by the threads, not by
+ * the number of realizations. Every metric keeps one RunningStatistics per degree and per
+ * thread, and the threads' statistics are merged when they are done.
+ * Realization i is generated from the i-th draw of Random(seed), whatever thread makes it,
+ * so the graphs only depend on the seed. The merged sums may still differ in the last bits
+ * between runs, since the threads take the realizations in a different order each time.
+ *
+ * For each realization and each degree k present in it the metrics are, as DegreeDistribution,
+ * ClusteringCoefficient and NearestNeighborsDegree compute them for a single graph:
+ * - the degree distribution, P(k) = vertices of degree k / vertices; a realization without
+ *   degree k counts as P(k) = 0. The vertices of each degree are also summed over all the
+ *   realizations, for log binning.
+ * - the clustering coefficient, mean over the vertices of degree k
+ * - the nearest neighbors degree, mean over the vertices of degree k of the mean degree of
+ *   their neighbours
+ * The last two only average the realizations that have degree k, as for a single graph
+ * a degree that does not occur has no value.
+ */
+template <class Graph, class Vertex>
+class Ensemble
+{
+public:
+    enum Metric
+    {
+        DegreeDistribution = 1,
+        ClusteringVsDegree = 2,
+        NearestNeighborsDegreeVsDegree = 4,
+        AllMetrics = 7
+    };
+
+    // generates a realization from its seed; the ensemble takes ownership of the graph
+    typedef std::function<Graph*(std::uint64_t)> Model;
+
+    /**
+     * Constructor
+     * -----------
+     * @param model the random graph model
+     * @param metrics the metrics to compute, an or of Metric values
+     */
+    Ensemble(Model model, unsigned int metrics = AllMetrics) : model(model), metrics(metrics)
+    {
+    }
+
+    /**
+     * Method: run
+     * -----------
+     * Description: generates and measures the realizations, replacing the results of a
+     * previous run
+     * @param realizations number of graphs to generate
+     * @param seed seed the realization seeds are drawn from
+     * @param threads number of worker threads; 0 uses the hardware concurrency
+     */
+    void run(unsigned int realizations, std::uint64_t seed, unsigned int threads = 0)
+    {
+        std::vector<std::uint64_t> seeds(realizations);
+        Random rng(seed);
+        for (auto& realizationSeed : seeds)
+            realizationSeed = rng();
+
+        const unsigned int workers = workerCount(threads, realizations);
+        std::vector<Results> partial(workers);
+        parallelFor(realizations, workers, [&](unsigned int worker, std::size_t i) {
+            std::unique_ptr<Graph> g(model(seeds[i]));
+            measure(*g, partial[worker]);
+        });
+
+        results = Results();
+        for (const Results& worker : partial)
+        {
+            mergeSeries(results.degreeDistribution, worker.degreeDistribution);
+            for (const auto& entry : worker.degreeCounts)
+                results.degreeCounts[entry.first] += entry.second;
+            mergeSeries(results.clustering, worker.clustering);
+            mergeSeries(results.nearestNeighborsDegree, worker.nearestNeighborsDegree);
+        }
+        for (auto& entry : results.degreeDistribution)
+            entry.second.padWithZeros(realizations);
+        count = realizations;
+    }
+
+    unsigned int realizationsCount() const
+    {
+        return count;
+    }
+
+    const DegreeSeries& degreeDistribution() const
+    {
+        return results.degreeDistribution;
+    }
+
+    const DegreeCounts& degreeCounts() const
+    {
+        return results.degreeCounts;
+    }
+
+    const DegreeSeries& clusteringVsDegree() const
+    {
+        return results.clustering;
+    }
+
+    const DegreeSeries& nearestNeighborsDegreeVsDegree() const
+    {
+        return results.nearestNeighborsDegree;
+    }
+
+private:
+    struct Results
+    {
+        DegreeSeries degreeDistribution;
+        DegreeCounts degreeCounts;
+        DegreeSeries clustering;
+        DegreeSeries nearestNeighborsDegree;
+    };
+
+    void measure(Graph& g, Results& into) const
+    {
+        // the realizations already run in parallel, so the triangles are counted in one thread
+        ClusteringCoefficient<Graph, Vertex> clustering(1);
+        NearestNeighborsDegree<Graph, Vertex> nearestNeighbors;
+        graphpp::DegreeDistribution<Graph, Vertex> distribution(g);
+        const double vertices = g.verticesCount();
+
+        auto it = distribution.iterator();
+        while (!it.end())
+        {
+            const unsigned int degree = it->first;
+            if (metrics & DegreeDistribution)
+            {
+                into.degreeDistribution[degree].add(it->second / vertices);
+                into.degreeCounts[degree] += it->second;
+            }
+            if (metrics & ClusteringVsDegree)
+                into.clustering[degree].add(clustering.clusteringCoefficient(g, degree));
+            if (metrics & NearestNeighborsDegreeVsDegree)
+                into.nearestNeighborsDegree[degree].add(nearestNeighbors.meanDegree(g, degree));
+            ++it;
+        }
+    }
+
+    Model model;
+    unsigned int metrics;
+    Results results;
+    unsigned int count = 0;
+};
+}  // namespace graphpp
@@ -6,7 +6,10 @@
 #include "GraphReader.h"
 #include "IGraphFactory.h"
 #include "NearestNeighborsDegree.h"
+#include "ParallelGraphReader.h"
+#include "ParallelShellIndex.h"
 #include "ShellIndex.h"
+#include "SnapshotGraphReader.h"
 
 namespace graphpp
 {
@@ -18,10 +21,25 @@ public:
     {
         return new GraphReader<Graph, Vertex>();
     }
+    virtual IGraphReader<Graph, Vertex>* createGraphReader(unsigned int threads)
+    {
+        if (threads != 1)
+            return new ParallelGraphReader<Graph, Vertex>(threads);
+        return new GraphReader<Graph, Vertex>();
+    }
+    virtual IGraphReader<Graph, Vertex>* createSnapshotReader()
+    {
+        return new SnapshotGraphReader<Graph, Vertex>();
+    }
     virtual IBetweenness<Graph, Vertex>* createBetweenness(Graph& g)
     {
         return new Betweenness<Graph, Vertex>(g);
     }
+    virtual IBetweenness<Graph, Vertex>* createApproximateBetweenness(
+        Graph& g, const BetweennessSample<typename Vertex::VertexId>& sample)
+    {
+        return new Betweenness<Graph, Vertex>(g, sample);
+    }
     virtual MaxClique<Graph, Vertex>* createMaxClique(Graph& g)
     {
         return new MaxClique<Graph, Vertex>(g);
@@ -42,6 +60,13 @@ public:
     {
         return new ShellIndex<Graph, Vertex>(g, type);
     }
+    virtual IShellIndex<Graph, Vertex>* createShellIndex(
+        Graph& g, ShellIndexType type, unsigned int threads)
+    {
+        if (type == ShellIndexTypeSimple && threads != 1)
+            return new ParallelShellIndex<Graph, Vertex>(g, threads);
+        return new ShellIndex<Graph, Vertex>(g, type);
+    }
 
     virtual IDegreeDistribution<Graph, Vertex>* createDegreeDistribution(Graph& g)
     {
@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <cstdint>
+#include "EdgeListParser.h"
 #include "MolloyReedGraphReader.h"
+#include "Random.h"
 #include "typedefs.h"
 
 class GraphGenerator
@@ -19,49 +22,63 @@ private:
     GraphGenerator();
 
     static GraphGenerator* instance;
-    float distanceBetweenVertex(unsigned int vertex1Id, unsigned int vertex2Id);
-    void addVertexPosition();
-    void addEdges(
-        Graph* graph,
-        Vertex* vertex,
-        std::map<float, unsigned int> distance,
-        unsigned int quant,
-        std::vector<unsigned int>* vertexIndexes);
     inline double hiperbolicDistance(PolarPosition p1, PolarPosition p2);
     inline double getMaxRadius(int i, float a, float c);
-    inline PolarPosition getRandomHyperbolicCoordinates(float a, double maxr);
+    inline PolarPosition getRandomHyperbolicCoordinates(graphpp::Random& rng, float a, double maxr);
+
+    // Steps of the HOT Extended model, see generateHotExtendedGraph
+    struct HotModel;
+    void addOriginalVertex(HotModel& model);
+    void addFKPNode(HotModel& model, unsigned int vertexIndex, float xi, unsigned int m);
+    void addExtendedEdges(HotModel& model, unsigned int q, unsigned int vertexIndex, float r);
+    unsigned int chooseNewRoot(HotModel& model, unsigned int vertexIndex, unsigned int t);
 
 public:
     static GraphGenerator* getInstance();
-    void addOriginalVertex(Graph* graph);
-    void addFKPNode(
-        unsigned int vertexIndex,
-        Graph* graph,
-        unsigned int root,
-        float xi,
-        std::vector<unsigned int>* vertexIndexes,
-        unsigned int m);
-    void addExtendedEdges(
-        unsigned int q,
-        unsigned int vertexIndex,
-        Graph* graph,
-        unsigned int root,
-        float r,
-        std::vector<unsigned int>* vertexIndexes);
-    int chooseNewRoot(
-        unsigned int vertexIndex,
-        unsigned int t,
-        unsigned int root,
-        std::vector<unsigned int> vertexIndexes);
 
-    Graph* generateGraphFromFile(std::string path, bool directed, bool multigraph);
-    DirectedGraph* generateDirectedGraphFromFile(std::string path, bool multigraph);
-    WeightedGraph* generateWeightedGraphFromFile(std::string path, bool directed, bool multigraph);
-    Graph* generateErdosRenyiGraph(unsigned int n, float p);
+    // threads: threads used to parse the file; 0 uses the hardware concurrency
+    // throughput: if not null, the edges read and the time taken; empty for snapshots
+    Graph* generateGraphFromFile(
+        std::string path,
+        bool directed,
+        bool multigraph,
+        unsigned int threads = 0,
+        graphpp::ReadThroughput* throughput = nullptr);
+    DirectedGraph* generateDirectedGraphFromFile(
+        std::string path,
+        bool multigraph,
+        unsigned int threads = 0,
+        graphpp::ReadThroughput* throughput = nullptr);
+    WeightedGraph* generateWeightedGraphFromFile(
+        std::string path,
+        bool directed,
+        bool multigraph,
+        unsigned int threads = 0,
+        graphpp::ReadThroughput* throughput = nullptr);
+    // Every model takes a seed for its graphpp::Random streams: the same parameters and seed
+    // give the same graph, whatever the number of threads. The overloads without a seed take
+    // it from rand() (Random::seedFromRand).
+
+    // biggestComponent: keep only the biggest component, as the GUI and the command line do
+    // threads: threads used to draw the edges; 0 uses the hardware concurrency
+    Graph* generateErdosRenyiGraph(
+        unsigned int n, float p, bool biggestComponent = true, unsigned int threads = 0);
+    Graph* generateErdosRenyiGraph(
+        unsigned int n, float p, bool biggestComponent, unsigned int threads, std::uint64_t seed);
     Graph* generateBarabasiAlbertGraph(unsigned int m_0, unsigned int m, unsigned int n);
+    Graph* generateBarabasiAlbertGraph(
+        unsigned int m_0, unsigned int m, unsigned int n, std::uint64_t seed);
     Graph* generateHotExtendedGraph(
         unsigned int m, unsigned int n, float xi, unsigned int q, float r, unsigned int t);
-    Graph* generateMolloyReedGraph(std::string path);
-    Graph* generateHiperbolicGraph(unsigned int n, float a, float c);
+    Graph* generateHotExtendedGraph(
+        unsigned int m, unsigned int n, float xi, unsigned int q, float r, unsigned int t,
+        std::uint64_t seed);
+    // giantComponent: keep only the biggest connected component
+    Graph* generateMolloyReedGraph(std::string path, bool giantComponent = false);
+    Graph* generateMolloyReedGraph(std::string path, bool giantComponent, std::uint64_t seed);
+    // threads: threads used to find the edges; 0 uses the hardware concurrency
+    Graph* generateHiperbolicGraph(unsigned int n, float a, float c, unsigned int threads = 0);
+    Graph* generateHiperbolicGraph(
+        unsigned int n, float a, float c, unsigned int threads, std::uint64_t seed);
     double getExpectedAvgNodeDeg(unsigned int n, float a, float c);
 };
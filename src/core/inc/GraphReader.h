@@ -1,50 +1,91 @@
 #pragma once
 
-#include <fstream>
-#include <iostream>
+#include <chrono>
 #include <string>
+#include <vector>
+#include "EdgeListParser.h"
 #include "GraphExceptions.h"
 #include "IGraphReader.h"
+#include "MappedFile.h"
 
 namespace graphpp
 {
+/**
+ * Class: GraphReader
+ * ------------------
+ * Description: Reads an edge list, "source [destination]" per line, into a graph. The file
+ * is memory mapped and parsed in place by an EdgeListParser; lines are collected in blocks
+ * and each block is then added to the graph, creating the vertices in order of appearance.
+ * Repeated edges are ignored: unless the graph is a multigraph, they are found with a
+ * RepeatedEdgeFilter and the others are added without addEdge's search of the neighbours.
+ * Used for undirected and directed graphs.
+ */
 template <class Graph, class Vertex>
-class GraphReader : public IGraphReader<Graph, Vertex>
+class GraphReader : public IGraphReader<Graph, Vertex>, public ReadThroughput
 {
 public:
     // this typedefs are also present in the superclass. Any way to remove it?
     typedef std::string FileName;
     typedef unsigned int LineNumber;
+
     virtual void read(Graph& g, std::string source)
     {
-        std::ifstream sourceFile;
-
-        sourceFile.open(source.c_str(), std::ios_base::in);
+        const auto start = std::chrono::steady_clock::now();
+        const MappedFile file(source);
+        EdgeListParser parser(file.begin(), file.end(), false);
+        // the graph already has edges, which the read ones must be checked against
+        const bool checked = g.verticesCount() != 0;
+        RepeatedEdgeFilter repeated(g.isDigraph());
+
+        std::vector<EdgeListParser::Line> block;
+        block.reserve(BlockSize);
+        EdgeListParser::Line line;
+        bool more = true;
+        edgesCount = 0;
+        while (more)
+        {
+            block.clear();
+            while (block.size() < BlockSize && (more = parser.next(line)))
+            {
+                block.push_back(line);
+                edgesCount += line.isEdge;
+            }
+            addLines(g, block, checked, repeated);
+        }
 
-        if (!sourceFile)
-            throw FileNotFoundException(source);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        seconds = elapsed.count();
 
-        std::string line;
+        currentLineNumber = parser.getLineNumber();
+    }
 
-        currentLineNumber = 1;
-        while (getline(sourceFile, line))
-        {
-            std::string tree_str = line;
+    LineNumber getLineNumber() const
+    {
+        return currentLineNumber;
+    }
 
-            character = tree_str.c_str();
+private:
+    static const std::size_t BlockSize = 1 << 16;
 
-            if (!isEmptyLine())
+    void addLines(
+        Graph& g,
+        const std::vector<EdgeListParser::Line>& lines,
+        bool checked,
+        RepeatedEdgeFilter& repeated)
+    {
+        const bool multigraph = g.isMultigraph();
+        if (!multigraph)
+            repeated.reserve(lines.size());
+        for (const auto& line : lines)
+        {
+            Vertex* sourceNode = loadVertex(g, line.source);
+            if (line.isEdge)
             {
-                consume_whitespace();
-                Vertex* sourceNode = loadVertex(g);
-                consume_whitespace();
-
-                if (*character != '\0')
+                Vertex* destinationNode = loadVertex(g, line.destination);
+                if (multigraph || (!checked && repeated.firstTime(line)))
+                    g.addEdgeUnchecked(sourceNode, destinationNode);
+                else if (checked)
                 {
-                    Vertex* destinationNode = loadVertex(g);
-                    consume_whitespace();
-                    if (*character != '\0')
-                        throw MalformedLineException(getLineNumberText());
                     try
                     {
                         g.addEdge(sourceNode, destinationNode);
@@ -55,78 +96,24 @@ public:
                     }
                 }
             }
-
-            ++currentLineNumber;
         }
-
-        sourceFile.close();
     }
 
-    LineNumber getLineNumber() const
+    Vertex* loadVertex(Graph& g, unsigned int id)
     {
-        return currentLineNumber;
-    }
-
-private:
-    std::string getLineNumberText() const
-    {
-        std::stringstream s;
-        s << "Line: " << currentLineNumber;
-        return s.str();
-    }
-
-    Vertex* loadVertex(Graph& g)
-    {
-        Vertex* vertex = new Vertex(readUnsignedInt());
-        Vertex* vertexAux = vertex;
-        if ((vertex = g.getVertexById(vertex->getVertexId())) != nullptr)
-            delete vertexAux;
-        else
+        Vertex* vertex = g.getVertexById(id);
+        if (vertex == nullptr)
         {
-            vertex = vertexAux;
+            vertex = new Vertex(id);
             g.addVertex(vertex);
         }
 
         return vertex;
     }
 
-    unsigned int readUnsignedInt()
-    {
-        unsigned int ret = 0;
-        if (!in_range(*character, '0', '9'))
-            throw UnsignedIntegerMalformedException(getLineNumberText());
-        else
-        {
-            std::string branchLenStr;
-            while (in_range(*character, '0', '9'))
-            {
-                branchLenStr += *character;
-                ++character;
-            }
-
-            if (!from_string<unsigned int>(branchLenStr, ret))
-                throw UnsignedIntegerMalformedException(getLineNumberText());
-        }
-        return ret;
-    }
-
-    // TODO this method should be const
-    bool isEmptyLine()
-    {
-        bool ret = false;
-        consume_whitespace();
-        if (*character == '\0')
-            ret = true;
-        return ret;
-    }
-
-    void consume_whitespace()
-    {
-        while (*character == ' ' || *character == '\t')
-            ++character;
-    }
-
     LineNumber currentLineNumber;
-    const char* character;
 };
+
+template <class Graph, class Vertex>
+const std::size_t GraphReader<Graph, Vertex>::BlockSize;
 }  // namespace graphpp
@@ -0,0 +1,261 @@
+// This toolbox is licensed under the Academic Free License 3.0.
+// Instituto Tecnológico de Buenos Aires (ITBA).
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "IGraphReader.h"
+#include "MappedFile.h"
+
+DEFINE_SPECIFIC_EXCEPTION_TEXT(
+    MalformedSnapshotException,
+    GraphLoadExceptionHierarchy,
+    "File is not a valid graph snapshot.");
+
+namespace graphpp
+{
+/**
+ * Class: GraphSnapshot
+ * --------------------
+ * Description: binary image of a graph, written by GraphWriter and loaded by the snapshot
+ * readers with a single mmap and no parsing. All fields are little endian:
+ *
+ *   header    magic "CNGRAPH\0", u32 version, u32 flags, u64 vertices (n), u64 entries (m)
+ *   offsets   (n + 1) x u64: entries [offsets[v], offsets[v + 1]) are the neighbours of v
+ *   ids       n x u32: vertex ids, in the order of the graph's vertex container
+ *   neighbors m x u32: positions in ids (not ids), in the order of each neighbour list
+ *   padding   to a multiple of 8 bytes
+ *   weights   m x f64, only with FlagWeighted: the weight of each entry
+ *
+ * Undirected graphs store every edge in the lists of both ends, as the graph does. With
+ * FlagDirected the lists hold the out neighbours only; in neighbours are rebuilt on load.
+ * FlagMultigraph marks lists that may repeat a neighbour.
+ * Readers reject other versions.
+ */
+class GraphSnapshot
+{
+public:
+    typedef std::uint32_t Id;
+    typedef std::uint64_t Offset;
+    typedef double Weight;
+
+    static const std::uint32_t Version = 1;
+    static const std::uint32_t FlagDirected = 1;
+    static const std::uint32_t FlagWeighted = 2;
+    static const std::uint32_t FlagMultigraph = 4;
+    static const std::size_t HeaderSize = 32;
+
+    /**
+     * Constructor
+     * -----------
+     * @param path snapshot to map
+     * @throws FileNotFoundException if the file cannot be opened
+     * @throws MalformedSnapshotException if the header or the section sizes are wrong
+     */
+    explicit GraphSnapshot(const std::string& path) : file(path)
+    {
+        if (file.size() < HeaderSize || !hasMagic(file.begin()))
+            throw MalformedSnapshotException(path);
+        if (read<std::uint32_t>(file.begin() + 8) != Version)
+            throw MalformedSnapshotException(path + ": unsupported version");
+
+        flags = read<std::uint32_t>(file.begin() + 12);
+        n = read<std::uint64_t>(file.begin() + 16);
+        m = read<std::uint64_t>(file.begin() + 24);
+
+        // sizes are checked before multiplying, so a corrupt header cannot overflow them
+        const std::uint64_t limit = file.size();
+        if (n >= limit || m >= limit || fileSize(n, m, flags) != limit)
+            throw MalformedSnapshotException(path);
+
+        offsets = file.begin() + HeaderSize;
+        ids = offsets + (n + 1) * sizeof(Offset);
+        neighbors = ids + n * sizeof(Id);
+        weights = file.begin() + weightsOffset(n, m);
+
+        if (offset(0) != 0 || offset(n) != m)
+            throw MalformedSnapshotException(path);
+    }
+
+    /**
+     * Method: isSnapshot
+     * ------------------
+     * Description: whether the file starts with the snapshot magic, so callers can choose
+     * between the text and the snapshot readers
+     */
+    static bool isSnapshot(const std::string& path)
+    {
+        std::ifstream stream(path.c_str(), std::ios_base::in | std::ios_base::binary);
+        char bytes[MagicSize];
+        return stream.read(bytes, MagicSize) && hasMagic(bytes);
+    }
+
+    /**
+     * Method: hasExtension
+     * --------------------
+     * Description: whether the path ends with ".cngraph", the extension that makes the
+     * network exports write a snapshot instead of an edge list
+     */
+    static bool hasExtension(const std::string& path)
+    {
+        const std::string extension = ".cngraph";
+        return path.size() >= extension.size() &&
+               path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+    }
+
+    std::uint32_t getFlags() const
+    {
+        return flags;
+    }
+
+    bool isDirected() const
+    {
+        return (flags & FlagDirected) != 0;
+    }
+
+    bool isWeighted() const
+    {
+        return (flags & FlagWeighted) != 0;
+    }
+
+    bool isMultigraph() const
+    {
+        return (flags & FlagMultigraph) != 0;
+    }
+
+    std::uint64_t verticesCount() const
+    {
+        return n;
+    }
+
+    std::uint64_t entriesCount() const
+    {
+        return m;
+    }
+
+    Id id(std::uint64_t v) const
+    {
+        return read<Id>(ids + v * sizeof(Id));
+    }
+
+    Offset offset(std::uint64_t v) const
+    {
+        return read<Offset>(offsets + v * sizeof(Offset));
+    }
+
+    Id neighbor(std::uint64_t e) const
+    {
+        return read<Id>(neighbors + e * sizeof(Id));
+    }
+
+    Weight weight(std::uint64_t e) const
+    {
+        return read<Weight>(weights + e * sizeof(Weight));
+    }
+
+    /**
+     * Method: header
+     * --------------
+     * Description: the header of a snapshot with the given contents, for writers
+     */
+    static std::vector<char> header(std::uint32_t flags, std::uint64_t n, std::uint64_t m)
+    {
+        std::vector<char> ret;
+        ret.insert(ret.end(), magic(), magic() + MagicSize);
+        append(ret, Version);
+        append(ret, flags);
+        append(ret, n);
+        append(ret, m);
+        return ret;
+    }
+
+    /**
+     * Method: append
+     * --------------
+     * Description: appends a value in little endian order to a write buffer
+     */
+    template <class T>
+    static void append(std::vector<char>& buffer, T value)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        if (!littleEndian())
+            reverse(bytes, sizeof(T));
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    // bytes of padding after the ids and neighbours sections
+    static std::size_t padding(std::uint64_t n, std::uint64_t m)
+    {
+        return (n + m) % 2 * sizeof(Id);
+    }
+
+private:
+    static const std::size_t MagicSize = 8;
+
+    // the terminating null is part of the magic
+    static const char* magic()
+    {
+        return "CNGRAPH";
+    }
+
+    static bool hasMagic(const char* bytes)
+    {
+        return std::memcmp(bytes, magic(), MagicSize) == 0;
+    }
+
+    static std::uint64_t weightsOffset(std::uint64_t n, std::uint64_t m)
+    {
+        return HeaderSize + (n + 1) * sizeof(Offset) + (n + m) * sizeof(Id) + padding(n, m);
+    }
+
+    static std::uint64_t fileSize(std::uint64_t n, std::uint64_t m, std::uint32_t flags)
+    {
+        return weightsOffset(n, m) + ((flags & FlagWeighted) != 0 ? m * sizeof(Weight) : 0);
+    }
+
+    static bool littleEndian()
+    {
+#if defined(__BYTE_ORDER__)
+        return __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+#else
+        const std::uint16_t one = 1;
+        return *reinterpret_cast<const unsigned char*>(&one) == 1;
+#endif
+    }
+
+    static void reverse(char* bytes, std::size_t size)
+    {
+        for (std::size_t i = 0; i < size / 2; ++i)
+            std::swap(bytes[i], bytes[size - 1 - i]);
+    }
+
+    // unaligned little endian load; a plain load on little endian hosts
+    template <class T>
+    static T read(const char* p)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, p, sizeof(T));
+        if (!littleEndian())
+            reverse(bytes, sizeof(T));
+        T ret;
+        std::memcpy(&ret, bytes, sizeof(T));
+        return ret;
+    }
+
+    const MappedFile file;
+    std::uint32_t flags;
+    std::uint64_t n;
+    std::uint64_t m;
+    const char* offsets;
+    const char* ids;
+    const char* neighbors;
+    const char* weights;
+};
+}  // namespace graphpp
@@ -9,11 +9,14 @@
 class GraphWriter
 {
 public:
+    // Edge lists, one line per edge. Paths ending in .gz are gzip compressed, see
+    // BufferedOutput.
     void writeGraph(Graph *graph, std::string outputPath);
     void writeWeightedGraph(WeightedGraph *WeightedGraph, std::string outputPath);
     void writeDirectedGraph(DirectedGraph *graph, std::string outputPath);
 
-private:
-    std::list<unsigned int> visitedVertexes;
-    bool vertexWasVisited(unsigned int vertexId);
+    // Binary GraphSnapshot files, which load without parsing. See GraphSnapshot.h.
+    void writeGraphSnapshot(Graph *graph, std::string outputPath);
+    void writeWeightedGraphSnapshot(WeightedGraph *weightedGraph, std::string outputPath);
+    void writeDirectedGraphSnapshot(DirectedGraph *graph, std::string outputPath);
 };
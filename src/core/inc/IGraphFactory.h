@@ -1,5 +1,6 @@
 #pragma once
 
+#include "BetweennessSample.h"
 #include "IBetweenness.h"
 #include "IClusteringCoefficient.h"
 #include "IDegreeDistribution.h"
@@ -18,13 +19,36 @@ class IGraphFactory
 public:
     virtual IBetweenness<Graph, Vertex>* createBetweenness(Graph& g) = 0;
 
+    virtual IBetweenness<Graph, Vertex>* createApproximateBetweenness(
+        Graph& g, const BetweennessSample<typename Vertex::VertexId>& sample) = 0;
+
     virtual IClusteringCoefficient<Graph, Vertex>* createClusteringCoefficient() = 0;
 
     virtual INearestNeighborsDegree<Graph, Vertex>* createNearestNeighborsDegree() = 0;
 
     virtual IShellIndex<Graph, Vertex>* createShellIndex(Graph& g, ShellIndexType type) = 0;
 
+    /**
+     * Method: createShellIndex
+     * ------------------------
+     * Description: like createShellIndex(g, type), using up to the given number of threads
+     * where the factory has a parallel decomposition for the type
+     * @param threads number of worker threads; 0 uses the hardware concurrency
+     */
+    virtual IShellIndex<Graph, Vertex>* createShellIndex(
+        Graph& g, ShellIndexType type, unsigned int threads) = 0;
+
     virtual IGraphReader<Graph, Vertex>* createGraphReader() = 0;
+    /**
+     * Method: createGraphReader
+     * -------------------------
+     * Description: like createGraphReader(), parsing the file on up to the given number of
+     * threads where the factory has a parallel reader
+     * @param threads number of worker threads; 0 uses the hardware concurrency
+     */
+    virtual IGraphReader<Graph, Vertex>* createGraphReader(unsigned int threads) = 0;
+    // reader of the binary GraphSnapshot files, see GraphSnapshot::isSnapshot
+    virtual IGraphReader<Graph, Vertex>* createSnapshotReader() = 0;
 
     virtual IDegreeDistribution<Graph, Vertex>* createDegreeDistribution(Graph& g) = 0;
 
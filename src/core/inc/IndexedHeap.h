@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace graphpp
+{
+/**
+ * Class: IndexedHeap
+ * ------------------
+ * Description: d-ary min-heap over the items 0..capacity-1 with decrease-key. Each item
+ * is in the heap at most once and knows its position, so decreaseKey is a sift-up instead
+ * of a rebuild. Intended to be reused across runs: clear() only touches the items that are
+ * still in the heap.
+ * Template Argument Key: priority type, compared with <
+ * Template Argument Arity: children per node; 4 keeps the tree shallow and cache friendly
+ */
+template <class Key, unsigned int Arity = 4>
+class IndexedHeap
+{
+public:
+    typedef unsigned int Item;
+
+    explicit IndexedHeap(Item capacity) : keys(capacity), position(capacity, NotInHeap) {}
+
+    bool empty() const
+    {
+        return heap.empty();
+    }
+
+    std::size_t size() const
+    {
+        return heap.size();
+    }
+
+    bool contains(Item item) const
+    {
+        return position[item] != NotInHeap;
+    }
+
+    Item top() const
+    {
+        return heap.front();
+    }
+
+    const Key& key(Item item) const
+    {
+        return keys[item];
+    }
+
+    /**
+     * Method: push
+     * ------------
+     * Description: inserts an item that is not in the heap
+     */
+    void push(Item item, const Key& key)
+    {
+        keys[item] = key;
+        position[item] = heap.size();
+        heap.push_back(item);
+        siftUp(heap.size() - 1);
+    }
+
+    /**
+     * Method: decreaseKey
+     * -------------------
+     * Description: lowers the key of an item already in the heap
+     */
+    void decreaseKey(Item item, const Key& key)
+    {
+        keys[item] = key;
+        siftUp(position[item]);
+    }
+
+    /**
+     * Method: pushOrDecrease
+     * ----------------------
+     * Description: inserts the item, or lowers its key if it is already in the heap
+     */
+    void pushOrDecrease(Item item, const Key& key)
+    {
+        if (contains(item))
+            decreaseKey(item, key);
+        else
+            push(item, key);
+    }
+
+    /**
+     * Method: pop
+     * -----------
+     * Description: removes the item with the smallest key
+     * @returns the removed item
+     */
+    Item pop()
+    {
+        const Item ret = heap.front();
+        position[ret] = NotInHeap;
+        const Item last = heap.back();
+        heap.pop_back();
+        if (!heap.empty())
+        {
+            heap[0] = last;
+            position[last] = 0;
+            siftDown(0);
+        }
+        return ret;
+    }
+
+    void clear()
+    {
+        for (const Item item : heap)
+            position[item] = NotInHeap;
+        heap.clear();
+    }
+
+private:
+    static const std::size_t NotInHeap = std::size_t(-1);
+
+    void siftUp(std::size_t i)
+    {
+        const Item item = heap[i];
+        while (i > 0)
+        {
+            const std::size_t parent = (i - 1) / Arity;
+            if (!(keys[item] < keys[heap[parent]]))
+                break;
+            place(heap[parent], i);
+            i = parent;
+        }
+        place(item, i);
+    }
+
+    void siftDown(std::size_t i)
+    {
+        const Item item = heap[i];
+        const std::size_t n = heap.size();
+        while (true)
+        {
+            const std::size_t first = i * Arity + 1;
+            if (first >= n)
+                break;
+            const std::size_t last = first + Arity < n ? first + Arity : n;
+            std::size_t best = first;
+            for (std::size_t c = first + 1; c < last; ++c)
+                if (keys[heap[c]] < keys[heap[best]])
+                    best = c;
+            if (!(keys[heap[best]] < keys[item]))
+                break;
+            place(heap[best], i);
+            i = best;
+        }
+        place(item, i);
+    }
+
+    void place(Item item, std::size_t i)
+    {
+        heap[i] = item;
+        position[item] = i;
+    }
+
+    std::vector<Item> heap;
+    std::vector<Key> keys;
+    std::vector<std::size_t> position;
+};
+
+template <class Key, unsigned int Arity>
+const std::size_t IndexedHeap<Key, Arity>::NotInHeap;
+}  // namespace graphpp
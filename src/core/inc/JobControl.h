@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include "GraphExceptions.h"
+
+/**
+ * Exception: JobCancelled
+ * -----------------------
+ * Description: Exception thrown by the checkpoints of a computation whose job was cancelled
+ */
+DEFINE_SPECIFIC_EXCEPTION_TEXT(JobCancelled, GraphExceptionHierarchy, "The job was cancelled");
+
+namespace graphpp
+{
+/**
+ * Class: JobControl
+ * -----------------
+ * Description: lets another thread follow and stop a long computation. The thread running
+ * the computation installs the job with a Scope; the long loops of the core (parallelFor,
+ * the generators, the readers, the shell index and max clique searches) then call checkpoint
+ * or progress, which throw JobCancelled once cancel was called and record how far the
+ * current stage is. On a thread without a job both are a thread-local read, so code that
+ * does not run as a job does not pay for them. parallelFor hands the job of the calling
+ * thread to its workers.
+ * The computations only release what they own when JobCancelled goes through them; a
+ * cancelled computation leaves its input graph in whatever state it reached.
+ */
+class JobControl
+{
+public:
+    /**
+     * Class: Scope
+     * ------------
+     * Description: makes a job the one of the current thread while it lives
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(JobControl* job) : previous(currentJob())
+        {
+            currentJob() = job;
+        }
+
+        ~Scope()
+        {
+            currentJob() = previous;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        JobControl* previous;
+    };
+
+    /**
+     * Method: cancel
+     * --------------
+     * Description: asks the job to stop; its next checkpoint throws JobCancelled. May be
+     * called from any thread.
+     */
+    void cancel()
+    {
+        cancelRequested.store(true, std::memory_order_relaxed);
+    }
+
+    bool cancelled() const
+    {
+        return cancelRequested.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Method: fraction
+     * ----------------
+     * @returns how far the current stage of the job is, in [0, 1]
+     */
+    double fraction() const
+    {
+        const std::size_t total = stageTotal.load(std::memory_order_relaxed);
+        const std::size_t done = stageDone.load(std::memory_order_relaxed);
+        return total == 0 ? 0.0 : done >= total ? 1.0 : double(done) / total;
+    }
+
+    /**
+     * Method: current
+     * ---------------
+     * @returns the job of the calling thread, or nullptr if it runs none
+     */
+    static JobControl* current()
+    {
+        return currentJob();
+    }
+
+    /**
+     * Method: checkpoint
+     * ------------------
+     * Description: throws JobCancelled if the job of the calling thread was cancelled
+     */
+    static void checkpoint()
+    {
+        const JobControl* job = currentJob();
+        if (job != nullptr && job->cancelled())
+            throw JobCancelled();
+    }
+
+    /**
+     * Method: progress
+     * ----------------
+     * Description: records that done of the total items of the current stage are over, then
+     * is a checkpoint
+     */
+    static void progress(std::size_t done, std::size_t total)
+    {
+        JobControl* job = currentJob();
+        if (job == nullptr)
+            return;
+        job->stageTotal.store(total, std::memory_order_relaxed);
+        job->stageDone.store(done, std::memory_order_relaxed);
+        if (job->cancelled())
+            throw JobCancelled();
+    }
+
+private:
+    static JobControl*& currentJob()
+    {
+        static thread_local JobControl* job = nullptr;
+        return job;
+    }
+
+    std::atomic<bool> cancelRequested{false};
+    std::atomic<std::size_t> stageDone{0};
+    std::atomic<std::size_t> stageTotal{0};
+};
+}  // namespace graphpp
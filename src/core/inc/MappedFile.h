@@ -0,0 +1,115 @@
+// This toolbox is licensed under the Academic Free License 3.0.
+// Instituto Tecnológico de Buenos Aires (ITBA).
+
+#pragma once
+
+#ifdef _WIN32
+#include <fstream>
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <cstddef>
+#include <string>
+
+#include "IGraphReader.h"
+
+namespace graphpp
+{
+/**
+ * Class: MappedFile
+ * -----------------
+ * Description: read-only memory mapping of a whole file, so readers can parse it in place
+ * without copying lines. The mapping is released on destruction. On Windows, which has no
+ * mmap, the file is read into memory instead.
+ */
+class MappedFile
+{
+public:
+    /**
+     * Constructor
+     * -----------
+     * @param path file to map
+     * @throws FileNotFoundException if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path) : data(nullptr), length(0)
+    {
+#ifdef _WIN32
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            throw FileNotFoundException(path);
+
+        const std::streamoff end = file.tellg();
+        if (end < 0)
+            throw FileNotFoundException(path);
+        contents.resize(std::size_t(end));
+        file.seekg(0);
+        if (!file.read(contents.data(), end))
+            throw FileNotFoundException(path);
+        data = contents.data();
+        length = contents.size();
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw FileNotFoundException(path);
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+        {
+            ::close(fd);
+            throw FileNotFoundException(path);
+        }
+
+        length = info.st_size;
+        if (length > 0)
+        {
+            void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED)
+            {
+                ::close(fd);
+                throw FileNotFoundException(path);
+            }
+            ::madvise(mapping, length, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapping);
+        }
+        ::close(fd);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+#ifndef _WIN32
+        if (data != nullptr)
+            ::munmap(const_cast<char*>(data), length);
+#endif
+    }
+
+    const char* begin() const
+    {
+        return data;
+    }
+
+    const char* end() const
+    {
+        return data + length;
+    }
+
+    std::size_t size() const
+    {
+        return length;
+    }
+
+private:
+    const char* data;
+    std::size_t length;
+#ifdef _WIN32
+    std::vector<char> contents;
+#endif
+};
+}  // namespace graphpp
@@ -1,10 +1,16 @@
 #pragma once
 
+#include "CliqueSearch.h"
+#include "CompressedGraph.h"
 #include "IMaxClique.h"
+#include "JobControl.h"
 #include "TraverserOrdered.h"
 #include "mili/mili.h"
 
-#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <vector>
 #include "typedefs.h"
 
 namespace graphpp
@@ -20,6 +26,7 @@ public:
 
     bool visitVertex(Vertex* vertex)
     {
+        JobControl::checkpoint();
         maxCliqueObserver.visit(vertex);
         return true;
     }
@@ -244,28 +251,6 @@ private:
 template <class Graph, class Vertex>
 class MaxCliqueExact;
 
-template <class Graph, class Vertex>
-class MaxCliqueExactVisitor
-{
-public:
-    MaxCliqueExactVisitor(MaxCliqueExact<Graph, Vertex>& observer) : maxCliquenObserver(observer) {}
-
-    bool visitVertex(Vertex* vertex)
-    {
-        maxCliquenObserver.visit(vertex);
-
-        if ((time(nullptr) - maxCliquenObserver.start) > maxCliquenObserver.maxTime)
-        {
-            maxCliquenObserver.timeouted = true;
-            return false;
-        }
-        return true;
-    }
-
-private:
-    MaxCliqueExact<Graph, Vertex>& maxCliquenObserver;
-};
-
 template <class Graph, class Vertex>
 class MaxCliqueExactMap
 {
@@ -281,228 +266,39 @@ private:
     MaxCliqueExact<Graph, Vertex>& maxCliqueObserver;
 };
 
+/**
+ * Class: MaxCliqueExact
+ * ---------------------
+ * Description: the exact size of the largest clique containing each vertex, their
+ * distribution and a maximum clique of the graph, found by a CliqueSearch on a compressed
+ * copy of the graph.
+ * If the search takes longer than max_time seconds it stops, finished() is false and the
+ * sizes and clique are the largest found until then; the distribution is only computed for
+ * a finished search.
+ */
 template <class Graph, class Vertex>
 class MaxCliqueExact : public IMaxClique<Graph, Vertex>
 {
 public:
-    typedef std::map<typename Vertex::VertexId, typename std::list<int>*> MaxCliqueContainer;
-    typedef AutonomousIterator<MaxCliqueContainer> MaxCliqueIterator;
-    typedef typename Vertex::VerticesIterator NeighborsIterator;
-    typedef typename std::list<Vertex*> L_type;
-    typedef typename L_type::iterator L_iterator;
-    typedef typename std::list<L_type*> a_type;
-    typedef typename a_type::iterator a_iterator;
-    typedef typename std::map<Vertex*, a_type*> as_type;
-    typedef typename as_type::iterator as_iterator;
-
     MaxCliqueExact(Graph& graph, int max_time)
-        : maxTime(max_time), timeouted(false), start(time(NULL))
     {
-        calculateMaxClique(graph);
-    }
-
-    virtual MaxCliqueIterator iterator()
-    {
-        return MaxCliqueIterator(container);
+        calculateMaxClique(graph, max_time);
     }
 
     virtual bool finished()
     {
-        return !timeouted;
-    }
-
-    /*void visit(Vertex* v){
-
-    }*/
-
-    void visit(Vertex* v)
-    {
-        for (auto it1 = v->neighborsIterator(); !it1.end(); it1++)
-        {
-            if ((time(nullptr) - start) > maxTime)
-            {
-                return;
-            }
-
-            Vertex* x = *it1;
-            if (x->getVisited())
-            {
-                if (as[x] == nullptr)
-                {
-                    as[x] = new a_type();
-                    bool _new = false;
-                    bool _old = false;
-                    L_type* L = new L_type();
-                    L->push_back(x);
-                    L->push_back(v);
-
-                    if (as[v] == nullptr)
-                    {
-                        as[v] = new a_type();
-                        _new = true;
-                    }
-                    else
-                        for (a_iterator it3 = as[v]->begin(); it3 != as[v]->end(); it3++)
-                        {
-                            if ((time(nullptr) - start) > maxTime)
-                            {
-                                return;
-                            }
-                            L_type* B = (*it3);
-                            if (B->size() < L->size())
-                            {
-                                if (include(B, L))
-                                {
-                                    it3 = as[v]->erase(it3);
-                                }
-                                _new = true;
-                            }
-                            else
-                            {
-                                if (!include(L, B))
-                                {
-                                    _new = true;
-                                }
-                                else
-                                {
-                                    _old = true;
-                                }
-                            }
-                        }
-
-                    if (_new && !_old)
-                    {
-                        for (L_iterator itF = L->begin(); itF != L->end(); itF++)
-                        {
-                            if ((time(nullptr) - start) > maxTime)
-                            {
-                                return;
-                            }
-                            as[(*itF)]->push_back(L);
-                        }
-                    }
-                }
-                else
-                    for (a_iterator it2 = as[x]->begin(); it2 != as[x]->end(); it2++)
-                    {
-                        if ((time(nullptr) - start) > maxTime)
-                        {
-                            return;
-                        }
-                        L_type* A = (*it2);
-                        bool _new = false;
-                        bool _old = false;
-
-                        L_type* L = new L_type();
-                        NeighborsIterator iterator1 = v->neighborsIterator();
-                        while (!iterator1.end())
-                        {
-                            L_iterator iterator2 = A->begin();
-                            while (iterator2 != A->end())
-                            {
-                                if ((time(nullptr) - start) > maxTime)
-                                {
-                                    return;
-                                }
-                                if ((*iterator1)->getVertexId() == (*iterator2)->getVertexId())
-                                {
-                                    L->push_back(*iterator1);
-                                }
-                                iterator2++;
-                            }
-                            iterator1++;
-                        }
-                        L->push_back(v);
-
-                        if (as[v] == nullptr)
-                        {
-                            as[v] = new a_type();
-                            _new = true;
-                        }
-                        else
-                            for (a_iterator it3 = as[v]->begin(); it3 != as[v]->end(); it3++)
-                            {
-                                if ((time(nullptr) - start) > maxTime)
-                                {
-                                    return;
-                                }
-                                L_type* B = (*it3);
-                                if (B->size() < L->size())
-                                {
-                                    if (include(B, L))
-                                    {
-                                        it3 = as[v]->erase(it3);
-                                    }
-                                    _new = true;
-                                }
-                                else
-                                {
-                                    if (!include(L, B))
-                                    {
-                                        _new = true;
-                                    }
-                                    else
-                                    {
-                                        _old = true;
-                                    }
-                                }
-                            }
-
-                        if (_new && !_old)
-                        {
-                            for (L_iterator itF = L->begin(); itF != L->end(); itF++)
-                            {
-                                if ((time(nullptr) - start) > maxTime)
-                                {
-                                    return;
-                                }
-                                as[(*itF)]->push_back(L);
-                            }
-                        }
-                    }
-            }
-        }
+        return done;
     }
 
     int getMaxCliqueSize(Vertex* vertex)
     {
-        unsigned int max_size = 0;
-        std::list<int>* ids = new std::list<int>();
-        for (a_iterator iterator2 = as[vertex]->begin(); iterator2 != as[vertex]->end();
-             iterator2++)
-        {
-            if ((*iterator2) && (*iterator2)->size() > max_size)
-            {
-                max_size = (*iterator2)->size();
-                delete ids;
-                ids = new std::list<int>();
-                for (L_iterator iterator10 = (*iterator2)->begin();
-                     iterator10 != (*iterator2)->end(); iterator10++)
-                {
-                    ids->push_back((*iterator10)->getVertexId());
-                }
-            }
-        }
-
-        container[vertex->getVertexId()] = ids;
-
-        return max_size;
+        auto it = std::lower_bound(ids.begin(), ids.end(), vertex->getVertexId());
+        return it == ids.end() || *it != vertex->getVertexId() ? 0 : sizes[it - ids.begin()];
     }
 
     virtual std::list<int> getMaxCliqueList()
     {
-        unsigned int max_size = 0;
-        std::list<int>* ids = nullptr;
-        for (MaxCliqueIterator it = MaxCliqueIterator(container); !it.end(); it++)
-        {
-            if (it->second->size() > max_size)
-            {
-                max_size = it->second->size();
-                ids = (it->second);
-            }
-        }
-
-        return *ids;
+        return maxClique;
     }
 
     virtual DistributionIterator distIterator()
@@ -511,47 +307,33 @@ public:
     }
 
 private:
-    bool include(L_type* B, L_type* A)
-    {
-        for (L_iterator iterator1 = B->begin(); iterator1 != B->end(); iterator1++)
-        {
-            bool cont = false;
-            for (L_iterator iterator2 = A->begin(); iterator2 != A->end(); iterator2++)
-            {
-                if ((*iterator1)->getVertexId() == (*iterator2)->getVertexId())
-                {
-                    cont = true;
-                }
-            }
-            if (!cont)
-            {
-                return false;
-            }
-        }
-        return true;
-    }
-
-    void calculateMaxClique(Graph& graph)
+    void calculateMaxClique(Graph& graph, int max_time)
     {
-        MaxCliqueExactVisitor<Graph, Vertex> visitor(*this);
-        TraverserOrdered<Graph, Vertex, MaxCliqueExactVisitor<Graph, Vertex>, DegreeCompare>::
-            traverse(graph, visitor, DegreeCompare());
-
-        if (!timeouted)
+        const CompressedGraph csr(graph);
+        const CliqueSearch search(
+            csr, CliqueSearch::Clock::now() + std::chrono::seconds(std::max(0, max_time)));
+
+        done = search.finished();
+        ids = csr.getIds();
+        sizes.resize(ids.size());
+        for (CliqueSearch::Index i = 0; i < ids.size(); ++i)
+            sizes[i] = search.cliqueSizeOf(i);
+        for (const CliqueSearch::Index i : search.maximumClique())
+            maxClique.push_back(ids[i]);
+
+        if (done)
         {
             MaxCliqueExactMap<Graph, Vertex> map(*this);
             distribution.calculateDistribution(graph, &map);
         }
     }
 
-    as_type as;
-    MaxCliqueContainer container;
+    bool done;
+    // by increasing id, as the indices of the compressed graph
+    std::vector<typename Vertex::VertexId> ids;
+    std::vector<unsigned int> sizes;
+    std::list<int> maxClique;
     IntegerDistribution<Graph, Vertex, MaxCliqueExactMap<Graph, Vertex>> distribution;
-
-public:
-    int maxTime;
-    bool timeouted;
-    int start;
 };
 }  // namespace graphpp
 /*
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+
+#include "PropertyMap.h"
+
+namespace graphpp
+{
+/**
+ * Class: MetricCache
+ * ------------------
+ * Description: results of metrics, kept for the version of the graph they were computed on.
+ * A result is looked up by its Key: the metric, its parameters (as a string, e.g. the
+ * betweenness samples), the directed out/in flags and the graph version. Each metric,
+ * parameters and flags hold one result: asking for it with another version computes it again
+ * and replaces the old one, so a result is never served for a graph that changed since, and
+ * the results of older versions are not kept around.
+ * Results may be of any type, e.g. a PropertyMap or a VertexProperty; asking for a result
+ * with another type than it was stored with throws PropertyTypeMismatch.
+ * Not thread safe.
+ */
+class MetricCache
+{
+public:
+    struct Key
+    {
+        std::string metric;
+        std::string parameters;
+        bool directedOut;
+        bool directedIn;
+        std::uint64_t graphVersion;
+    };
+
+    /**
+     * Method: get
+     * -----------
+     * Description: looks up a result, computing it if it is not there or is for another
+     * graph version
+     * @param key the result to look up
+     * @param compute called as compute(result) on a default constructed T to fill it in
+     * @returns the result; it stays valid until the same result is replaced or the cache is
+     * cleared
+     */
+    template <class T, class Compute>
+    T& get(const Key& key, Compute compute)
+    {
+        Entry& entry = entries[slot(key)];
+        if (entry.result && entry.graphVersion == key.graphVersion)
+            return typed<T>(*entry.result);
+
+        // drop the stale result before computing the new one, not to hold both
+        entry.result.reset();
+        std::unique_ptr<TypedResult<T>> result(new TypedResult<T>());
+        compute(result->value);
+        entry.graphVersion = key.graphVersion;
+        entry.result = std::move(result);
+        return typed<T>(*entry.result);
+    }
+
+    /**
+     * Method: contains
+     * ----------------
+     * @returns whether the result of key is there for its graph version
+     */
+    bool contains(const Key& key) const
+    {
+        auto it = entries.find(slot(key));
+        return it != entries.end() && it->second.result &&
+               it->second.graphVersion == key.graphVersion;
+    }
+
+    /**
+     * Method: size
+     * ------------
+     * @returns the number of results kept
+     */
+    std::size_t size() const
+    {
+        std::size_t count = 0;
+        for (const auto& entry : entries)
+            count += entry.second.result ? 1 : 0;
+        return count;
+    }
+
+    void clear()
+    {
+        entries.clear();
+    }
+
+private:
+    typedef std::tuple<std::string, std::string, bool, bool> Slot;
+
+    class Result
+    {
+    public:
+        virtual ~Result() {}
+    };
+
+    template <class T>
+    class TypedResult : public Result
+    {
+    public:
+        T value;
+    };
+
+    struct Entry
+    {
+        std::uint64_t graphVersion = 0;
+        std::unique_ptr<Result> result;
+    };
+
+    static Slot slot(const Key& key)
+    {
+        return Slot(key.metric, key.parameters, key.directedOut, key.directedIn);
+    }
+
+    template <class T>
+    static T& typed(Result& result)
+    {
+        TypedResult<T>* typedResult = dynamic_cast<TypedResult<T>*>(&result);
+        if (typedResult == nullptr)
+            throw PropertyTypeMismatch();
+        return typedResult->value;
+    }
+
+    std::map<Slot, Entry> entries;
+};
+}  // namespace graphpp
@@ -4,31 +4,57 @@
 
 #pragma once
 
-#include <math.h>
+#include <cstdint>
+#include <cstdlib>
 #include <fstream>
-#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "DisjointSets.h"
 #include "IGraphReader.h"
+#include "Random.h"
 
 namespace graphpp
 {
-struct pair_hash
-{
-    inline std::size_t operator()(const std::pair<int, int>& v) const
-    {
-        return v.first * 31 + v.second;
-    }
-};
-
+/**
+ * Class: MolloyReedGraphReader
+ * ----------------------------
+ * Description: Builds a Molloy-Reed (configuration model) graph from a file with lines
+ * "degree amount": amount vertices get the given degree, with ids from 0 in increasing order of
+ * degree. Every vertex gets a stub per unit of degree, the stubs are shuffled and paired in
+ * order. Pairs that would make a loop or repeat an edge, found with a hashed edge set, are
+ * repaired: their stubs are shuffled and paired again a few times, and what is left is swapped
+ * with random edges already placed. The few stubs that still find no partner, and the last one
+ * of an odd total, are dropped, so the degrees may fall short by a little.
+ * Time and memory are O(n + m).
+ */
 template <class Graph, class Vertex>
 class MolloyReedGraphReader : public IGraphReader<Graph, Vertex>
 {
 public:
-    std::vector<unsigned int> vertexesFutureDegrees;
-
     typedef std::string FileName;
     typedef unsigned int LineNumber;
     typedef typename Vertex::VerticesIterator NeighborsIterator;
 
+    // The seed comes from rand()
+    MolloyReedGraphReader()
+        : seed(Random::seedFromRand()), giantComponent(false), unpairedStubs(0)
+    {
+    }
+
+    /**
+     * Constructor
+     * -----------
+     * @param seed seed of the stub shuffle: the same file and seed give the same graph
+     * @param giantComponent keep only the biggest connected component
+     */
+    explicit MolloyReedGraphReader(std::uint64_t seed, bool giantComponent = false)
+        : seed(seed), giantComponent(giantComponent), unpairedStubs(0)
+    {
+    }
+
     virtual void read(Graph& graph, std::string source)
     {
         std::map<unsigned int, unsigned int> k;
@@ -66,333 +92,167 @@ public:
         return currentLineNumber;
     }
 
+    /**
+     * Method: getUnpairedStubs
+     * ------------------------
+     * Description: stubs of the last read that were dropped because no valid partner was found
+     */
+    std::size_t getUnpairedStubs() const
+    {
+        return unpairedStubs;
+    }
+
 private:
-    void debug(const std::vector<unsigned int>& vec)
+    typedef std::pair<unsigned int, unsigned int> Edge;
+
+    // Times the stubs of the rejected pairs are shuffled and paired again
+    static const unsigned int RepairRounds = 8;
+    // Random edges tried for each pair still rejected after the rounds
+    static const unsigned int SwapAttempts = 64;
+
+    static std::uint64_t key(unsigned int u, unsigned int v)
     {
-        for (auto& v : vec)
-            std::cout << v << std::endl;
+        return u < v ? (std::uint64_t)u << 32 | v : (std::uint64_t)v << 32 | u;
     }
 
-    void debug(const std::set<unsigned int>& set)
+    // Random::below keeps the graph the same on every standard library, unlike std::shuffle
+    void shuffle(std::vector<unsigned int>& values)
     {
-        for (auto& v : set)
-            std::cout << v << std::endl;
+        for (std::size_t i = values.size(); i > 1; --i)
+            std::swap(values[i - 1], values[rng.below(i)]);
     }
 
-    void molloyReedAlgorithm(Graph& graph, std::map<unsigned int, unsigned int> k)
+    bool canJoin(unsigned int u, unsigned int v) const
     {
-        int totalNodes = 0;
-        int freeDegrees = 0;
-        bool vertexesWithOneFreeDegreeFull = false;
-        std::set<unsigned int> nodesSet;
-        std::map<unsigned int, unsigned int> vertexesIdsDegrees;
-        std::map<unsigned int, std::set<unsigned int>> nodesNotConnectedTo;
-        std::vector<unsigned int> unconectedVertexesIds;
-        std::vector<unsigned int> unconectedVertexesOneDegreeIds;
-        std::vector<unsigned int> vertexesWithOneFreeDegree;
-        std::vector<unsigned int> vertexesWithFreeDegrees;
-        std::vector<unsigned int> vertexesWitNoFreeDegrees;
-        std::vector<unsigned int> vertexesInTheGraph;
-        unsigned int id = 0;
-        unsigned int maxDegreeId = 0;
-        unsigned int maxDegreeQuant = 0;
-
-        std::map<unsigned int, unsigned int>::iterator it;
-
-        unsigned int maxIndex = 0;
-        unsigned int maxIndexOneDegree = 0;
-        unsigned int maxDegreeIndex = 0;
-        for (it = k.begin(); it != k.end(); it++)
+        return u != v && edgeSet.count(key(u, v)) == 0;
+    }
+
+    void join(unsigned int u, unsigned int v)
+    {
+        edges.push_back(Edge(u, v));
+        edgeSet.insert(key(u, v));
+    }
+
+    // pairs consecutive stubs, returning the stubs of the pairs that were rejected
+    std::vector<unsigned int> pairStubs(const std::vector<unsigned int>& stubs)
+    {
+        std::vector<unsigned int> rejected;
+        for (std::size_t i = 0; i + 1 < stubs.size(); i += 2)
         {
-            std::cout << "key: " << it->first << " value: " << it->second << "\n";
-            unsigned int quantityOfVertexes = it->second;
-            unsigned int degrees = it->first;
-            if (maxDegreeQuant < degrees)
+            if (canJoin(stubs[i], stubs[i + 1]))
             {
-                if (degrees > 1)
-                {
-                    maxDegreeIndex = maxIndex;
-                }
-                else
-                {
-                    maxDegreeIndex = maxIndexOneDegree;
-                }
-                maxDegreeQuant = degrees;
-                maxDegreeId = id;
+                join(stubs[i], stubs[i + 1]);
             }
-            for (unsigned int i = 0; i < quantityOfVertexes; i++)
+            else
             {
-                vertexesIdsDegrees[id] = degrees;
-                if (degrees == 1)
-                {
-                    unconectedVertexesOneDegreeIds.push_back(id);
-                    maxIndexOneDegree++;
-                }
-                else
-                {
-                    unconectedVertexesIds.push_back(id);
-                    maxIndex++;
-                }
-                nodesSet.insert(id);
-                id++;
+                rejected.push_back(stubs[i]);
+                rejected.push_back(stubs[i + 1]);
             }
         }
+        return rejected;
+    }
 
-        for (int i = 0; i < id; i++)
-        {
-            std::set<unsigned int> newNodeSet = nodesSet;
-            newNodeSet.erase(i);
-            nodesNotConnectedTo[i] = newNodeSet;
-        }
-        std::cout << "maxDegreeQuant: " << maxDegreeQuant << std::endl;
-        totalNodes = id;
-        freeDegrees = maxDegreeQuant;
-        if (freeDegrees == 1)
-        {
-            vertexesWithOneFreeDegree.push_back(maxDegreeId);
-            unconectedVertexesOneDegreeIds.erase(
-                unconectedVertexesOneDegreeIds.begin() + maxDegreeIndex);
-        }
-        else
+    // replaces a random edge (x, y) by (u, x) and (v, y), which keeps every degree
+    bool swapIn(unsigned int u, unsigned int v)
+    {
+        for (unsigned int attempt = 0; attempt < SwapAttempts && !edges.empty(); ++attempt)
         {
-            vertexesWithFreeDegrees.push_back(maxDegreeId);
-            unconectedVertexesIds.erase(unconectedVertexesIds.begin() + maxDegreeIndex);
+            const std::size_t e = rng.below(edges.size());
+            unsigned int x = edges[e].first;
+            unsigned int y = edges[e].second;
+            if (rng.below(2) == 1)
+                std::swap(x, y);
+            if (canJoin(u, x) && canJoin(v, y) && key(u, x) != key(v, y))
+            {
+                edgeSet.erase(key(x, y));
+                edges[e] = Edge(u, x);
+                edgeSet.insert(key(u, x));
+                join(v, y);
+                return true;
+            }
         }
-        vertexesInTheGraph.push_back(maxDegreeId);
-
-        Vertex* firstVertex = new Vertex(maxDegreeId);
-        graph.addVertex(firstVertex);
+        return false;
+    }
 
-        std::cout << "maxDegreeId: " << maxDegreeId << std::endl;
-        std::cout << "maxDegreeQuant: " << maxDegreeQuant << std::endl;
-        std::cout << "unconectedVertexesIds:" << std::endl;
-        debug(unconectedVertexesIds);
-        std::cout << "unconectedVertexesOneDegreeIds:" << std::endl;
-        debug(unconectedVertexesOneDegreeIds);
+    // marks the vertices of the biggest connected component of the edges
+    std::vector<bool> biggestComponent(std::size_t n) const
+    {
+        DisjointSets sets(n);
+        for (const auto& edge : edges)
+            sets.join(edge.first, edge.second);
+
+        unsigned int biggest = 0;
+        for (unsigned int v = 1; v < n; ++v)
+            if (sets.size(v) > sets.size(biggest))
+                biggest = v;
+
+        std::vector<bool> ret(n);
+        biggest = n > 0 ? sets.find(biggest) : 0;
+        for (unsigned int v = 0; v < n; ++v)
+            ret[v] = sets.find(v) == biggest;
+        return ret;
+    }
 
-        std::cout << "StartAlgorithm: \n\n";
+    void molloyReedAlgorithm(Graph& graph, const std::map<unsigned int, unsigned int>& k)
+    {
+        rng = Random(seed);
+        edges.clear();
+        edgeSet.clear();
 
-        while (!unconectedVertexesIds.empty() || !unconectedVertexesOneDegreeIds.empty())
+        std::vector<unsigned int> degrees;
+        std::size_t stubsCount = 0;
+        for (const auto& entry : k)
         {
-            // cout << "unconectedVertexesIds: \n";
-            // debug(unconectedVertexesIds);
-            // cout << "unconectedVertexesOneDegreeIds: \n";
-            // debug(unconectedVertexesOneDegreeIds);
+            degrees.insert(degrees.end(), entry.second, entry.first);
+            stubsCount += (std::size_t)entry.first * entry.second;
+        }
 
-            int unconectedSize;
-            unsigned int nextVertexId;
-            unsigned int nextVertexDegree;
+        std::vector<unsigned int> stubs;
+        stubs.reserve(stubsCount);
+        for (std::size_t v = 0; v < degrees.size(); ++v)
+            stubs.insert(stubs.end(), degrees[v], v);
+        shuffle(stubs);
 
-            int index_new;
-            if (!unconectedVertexesIds.empty())
-            {
-                unconectedSize = unconectedVertexesIds.size();
-                index_new = rand() % unconectedSize;
-                nextVertexId = unconectedVertexesIds[index_new];
-                nextVertexDegree = vertexesIdsDegrees[nextVertexId];
-                unconectedVertexesIds.erase(unconectedVertexesIds.begin() + index_new);
-            }
-            else
-            {
-                unconectedSize = unconectedVertexesOneDegreeIds.size();
-                index_new = rand() % unconectedSize;
-                nextVertexId = unconectedVertexesOneDegreeIds[index_new];
-                nextVertexDegree = vertexesIdsDegrees[nextVertexId];
-                unconectedVertexesOneDegreeIds.erase(
-                    unconectedVertexesOneDegreeIds.begin() + index_new);
-            }
+        edges.reserve(stubsCount / 2);
+        edgeSet.reserve(stubsCount / 2);
+        std::vector<unsigned int> rejected = pairStubs(stubs);
+        std::vector<unsigned int>().swap(stubs);
 
-            std::cout << "unconected is empty?: " << unconectedVertexesIds.empty() << "\n";
-            std::cout << "unconectedSize: " << unconectedSize << "\n";
-            std::cout << "nodeFromIndex: " << index_new << "\n";
-            std::cout << "nodeFromId: " << nextVertexId << "\n";
-            std::cout << "nodeFromDegree: " << nextVertexDegree << "\n";
-
-            if (nextVertexDegree != 0)
-            {
-                vertexesIdsDegrees[nextVertexId] = nextVertexDegree - 1;
-                size_t noFreeAndOneFreeSize =
-                    vertexesWithOneFreeDegree.size() + vertexesWitNoFreeDegrees.size();
-                if (noFreeAndOneFreeSize == vertexesInTheGraph.size())
-                {
-                    vertexesWithOneFreeDegreeFull = true;
-                }
-
-                unsigned int selectedId;
-                int size;
-                int index;
-                if (vertexesWithOneFreeDegreeFull)
-                {
-                    size = vertexesWithOneFreeDegree.size();
-                    if (size == 0)
-                    {
-                        break;
-                    }
-                    index = rand() % size;
-                    selectedId = vertexesWithOneFreeDegree[index];
-                }
-                else
-                {
-                    size = vertexesWithFreeDegrees.size();
-                    index = rand() % size;
-                    selectedId = vertexesWithFreeDegrees[index];
-                }
-
-                std::cout << "nodeToIndex: " << index << "\n";
-                std::cout << "nodeToId: " << selectedId << "\n";
-                std::cout << "nodeToDegree: " << vertexesIdsDegrees[selectedId] << "\n";
-
-                if (vertexesIdsDegrees[selectedId] == 0)
-                {
-                    vertexesWithOneFreeDegree.erase(vertexesWithOneFreeDegree.begin() + index);
-                    vertexesWitNoFreeDegrees.push_back(selectedId);
-                }
-                else
-                {
-                    int degreesLeft = vertexesIdsDegrees[selectedId] - 1;
-                    vertexesIdsDegrees[selectedId] = degreesLeft;
-                    if (degreesLeft == 1)
-                    {
-                        vertexesWithFreeDegrees.erase(vertexesWithFreeDegrees.begin() + index);
-                        vertexesWithOneFreeDegree.push_back(selectedId);
-                    }
-                    else if (degreesLeft == 0)
-                    {
-                        vertexesWithOneFreeDegree.erase(vertexesWithOneFreeDegree.begin() + index);
-                        vertexesWitNoFreeDegrees.push_back(selectedId);
-                    }
-                    // cout << "vertexesWithFreeDegrees: \n";
-                    // debug(vertexesWithFreeDegrees);
-                    // cout << "vertexesWithOneFreeDegree: \n";
-                    // debug(vertexesWithOneFreeDegree);
-                    Vertex* existentVertex = graph.getVertexById(selectedId);
-                    Vertex* newVertex = new Vertex(nextVertexId);
-                    graph.addVertex(newVertex);
-                    graph.addEdge(existentVertex, newVertex);
-
-                    vertexesInTheGraph.push_back(nextVertexId);
-                    nodesNotConnectedTo[selectedId].erase(nextVertexId);
-                    nodesNotConnectedTo[nextVertexId].erase(selectedId);
-
-                    if (nextVertexDegree - 1 == 0)
-                    {
-                        vertexesWitNoFreeDegrees.push_back(nextVertexId);
-                    }
-                    else if (nextVertexDegree - 1 == 1)
-                    {
-                        vertexesWithOneFreeDegree.push_back(nextVertexId);
-                    }
-                    else
-                    {
-                        vertexesWithFreeDegrees.push_back(nextVertexId);
-                        vertexesWithOneFreeDegreeFull = false;
-                    }
-                }
-            }
-            // printVertexVector(graph, vertexesInTheGraph);
+        for (unsigned int round = 0; round < RepairRounds && rejected.size() >= 2; ++round)
+        {
+            shuffle(rejected);
+            rejected = pairStubs(rejected);
         }
 
-        std::cout << "####################### Begin rewire! #######################: \n\n";
-        while (!vertexesWithFreeDegrees.empty() || !vertexesWithOneFreeDegree.empty())
-        {
-            unsigned int index_new;
-            unsigned int selectedId;
-            unsigned int selectedDegrees;
-            bool fromFreeDegrees;
-            if (!vertexesWithFreeDegrees.empty())
-            {
-                index_new = rand() % vertexesWithFreeDegrees.size();
-                selectedId = vertexesWithFreeDegrees[index_new];
-                selectedDegrees = vertexesIdsDegrees[selectedId];
-                fromFreeDegrees = true;
-            }
-            else
-            {
-                index_new = rand() % vertexesWithOneFreeDegree.size();
-                selectedId = vertexesWithOneFreeDegree[index_new];
-                selectedDegrees = vertexesIdsDegrees[selectedId];
-                fromFreeDegrees = false;
-            }
-            std::cout << "fromFreeDegrees: " << fromFreeDegrees << "\n";
-            std::cout << "selectedId: " << selectedId << "\n";
-            std::cout << "selectedDegrees: " << selectedDegrees << "\n";
-            std::cout << "nodesNotConnectedTo: "
-                      << "\n";
+        unpairedStubs = stubsCount % 2;
+        for (std::size_t i = 0; i + 1 < rejected.size(); i += 2)
+            if (!swapIn(rejected[i], rejected[i + 1]))
+                unpairedStubs += 2;
+        edgeSet.clear();
 
-            std::set<unsigned int> unconectedVertexes = nodesNotConnectedTo[selectedId];
-            std::set<unsigned int>::const_iterator it(nodesNotConnectedTo[selectedId].begin());
+        std::vector<bool> keep(degrees.size(), true);
+        if (giantComponent)
+            keep = biggestComponent(degrees.size());
 
-            // debug(unconectedVertexes);
-            if (!unconectedVertexes.empty() && selectedDegrees != 0)
-            {
-                unsigned int willConnectIndex = rand() % unconectedVertexes.size();
-                advance(it, willConnectIndex);
-                unsigned int willConnect = *it;
-                unsigned int willConnectDegrees = vertexesIdsDegrees[willConnect];
-                if (willConnectDegrees != 0)
-                {
-                    if (fromFreeDegrees)
-                    {
-                        vertexesWithFreeDegrees.erase(vertexesWithFreeDegrees.begin() + index_new);
-                    }
-                    else
-                    {
-                        vertexesWithOneFreeDegree.erase(
-                            vertexesWithOneFreeDegree.begin() + index_new);
-                    }
-
-                    if (selectedDegrees - 1 == 1)
-                    {
-                        vertexesWithOneFreeDegree.push_back(selectedId);
-                    }
-                    else if (selectedDegrees - 1 == 0)
-                    {
-                        vertexesWitNoFreeDegrees.push_back(selectedId);
-                    }
-                    vertexesIdsDegrees[selectedId] = selectedDegrees - 1;
-                    vertexesIdsDegrees[willConnect] = willConnectDegrees - 1;
-                    Vertex* existentVertexFrom = graph.getVertexById(selectedId);
-                    Vertex* existentVertexTo = graph.getVertexById(willConnect);
-                    graph.addEdge(existentVertexFrom, existentVertexTo);
-                    nodesNotConnectedTo[selectedId].erase(willConnect);
-                    nodesNotConnectedTo[willConnect].erase(selectedId);
-                }
-                else
-                {
-                    nodesNotConnectedTo[selectedId].erase(willConnect);
-                }
-            }
-            else
-            {
-                nodesNotConnectedTo.erase(selectedId);
-                if (fromFreeDegrees)
-                {
-                    vertexesWithFreeDegrees.erase(vertexesWithFreeDegrees.begin() + index_new);
-                }
-                else
-                {
-                    vertexesWithOneFreeDegree.erase(vertexesWithOneFreeDegree.begin() + index_new);
-                }
-                vertexesIdsDegrees[selectedId] = 0;
-            }
-            // printVertexVector(graph, vertexesInTheGraph);
+        std::vector<Vertex*> vertices(degrees.size(), nullptr);
+        std::fill(degrees.begin(), degrees.end(), 0);
+        for (const auto& edge : edges)
+        {
+            degrees[edge.first]++;
+            degrees[edge.second]++;
         }
-    }
-
-    // Given a vector with node ids, print for each one it's id, actual degree and free degrees.
-    void printVertexVector(Graph& graph, std::vector<unsigned int> vec)
-    {
-        Vertex* v;
-        for (unsigned int i = 0; i < vec.size(); i++)
+        for (std::size_t v = 0; v < degrees.size(); ++v)
         {
-            v = graph.getVertexById(vec[i]);
-            std::cout << "The vertex " << vec[i] << " has " << v->degree() << " neighbours\n";
+            if (!keep[v])
+                continue;
+            vertices[v] = new Vertex(v);
+            vertices[v]->reserveEdges(degrees[v]);
+            graph.addVertex(vertices[v]);
         }
-    }
-
-    int openDegrees(Vertex* vertex)
-    {
-        return vertexesFutureDegrees[vertex->getVertexId() - 1] - vertex->degree();
+        for (const auto& edge : edges)
+            if (keep[edge.first])
+                graph.addEdgeUnchecked(vertices[edge.first], vertices[edge.second]);
+        std::vector<Edge>().swap(edges);
     }
 
     std::string getLineNumberText() const
@@ -437,6 +297,12 @@ private:
             ++character;
     }
 
+    std::uint64_t seed;
+    bool giantComponent;
+    std::size_t unpairedStubs;
+    Random rng;
+    std::vector<Edge> edges;
+    std::unordered_set<std::uint64_t> edgeSet;
     LineNumber currentLineNumber;
     const char* character;
 };
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "JobControl.h"
+
+namespace graphpp
+{
+/**
+ * Method: workerCount
+ * -------------------
+ * Description: number of threads to use for an amount of independent work items.
+ * @param requested requested threads; 0 means the hardware concurrency
+ * @param work number of work items, there is no point in having more threads than items
+ * @returns a thread count, at least 1
+ */
+inline unsigned int workerCount(unsigned int requested, std::size_t work)
+{
+    if (requested == 0)
+        requested = std::max(1u, std::thread::hardware_concurrency());
+    return (unsigned int)std::max<std::size_t>(1, std::min<std::size_t>(requested, work));
+}
+
+/**
+ * Method: parallelFor
+ * -------------------
+ * Description: calls body(worker, i) for every i in [0, count), spread over the given
+ * number of threads. Items are handed out in small batches from a shared counter, so uneven
+ * items are balanced. worker is in [0, threads) and identifies the calling thread, which
+ * lets the body use per-thread state without locking. The calling thread is worker 0.
+ * The workers run the job of the calling thread, if any (see JobControl): they stop at the
+ * next item once it is cancelled, and every batch reports the items done as the progress.
+ * If body throws, no more items are handed out and, once every thread is done, the first
+ * exception thrown is rethrown to the caller.
+ * @param count number of items
+ * @param threads number of threads, as returned by workerCount
+ * @param body callable taking (unsigned int worker, std::size_t item)
+ */
+template <class Body>
+void parallelFor(std::size_t count, unsigned int threads, Body body)
+{
+    const std::size_t batch =
+        std::max<std::size_t>(1, std::min<std::size_t>(64, count / (threads * 16)));
+    std::atomic<std::size_t> next(0);
+    std::atomic<std::size_t> finished(0);
+    JobControl* job = JobControl::current();
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&](unsigned int w) {
+        JobControl::Scope scope(job);
+        try
+        {
+            std::size_t first;
+            while ((first = next.fetch_add(batch)) < count)
+            {
+                const std::size_t last = std::min(count, first + batch);
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    JobControl::checkpoint();
+                    body(w, i);
+                }
+                JobControl::progress(finished += last - first, count);
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error)
+                error = std::current_exception();
+            next.store(count);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned int w = 1; w < threads; ++w)
+        pool.emplace_back(worker, w);
+    worker(0);
+    for (auto& thread : pool)
+        thread.join();
+    if (error)
+        std::rethrow_exception(error);
+}
+}  // namespace graphpp
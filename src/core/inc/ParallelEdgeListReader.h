@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "EdgeListParser.h"
+#include "IGraphReader.h"
+#include "JobControl.h"
+#include "MappedFile.h"
+#include "Parallel.h"
+
+namespace graphpp
+{
+/**
+ * Class: ParallelEdgeListReader
+ * -----------------------------
+ * Description: Base of the readers that load an edge list using several threads. The mapped
+ * file is split into newline aligned chunks which are parsed concurrently into one edge
+ * buffer per chunk. Unless the graph is a multigraph, repeated edges are then found in
+ * parallel (edges are spread by key over the threads, which sort their share). Finally the
+ * buffers are added to the graph in file order, so vertices and neighbours end up in the
+ * same order as with the sequential readers. Subclasses add the edges and decide what a
+ * repeated edge means.
+ * If several lines are malformed the first one is reported.
+ */
+template <class Graph, class Vertex>
+class ParallelEdgeListReader : public IGraphReader<Graph, Vertex>, public ReadThroughput
+{
+public:
+    typedef unsigned int LineNumber;
+    typedef EdgeListParser::Line Line;
+
+    virtual void read(Graph& g, std::string source)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const MappedFile file(source);
+        // the graph already has edges, which the parsed ones must be checked against
+        const bool checked = g.verticesCount() != 0;
+
+        std::vector<const char*> bounds = chunkBounds(file);
+        const std::size_t chunks = bounds.size() - 1;
+        const unsigned int workers = workerCount(threads, chunks);
+
+        std::vector<std::vector<Line>> lines(chunks);
+        parse(bounds, workers, lines);
+
+        edgesCount = 0;
+        for (const auto& chunk : lines)
+            for (const auto& line : chunk)
+                edgesCount += line.isEdge;
+
+        std::vector<std::vector<char>> repeated(chunks);
+        for (std::size_t c = 0; c < chunks; ++c)
+            repeated[c].assign(lines[c].size(), 0);
+        if (!g.isMultigraph())
+            findRepeated(lines, g.isDigraph(), workers, repeated);
+
+        for (std::size_t c = 0; c < chunks; ++c)
+        {
+            JobControl::progress(c, chunks);
+            for (std::size_t i = 0; i < lines[c].size(); ++i)
+            {
+                const Line& line = lines[c][i];
+                Vertex* sourceNode = loadVertex(g, line.source);
+                if (line.isEdge)
+                {
+                    Vertex* destinationNode = loadVertex(g, line.destination);
+                    if (repeated[c][i])
+                        repeatedEdge(line);
+                    else
+                        addEdge(g, sourceNode, destinationNode, line, checked);
+                }
+            }
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        seconds = elapsed.count();
+    }
+
+    LineNumber getLineNumber() const
+    {
+        return currentLineNumber;
+    }
+
+protected:
+    /**
+     * Constructor
+     * -----------
+     * @param threads number of worker threads; 0 uses the hardware concurrency
+     * @param weighted whether lines carry a weight column
+     */
+    ParallelEdgeListReader(unsigned int threads, bool weighted)
+        : threads(threads), weighted(weighted), currentLineNumber(1)
+    {
+    }
+
+    /**
+     * Method: addEdge
+     * ---------------
+     * Description: adds the edge of a line that is not repeated within the file
+     * @param checked whether the edge may already be in the graph
+     */
+    virtual void addEdge(Graph& g, Vertex* s, Vertex* d, const Line& line, bool checked) = 0;
+
+    /**
+     * Method: repeatedEdge
+     * --------------------
+     * Description: called instead of addEdge for a line repeating an earlier edge of the file
+     */
+    virtual void repeatedEdge(const Line& line) = 0;
+
+    static std::string getLineNumberText(LineNumber lineNumber)
+    {
+        std::stringstream s;
+        s << "Line: " << lineNumber;
+        return s.str();
+    }
+
+private:
+    // below this size a chunk is not worth a thread
+    static const std::size_t MinChunkSize = 1 << 12;
+    // chunks per thread, so a slow chunk does not keep the other threads waiting
+    static const unsigned int ChunksPerThread = 4;
+
+    /**
+     * Struct: Entry
+     * -------------
+     * Description: an edge of the file, for finding the repeated ones: its key and its
+     * position in the chunk buffers.
+     */
+    struct Entry
+    {
+        std::uint64_t key;
+        std::uint32_t chunk;
+        std::uint32_t position;
+
+        bool operator<(const Entry& other) const
+        {
+            return key < other.key;
+        }
+    };
+
+    // chunk c is [bounds[c], bounds[c + 1]); every chunk but the last ends with a newline
+    std::vector<const char*> chunkBounds(const MappedFile& file) const
+    {
+        const std::size_t size = file.size();
+        const std::size_t wanted = std::min<std::size_t>(
+            workerCount(threads, ~std::size_t(0)) * ChunksPerThread,
+            std::max<std::size_t>(1, size / MinChunkSize));
+
+        std::vector<const char*> bounds(1, file.begin());
+        for (std::size_t c = 1; c < wanted; ++c)
+        {
+            const char* p = std::max(bounds.back(), file.begin() + size / wanted * c);
+            const char* eol = std::find(p, file.end(), '\n');
+            if (eol == file.end())
+                break;
+            bounds.push_back(eol + 1);
+        }
+        if (bounds.back() != file.end() || bounds.size() == 1)
+            bounds.push_back(file.end());
+        return bounds;
+    }
+
+    void parse(
+        const std::vector<const char*>& bounds,
+        unsigned int workers,
+        std::vector<std::vector<Line>>& lines)
+    {
+        const std::size_t chunks = lines.size();
+
+        // the number of the first line of every chunk, for the error messages
+        std::vector<LineNumber> firstLine(chunks + 1, 0);
+        parallelFor(chunks, workers, [&](unsigned int, std::size_t c) {
+            firstLine[c + 1] = std::count(bounds[c], bounds[c + 1], '\n');
+        });
+        firstLine[0] = 1;
+        for (std::size_t c = 0; c < chunks; ++c)
+            firstLine[c + 1] += firstLine[c];
+
+        std::vector<std::exception_ptr> errors(chunks);
+        std::vector<LineNumber> lastLine(chunks);
+        parallelFor(chunks, workers, [&](unsigned int, std::size_t c) {
+            EdgeListParser parser(bounds[c], bounds[c + 1], weighted, firstLine[c]);
+            Line line;
+            try
+            {
+                while (parser.next(line))
+                    lines[c].push_back(line);
+            }
+            catch (...)
+            {
+                errors[c] = std::current_exception();
+            }
+            lastLine[c] = parser.getLineNumber();
+        });
+
+        for (const auto& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+        currentLineNumber = lastLine.back();
+    }
+
+    /**
+     * Method: findRepeated
+     * --------------------
+     * Description: marks every edge that is already in an earlier line. Each thread scatters
+     * the edges of its chunks over as many buckets as threads, by key; then each thread sorts
+     * one bucket. The sort is stable and the buckets are filled in file order, so the first
+     * edge of a run of equal keys is the one that appears first in the file.
+     */
+    static void findRepeated(
+        const std::vector<std::vector<Line>>& lines,
+        bool digraph,
+        unsigned int workers,
+        std::vector<std::vector<char>>& repeated)
+    {
+        const std::size_t chunks = lines.size();
+        std::vector<std::vector<std::vector<Entry>>> scattered(
+            chunks, std::vector<std::vector<Entry>>(workers));
+
+        parallelFor(chunks, workers, [&](unsigned int, std::size_t c) {
+            for (std::size_t i = 0; i < lines[c].size(); ++i)
+            {
+                const Line& line = lines[c][i];
+                if (!line.isEdge)
+                    continue;
+                const Entry entry = {
+                    EdgeListParser::edgeKey(line, digraph), std::uint32_t(c), std::uint32_t(i)};
+                scattered[c][mix(entry.key) % workers].push_back(entry);
+            }
+        });
+
+        parallelFor(workers, workers, [&](unsigned int, std::size_t b) {
+            std::vector<Entry> bucket;
+            for (std::size_t c = 0; c < chunks; ++c)
+                bucket.insert(bucket.end(), scattered[c][b].begin(), scattered[c][b].end());
+            std::stable_sort(bucket.begin(), bucket.end());
+            for (std::size_t i = 1; i < bucket.size(); ++i)
+                if (bucket[i].key == bucket[i - 1].key)
+                    repeated[bucket[i].chunk][bucket[i].position] = 1;
+        });
+    }
+
+    // spreads the keys of a vertex over the buckets
+    static std::uint64_t mix(std::uint64_t key)
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdull;
+        key ^= key >> 33;
+        return key;
+    }
+
+    Vertex* loadVertex(Graph& g, unsigned int id)
+    {
+        Vertex* vertex = g.getVertexById(id);
+        if (vertex == nullptr)
+        {
+            vertex = new Vertex(id);
+            g.addVertex(vertex);
+        }
+
+        return vertex;
+    }
+
+    const unsigned int threads;
+    const bool weighted;
+    LineNumber currentLineNumber;
+};
+
+template <class Graph, class Vertex>
+const std::size_t ParallelEdgeListReader<Graph, Vertex>::MinChunkSize;
+
+template <class Graph, class Vertex>
+const unsigned int ParallelEdgeListReader<Graph, Vertex>::ChunksPerThread;
+}  // namespace graphpp
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "GraphExceptions.h"
+#include "ParallelEdgeListReader.h"
+
+namespace graphpp
+{
+/**
+ * Class: ParallelGraphReader
+ * --------------------------
+ * Description: Reads the same edge lists as GraphReader using several threads, see
+ * ParallelEdgeListReader. Repeated edges are ignored. Used for undirected and directed graphs.
+ */
+template <class Graph, class Vertex>
+class ParallelGraphReader : public ParallelEdgeListReader<Graph, Vertex>
+{
+public:
+    typedef typename ParallelEdgeListReader<Graph, Vertex>::Line Line;
+
+    /**
+     * Constructor
+     * -----------
+     * @param threads number of worker threads; 0 uses the hardware concurrency
+     */
+    explicit ParallelGraphReader(unsigned int threads = 0)
+        : ParallelEdgeListReader<Graph, Vertex>(threads, false)
+    {
+    }
+
+protected:
+    virtual void addEdge(Graph& g, Vertex* s, Vertex* d, const Line&, bool checked)
+    {
+        if (!checked)
+            g.addEdgeUnchecked(s, d);
+        else
+        {
+            try
+            {
+                g.addEdge(s, d);
+            }
+            catch (const DuplicateEdge& ex)
+            {
+                // throw DuplicatedEdgeLoading(getLineNumberText());
+            }
+        }
+    }
+
+    virtual void repeatedEdge(const Line&)
+    {
+    }
+};
+}  // namespace graphpp
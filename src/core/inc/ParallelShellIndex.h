@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "CompressedGraph.h"
+#include "IShellIndex.h"
+#include "Parallel.h"
+
+namespace graphpp
+{
+/**
+ * Class: ParallelShellIndex
+ * -------------------------
+ * Description: k-core decomposition for ShellIndexTypeSimple that runs on several threads.
+ * Every vertex starts with its degree and is repeatedly replaced by the h-index of the
+ * values of its neighbours (the largest h such that h neighbours have a value >= h); the
+ * values only go down and settle on the core numbers. Rounds are synchronous: a round reads
+ * the values of the previous one, so the threads never write what others read, and only the
+ * neighbours of vertices that changed are recomputed in the next round.
+ * Gives the same ShellIndexContainer as ShellIndex with ShellIndexTypeSimple.
+ */
+template <class Graph, class Vertex>
+class ParallelShellIndex : public IShellIndex<Graph, Vertex>
+{
+public:
+    typedef typename IShellIndex<Graph, Vertex>::ShellIndexContainer ShellIndexContainer;
+    typedef typename IShellIndex<Graph, Vertex>::ShellIndexIterator ShellIndexIterator;
+
+    /**
+     * Constructor
+     * -----------
+     * @param g the graph; it is frozen into a CompressedGraph first
+     * @param threads number of worker threads; 0 uses the hardware concurrency
+     */
+    ParallelShellIndex(Graph& g, unsigned int threads = 0)
+    {
+        const CompressedGraph csr(g);
+        const std::vector<unsigned int> core = coreNumbers(csr, threads);
+
+        // ids are sorted, so every insertion goes at the end of the map
+        const auto& ids = csr.getIds();
+        for (Index v = 0; v < ids.size(); ++v)
+            shellIndex.insert(shellIndex.end(), std::make_pair(ids[v], core[v]));
+    }
+
+    virtual ShellIndexIterator iterator()
+    {
+        return ShellIndexIterator(shellIndex);
+    }
+
+private:
+    typedef CompressedGraph::Index Index;
+    typedef std::pair<Index, unsigned int> Change;
+
+    /**
+     * Struct: Scratch
+     * ---------------
+     * Description: per-thread state: a histogram for the h-index and the changes and newly
+     * activated vertices found by the thread in the current round.
+     */
+    struct Scratch
+    {
+        std::vector<Index> histogram;
+        std::vector<Change> changes;
+        std::vector<Index> activated;
+    };
+
+    static std::vector<unsigned int> coreNumbers(const CompressedGraph& csr, unsigned int threads)
+    {
+        const Index n = csr.verticesCount();
+        const auto& offsets = csr.getOffsets();
+        const auto& neighbors = csr.getNeighbors();
+
+        std::vector<unsigned int> core(n);
+        unsigned int maxDegree = 0;
+        for (Index v = 0; v < n; ++v)
+        {
+            core[v] = offsets[v + 1] - offsets[v];
+            maxDegree = std::max(maxDegree, core[v]);
+        }
+
+        threads = workerCount(threads, n);
+        std::vector<Scratch> scratch(threads);
+        for (auto& s : scratch)
+            s.histogram.assign(maxDegree + 1, 0);
+        std::vector<std::atomic<unsigned char>> queued(n);
+        for (auto& q : queued)
+            q.store(0, std::memory_order_relaxed);
+
+        std::vector<Index> active(n);
+        for (Index v = 0; v < n; ++v)
+            active[v] = v;
+        std::vector<Change> changed;
+
+        while (!active.empty())
+        {
+            parallelFor(active.size(), threads, [&](unsigned int worker, std::size_t i) {
+                const Index v = active[i];
+                const unsigned int h = hIndex(csr, core, v, scratch[worker].histogram);
+                if (h < core[v])
+                    scratch[worker].changes.push_back(Change(v, h));
+            });
+
+            changed.clear();
+            for (auto& s : scratch)
+            {
+                changed.insert(changed.end(), s.changes.begin(), s.changes.end());
+                s.changes.clear();
+            }
+            for (const auto& change : changed)
+                core[change.first] = change.second;
+
+            // only neighbours above the new value of a changed vertex can go down
+            parallelFor(changed.size(), threads, [&](unsigned int worker, std::size_t i) {
+                const Index v = changed[i].first;
+                for (auto e = offsets[v]; e < offsets[v + 1]; ++e)
+                {
+                    const Index u = neighbors[e];
+                    if (core[u] > core[v] && !queued[u].exchange(1, std::memory_order_relaxed))
+                        scratch[worker].activated.push_back(u);
+                }
+            });
+
+            active.clear();
+            for (auto& s : scratch)
+            {
+                active.insert(active.end(), s.activated.begin(), s.activated.end());
+                s.activated.clear();
+            }
+            for (const Index v : active)
+                queued[v].store(0, std::memory_order_relaxed);
+        }
+
+        return core;
+    }
+
+    // h-index of the values of the neighbours of v, which is never above core[v]
+    static unsigned int hIndex(
+        const CompressedGraph& csr,
+        const std::vector<unsigned int>& core,
+        Index v,
+        std::vector<Index>& histogram)
+    {
+        const auto& offsets = csr.getOffsets();
+        const auto& neighbors = csr.getNeighbors();
+        const unsigned int k = core[v];
+
+        for (auto e = offsets[v]; e < offsets[v + 1]; ++e)
+            ++histogram[std::min(core[neighbors[e]], k)];
+
+        unsigned int h = 0;
+        Index atLeast = 0;
+        for (unsigned int i = k; i > 0; --i)
+        {
+            atLeast += histogram[i];
+            if (atLeast >= i)
+            {
+                h = i;
+                break;
+            }
+        }
+        std::fill(histogram.begin(), histogram.begin() + k + 1, 0);
+        return h;
+    }
+
+    ShellIndexContainer shellIndex;
+};
+}  // namespace graphpp
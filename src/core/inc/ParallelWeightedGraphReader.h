@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include "GraphExceptions.h"
+#include "IGraphReader.h"
+#include "ParallelEdgeListReader.h"
+
+namespace graphpp
+{
+/**
+ * Class: ParallelWeightedGraphReader
+ * ----------------------------------
+ * Description: Reads the same weighted edge lists as WeightedGraphReader using several
+ * threads, see ParallelEdgeListReader. Like WeightedGraphReader, a repeated edge throws
+ * DuplicatedEdgeLoading with its line.
+ */
+template <class Graph, class Vertex>
+class ParallelWeightedGraphReader : public ParallelEdgeListReader<Graph, Vertex>
+{
+public:
+    typedef typename ParallelEdgeListReader<Graph, Vertex>::Line Line;
+
+    /**
+     * Constructor
+     * -----------
+     * @param threads number of worker threads; 0 uses the hardware concurrency
+     */
+    explicit ParallelWeightedGraphReader(unsigned int threads = 0)
+        : ParallelEdgeListReader<Graph, Vertex>(threads, true)
+    {
+    }
+
+protected:
+    virtual void addEdge(Graph& g, Vertex* s, Vertex* d, const Line& line, bool checked)
+    {
+        if (!checked)
+            g.addEdgeUnchecked(s, d, line.weight);
+        else
+        {
+            try
+            {
+                g.addEdge(s, d, line.weight);
+            }
+            catch (const DuplicateEdge& ex)
+            {
+                repeatedEdge(line);
+            }
+        }
+    }
+
+    virtual void repeatedEdge(const Line& line)
+    {
+        throw DuplicatedEdgeLoading(this->getLineNumberText(line.number));
+    }
+};
+}  // namespace graphpp
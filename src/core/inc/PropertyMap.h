@@ -1,10 +1,242 @@
 #pragma once
 
 #include <sstream> // Required to avoid compilation issue with ctype_base library.
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "GraphExceptions.h"
 #include "mili/mili.h"
 
+/**
+ * Exception: PropertyTypeMismatch
+ * -------------------------------
+ * Description: Exception used when a property is accessed with another type, or as a typed
+ * column when it was created with addProperty (or the other way around)
+ */
+DEFINE_SPECIFIC_EXCEPTION_TEXT(
+    PropertyTypeMismatch, GraphExceptionHierarchy,
+    "The property was created with another type");
+
 namespace graphpp
 {
+/**
+ * Class: PropertySeries
+ * ---------------------
+ * Description: values keyed by an unsigned integer, a degree or a vertex id, kept sorted by
+ * key in a flat vector of pairs. The metric loops produce their keys in increasing order, so
+ * setting them is an append; other keys are inserted in place. Lookups are binary searches.
+ * Iteration goes in numeric key order (a VariantsSet goes in string order, "10" < "9").
+ * Iterators give mutable values; the keys must not be changed through them.
+ */
+template <class T>
+class PropertySeries
+{
+public:
+    typedef unsigned int Key;
+    typedef std::pair<Key, T> Entry;
+    typedef typename std::vector<Entry>::iterator iterator;
+    typedef typename std::vector<Entry>::const_iterator const_iterator;
+
+    /**
+     * Method: operator[]
+     * ------------------
+     * @returns the value of a key, inserted as T() if the key is not there
+     */
+    T& operator[](Key key)
+    {
+        if (entries.empty() || entries.back().first < key)
+        {
+            entries.emplace_back(key, T());
+            return entries.back().second;
+        }
+        auto it = std::lower_bound(entries.begin(), entries.end(), key, keyLess);
+        if (it->first != key)
+            it = entries.insert(it, Entry(key, T()));
+        return it->second;
+    }
+
+    void set(Key key, const T& value)
+    {
+        (*this)[key] = value;
+    }
+
+    /**
+     * Method: find
+     * ------------
+     * @returns the value of a key, or nullptr if the key is not there
+     */
+    const T* find(Key key) const
+    {
+        auto it = std::lower_bound(entries.begin(), entries.end(), key, keyLess);
+        return it == entries.end() || it->first != key ? nullptr : &it->second;
+    }
+
+    bool contains(Key key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    /**
+     * Method: get
+     * -----------
+     * @returns the value of a key; throws BadElementName, as VariantsSet does, if there is
+     * none
+     */
+    const T& get(Key key) const
+    {
+        const T* value = find(key);
+        if (value == nullptr)
+            throw BadElementName();
+        return *value;
+    }
+
+    void reserve(std::size_t size)
+    {
+        entries.reserve(size);
+    }
+
+    std::size_t size() const
+    {
+        return entries.size();
+    }
+
+    bool empty() const
+    {
+        return entries.empty();
+    }
+
+    void clear()
+    {
+        entries.clear();
+    }
+
+    iterator begin()
+    {
+        return entries.begin();
+    }
+
+    iterator end()
+    {
+        return entries.end();
+    }
+
+    const_iterator begin() const
+    {
+        return entries.begin();
+    }
+
+    const_iterator end() const
+    {
+        return entries.end();
+    }
+
+private:
+    static bool keyLess(const Entry& entry, Key key)
+    {
+        return entry.first < key;
+    }
+
+    std::vector<Entry> entries;
+};
+
+/**
+ * Class: VertexProperty
+ * ---------------------
+ * Description: one value per vertex, in a dense array indexed by vertex id, plus a flag per
+ * id telling which vertices have a value. Meant for the compact ids the readers and
+ * generators produce: the arrays are as long as the largest id.
+ */
+template <class T>
+class VertexProperty
+{
+public:
+    typedef unsigned int VertexId;
+
+    void set(VertexId id, const T& value)
+    {
+        if (id >= values.size())
+        {
+            values.resize(std::size_t(id) + 1);
+            present.resize(std::size_t(id) + 1, false);
+        }
+        if (!present[id])
+        {
+            present[id] = true;
+            ++count;
+        }
+        values[id] = value;
+    }
+
+    bool contains(VertexId id) const
+    {
+        return id < present.size() && present[id];
+    }
+
+    /**
+     * Method: get
+     * -----------
+     * @returns the value of a vertex; throws BadElementName if it has none
+     */
+    const T& get(VertexId id) const
+    {
+        if (!contains(id))
+            throw BadElementName();
+        return values[id];
+    }
+
+    /**
+     * Method: forEach
+     * ---------------
+     * Description: calls f(id, value) for every vertex with a value, in increasing id order
+     */
+    template <class F>
+    void forEach(F f) const
+    {
+        for (VertexId id = 0; id < values.size(); ++id)
+            if (present[id])
+                f(id, values[id]);
+    }
+
+    void reserve(std::size_t ids)
+    {
+        values.reserve(ids);
+        present.reserve(ids);
+    }
+
+    std::size_t size() const
+    {
+        return count;
+    }
+
+    void clear()
+    {
+        values.clear();
+        present.clear();
+        count = 0;
+    }
+
+private:
+    std::vector<T> values;
+    std::vector<bool> present;
+    std::size_t count = 0;
+};
+
+/**
+ * Class: PropertyMap
+ * ------------------
+ * Description: named metric values. The typed columns, series (keyed by degree) and
+ * vertexProperty (keyed by vertex id), keep the values as numbers and are what the metric
+ * code fills and reads. addProperty and getProperty keep the older string-keyed sets, for
+ * values that are not keyed by a number; getPropertySet, containsProperty and getProperty
+ * also read the typed columns, through a VariantsSet view built on demand, so that the
+ * exporters and plotters taking a VariantsSet work with both kinds of property.
+ */
 class PropertyMap
 {
 public:
@@ -12,9 +244,36 @@ public:
     typedef std::string Id;
     typedef std::map<PropertyName, VariantsSet> Properties;
 
+    /**
+     * Method: series
+     * --------------
+     * @returns the per-degree series with the given name, created empty if it does not exist;
+     * throws PropertyTypeMismatch if the name holds something else
+     */
+    template <typename PropertyType>
+    PropertySeries<PropertyType>& series(const PropertyName& name)
+    {
+        return column<SeriesColumn<PropertyType>>(name).data;
+    }
+
+    /**
+     * Method: vertexProperty
+     * ----------------------
+     * @returns the per-vertex property with the given name, created empty if it does not
+     * exist; throws PropertyTypeMismatch if the name holds something else
+     */
+    template <typename PropertyType>
+    VertexProperty<PropertyType>& vertexProperty(const PropertyName& name)
+    {
+        return column<VertexColumn<PropertyType>>(name).data;
+    }
+
     template <typename PropertyType>
     void addProperty(const PropertyName& name, Id id, PropertyType value)
     {
+        if (columns.count(name) > 0)
+            throw PropertyTypeMismatch();
+
         auto search = properties.find(name);
 
         if (search == properties.end())
@@ -34,24 +293,47 @@ public:
     template <typename PropertyType>
     PropertyType getProperty(const PropertyName& name, const Id id)
     {
-        return getPropertySet(name).get_element<PropertyType>(id);
+        auto typed = columns.find(name);
+        if (typed == columns.end())
+            return getPropertySet(name).get_element<PropertyType>(id);
+
+        std::string value;
+        if (!typed->second->find(id, value))
+            throw BadElementName();
+        return from_string<PropertyType>(value);
     }
 
     // TODO method should be const
     // FIXME this method causes segmentation fault when property name does not exists on map!!
+    // For a typed column the set is rebuilt on every call.
     VariantsSet& getPropertySet(const PropertyName& name)
     {
+        auto typed = columns.find(name);
+        if (typed != columns.end())
+        {
+            VariantsSet& view = views[name];
+            view.clear();
+            typed->second->toVariants(view);
+            return view;
+        }
         return properties.find(name)->second;
     }
 
     bool containsPropertySet(const PropertyName& name) const
     {
-        return properties.count(name) > 0;
+        return properties.count(name) > 0 || columns.count(name) > 0;
     }
 
     // TODO method should be const
     bool containsProperty(const PropertyName& name, const Id id)
     {
+        auto typed = columns.find(name);
+        if (typed != columns.end())
+        {
+            std::string value;
+            return typed->second->find(id, value);
+        }
+
         auto search = properties.find(name);
         if (search == properties.end())
             return false;
@@ -61,13 +343,103 @@ public:
     void clear()
     {
         properties.clear();
+        columns.clear();
+        views.clear();
     }
 
     void deleteProperty(const PropertyName& name) {
         properties.erase(name);
+        columns.erase(name);
+        views.erase(name);
     }
 
 private:
+    // a typed property, seen through strings by the VariantsSet accessors
+    class Column
+    {
+    public:
+        virtual ~Column() {}
+        virtual void toVariants(VariantsSet& set) const = 0;
+        // the value of a key as a string; false if there is none
+        virtual bool find(const Id& id, std::string& value) const = 0;
+
+    protected:
+        static bool parseKey(const Id& id, unsigned int& key)
+        {
+            char* end = nullptr;
+            errno = 0;
+            const unsigned long parsed = std::strtoul(id.c_str(), &end, 10);
+            if (id.empty() || id[0] == '-' || *end != '\0' || errno != 0 || parsed > UINT_MAX)
+                return false;
+            key = (unsigned int)parsed;
+            return true;
+        }
+    };
+
+    template <typename PropertyType>
+    class SeriesColumn : public Column
+    {
+    public:
+        void toVariants(VariantsSet& set) const override
+        {
+            for (const auto& entry : data)
+                set.insert<PropertyType>(to_string<unsigned int>(entry.first), entry.second);
+        }
+
+        bool find(const Id& id, std::string& value) const override
+        {
+            unsigned int key;
+            const PropertyType* found = parseKey(id, key) ? data.find(key) : nullptr;
+            if (found != nullptr)
+                value = to_string<PropertyType>(*found);
+            return found != nullptr;
+        }
+
+        PropertySeries<PropertyType> data;
+    };
+
+    template <typename PropertyType>
+    class VertexColumn : public Column
+    {
+    public:
+        void toVariants(VariantsSet& set) const override
+        {
+            data.forEach([&set](unsigned int id, const PropertyType& value) {
+                set.insert<PropertyType>(to_string<unsigned int>(id), value);
+            });
+        }
+
+        bool find(const Id& id, std::string& value) const override
+        {
+            unsigned int key;
+            const bool found = parseKey(id, key) && data.contains(key);
+            if (found)
+                value = to_string<PropertyType>(data.get(key));
+            return found;
+        }
+
+        VertexProperty<PropertyType> data;
+    };
+
+    template <class ColumnType>
+    ColumnType& column(const PropertyName& name)
+    {
+        auto it = columns.find(name);
+        if (it == columns.end())
+        {
+            if (properties.count(name) > 0)
+                throw PropertyTypeMismatch();
+            it = columns.emplace(name, std::unique_ptr<Column>(new ColumnType())).first;
+        }
+        ColumnType* typed = dynamic_cast<ColumnType*>(it->second.get());
+        if (typed == nullptr)
+            throw PropertyTypeMismatch();
+        return *typed;
+    }
+
     Properties properties;
+    std::map<PropertyName, std::unique_ptr<Column>> columns;
+    // VariantsSet views of the typed columns, returned by getPropertySet
+    Properties views;
 };
 }  // namespace graphpp
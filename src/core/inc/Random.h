@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace graphpp
+{
+/**
+ * Class: Random
+ * -------------
+ * Description: xoshiro256** generator (Blackman and Vigna): 256 bits of state and a few
+ * shifts, rotations and a multiplication per 64-bit draw. jump advances the state by 2^128
+ * draws, so one seed splits into streams that never overlap, one per thread or per block of
+ * work. The state is filled from the seed with splitmix64, so every seed, 0 included, is a
+ * good one. It is a UniformRandomBitGenerator, but uniform and below are preferred: unlike
+ * the std distributions they give the same numbers on every standard library.
+ * A generator must not be shared between threads; give each one its own stream.
+ */
+class Random
+{
+public:
+    typedef std::uint64_t result_type;
+
+    explicit Random(std::uint64_t seed = 0)
+    {
+        for (auto& word : state)
+        {
+            seed += 0x9e3779b97f4a7c15ull;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    /**
+     * Method: seedFromRand
+     * --------------------
+     * Description: a 64-bit seed made of two rand() draws, for the callers that take no seed;
+     * srand still reproduces what they generate
+     */
+    static std::uint64_t seedFromRand()
+    {
+        const std::uint64_t seedLow = rand();
+        const std::uint64_t seedHigh = rand();
+        return seedHigh << 32 | seedLow;
+    }
+
+    static constexpr result_type min()
+    {
+        return 0;
+    }
+
+    static constexpr result_type max()
+    {
+        return UINT64_MAX;
+    }
+
+    result_type operator()()
+    {
+        const std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const std::uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    /**
+     * Method: uniform
+     * ---------------
+     * @returns a double in [0, 1) with the 53 high bits of a draw
+     */
+    double uniform()
+    {
+        return ((*this)() >> 11) * (1.0 / (std::uint64_t(1) << 53));
+    }
+
+    /**
+     * Method: below
+     * -------------
+     * @returns an integer in [0, bound), bound > 0. It is the draw modulo bound: the bias is
+     * below bound / 2^64.
+     */
+    std::uint64_t below(std::uint64_t bound)
+    {
+        return (*this)() % bound;
+    }
+
+    /**
+     * Method: jump
+     * ------------
+     * Description: advances the generator as 2^128 draws would
+     */
+    void jump()
+    {
+        static const std::uint64_t Jump[] = {0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+                                             0xa9582618e03fc9aaull, 0x39abdc4529b1661cull};
+        std::uint64_t jumped[4] = {0, 0, 0, 0};
+        for (std::uint64_t word : Jump)
+        {
+            for (unsigned int bit = 0; bit < 64; bit++)
+            {
+                if (word & (std::uint64_t(1) << bit))
+                    for (unsigned int i = 0; i < 4; i++)
+                        jumped[i] ^= state[i];
+                (*this)();
+            }
+        }
+        for (unsigned int i = 0; i < 4; i++)
+            state[i] = jumped[i];
+    }
+
+    /**
+     * Method: streams
+     * ---------------
+     * Description: splits the generator into independent streams: the first one is a copy of
+     * this generator and each next one is jumped ahead of the previous one
+     * @param count number of streams
+     */
+    std::vector<Random> streams(std::size_t count) const
+    {
+        std::vector<Random> ret;
+        ret.reserve(count);
+        Random next = *this;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            ret.push_back(next);
+            next.jump();
+        }
+        return ret;
+    }
+
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::uint64_t state[4];
+};
+}  // namespace graphpp
@@ -1,217 +1,271 @@
 #pragma once
 
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "IShellIndex.h"
 #include "IShellIndexNode.h"
-#include "ShellIndexSimpleNode.h"
-#include "ShellIndexDirectedNode.h"
-#include "ShellIndexWeightedNode.h"
+#include "JobControl.h"
 #include "typedefs.h"
 
-namespace graphpp {
-
-    template<class Graph, class Vertex>
-    class ShellIndex : public IShellIndex<Graph, Vertex> {
-    public:
-        typedef typename IShellIndex<Graph, Vertex>::ShellIndexContainer ShellIndexContainer;
-        typedef typename IShellIndex<Graph, Vertex>::ShellIndexIterator ShellIndexIterator;
-
-        ShellIndex(Graph &g, ShellIndexType type) {
-            shellIndexType = type;
-            totalVertexes = initMap(g);
-            if (type == ShellIndexTypeWeightedEqualStrength) {
-                getEqualStrengthBinning(g);
-            } else if (type == ShellIndexTypeWeightedEqualPopulation) {
-                getEqualPopulationBinning(g);
-            }
-            initMultimapSet(g, type);
-            calculateShellIndex();
-        }
+namespace graphpp
+{
+/**
+ * Class: ShellIndex
+ * -----------------
+ * Description: k-core decomposition with the Batagelj-Zaversnik bucket algorithm. Vertices
+ * get a dense index; their current degree (or strength bin) and the vertices to update when
+ * they are removed live in flat arrays. vert holds the vertices sorted by current degree,
+ * binStart the first position of every degree and pos the position of each vertex, so
+ * lowering a degree by one is a swap with the first vertex of its bin: O(n + m) overall.
+ *
+ * Simple: the degree, neighbours are updated on removal.
+ * In/out degree: the in (out) degree; removing a vertex lowers the in (out) degree of the
+ * vertices it points to (is pointed from), which gives the (k,0) ((0,l)) cores.
+ * Weighted: the strength is binned in weightedEqualStrengthBins bins, by equal strength or
+ * equal population; removal subtracts the edge weight and may drop several bins at once.
+ */
+template <class Graph, class Vertex>
+class ShellIndex : public IShellIndex<Graph, Vertex>
+{
+public:
+    typedef typename IShellIndex<Graph, Vertex>::ShellIndexContainer ShellIndexContainer;
+    typedef typename IShellIndex<Graph, Vertex>::ShellIndexIterator ShellIndexIterator;
 
-        virtual ShellIndexIterator iterator() {
-            return ShellIndexIterator(shellIndex);
+    ShellIndex(Graph& g, ShellIndexType type) : weighted(false)
+    {
+        indexVertices(g);
+        switch (type)
+        {
+            case ShellIndexTypeWeightedEqualStrength:
+            case ShellIndexTypeWeightedEqualPopulation:
+                loadWeighted(type);
+                break;
+            case ShellIndexTypeInDegree:
+            case ShellIndexTypeOutDegree:
+                loadDirected(type);
+                break;
+            default:
+                loadSimple();
         }
+        decompose();
 
-    private:
+        std::vector<std::pair<typename Vertex::VertexId, unsigned int>> sorted;
+        sorted.reserve(vertices.size());
+        for (Index v = 0; v < vertices.size(); ++v)
+            sorted.emplace_back(vertices[v]->getVertexId(), key[v]);
+        std::sort(sorted.begin(), sorted.end());
+        for (const auto& entry : sorted)
+            shellIndex.insert(shellIndex.end(), entry);
+    }
 
+    virtual ShellIndexIterator iterator()
+    {
+        return ShellIndexIterator(shellIndex);
+    }
 
-        INode<Graph, Vertex> *getNextNode() {
-            int iterationLimit = totalVertexes;
-            if (shellIndexType == ShellIndexTypeWeightedEqualStrength) {
-                iterationLimit = weightedEqualStrengthBins;
-            }
+private:
+    typedef unsigned int Index;
 
-            for (int i = 0; i < iterationLimit; i++) {
-                if (!nodesByCurrentDegree[i].empty()) {
-                    return nodesByCurrentDegree[i].front();
-                }
-            }
-            return nullptr;
+    void indexVertices(Graph& g)
+    {
+        auto it = g.verticesConstIterator();
+        while (!it.end())
+        {
+            Vertex* v = *it;
+            indexById[v->getVertexId()] = vertices.size();
+            vertices.push_back(v);
+            ++it;
         }
+    }
 
-        void calculateShellIndex() {
-            int k = 0;
-            // While there are remaining vertices in the graph
-            // Select the vertex with the lowest current degree
-            while (getNextNode() != nullptr) {
-                INode<Graph, Vertex> *nextNode = getNextNode();
-                int degree = nextNode->getDegree();
-
-                // If the degree is higher than k, then we have a new higher k-core
-                // If lower, then it belongs to the actual k-core
-                if (degree > k) {
-                    k = degree;
-                }
-                // Setting the coreness as the current k.
-                shellIndex[nextNode->getVertexId()] = k;
-                // Will mark it as removed from the structure, since the coreness is already calculated
-                nodesByVertexId[nextNode->getVertexId()]->markAsRemove();
-                nodesByCurrentDegree[degree].remove(nextNode);
-                NeighbourIdsIterator neighborsIt = nextNode->getNeighbourIdsIterator();
-                // Iterate through each of it's neighbors to reduce their degree by 1, since v was
-                // removed.
-                for (auto neighbourId: neighborsIt) {
-                    // Get the vertex node to be able to lower it one level in the structure
-                    INode<Graph, Vertex> *neighNode = nodesByVertexId[neighbourId];
-
-                    if (neighNode->getDegree() > 0) {
-                        // Remove it from the current level
-                        nodesByCurrentDegree[neighNode->getDegree()].remove(neighNode);
-                        neighNode->decreaseDegree(nextNode->getVertexId());
-
-                        if (neighNode->getDegree() > 0) {
-                            // Re add it to a lower level if it still has a valid degree
-                            nodesByCurrentDegree[neighNode->getDegree()].push_back(neighNode);
-                        } else {
-                            // Remove it and set coreness if the degree dropped to 0
-                            shellIndex[neighNode->getVertexId()] = k;
-                        }
-                    }
-                }
-            }
+    template <class Iterator>
+    void addNeighbours(Iterator it)
+    {
+        while (!it.end())
+        {
+            notify.push_back(indexById[(*it)->getVertexId()]);
+            ++it;
         }
+        notifyOffsets.push_back(notify.size());
+    }
 
-        int initMap(Graph &g) {
-            VerticesConstIterator it = g.verticesConstIterator();
-            int total = 0;
-
-            // initialize all elements in zero
-            while (!it.end()) {
-                Vertex *v = *it;
-                shellIndex.insert(
-                        std::pair<typename Vertex::VertexId, unsigned int>(v->getVertexId(), 0));
-                ++it;
-                total++;
-            }
-
-            return total;
+    void loadSimple()
+    {
+        notifyOffsets.assign(1, 0);
+        for (Vertex* v : vertices)
+        {
+            key.push_back(v->degree());
+            addNeighbours(v->neighborsConstIterator());
         }
+    }
 
-        void initMultimapSet(Graph &g, ShellIndexType type) {
-            VerticesConstIterator it = g.verticesConstIterator();
-            nodesByVertexId = new INode<Graph, Vertex> *[totalVertexes + 1];  // will not use index 0
-
-            if (type == ShellIndexTypeWeightedEqualPopulation || type == ShellIndexTypeWeightedEqualStrength) {
-                nodesByCurrentDegree =
-                        new std::list<INode<Graph, Vertex> *>[totalVertexes > weightedEqualStrengthBins ? totalVertexes
-                                                                                                        : weightedEqualStrengthBins];
-            } else {
-                nodesByCurrentDegree =
-                        new std::list<INode<Graph, Vertex> *>[totalVertexes];
+    void loadDirected(ShellIndexType type)
+    {
+        notifyOffsets.assign(1, 0);
+        for (Vertex* v : vertices)
+        {
+            DirectedVertex* directedVertex = reinterpret_cast<DirectedVertex*>(v);
+            if (type == ShellIndexTypeInDegree)
+            {
+                key.push_back(directedVertex->inDegree());
+                addNeighbours(directedVertex->outNeighborsConstIterator());
             }
-            // initialize all elements using the vertex id and the vertex degree
-            while (!it.end()) {
-                Vertex *v = *it;
-                INode<Graph, Vertex> *newNode = getNodeFromType(v, type);//new Node();
-                nodesByVertexId[newNode->getVertexId()] = newNode;
-                unsigned int nodeDegree = (unsigned int) (newNode->getDegree());
-                nodesByCurrentDegree[nodeDegree].push_back(newNode);
-                ++it;
+            else
+            {
+                key.push_back(directedVertex->outDegree());
+                addNeighbours(directedVertex->inNeighborsConstIterator());
             }
         }
+    }
 
-        INode<Graph, Vertex> *getNodeFromType(Vertex *v, ShellIndexType type) {
-            switch (type) {
-                case ShellIndexTypeWeightedEqualStrength:{
-                    return new WeightedNode<Graph, Vertex>(v, type, weightedBinsLimitsEqStrength);
-                }
-                case ShellIndexTypeWeightedEqualPopulation: {
-                    return new WeightedNode<Graph, Vertex>(v, type, weightedBinsLimitsEqPopulation);
-                }
-                case ShellIndexTypeInDegree:
-                case ShellIndexTypeOutDegree: {
-                    return new DirectedNode<Graph, Vertex>(v, type);
-                }
-                default:{
-                    return new SimpleNode<Graph, Vertex>(v, type);
-                }
-            }
+    void loadWeighted(ShellIndexType type)
+    {
+        weighted = true;
+        notifyOffsets.assign(1, 0);
+        for (Vertex* v : vertices)
+        {
+            WeightedVertex* weightedVertex = reinterpret_cast<WeightedVertex*>(v);
+            strength.push_back(weightedVertex->strength());
+            addNeighbours(weightedVertex->neighborsConstIterator());
+            for (unsigned int slot = 0; slot < weightedVertex->degree(); ++slot)
+                notifyWeights.push_back(weightedVertex->edgeWeightAt(slot));
         }
 
-        void getEqualStrengthBinning(Graph g) {
-            VerticesConstIterator it = g.verticesConstIterator();
-            double maxStrength = 0;
-            while (!it.end()) {
-                WeightedVertex *weightedVertex = reinterpret_cast<WeightedVertex *>(*it);
-                if (weightedVertex->getInitialStrength() > maxStrength) {
-                    maxStrength = weightedVertex->getInitialStrength();
-                }
-                ++it;
-            }
-            weightedBinsLimitsEqStrength   = new std::vector<double>(0);
-            for (double bin = 1; bin <= weightedEqualStrengthBins; bin++) {
-                // In case the bucket is at a double value, it is casted to the closest integer
-                weightedBinsLimitsEqStrength->push_back(maxStrength * bin / weightedEqualStrengthBins);
-            }
+        if (type == ShellIndexTypeWeightedEqualStrength)
+            equalStrengthBinning();
+        else
+            equalPopulationBinning();
+
+        for (const double s : strength)
+            key.push_back(strengthToBin(s));
+    }
+
+    void equalStrengthBinning()
+    {
+        double maxStrength = 0;
+        for (const double s : strength)
+            maxStrength = std::max(maxStrength, s);
+        for (double bin = 1; bin <= weightedEqualStrengthBins; bin++)
+            binLimits.push_back(maxStrength * bin / weightedEqualStrengthBins);
+    }
+
+    void equalPopulationBinning()
+    {
+        std::vector<double> sorted(strength);
+        std::sort(sorted.begin(), sorted.end());
+        if (sorted.empty())
+            return;
+        for (double bin = 1; bin < weightedEqualStrengthBins; bin++)
+        {
+            // In case the bucket is at a double value, it is casted to the closest integer
+            const Index borderVertexIndex = sorted.size() * bin / weightedEqualStrengthBins;
+            binLimits.push_back((unsigned int)(sorted[borderVertexIndex]));
         }
+    }
 
-        void getEqualPopulationBinning(Graph g) {
-            std::vector<WeightedVertex *> *weightedVertexVector = new std::vector<WeightedVertex *>(0);
-            VerticesConstIterator it = g.verticesConstIterator();
-            while (!it.end()) {
-                WeightedVertex *weightedVertex = reinterpret_cast<WeightedVertex *>(*it);
-                weightedVertexVector->push_back(weightedVertex);
-                ++it;
-            }
+    unsigned int strengthToBin(double s) const
+    {
+        unsigned int bin = 1;
+        while (bin < binLimits.size() && s > binLimits[bin])
+            bin++;
+        return bin;
+    }
 
-            std::sort(weightedVertexVector->begin(), weightedVertexVector->end(), weightedVertexComparator);
+    /**
+     * Method: decompose
+     * -----------------
+     * Description: processes the vertices by increasing current key. When a vertex is taken
+     * its key is its core number; the keys of the vertices it notifies are lowered, but never
+     * below the key being processed, so the order of vert stays valid.
+     */
+    void decompose()
+    {
+        const Index n = vertices.size();
+        unsigned int maxKey = 0;
+        for (const unsigned int k : key)
+            maxKey = std::max(maxKey, k);
 
-            weightedBinsLimitsEqPopulation = new std::vector<double>(0);
-            for (double bin = 1; bin < weightedEqualStrengthBins; bin++) {
-                unsigned int borderVertexIndex =  (totalVertexes * bin / weightedEqualStrengthBins);
-                weightedBinsLimitsEqPopulation->push_back(
-                        (unsigned int) (weightedVertexVector->at(borderVertexIndex)->getInitialStrength()));
-            }
+        // counting sort of the vertices by key
+        binStart.assign(maxKey + 2, 0);
+        for (const unsigned int k : key)
+            ++binStart[k + 1];
+        for (unsigned int k = 0; k <= maxKey; ++k)
+            binStart[k + 1] += binStart[k];
+        vert.resize(n);
+        pos.resize(n);
+        std::vector<Index> next(binStart.begin(), binStart.end() - 1);
+        for (Index v = 0; v < n; ++v)
+        {
+            pos[v] = next[key[v]]++;
+            vert[pos[v]] = v;
         }
 
-        struct {
-            bool operator()(WeightedVertex *first, WeightedVertex *second) const{
-                return (first->getInitialStrength() < second->getInitialStrength());
+        for (Index i = 0; i < n; ++i)
+        {
+            if (i % 4096 == 0)
+                JobControl::progress(i, n);
+            const Index v = vert[i];
+            for (auto e = notifyOffsets[v]; e < notifyOffsets[v + 1]; ++e)
+            {
+                const Index u = notify[e];
+                if (pos[u] <= i)
+                    continue;
+
+                unsigned int target = key[u] > 0 ? key[u] - 1 : 0;
+                if (weighted)
+                {
+                    strength[u] -= notifyWeights[e];
+                    target = strengthToBin(strength[u]);
+                }
+                target = std::max(target, key[v]);
+                while (key[u] > target)
+                    moveDown(u);
             }
-        }weightedVertexComparator;
+        }
+    }
 
+    // Moves u to the end of the bin below: swap it with the first vertex of its bin, then
+    // shift the start of the bin by one.
+    void moveDown(Index u)
+    {
+        const unsigned int k = key[u];
+        const Index first = binStart[k];
+        const Index w = vert[first];
+        if (u != w)
+        {
+            vert[pos[u]] = w;
+            pos[w] = pos[u];
+            vert[first] = u;
+            pos[u] = first;
+        }
+        ++binStart[k];
+        --key[u];
+    }
 
-        //TO CALL SORT --> list.sort(compareNodes);
+    // This container will be set with the coreness of each vertex when found.
+    ShellIndexContainer shellIndex;
 
-        typedef typename Graph::VerticesConstIterator VerticesConstIterator;
+    std::vector<Vertex*> vertices;
+    std::unordered_map<typename Vertex::VertexId, Index> indexById;
 
-        // This container will be set with the coreness of each vertex when found.
-        ShellIndexContainer shellIndex;
+    // current degree or strength bin of every vertex; the core number once processed
+    std::vector<unsigned int> key;
+    // vertices whose key may drop when a vertex is removed, in CSR layout
+    std::vector<std::size_t> notifyOffsets;
+    std::vector<Index> notify;
+    std::vector<double> notifyWeights;
 
-        // This structure represents an array of node pointers.
-        // This nodes are the different node-vertexes in the main structure
-        // The index of the array represents the id of the node.
-        // Used to get the node structure in O(1), to allow it to be moved to another list.
-        INode<Graph, Vertex> **nodesByVertexId;
-        // This is the main structure, contains an array of linked lists.
-        // The index of the array represents the current degree of the vertexes stored on that list.
-        // The lists are doubly-linked lists to allow a node representation to be easily removed.
-        std::list<INode<Graph, Vertex> *> *nodesByCurrentDegree;
-        int totalVertexes;
-        std::vector<double> * weightedBinsLimitsEqStrength;
-        std::vector<double> * weightedBinsLimitsEqPopulation;
+    std::vector<Index> vert;
+    std::vector<Index> pos;
+    std::vector<Index> binStart;
 
-        const int weightedEqualStrengthBins = 10;
+    bool weighted;
+    std::vector<double> strength;
+    std::vector<double> binLimits;
 
-        ShellIndexType shellIndexType;
-    };
+    const int weightedEqualStrengthBins = 10;
+};
 }  // namespace graphpp
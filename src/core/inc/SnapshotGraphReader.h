@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include "GraphExceptions.h"
+#include "SnapshotReader.h"
+
+namespace graphpp
+{
+/**
+ * Class: SnapshotGraphReader
+ * --------------------------
+ * Description: Reads a GraphSnapshot into an unweighted or directed graph. The weights of a
+ * weighted snapshot are ignored. Like GraphReader, repeated edges are ignored when the graph
+ * is not a multigraph.
+ */
+template <class Graph, class Vertex>
+class SnapshotGraphReader : public SnapshotReader<Graph, Vertex>
+{
+protected:
+    virtual void check(const GraphSnapshot&, const std::string&)
+    {
+    }
+
+    virtual void addEntry(Vertex* s, Vertex* d, const GraphSnapshot&, std::uint64_t)
+    {
+        s->addEdge(d);
+    }
+
+    virtual void addEdge(Graph& g, Vertex* s, Vertex* d, const GraphSnapshot&, std::uint64_t)
+    {
+        try
+        {
+            g.addEdge(s, d);
+        }
+        catch (const DuplicateEdge& ex)
+        {
+        }
+    }
+
+    virtual void repeatedEntry(const std::string&)
+    {
+    }
+};
+}  // namespace graphpp
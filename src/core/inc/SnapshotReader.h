@@ -0,0 +1,114 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "GraphSnapshot.h"
+#include "IGraphReader.h"
+#include "JobControl.h"
+
+namespace graphpp
+{
+/**
+ * Class: SnapshotReader
+ * ---------------------
+ * Description: Base of the readers of GraphSnapshot files. The snapshot is mapped and its
+ * arrays are walked once: vertices are created in the stored order and every neighbour list
+ * is rebuilt entry by entry, so no duplicate checks or lookups are needed. A directed
+ * snapshot read into an undirected graph adds each arc as an edge instead, ignoring the
+ * ones already present. A multigraph snapshot read into a graph that is not one may repeat
+ * a neighbour in a list: only the first entry is added and the others are passed to
+ * repeatedEntry. Subclasses add the entries to the vertices.
+ */
+template <class Graph, class Vertex>
+class SnapshotReader : public IGraphReader<Graph, Vertex>
+{
+public:
+    virtual void read(Graph& g, std::string source)
+    {
+        const GraphSnapshot snapshot(source);
+        check(snapshot, source);
+
+        const std::uint64_t n = snapshot.verticesCount();
+        std::vector<Vertex*> vertices(n);
+        for (std::uint64_t v = 0; v < n; ++v)
+            vertices[v] = loadVertex(g, snapshot.id(v));
+
+        const bool asEdges = snapshot.isDirected() && !g.isDigraph();
+        const bool repeats = snapshot.isMultigraph() && !g.isMultigraph() && !asEdges;
+        // lastList[u] == v if u is already in the list of v; an undirected loop is two entries
+        std::vector<std::uint64_t> lastList(repeats ? n : 0, n);
+        const unsigned int loopEntries = g.isDigraph() ? 1 : 2;
+        for (std::uint64_t v = 0; v < n; ++v)
+        {
+            if (v % 4096 == 0)
+                JobControl::progress(v, n);
+            const GraphSnapshot::Offset first = snapshot.offset(v);
+            const GraphSnapshot::Offset last = snapshot.offset(v + 1);
+            if (last < first || last > snapshot.entriesCount())
+                throw MalformedSnapshotException(source);
+
+            unsigned int loops = 0;
+            for (GraphSnapshot::Offset e = first; e < last; ++e)
+            {
+                const GraphSnapshot::Id u = snapshot.neighbor(e);
+                if (u >= n)
+                    throw MalformedSnapshotException(source);
+                if (asEdges)
+                    addEdge(g, vertices[v], vertices[u], snapshot, e);
+                else if (repeats && (u == v ? ++loops > loopEntries : lastList[u] == v))
+                    repeatedEntry(source);
+                else
+                {
+                    if (repeats)
+                        lastList[u] = v;
+                    addEntry(vertices[v], vertices[u], snapshot, e);
+                }
+            }
+        }
+    }
+
+protected:
+    /**
+     * Method: check
+     * -------------
+     * Description: rejects snapshots that lack what the graph needs
+     */
+    virtual void check(const GraphSnapshot& snapshot, const std::string& source) = 0;
+
+    /**
+     * Method: addEntry
+     * ----------------
+     * Description: appends entry e of the snapshot to the neighbour list of s only
+     */
+    virtual void addEntry(Vertex* s, Vertex* d, const GraphSnapshot& snapshot, std::uint64_t e) = 0;
+
+    /**
+     * Method: addEdge
+     * ---------------
+     * Description: adds entry e of a directed snapshot as an edge of an undirected graph
+     */
+    virtual void addEdge(
+        Graph& g, Vertex* s, Vertex* d, const GraphSnapshot& snapshot, std::uint64_t e) = 0;
+
+    /**
+     * Method: repeatedEntry
+     * ---------------------
+     * Description: called instead of addEntry for an entry repeating an earlier one of its
+     * list, when a multigraph snapshot is read into a graph that is not a multigraph
+     */
+    virtual void repeatedEntry(const std::string& source) = 0;
+
+private:
+    Vertex* loadVertex(Graph& g, unsigned int id)
+    {
+        Vertex* vertex = g.getVertexById(id);
+        if (vertex == nullptr)
+        {
+            vertex = new Vertex(id);
+            g.addVertex(vertex);
+        }
+
+        return vertex;
+    }
+};
+}  // namespace graphpp
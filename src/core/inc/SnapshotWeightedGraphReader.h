@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include "GraphExceptions.h"
+#include "SnapshotReader.h"
+
+namespace graphpp
+{
+/**
+ * Class: SnapshotWeightedGraphReader
+ * ----------------------------------
+ * Description: Reads a GraphSnapshot into a weighted graph. The snapshot must have weights.
+ * Like WeightedGraphReader, a repeated edge is an error when the graph is not a multigraph.
+ */
+template <class Graph, class Vertex>
+class SnapshotWeightedGraphReader : public SnapshotReader<Graph, Vertex>
+{
+protected:
+    virtual void check(const GraphSnapshot& snapshot, const std::string& source)
+    {
+        if (!snapshot.isWeighted())
+            throw MalformedSnapshotException(source + ": the snapshot has no weights");
+    }
+
+    virtual void addEntry(Vertex* s, Vertex* d, const GraphSnapshot& snapshot, std::uint64_t e)
+    {
+        s->addEdge(d, snapshot.weight(e));
+    }
+
+    virtual void addEdge(
+        Graph& g, Vertex* s, Vertex* d, const GraphSnapshot& snapshot, std::uint64_t e)
+    {
+        try
+        {
+            g.addEdge(s, d, snapshot.weight(e));
+        }
+        catch (const DuplicateEdge& ex)
+        {
+        }
+    }
+
+    virtual void repeatedEntry(const std::string& source)
+    {
+        throw DuplicatedEdgeLoading(source + ": the snapshot repeats an edge");
+    }
+};
+}  // namespace graphpp
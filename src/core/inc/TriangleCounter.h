@@ -0,0 +1,225 @@
+// This toolbox is licensed under the Academic Free License 3.0.
+// Instituto Tecnológico de Buenos Aires (ITBA).
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <vector>
+
+#include "CompressedGraph.h"
+#include "Parallel.h"
+
+namespace graphpp
+{
+/**
+ * Class: TriangleCounter
+ * ----------------------
+ * Description: counts the triangles of every vertex of an undirected graph in one pass and
+ * derives the local clustering coefficients from them. Vertices are ranked by degree and
+ * every edge is oriented from the lower to the higher rank, so each vertex keeps a sorted
+ * list of its higher ranked neighbours of size O(sqrt(m)). Each triangle is then found
+ * exactly once, by merging the lists of the two lower ranked corners, instead of scanning
+ * the neighbours of the neighbours of every vertex.
+ */
+class TriangleCounter
+{
+public:
+    typedef CompressedGraph::VertexId VertexId;
+    typedef CompressedGraph::Index Index;
+    typedef unsigned long long Count;
+    typedef std::vector<double> Coefficients;
+
+    /**
+     * Constructor
+     * -----------
+     * @param g the graph; it is frozen into a CompressedGraph first
+     * @param threads number of worker threads; 0 uses the hardware concurrency
+     */
+    template <
+        class Graph,
+        class = typename std::enable_if<!std::is_same<Graph, CompressedGraph>::value>::type>
+    explicit TriangleCounter(Graph& g, unsigned int threads = 0)
+    {
+        count(CompressedGraph(g), threads);
+    }
+
+    explicit TriangleCounter(const CompressedGraph& csr, unsigned int threads = 0)
+    {
+        count(csr, threads);
+    }
+
+    /**
+     * Method: triangles
+     * -----------------
+     * @returns the number of triangles the vertex belongs to, 0 if it is not in the graph
+     */
+    Count triangles(VertexId id) const
+    {
+        const Index i = indexOf(id);
+        return i == ids.size() ? 0 : triangleCount[i];
+    }
+
+    /**
+     * Method: clustering
+     * ------------------
+     * Description: local clustering coefficient, 2t / (k (k - 1)); 0 for degrees below 2
+     * @returns the coefficient, or 0 if the vertex is not in the graph
+     */
+    double clustering(VertexId id) const
+    {
+        const Index i = indexOf(id);
+        return i == ids.size() ? 0.0 : coefficient(i);
+    }
+
+    /**
+     * Method: clusteringForDegree
+     * ---------------------------
+     * Description: clustering coefficients of all the vertices with a given degree, sorted
+     * ascending, ready for quartiles
+     */
+    const Coefficients& clusteringForDegree(unsigned int degree) const
+    {
+        static const Coefficients none;
+        const auto it = byDegree.find(degree);
+        return it == byDegree.end() ? none : it->second;
+    }
+
+    /**
+     * Method: meanClustering
+     * ----------------------
+     * @returns the mean clustering coefficient of the vertices with a given degree, 0 if
+     * there are none
+     */
+    double meanClustering(unsigned int degree) const
+    {
+        const auto it = meanByDegree.find(degree);
+        return it == meanByDegree.end() ? 0.0 : it->second;
+    }
+
+    /**
+     * Method: allClustering
+     * ---------------------
+     * @returns the clustering coefficients of every vertex, sorted ascending
+     */
+    Coefficients allClustering() const
+    {
+        Coefficients ret;
+        ret.reserve(ids.size());
+        for (Index i = 0; i < ids.size(); ++i)
+            ret.push_back(coefficient(i));
+        std::sort(ret.begin(), ret.end());
+        return ret;
+    }
+
+private:
+    void count(const CompressedGraph& csr, unsigned int threads)
+    {
+        const Index n = csr.verticesCount();
+        const auto& offsets = csr.getOffsets();
+        const auto& neighbors = csr.getNeighbors();
+        ids = csr.getIds();
+        degrees.resize(n);
+        for (Index v = 0; v < n; ++v)
+            degrees[v] = offsets[v + 1] - offsets[v];
+
+        // rank[v] is the position of v when sorting by degree, ties broken by index
+        std::vector<Index> order(n);
+        for (Index v = 0; v < n; ++v)
+            order[v] = v;
+        std::stable_sort(order.begin(), order.end(), [this](Index a, Index b) {
+            return degrees[a] < degrees[b];
+        });
+        std::vector<Index> rank(n);
+        for (Index r = 0; r < n; ++r)
+            rank[order[r]] = r;
+
+        // forward adjacency in rank space: only the neighbours ranked above
+        std::vector<std::size_t> forwardOffsets(n + 1, 0);
+        std::vector<Index> forward;
+        forward.reserve(neighbors.size() / 2);
+        for (Index r = 0; r < n; ++r)
+        {
+            const Index v = order[r];
+            for (auto e = offsets[v]; e < offsets[v + 1]; ++e)
+                if (rank[neighbors[e]] > r)
+                    forward.push_back(rank[neighbors[e]]);
+            std::sort(forward.begin() + forwardOffsets[r], forward.end());
+            forward.erase(
+                std::unique(forward.begin() + forwardOffsets[r], forward.end()), forward.end());
+            forwardOffsets[r + 1] = forward.size();
+        }
+
+        // one shared counter per vertex: per-thread arrays would take threads * n counters
+        std::vector<std::atomic<Count>> shared(n);
+        parallelFor(n, workerCount(threads, n), [&](unsigned int, std::size_t u) {
+            Count own = 0;
+            const Index* uFirst = forward.data() + forwardOffsets[u];
+            const Index* uLast = forward.data() + forwardOffsets[u + 1];
+            for (const Index* w = uFirst; w != uLast; ++w)
+            {
+                // merge the lists of u and w; their common entries close a triangle
+                const Index* a = w + 1;
+                const Index* b = forward.data() + forwardOffsets[*w];
+                const Index* bLast = forward.data() + forwardOffsets[*w + 1];
+                Count closed = 0;
+                while (a != uLast && b != bLast)
+                {
+                    if (*a < *b)
+                        ++a;
+                    else if (*b < *a)
+                        ++b;
+                    else
+                    {
+                        shared[*a].fetch_add(1, std::memory_order_relaxed);
+                        ++closed;
+                        ++a;
+                        ++b;
+                    }
+                }
+                if (closed > 0)
+                    shared[*w].fetch_add(closed, std::memory_order_relaxed);
+                own += closed;
+            }
+            if (own > 0)
+                shared[u].fetch_add(own, std::memory_order_relaxed);
+        });
+
+        triangleCount.resize(n);
+        for (Index r = 0; r < n; ++r)
+            triangleCount[order[r]] = shared[r].load(std::memory_order_relaxed);
+
+        std::map<unsigned int, double> sums;
+        for (Index v = 0; v < n; ++v)
+        {
+            const double c = coefficient(v);
+            byDegree[degrees[v]].push_back(c);
+            sums[degrees[v]] += c;
+        }
+        for (auto& entry : byDegree)
+        {
+            std::sort(entry.second.begin(), entry.second.end());
+            meanByDegree[entry.first] = sums[entry.first] / entry.second.size();
+        }
+    }
+
+    Index indexOf(VertexId id) const
+    {
+        const auto it = std::lower_bound(ids.begin(), ids.end(), id);
+        return (it == ids.end() || *it != id) ? ids.size() : Index(it - ids.begin());
+    }
+
+    double coefficient(Index v) const
+    {
+        const double k = degrees[v];
+        return k < 2 ? 0.0 : 2.0 * triangleCount[v] / (k * (k - 1));
+    }
+
+    std::vector<VertexId> ids;
+    std::vector<unsigned int> degrees;
+    std::vector<Count> triangleCount;
+    std::map<unsigned int, Coefficients> byDegree;
+    std::map<unsigned int, double> meanByDegree;
+};
+}  // namespace graphpp
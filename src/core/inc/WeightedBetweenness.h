@@ -1,48 +1,72 @@
 #pragma once
 
-#include <list>
-#include <queue>
-#include <stack>
+#include <limits>
 #include <vector>
 
+#include "BetweennessSample.h"
+#include "CompressedGraph.h"
 #include "IBetweenness.h"
+#include "IndexedHeap.h"
+#include "Parallel.h"
 #include "mili/mili.h"
 
 namespace graphpp
 {
-class BrandesNodeComparatorLargerFirst
-{
-public:
-    bool operator()(
-        graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>* v1,
-        graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>* v2)
-    {
-        return v1->distance < v2->distance;
-    }
-};
-
-class BrandesNodeComparatorSmallerFirst
-{
-public:
-    bool operator()(
-        graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>* v1,
-        graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>* v2)
-    {
-        return v1->distance > v2->distance;
-    }
-};
-
+/**
+ * Class: WeightedBetweenness
+ * --------------------------
+ * Description: Brandes' algorithm for weighted graphs, one Dijkstra per source. The graph
+ * is frozen into a weighted CompressedGraph; distances, path counts and dependencies live
+ * in per-thread arrays, so sources run concurrently like in Betweenness. The frontier is
+ * an IndexedHeap with decrease-key and S is the settle order, kept as a plain stack.
+ */
 template <class Graph, class Vertex>
 class WeightedBetweenness : public IBetweenness<Graph, Vertex>
 {
 public:
     typedef typename IBetweenness<Graph, Vertex>::BetweennessContainer BetweennessContainer;
     typedef typename IBetweenness<Graph, Vertex>::BetweennessIterator BetweennessIterator;
+    typedef BetweennessSample<typename Vertex::VertexId> Sample;
+
+    /**
+     * Constructor
+     * -----------
+     * @param g the graph
+     * @param threads number of worker threads; 0 uses the hardware concurrency
+     */
+    WeightedBetweenness(Graph& g, unsigned int threads = 0)
+    {
+        const CompressedGraph csr(g);
+        std::vector<Index> sources(csr.verticesCount());
+        for (Index i = 0; i < sources.size(); ++i)
+            sources[i] = i;
+
+        initMap(g, 1, betweenness, 0.0, 0.0);
+        calculateBetweenness(csr, sources, 1.0, threads);
+    }
 
-    WeightedBetweenness(Graph& g)
+    /**
+     * Constructor
+     * -----------
+     * Description: approximate betweenness, using only the sampled pivots as sources
+     * @param g the graph
+     * @param sample the pivots and the scale to apply
+     * @param threads number of worker threads; 0 uses the hardware concurrency
+     */
+    WeightedBetweenness(Graph& g, const Sample& sample, unsigned int threads = 0)
     {
+        const CompressedGraph csr(g);
+        std::vector<Index> sources;
+        sources.reserve(sample.getPivots().size());
+        for (const auto id : sample.getPivots())
+        {
+            const Index index = csr.indexOf(id);
+            if (index < csr.verticesCount())
+                sources.push_back(index);
+        }
+
         initMap(g, 1, betweenness, 0.0, 0.0);
-        calculateBetweenness(g);
+        calculateBetweenness(csr, sources, sample.getScale(), threads);
     }
 
     virtual BetweennessIterator iterator()
@@ -51,103 +75,125 @@ public:
     }
 
 private:
-    double const inf = 1.0 / 0.0;
-
-    void calculateBetweenness(Graph& g)
+    typedef CompressedGraph::Index Index;
+    typedef CompressedGraph::Weight Weight;
+
+    /**
+     * Struct: Scratch
+     * ---------------
+     * Description: per-thread state. Only the entries settled by the last run are reset.
+     */
+    struct Scratch
     {
-        auto iter = g.verticesIterator();
-        int n = g.verticesCount();
-        int i = 1;
-        while (!iter.end())
+        explicit Scratch(Index n)
+            : sigma(n, 0.0),
+              delta(n, 0.0),
+              distance(n, std::numeric_limits<Weight>::infinity()),
+              partial(n, 0.0),
+              queue(n)
         {
-            Vertex* s = *iter;
-            std::priority_queue<Vertex*, std::vector<Vertex*>, BrandesNodeComparatorLargerFirst> S;
-            std::priority_queue<Vertex*, std::vector<Vertex*>, BrandesNodeComparatorSmallerFirst> Q;
-            std::map<typename Vertex::VertexId, std::list<typename Vertex::VertexId>> p;
-            std::map<typename Vertex::VertexId, double> sigma;
-            std::map<typename Vertex::VertexId, double> d;
-            std::map<typename Vertex::VertexId, double> delta;
-
-            initMap(g, s->getVertexId(), sigma, 0.0, 1.0);
-            initMap(g, s->getVertexId(), delta, 0.0, 0.0);
-            initDistances(g, inf);
-            s->distance = 0.0;
-
-            Q.push(s);
-
-            while (!Q.empty())
-            {
-                // printPQ(Q);
-                Vertex* v = Q.top();
-                Q.pop();
-                S.push(v);
+            order.reserve(n);
+        }
 
-                // iterate through v's neighbors
-                auto neighbourIter = v->neighborsIterator();
+        std::vector<double> sigma;
+        std::vector<double> delta;
+        std::vector<Weight> distance;
+        std::vector<Index> order;
+        std::vector<double> partial;
+        IndexedHeap<Weight> queue;
+    };
+
+    void calculateBetweenness(
+        const CompressedGraph& csr,
+        const std::vector<Index>& sources,
+        double scale,
+        unsigned int threads)
+    {
+        const Index n = csr.verticesCount();
+        threads = workerCount(threads, sources.size());
 
-                while (!neighbourIter.end())
-                {
-                    Vertex* w = static_cast<Vertex*>(*neighbourIter);
-                    double alt = v->distance + v->edgeWeight(w);
-                    double wValue = w->distance;
-
-                    if (alt < wValue)
-                    {
-                        w->distance = alt;
-                        // refreshing ordering of priority queues
-                        std::make_heap(
-                            const_cast<Vertex**>(&Q.top()),
-                            const_cast<Vertex**>(&Q.top()) + Q.size(),
-                            BrandesNodeComparatorSmallerFirst());
-                        std::make_heap(
-                            const_cast<Vertex**>(&S.top()),
-                            const_cast<Vertex**>(&S.top()) + S.size(),
-                            BrandesNodeComparatorLargerFirst());
-                        if (wValue == inf)
-                        {
-                            Q.push(w);
-                        }
-                        sigma[w->getVertexId()] = 0.0;
-                        p[w->getVertexId()].clear();
-                        ;
-                    }
-                    // shortest path to w via v?
-                    if (w->distance == alt)
-                    {
-                        sigma[w->getVertexId()] = sigma[w->getVertexId()] + sigma[v->getVertexId()];
-                        p[w->getVertexId()].push_back(v->getVertexId());
-                    }
-
-                    ++neighbourIter;
-                }
-            }
+        std::vector<Scratch> scratch;
+        scratch.reserve(threads);
+        for (unsigned int t = 0; t < threads; ++t)
+            scratch.emplace_back(n);
 
-            while (!S.empty())
-            {
-                Vertex* w = S.top();
-                S.pop();
+        parallelFor(sources.size(), threads, [&](unsigned int worker, std::size_t i) {
+            accumulate(csr, sources[i], scratch[worker]);
+        });
 
-                std::list<typename Vertex::VertexId> vertices = p[w->getVertexId()];
-                typename std::list<typename Vertex::VertexId>::iterator it;
+        const auto& ids = csr.getIds();
+        for (Index v = 0; v < n; ++v)
+        {
+            double total = 0.0;
+            for (const auto& s : scratch)
+                total += s.partial[v];
+            betweenness[ids[v]] += total * scale;
+        }
+    }
 
-                for (it = vertices.begin(); it != vertices.end(); ++it)
-                {
-                    typename Vertex::VertexId v = *it;
-                    double c =
-                        (sigma[v] / sigma[w->getVertexId()]) * (1.0 + delta[w->getVertexId()]);
-                    delta[v] = delta[v] + c;
-                }
+    /**
+     * Method: accumulate
+     * ------------------
+     * Description: single source step. Predecessors are not stored: w is a successor of v
+     * on a shortest path iff distance[w] == distance[v] + weight(v, w), which is the same
+     * sum the forward pass compared, so the test is exact.
+     */
+    static void accumulate(const CompressedGraph& csr, Index source, Scratch& s)
+    {
+        const auto& offsets = csr.getOffsets();
+        const auto& neighbors = csr.getNeighbors();
+        const auto& weights = csr.getWeights();
+        const Weight inf = std::numeric_limits<Weight>::infinity();
+
+        s.order.clear();
+        s.sigma[source] = 1.0;
+        s.distance[source] = 0.0;
+        s.queue.push(source, 0.0);
+
+        while (!s.queue.empty())
+        {
+            const Index v = s.queue.pop();
+            s.order.push_back(v);
 
-                if (w->getVertexId() != s->getVertexId())
+            for (auto e = offsets[v]; e < offsets[v + 1]; ++e)
+            {
+                const Index w = neighbors[e];
+                const Weight alt = s.distance[v] + weights[e];
+                if (alt < s.distance[w])
                 {
-                    betweenness[w->getVertexId()] += delta[w->getVertexId()];
+                    if (s.distance[w] == inf)
+                        s.queue.push(w, alt);
+                    else
+                        s.queue.decreaseKey(w, alt);
+                    s.distance[w] = alt;
+                    s.sigma[w] = 0.0;
                 }
+                if (s.distance[w] == alt)
+                    s.sigma[w] += s.sigma[v];
+            }
+        }
+
+        for (std::size_t i = s.order.size(); i-- > 0;)
+        {
+            const Index v = s.order[i];
+            double dependency = 0.0;
+            for (auto e = offsets[v]; e < offsets[v + 1]; ++e)
+            {
+                const Index w = neighbors[e];
+                if (s.distance[w] == s.distance[v] + weights[e])
+                    dependency += (1 + s.delta[w]) / s.sigma[w];
             }
+            s.delta[v] = s.sigma[v] * dependency;
 
-            printf("Progress: %.2f%% \n", (double)i / (double)n * 100.0);
+            if (v != source)
+                s.partial[v] += s.delta[v];
+        }
 
-            ++iter;
-            ++i;
+        for (const Index v : s.order)
+        {
+            s.sigma[v] = 0.0;
+            s.delta[v] = 0.0;
+            s.distance[v] = inf;
         }
     }
 
@@ -171,65 +217,6 @@ private:
         m[vertexId] = distinguishedValue;
     }
 
-    void initDistances(Graph& g, double commonValue)
-    {
-        auto it = g.verticesIterator();
-        while (!it.end())
-        {
-            Vertex* v = *it;
-            v->distance = commonValue;
-            ++it;
-        }
-    }
-
-    void printPQ(std::priority_queue<
-                 graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>*,
-                 std::vector<
-                     graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>*,
-                     std::allocator<graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>*>>,
-                 graphpp::BrandesNodeComparatorSmallerFirst>& S)
-    {
-        std::priority_queue<
-            graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>*,
-            std::vector<
-                graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>*,
-                std::allocator<graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>*>>,
-            graphpp::BrandesNodeComparatorSmallerFirst>
-            pq = S;
-        printf("[ ");
-        while (!pq.empty())
-        {
-            Vertex* v = pq.top();
-            printf("id: %d - dist: %f /", v->getVertexId(), v->distance);
-            pq.pop();
-        }
-        printf("] \n ");
-    }
-
-    void printPS(std::priority_queue<
-                 graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>*,
-                 std::vector<
-                     graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>*,
-                     std::allocator<graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>*>>,
-                 graphpp::BrandesNodeComparatorLargerFirst>& S)
-    {
-        std::priority_queue<
-            graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>*,
-            std::vector<
-                graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>*,
-                std::allocator<graphpp::WeightedVertexAspect<graphpp::AdjacencyListVertex>*>>,
-            graphpp::BrandesNodeComparatorLargerFirst>
-            pq = S;
-        printf("[ ");
-        while (!pq.empty())
-        {
-            Vertex* v = pq.top();
-            printf("id: %d ;dist: %f , \n", v->getVertexId(), v->distance);
-            pq.pop();
-        }
-        printf("\n] \n ");
-    }
-
     BetweennessContainer betweenness;
 };
 }  // namespace graphpp
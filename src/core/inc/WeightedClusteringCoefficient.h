@@ -35,11 +35,13 @@ public:
     {
         double links = 0.0;
         auto it = vertex->neighborsIterator();
+        auto weightsIt = vertex->weightsIterator();
         double ret;
 
         while (!it.end())
         {
             Vertex* n = static_cast<Vertex*>(*it);
+            const double weight = *weightsIt;
 
             auto innerIter = n->neighborsIterator();
 
@@ -48,11 +50,12 @@ public:
                 Vertex* i = static_cast<Vertex*>(*innerIter);
                 // if i is neighbour of vertex, we close a triangle
                 if (i->isNeighbourOf(vertex))
-                    links += (vertex->edgeWeight(n) + i->edgeWeight(vertex)) / 2.0;
+                    links += (weight + i->edgeWeight(vertex)) / 2.0;
 
                 ++innerIter;
             }
             ++it;
+            ++weightsIt;
         }
 
         if (vertex->degree() == 1 || vertex->strength() == 0)
@@ -18,6 +18,16 @@ public:
         s->addEdge(d, weight);
         if (!this->isDigraph())
             d->addEdge(s, weight);
+        this->touch();
+    }
+
+    // addEdge without the duplicate check, see AdjacencyListGraph::addEdgeUnchecked
+    void addEdgeUnchecked(WeightedVertex* s, WeightedVertex* d, Weight weight)
+    {
+        s->addEdge(d, weight);
+        if (!this->isDigraph())
+            d->addEdge(s, weight);
+        this->touch();
     }
 };
 }  // namespace graphpp
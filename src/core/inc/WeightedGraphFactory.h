@@ -3,6 +3,10 @@
 #include "Betweenness.h"
 #include "IBetweenness.h"
 #include "IGraphFactory.h"
+#include "ParallelShellIndex.h"
+#include "ParallelWeightedGraphReader.h"
+#include "ShellIndex.h"
+#include "SnapshotWeightedGraphReader.h"
 #include "StrengthDistribution.h"
 #include "WeightedBetweenness.h"
 #include "WeightedClusteringCoefficient.h"
@@ -19,10 +23,25 @@ public:
     {
         return new WeightedGraphReader<Graph, Vertex>();
     }
+    virtual IGraphReader<Graph, Vertex>* createGraphReader(unsigned int threads)
+    {
+        if (threads != 1)
+            return new ParallelWeightedGraphReader<Graph, Vertex>(threads);
+        return new WeightedGraphReader<Graph, Vertex>();
+    }
+    virtual IGraphReader<Graph, Vertex>* createSnapshotReader()
+    {
+        return new SnapshotWeightedGraphReader<Graph, Vertex>();
+    }
     virtual IBetweenness<Graph, Vertex>* createBetweenness(Graph& g)
     {
         return new WeightedBetweenness<Graph, Vertex>(g);
     }
+    virtual IBetweenness<Graph, Vertex>* createApproximateBetweenness(
+        Graph& g, const BetweennessSample<typename Vertex::VertexId>& sample)
+    {
+        return new WeightedBetweenness<Graph, Vertex>(g, sample);
+    }
     virtual IClusteringCoefficient<Graph, Vertex>* createClusteringCoefficient()
     {
         return new WeightedClusteringCoefficient<Graph, Vertex>();
@@ -35,6 +54,13 @@ public:
     {
         return new ShellIndex<Graph, Vertex>(g, type);
     }
+    virtual IShellIndex<Graph, Vertex>* createShellIndex(
+        Graph& g, ShellIndexType type, unsigned int threads)
+    {
+        if (type == ShellIndexTypeSimple && threads != 1)
+            return new ParallelShellIndex<Graph, Vertex>(g, threads);
+        return new ShellIndex<Graph, Vertex>(g, type);
+    }
     virtual IDegreeDistribution<Graph, Vertex>* createDegreeDistribution(Graph& g)
     {
         return new DegreeDistribution<Graph, Vertex>(g);
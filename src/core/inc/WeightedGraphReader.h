@@ -1,169 +1,115 @@
 #pragma once
 
-#include <fstream>
-#include <iostream>
+#include <chrono>
+#include <sstream>
 #include <string>
+#include <vector>
+#include "EdgeListParser.h"
+#include "GraphExceptions.h"
 #include "IGraphReader.h"
+#include "MappedFile.h"
 
 namespace graphpp
 {
+/**
+ * Class: WeightedGraphReader
+ * --------------------------
+ * Description: Reads a weighted edge list, "source [destination weight]" per line. Same
+ * memory mapped, block by block loading as GraphReader, but a repeated edge is an error.
+ */
 template <class Graph, class Vertex>
-class WeightedGraphReader : public IGraphReader<Graph, Vertex>
+class WeightedGraphReader : public IGraphReader<Graph, Vertex>, public ReadThroughput
 {
 public:
     // this typedefs are also present in the superclass. Any way to remove it?
     typedef unsigned int LineNumber;
+
     virtual void read(Graph& g, std::string source)
     {
-        std::ifstream sourceFile;
-        double weight;
-
-        sourceFile.open(source.c_str(), std::ios_base::in);
+        const auto start = std::chrono::steady_clock::now();
+        const MappedFile file(source);
+        EdgeListParser parser(file.begin(), file.end(), true);
+        // the graph already has edges, which the read ones must be checked against
+        const bool checked = g.verticesCount() != 0;
+        RepeatedEdgeFilter repeated(g.isDigraph());
+
+        std::vector<EdgeListParser::Line> block;
+        block.reserve(BlockSize);
+        EdgeListParser::Line line;
+        bool more = true;
+        edgesCount = 0;
+        while (more)
+        {
+            block.clear();
+            while (block.size() < BlockSize && (more = parser.next(line)))
+            {
+                block.push_back(line);
+                edgesCount += line.isEdge;
+            }
+            addLines(g, block, checked, repeated);
+        }
 
-        if (!sourceFile)
-            throw FileNotFoundException(source);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        seconds = elapsed.count();
+    }
 
-        std::string line;
+private:
+    static const std::size_t BlockSize = 1 << 16;
 
-        currentLineNumber = 1;
-        while (getline(sourceFile, line))
+    void addLines(
+        Graph& g,
+        const std::vector<EdgeListParser::Line>& lines,
+        bool checked,
+        RepeatedEdgeFilter& repeated)
+    {
+        const bool multigraph = g.isMultigraph();
+        if (!multigraph)
+            repeated.reserve(lines.size());
+        for (const auto& line : lines)
         {
-            std::string tree_str = line;
-
-            character = tree_str.c_str();
-
-            if (!isEmptyLine())
+            Vertex* sourceNode = loadVertex(g, line.source);
+            if (line.isEdge)
             {
-                consume_whitespace();
-                Vertex* sourceNode = loadVertex(g);
-                consume_whitespace();
-
-                if (*character != '\0')
+                Vertex* destinationNode = loadVertex(g, line.destination);
+                if (!multigraph && !repeated.firstTime(line))
+                    throw DuplicatedEdgeLoading(getLineNumberText(line.number));
+                if (!checked || multigraph)
+                    g.addEdgeUnchecked(sourceNode, destinationNode, line.weight);
+                else
                 {
-                    Vertex* destinationNode = loadVertex(g);
-                    consume_whitespace();
-                    weight = consume_weigth();
-                    consume_whitespace();
-                    if (*character != '\0')
-                        throw MalformedLineException(getLineNumberText());
                     try
                     {
-                        g.addEdge(sourceNode, destinationNode, weight);
+                        g.addEdge(sourceNode, destinationNode, line.weight);
                     }
                     catch (const DuplicateEdge& ex)
                     {
-                        throw DuplicatedEdgeLoading(getLineNumberText());
+                        throw DuplicatedEdgeLoading(getLineNumberText(line.number));
                     }
                 }
             }
-
-            ++currentLineNumber;
         }
-
-        sourceFile.close();
     }
 
-private:
-    std::string getLineNumberText() const
+    static std::string getLineNumberText(LineNumber lineNumber)
     {
         std::stringstream s;
-        s << "Line: " << currentLineNumber;
+        s << "Line: " << lineNumber;
         return s.str();
     }
 
-    Vertex* loadVertex(Graph& g)
+    Vertex* loadVertex(Graph& g, unsigned int id)
     {
-        Vertex* vertex = new Vertex(readUnsignedInt());
-        Vertex* vertexAux = vertex;
-        if ((vertex = g.getVertexById(vertex->getVertexId())) != nullptr)
-            delete vertexAux;
-        else
+        Vertex* vertex = g.getVertexById(id);
+        if (vertex == nullptr)
         {
-            vertex = vertexAux;
+            vertex = new Vertex(id);
             g.addVertex(vertex);
         }
 
         return vertex;
     }
-
-    unsigned int readUnsignedInt()
-    {
-        unsigned int ret = 0;
-        if (!in_range(*character, '0', '9'))
-            throw UnsignedIntegerMalformedException(getLineNumberText());
-        else
-        {
-            std::string branchLenStr;
-            while (in_range(*character, '0', '9'))
-            {
-                branchLenStr += *character;
-                ++character;
-            }
-
-            if (!from_string<unsigned int>(branchLenStr, ret))
-                throw UnsignedIntegerMalformedException(getLineNumberText());
-        }
-        return ret;
-    }
-
-    // TODO this method should be const
-    bool isEmptyLine()
-    {
-        bool ret = false;
-        consume_whitespace();
-        if (*character == '\0')
-            ret = true;
-        return ret;
-    }
-
-    void consume_whitespace()
-    {
-        while (*character == ' ' || *character == '\t')
-            ++character;
-    }
-
-    double consume_weigth()
-    {
-        consume_whitespace();
-        bool positive = false, hasExponent = false;
-        unsigned int exponent = 0;
-        double ret = 0.0;
-        std::string branchLenStr;
-        while (in_range(*character, '0', '9') || *character == '.')
-        {
-            branchLenStr += *character;
-            ++character;
-        }
-
-        if (*character == 'E' || *character == 'e')
-        {
-            ++character;
-            if (*character == '+')
-                positive = true;
-            else if (in_range(*character, '0', '9'))
-            {
-                --character;
-                positive = true;
-            }
-            else if (*character == '-')
-                positive = false;
-            else
-                throw MalformedDoubleException(getLineNumberText());
-            ++character;
-            exponent = readUnsignedInt();
-            hasExponent = true;
-        }
-
-        if (!from_string<double>(branchLenStr, ret))
-            throw MalformedDoubleException(getLineNumberText());
-
-        if (hasExponent)
-            ret = positive ? ret * pow(10.0, exponent) : ret / ((double)(pow(10.0, exponent)));
-
-        return ret;
-    }
-
-    LineNumber currentLineNumber;
-    const char* character;
 };
+
+template <class Graph, class Vertex>
+const std::size_t WeightedGraphReader<Graph, Vertex>::BlockSize;
 }  // namespace graphpp
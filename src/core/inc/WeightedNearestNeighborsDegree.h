@@ -34,14 +34,16 @@ public:
     virtual double meanDegreeForVertex(Vertex* v)
     {
         auto it = v->neighborsIterator();
+        auto weightsIt = v->weightsIterator();
         typename Vertex::Weight degreeSum = 0.0;
         while (!it.end())
         {
             Vertex* n = static_cast<Vertex*>(*it);
 
-            degreeSum += n->degree() * v->edgeWeight(n);
+            degreeSum += n->degree() * *weightsIt;
 
             ++it;
+            ++weightsIt;
         }
 
         return v->strength() == 0 ? 0 : double(degreeSum) / v->strength();
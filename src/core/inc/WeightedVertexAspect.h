@@ -1,98 +1,123 @@
 #pragma once
 
+#include <vector>
 #include "AdjacencyListVertex.h"
 
 namespace graphpp
 {
+/**
+ * Class: WeightedVertexAspect
+ * ---------------------------
+ * Description: Adds edge weights to a vertex. The weights are kept in a vector parallel to
+ * the neighbour vector of the vertex: the i-th weight belongs to the i-th neighbour, so
+ * iterating both together (or asking for a slot) is O(1) per edge, and memory grows with
+ * the number of edges only. The strength is kept up to date as edges come and go.
+ */
 template <class T>
 class WeightedVertexAspect : public T
 {
 public:
-    // TODO: make these typedefs private
     typedef AdjacencyListVertex::VertexId VertexId;
     typedef double Weight;
-    typedef std::map<VertexId, Weight> NeighborsWeights;
-    typedef AutonomousIterator<NeighborsWeights> WeightsIterator;
-    double distance;
+    typedef std::vector<Weight> NeighborsWeights;
+    typedef CAutonomousIterator<NeighborsWeights> WeightsIterator;
 
-    WeightedVertexAspect(VertexId id) : T(id) {
-        neighborIds = new std::list<unsigned int>[20000];
-        neighboursWeight = new std::vector<double>(20000);
-    }
+    WeightedVertexAspect(VertexId id) : T(id), currentStrength(0.0) {}
 
     void addEdge(WeightedVertexAspect<T>* other, Weight weight)
     {
         T::template addEdge<WeightedVertexAspect<T>>(other);
-        weights.insert(std::pair<VertexId, Weight>(other->getVertexId(), weight));
-        neighboursWeight-> push_back(weight);
-        neighborIds->push_back(other->getVertexId());
+        weights.push_back(weight);
+        currentStrength += weight;
     }
 
-    // TODO method should be const
-    Weight edgeWeight(WeightedVertexAspect<T>* neighbour)
+    /**
+     * Method: removeEdge
+     * ------------------
+     * Description: removes the first edge to other, together with its weight
+     * @param other the neighbour
+     */
+    void removeEdge(WeightedVertexAspect<T>* other)
     {
-        return weights[neighbour->getVertexId()];
+        const unsigned int slot = slotOf(other);
+        if (slot == weights.size())
+            return;
+        T::template removeEdge<WeightedVertexAspect<T>>(other);
+        currentStrength -= weights[slot];
+        weights.erase(weights.begin() + slot);
     }
 
-    Weight edgeWeightByNeighbour(unsigned int neighbourId)
+    /**
+     * Method: edgeWeight
+     * ------------------
+     * Description: weight of the edge to a neighbour. It scans the neighbour vector, like
+     * isNeighbourOf does; when iterating neighbours prefer edgeWeightAt or weightsIterator.
+     * @param neighbour the neighbour
+     * @returns the weight of the first edge to neighbour, or 0 if there is none
+     */
+    Weight edgeWeight(WeightedVertexAspect<T>* neighbour) const
     {
-        return weights[neighbourId];
+        const unsigned int slot = slotOf(neighbour);
+        return slot == weights.size() ? 0.0 : weights[slot];
     }
 
-    Weight getNeighbourWeight(unsigned int neighbourId){
-        int index = 0;
-        for (unsigned int neigh : (*neighborIds)){
-            if(neigh == neighbourId){
-                return neighboursWeight->at(index);
-            }
-            index++;
-        }
-        return index;
+    /**
+     * Method: edgeWeightAt
+     * --------------------
+     * Description: weight of the edge in a given neighbour slot
+     * @param slot position of the neighbour in neighborsIterator order
+     */
+    Weight edgeWeightAt(unsigned int slot) const
+    {
+        return weights[slot];
     }
 
-    WeightsIterator weightsIterator()
+    Weight edgeWeightByNeighbour(VertexId neighbourId) const
     {
-        WeightsIterator iter(weights);
-        return iter;
+        unsigned int slot = 0;
+        auto it = this->neighborsConstIterator();
+        while (!it.end() && (*it)->getVertexId() != neighbourId)
+        {
+            ++slot;
+            ++it;
+        }
+        return it.end() ? 0.0 : weights[slot];
     }
 
-
-    std::list<unsigned int> *getNeighborsIds(){
-        return neighborIds;
+    /**
+     * Method: weightsIterator
+     * -----------------------
+     * Description: iterates the weights in the same order as neighborsIterator
+     */
+    WeightsIterator weightsIterator() const
+    {
+        return WeightsIterator(weights);
     }
 
-
-    // TODO method should be const
-    Weight strength()
+    /**
+     * Method: strength
+     * ----------------
+     * Description: sum of the weights of the edges of the vertex, kept up to date
+     */
+    Weight strength() const
     {
-        WeightsIterator iter(weights);
-        Weight str = 0.0;
-
-        while (!iter.end())
-        {
-            str += iter->second;
-            ++iter;
-        }
-
-        return str;
+        return currentStrength;
     }
 
-    Weight getInitialStrength() {
-        if(!strengthComputed){
-            double currentStrength = 0.0;
-            for(auto it = neighboursWeight->begin(); it != neighboursWeight->end(); ++it) {
-                currentStrength += *it;
-            }
-            myStrength = currentStrength;
+private:
+    unsigned int slotOf(const WeightedVertexAspect<T>* neighbour) const
+    {
+        unsigned int slot = 0;
+        auto it = this->neighborsConstIterator();
+        while (!it.end() && *it != neighbour)
+        {
+            ++slot;
+            ++it;
         }
-        return myStrength ;
+        return slot;
     }
 
-private:
-    double myStrength = 0.0;
     NeighborsWeights weights;
-    std::list<unsigned int> * neighborIds;
-    std::vector<double>* neighboursWeight;
-    bool strengthComputed;
+    Weight currentStrength;
 };
 }  // namespace graphpp
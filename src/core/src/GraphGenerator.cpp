@@ -3,11 +3,23 @@
 // Last modification: December 19th, 2012.
 
 #include "GraphGenerator.h"
+#include <climits>
 #include <cmath>
-#include "ConnectivityVerifier.h"
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <queue>
+#include <set>
+#include <tuple>
+#include "ConnectedComponents.h"
 #include "DirectedGraphFactory.h"
 #include "GraphFactory.h"
+#include "GraphSnapshot.h"
 #include "IGraphReader.h"
+#include "JobControl.h"
+#include "Parallel.h"
+#include "Random.h"
 #include "TraverserBFS.h"
 #include "WeightedGraphFactory.h"
 
@@ -20,10 +32,232 @@ typedef struct Position
 } Position;
 
 static const double PI = atan(1) * 4;
-std::vector<Position> vertexesPositions;
 
 GraphGenerator* GraphGenerator::instance = nullptr;
 
+namespace
+{
+// copies what an edge list reader measured; the other readers leave it empty
+template <class Graph, class Vertex>
+void reportThroughput(const IGraphReader<Graph, Vertex>& reader, ReadThroughput* throughput)
+{
+    if (throughput == nullptr)
+        return;
+    const auto* measured = dynamic_cast<const ReadThroughput*>(&reader);
+    *throughput = measured != nullptr ? *measured : ReadThroughput();
+}
+
+// Pairs (w, v) of vertex positions, w < v, drawn by one block of generateErdosRenyiGraph
+typedef std::vector<std::pair<unsigned int, unsigned int>> PositionPairs;
+
+// The pair space of generateErdosRenyiGraph is cut into this many blocks, each one with its own
+// random stream. The number does not depend on the threads, so neither does the graph.
+const unsigned int ErdosRenyiBlocks = 256;
+
+// First row of a block: row v holds the v pairs (0, v) ... (v - 1, v), so rows up to
+// n * sqrt(block / blocks) hold about block / blocks of all the pairs.
+unsigned int firstRow(unsigned int n, unsigned int blocks, std::size_t block)
+{
+    if (block >= blocks)
+        return n;
+    return (unsigned int)std::min<double>(n, std::floor(n * std::sqrt((double)block / blocks)));
+}
+
+/*
+ * Draws the edges of G(n, p) among the pairs of rows [first, last) with the geometric
+ * skipping of Batagelj and Brandes: the number of pairs skipped before the next edge is
+ * geometric, so the cost is proportional to the edges drawn and not to the pairs.
+ */
+void erdosRenyiBlock(
+    unsigned int first, unsigned int last, double p, Random& rng, PositionPairs& edges)
+{
+    const double logQ = std::log1p(-p);
+    // pairs of the block, to stop before a skip overflows
+    const double pairs = ((double)last * last - (double)first * first) / 2 + last;
+
+    std::int64_t v = first;
+    std::int64_t w = -1;
+    while (v < last)
+    {
+        std::int64_t skip = 0;
+        if (p < 1)
+        {
+            const double draw = std::floor(std::log1p(-rng.uniform()) / logQ);
+            if (draw > pairs)
+                break;
+            skip = (std::int64_t)draw;
+        }
+        w += 1 + skip;
+        while (w >= v && v < last)
+        {
+            w -= v;
+            v++;
+        }
+        if (v < last)
+            edges.push_back(std::make_pair((unsigned int)w, (unsigned int)v));
+    }
+}
+
+// Angle -> vertex entries of a band of HyperbolicBands, searched either as a tree or, once no
+// more points are added, as a sorted vector
+typedef std::multimap<double, unsigned int> GrowingBand;
+typedef std::vector<std::pair<double, unsigned int>> SortedBand;
+
+GrowingBand::const_iterator lowerAngle(const GrowingBand& band, double angle)
+{
+    return band.lower_bound(angle);
+}
+
+GrowingBand::const_iterator upperAngle(const GrowingBand& band, double angle)
+{
+    return band.upper_bound(angle);
+}
+
+SortedBand::const_iterator lowerAngle(const SortedBand& band, double angle)
+{
+    return std::lower_bound(band.begin(), band.end(), std::make_pair(angle, 0u));
+}
+
+SortedBand::const_iterator upperAngle(const SortedBand& band, double angle)
+{
+    return std::upper_bound(band.begin(), band.end(), std::make_pair(angle, UINT_MAX));
+}
+
+/*
+ * Points of the hyperbolic model bucketed by radius into bands of equal width, each band sorted
+ * by angle. For a query point only the arc of each band that may hold points within a given
+ * distance is visited; farther bands are narrower arcs, nearer bands hold fewer points.
+ * Band is GrowingBand while points are added, and SortedBand, built from it, for the queries
+ * that follow.
+ */
+template <class Band>
+class HyperbolicBands
+{
+public:
+    HyperbolicBands(double maxRadius, double a) : width(0)
+    {
+        unsigned int count = 1;
+        if (maxRadius > 0 && a > 0)
+        {
+            // about ln 2 / a wide, so each band holds about half the points of the next one
+            const double wanted = std::ceil(maxRadius * a / std::log(2.0));
+            count = (unsigned int)std::min(std::max(wanted, 1.0), (double)MaxBands);
+            width = maxRadius / count;
+        }
+        resize(count);
+    }
+
+    template <class Other>
+    explicit HyperbolicBands(const HyperbolicBands<Other>& other) : width(other.width)
+    {
+        resize(other.bands.size());
+        for (std::size_t k = 0; k < bands.size(); ++k)
+            bands[k].assign(other.bands[k].begin(), other.bands[k].end());
+    }
+
+    void insert(unsigned int id, double r, double theta)
+    {
+        bands[band(r)].insert(std::make_pair(theta, id));
+    }
+
+    /*
+     * Calls visit(id) for the points that may be closer than distance to (r, theta) and for
+     * some farther ones, until visit returns true. Needs r <= distance.
+     * @returns whether visit returned true
+     */
+    template <class Visit>
+    bool forEachCandidate(double r, double theta, double distance, Visit visit) const
+    {
+        const double coshR = std::cosh(r);
+        const double sinhR = std::sinh(r);
+        const double coshDistance = std::cosh(distance);
+        for (std::size_t k = 0; k < bands.size(); ++k)
+        {
+            const double arc = maxAngle(coshR, sinhR, coshDistance, k);
+            if (arc < 0 || bands[k].empty())
+                continue;
+            if (arc >= PI)
+            {
+                if (visitRange(bands[k].begin(), bands[k].end(), visit))
+                    return true;
+                continue;
+            }
+            // the arc [theta - arc, theta + arc], split where it crosses 0 or 2 pi
+            if (visitArc(bands[k], theta - arc, theta + arc, visit) ||
+                (theta - arc < 0 &&
+                 visitArc(bands[k], theta - arc + 2 * PI, 2 * PI, visit)) ||
+                (theta + arc > 2 * PI && visitArc(bands[k], 0, theta + arc - 2 * PI, visit)))
+                return true;
+        }
+        return false;
+    }
+
+private:
+    template <class Other>
+    friend class HyperbolicBands;
+
+    static const unsigned int MaxBands = 64;
+
+    void resize(std::size_t count)
+    {
+        bands.resize(count);
+        coshLow.resize(count);
+        sinhLow.resize(count);
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            coshLow[k] = std::cosh(k * width);
+            sinhLow[k] = std::sinh(k * width);
+        }
+    }
+
+    std::size_t band(double r) const
+    {
+        if (width <= 0)
+            return 0;
+        return std::min(bands.size() - 1, (std::size_t)(r / width));
+    }
+
+    /*
+     * Largest angle between a point of radius r and a point of band k that is closer than
+     * distance, or -1 if there is none. cosh d = cosh r cosh r' - sinh r sinh r' cos angle, and
+     * for r <= distance the bound on cos angle grows with r', so the lower radius of the band
+     * gives the widest arc. The arc is widened a little so rounding cannot drop a point the
+     * exact check accepts.
+     */
+    double maxAngle(double coshR, double sinhR, double coshDistance, std::size_t k) const
+    {
+        if (sinhR <= 0 || sinhLow[k] <= 0)
+            return PI;
+        const double cosine = (coshR * coshLow[k] - coshDistance) / (sinhR * sinhLow[k]);
+        if (cosine <= -1)
+            return PI;
+        if (cosine > 1 + 1e-9)
+            return -1;
+        return std::acos(std::min(cosine, 1.0)) * (1 + 1e-9) + 1e-9;
+    }
+
+    template <class Visit>
+    static bool visitArc(const Band& band, double from, double to, Visit& visit)
+    {
+        return visitRange(lowerAngle(band, from), upperAngle(band, to), visit);
+    }
+
+    template <class Iterator, class Visit>
+    static bool visitRange(Iterator first, Iterator last, Visit& visit)
+    {
+        for (; first != last; ++first)
+            if (visit(first->second))
+                return true;
+        return false;
+    }
+
+    std::vector<Band> bands;
+    std::vector<double> coshLow;
+    std::vector<double> sinhLow;
+    double width;
+};
+}  // namespace
+
 GraphGenerator::GraphGenerator(){};
 
 GraphGenerator* GraphGenerator::getInstance()
@@ -36,123 +270,185 @@ GraphGenerator* GraphGenerator::getInstance()
     return instance;
 }
 
-Graph* GraphGenerator::generateGraphFromFile(std::string path, bool directed, bool multigraph)
+Graph* GraphGenerator::generateGraphFromFile(
+    std::string path,
+    bool directed,
+    bool multigraph,
+    unsigned int threads,
+    ReadThroughput* throughput)
 {
-    Graph* graph = new Graph(directed, multigraph);
+    std::unique_ptr<Graph> graph(new Graph(directed, multigraph));
 
-    auto factory = new GraphFactory<Graph, Vertex>();
-    auto reader = factory->createGraphReader();
+    GraphFactory<Graph, Vertex> factory;
+    std::unique_ptr<IGraphReader<Graph, Vertex>> reader(
+        GraphSnapshot::isSnapshot(path) ? factory.createSnapshotReader()
+                                        : factory.createGraphReader(threads));
     reader->read(*graph, path);
+    reportThroughput(*reader, throughput);
 
-    delete reader;
-    delete factory;
-
-    return graph;
+    return graph.release();
 }
 
-DirectedGraph* GraphGenerator::generateDirectedGraphFromFile(std::string path, bool multigraph)
+DirectedGraph* GraphGenerator::generateDirectedGraphFromFile(
+    std::string path, bool multigraph, unsigned int threads, ReadThroughput* throughput)
 {
-    auto graph = new DirectedGraph(multigraph);
-
-    auto factory = new DirectedGraphFactory<DirectedGraph, DirectedVertex>();
-    auto reader = factory->createGraphReader();
+    std::unique_ptr<DirectedGraph> graph(new DirectedGraph(multigraph));
 
+    DirectedGraphFactory<DirectedGraph, DirectedVertex> factory;
+    std::unique_ptr<IGraphReader<DirectedGraph, DirectedVertex>> reader(
+        GraphSnapshot::isSnapshot(path) ? factory.createSnapshotReader()
+                                        : factory.createGraphReader(threads));
     reader->read(*graph, path);
+    reportThroughput(*reader, throughput);
 
-    delete reader;
-    delete factory;
-
-    return graph;
+    return graph.release();
 }
 
 WeightedGraph* GraphGenerator::generateWeightedGraphFromFile(
-    std::string path, bool directed, bool multigraph)
+    std::string path,
+    bool directed,
+    bool multigraph,
+    unsigned int threads,
+    ReadThroughput* throughput)
 {
-    auto graph = new WeightedGraph(directed, multigraph);
-
-    auto factory = new WeightedGraphFactory<WeightedGraph, WeightedVertex>();
-    auto reader = factory->createGraphReader();
+    std::unique_ptr<WeightedGraph> graph(new WeightedGraph(directed, multigraph));
 
+    WeightedGraphFactory<WeightedGraph, WeightedVertex> factory;
+    std::unique_ptr<IGraphReader<WeightedGraph, WeightedVertex>> reader(
+        GraphSnapshot::isSnapshot(path) ? factory.createSnapshotReader()
+                                        : factory.createGraphReader(threads));
     reader->read(*graph, path);
+    reportThroughput(*reader, throughput);
 
-    delete reader;
-    delete factory;
+    return graph.release();
+}
 
-    return graph;
+Graph* GraphGenerator::generateErdosRenyiGraph(
+    unsigned int n, float p, bool biggestComponent, unsigned int threads)
+{
+    return generateErdosRenyiGraph(n, p, biggestComponent, threads, Random::seedFromRand());
 }
 
-Graph* GraphGenerator::generateErdosRenyiGraph(unsigned int n, float p)
+Graph* GraphGenerator::generateErdosRenyiGraph(
+    unsigned int n, float p, bool biggestComponent, unsigned int threads, std::uint64_t seed)
 {
-    auto graph = new Graph();
+    std::unique_ptr<Graph> graph(new Graph());
+    std::vector<Vertex*> vertices(n);
 
-    for (unsigned int i = 1; i <= n; i++)
+    for (unsigned int i = 0; i < n; i++)
     {
-        graph->addVertex(new Vertex(i));
+        vertices[i] = new Vertex(i + 1);
+        graph->addVertex(vertices[i]);
     }
 
-    for (unsigned int i = 1; i < n; i++)
+    const unsigned int blocks = std::min(ErdosRenyiBlocks, std::max(n, 1u));
+    std::vector<PositionPairs> edges(blocks);
+
+    if (p > 0)
     {
-        Vertex* srcVertex = graph->getVertexById(i);
+        std::vector<Random> streams = Random(seed).streams(blocks);
+        parallelFor(
+            blocks, workerCount(threads, blocks), [&](unsigned int, std::size_t block) {
+                erdosRenyiBlock(
+                    firstRow(n, blocks, block), firstRow(n, blocks, block + 1), p, streams[block],
+                    edges[block]);
+            });
+    }
 
-        for (unsigned int j = i + 1; j <= n; j++)
-        {
-            if ((float)rand() / RAND_MAX <= p)
-            {
-                Vertex* destVertex = graph->getVertexById(j);
-                graph->addEdge(srcVertex, destVertex);
-            }
-        }
+    // Blocks are added in order, so the graph does not depend on the number of threads
+    for (auto& block : edges)
+    {
+        for (const auto& edge : block)
+            graph->addEdgeUnchecked(vertices[edge.first], vertices[edge.second]);
+        PositionPairs().swap(block);
     }
 
-    // Keep only the biggest component (at least n/2 vertexes)
-    ConnectivityVerifier<Graph, Vertex> connectivityVerifier;
-    connectivityVerifier.getBiggestComponent(graph);
+    if (biggestComponent)
+        ConnectedComponents<Graph, Vertex>(*graph).keepGiantComponent(*graph);
 
-    return graph;
+    return graph.release();
 }
 
 Graph* GraphGenerator::generateBarabasiAlbertGraph(unsigned int m_0, unsigned int m, unsigned int n)
 {
-    auto graph = new Graph();
-    // Create a K_M_0 graph
-    for (unsigned int i = 1; i <= m_0; i++)
-        graph->addVertex(new Vertex(i));
-    for (unsigned int i = 1; i < m_0; i++)
-    {
-        Vertex* srcVertex = graph->getVertexById(i);
-        for (unsigned int j = i + 1; j <= m_0; j++)
-        {
-            Vertex* destVertex = graph->getVertexById(j);
-            graph->addEdge(srcVertex, destVertex);
-        }
-    }
+    return generateBarabasiAlbertGraph(m_0, m, n, Random::seedFromRand());
+}
+
+/*
+ * Barabasi-Albert Model
+ * Starts from a K_m_0 and attaches every new vertex to m distinct vertices chosen with
+ * probability proportional to their degree. The choice is a uniform draw from an array that
+ * holds each vertex once per edge end (m_0 times for the vertices of the K_m_0), so a vertex
+ * costs O(m) and the graph O(n m). The array is also the edge list: past the K_m_0 part it
+ * holds the pairs (target, new vertex) in order, and the graph is built from it at the end.
+ */
+Graph* GraphGenerator::generateBarabasiAlbertGraph(
+    unsigned int m_0, unsigned int m, unsigned int n, std::uint64_t seed)
+{
+    Random rng(seed);
+    n = std::max(n, m_0);
 
     // Fill the array with k apparitions of each vertex where k is the degree of the vertex
     std::vector<unsigned int> vertexIndexes;
+    vertexIndexes.reserve((std::size_t)m_0 * m_0 + 2 * (std::size_t)m * (n - m_0));
     for (unsigned int i = 1; i <= m_0; i++)
         for (unsigned int k = 0; k < m_0; k++)
             vertexIndexes.push_back(i);
 
+    // chosenBy[v] == i if v is already a target of vertex i
+    std::vector<unsigned int> chosenBy(n + 1, 0);
+    // vertices in the array; a new vertex cannot have more distinct targets than these
+    unsigned int attachable = m_0;
+
     for (unsigned int i = m_0 + 1; i <= n; i++)
     {
+        if (i % 4096 == 0)
+            JobControl::progress(i, n);
+        const unsigned int targets = std::min(m, attachable);
+        // candidates are drawn from the vertices before i only
+        const std::size_t size = vertexIndexes.size();
         unsigned int k = 0;
-        Vertex* newVertex = new Vertex(i);
-        while (k < m)
+        while (k < targets)
         {
-            unsigned int index = vertexIndexes[rand() % vertexIndexes.size()];
-            Vertex* selectedVertex = graph->getVertexById(index);
-            // It isn't the same vertex and it isn't connected
-            if (index != i && !selectedVertex->isNeighbourOf(newVertex))
+            const unsigned int index = vertexIndexes[rng.below(size)];
+            if (chosenBy[index] != i)
             {
+                chosenBy[index] = i;
                 vertexIndexes.push_back(index);
                 vertexIndexes.push_back(i);
-                graph->addVertex(newVertex);
-                graph->addEdge(selectedVertex, newVertex);
                 k++;
             }
         }
+        if (targets > 0)
+            attachable++;
+    }
+    std::vector<unsigned int>().swap(chosenBy);
+
+    auto graph = new Graph();
+    std::vector<Vertex*> vertices(n + 1);
+    std::vector<unsigned int> degrees(n + 1, 0);
+    for (unsigned int i = 1; i <= m_0; i++)
+        degrees[i] = m_0 - 1;
+    for (std::size_t e = (std::size_t)m_0 * m_0; e < vertexIndexes.size(); e += 2)
+    {
+        degrees[vertexIndexes[e]]++;
+        degrees[vertexIndexes[e + 1]]++;
+    }
+    for (unsigned int i = 1; i <= n; i++)
+    {
+        vertices[i] = new Vertex(i);
+        vertices[i]->reserveEdges(degrees[i]);
+        graph->addVertex(vertices[i]);
     }
-    vertexIndexes.clear();
+
+    // The K_m_0 graph
+    for (unsigned int i = 1; i < m_0; i++)
+        for (unsigned int j = i + 1; j <= m_0; j++)
+            graph->addEdgeUnchecked(vertices[i], vertices[j]);
+
+    for (std::size_t e = (std::size_t)m_0 * m_0; e < vertexIndexes.size(); e += 2)
+        graph->addEdgeUnchecked(vertices[vertexIndexes[e]], vertices[vertexIndexes[e + 1]]);
+
     return graph;
 }
 
@@ -178,235 +474,411 @@ Graph* GraphGenerator::generateBarabasiAlbertGraph(unsigned int m_0, unsigned in
  * Step 4) A new root is chosen with probability dependant on the node degree every t rounds.
  * */
 
+/*
+ * State of the HOT model while it grows: the vertices, their positions in the unit square, a
+ * grid over the square to find nearby vertices, the pairs of vertices closer than closeRadius
+ * sorted by distance, and the hop distance of every vertex to the root. The distances are kept
+ * up to date as edges are added, by relaxing only the vertices that get closer, and recomputed
+ * with a BFS only when the root changes. countBelow sizes the subtrees of a BFS tree of them.
+ */
+struct GraphGenerator::HotModel
+{
+    static const unsigned int Unreachable = UINT_MAX;
+
+    HotModel(Graph* graph, unsigned int n, std::uint64_t seed)
+        : graph(graph),
+          rng(seed),
+          root(1),
+          // about 25 n close pairs once the n vertices are in
+          closeRadius(std::min(1.5, 4 / std::sqrt(std::max(n, 1u)))),
+          cells((unsigned int)std::max(1.0, std::sqrt(n / 2.0))),
+          grid(cells * cells)
+    {
+        vertices.reserve(n + 1);
+        positions.reserve(n + 1);
+        hops.reserve(n + 1);
+        // vertex ids start at 1
+        vertices.push_back(nullptr);
+        positions.push_back(Position());
+        hops.push_back(Unreachable);
+    }
+
+    // adds the next vertex at a random position
+    void addVertex()
+    {
+        const unsigned int id = vertices.size();
+        vertices.push_back(new Vertex(id));
+        graph->addVertex(vertices.back());
+
+        Position position;
+        position.x = (float)rng.uniform();
+        position.y = (float)rng.uniform();
+        positions.push_back(position);
+        grid[cell(position.y) * cells + cell(position.x)].push_back(id);
+
+        forEachNear(id, closeRadius, [&](unsigned int j) {
+            const float d = distance(j, id);
+            if (j != id && d < closeRadius)
+                closePairs.insert(std::make_tuple(d, j, id));
+        });
+
+        hops.push_back(id == root ? 0 : Unreachable);
+    }
+
+    // adds the edge and brings closer to the root the vertices it gives a shorter path
+    void addEdge(unsigned int j, unsigned int k)
+    {
+        graph->addEdgeUnchecked(vertices[j], vertices[k]);
+        vertexIndexes.push_back(j);
+        vertexIndexes.push_back(k);
+
+        if (hops[j] != Unreachable && hops[j] + 1 < hops[k])
+            relax(k, hops[j] + 1);
+        else if (hops[k] != Unreachable && hops[k] + 1 < hops[j])
+            relax(j, hops[k] + 1);
+    }
+
+    void setRoot(unsigned int newRoot)
+    {
+        if (newRoot == root)
+            return;
+        root = newRoot;
+        std::fill(hops.begin(), hops.end(), Unreachable);
+        relax(root, 0);
+    }
+
+    float distance(unsigned int j, unsigned int k) const
+    {
+        return sqrt(
+            pow(positions[j].x - positions[k].x, 2) + pow(positions[j].y - positions[k].y, 2));
+    }
+
+    // hops the farther of j and k would get closer to the root with the edge (j, k)
+    unsigned int closer(unsigned int j, unsigned int k) const
+    {
+        if (hops[j] == Unreachable || hops[k] == Unreachable)
+            return 0;
+        const unsigned int difference = std::max(hops[j], hops[k]) - std::min(hops[j], hops[k]);
+        return difference > 0 ? difference - 1 : 0;
+    }
+
+    /*
+     * Hops to the root saved with the edge (j, k) by the farther of j and k and by the vertices
+     * below it in the BFS tree, as of the last countBelow: each of them gets closer(j, k) hops
+     * closer. Vertices that reach the root some other way may save hops too; they are left
+     * out, as finding them takes a relaxation for every candidate edge.
+     */
+    unsigned long long saved(unsigned int j, unsigned int k) const
+    {
+        const unsigned int farther = hops[j] < hops[k] ? k : j;
+        return (unsigned long long)closer(j, k) * below[farther];
+    }
+
+    /*
+     * Sets below[v] to the number of vertices whose path to the root in a BFS tree goes
+     * through v, v included. Every vertex takes as parent its first neighbour one hop closer.
+     */
+    void countBelow()
+    {
+        const unsigned int n = vertices.size() - 1;
+        unsigned int maxHops = 0;
+        for (unsigned int v = 1; v <= n; v++)
+            if (hops[v] != Unreachable)
+                maxHops = std::max(maxHops, hops[v]);
+
+        // reachable vertices by decreasing hops, so a vertex is counted before its parent
+        std::vector<unsigned int> start(maxHops + 2, 0);
+        for (unsigned int v = 1; v <= n; v++)
+            if (hops[v] != Unreachable)
+                start[maxHops - hops[v] + 1]++;
+        for (unsigned int h = 1; h <= maxHops + 1; h++)
+            start[h] += start[h - 1];
+        std::vector<unsigned int> order(start.back());
+        for (unsigned int v = 1; v <= n; v++)
+            if (hops[v] != Unreachable)
+                order[start[maxHops - hops[v]]++] = v;
+
+        below.assign(n + 1, 1);
+        for (unsigned int v : order)
+        {
+            if (hops[v] == 0)
+                continue;
+            auto it = vertices[v]->neighborsIterator();
+            while (!it.end() && hops[(*it)->getVertexId()] + 1 != hops[v])
+                ++it;
+            if (!it.end())
+                below[(*it)->getVertexId()] += below[v];
+        }
+    }
+
+    bool adjacent(unsigned int j, unsigned int k) const
+    {
+        return vertices[j]->degree() < vertices[k]->degree()
+                   ? vertices[j]->isNeighbourOf(vertices[k])
+                   : vertices[k]->isNeighbourOf(vertices[j]);
+    }
+
+    /*
+     * Calls visit(j) for every vertex j in the grid cells that meet the square of side
+     * 2 * radius centered at vertex k. radius may be infinite.
+     */
+    template <class Visit>
+    void forEachNear(unsigned int k, double radius, Visit visit) const
+    {
+        const unsigned int left = cell(std::max(0.0, positions[k].x - radius));
+        const unsigned int right = cell(std::min(1.0, positions[k].x + radius));
+        const unsigned int bottom = cell(std::max(0.0, positions[k].y - radius));
+        const unsigned int top = cell(std::min(1.0, positions[k].y + radius));
+        for (unsigned int y = bottom; y <= top; y++)
+            for (unsigned int x = left; x <= right; x++)
+                for (unsigned int j : grid[y * cells + x])
+                    visit(j);
+    }
+
+    Graph* graph;
+    Random rng;
+    std::vector<Vertex*> vertices;
+    std::vector<Position> positions;
+    // hops[v]: hop distance from v to the root
+    std::vector<unsigned int> hops;
+    // below[v]: vertices that reach the root through v in a BFS tree; see countBelow
+    std::vector<unsigned int> below;
+    // Every time an edge is added, two entries are added in vertexIndexes, the two indexes of
+    // the nodes joined.
+    std::vector<unsigned int> vertexIndexes;
+    unsigned int root;
+    const double closeRadius;
+    // (distance, j, k), j < k, for the pairs closer than closeRadius not known to be neighbours
+    std::set<std::tuple<float, unsigned int, unsigned int>> closePairs;
+
+private:
+    unsigned int cell(double coordinate) const
+    {
+        return std::min(cells - 1, (unsigned int)(coordinate * cells));
+    }
+
+    // BFS from source that only lowers distances, starting with hops[source] = distance
+    void relax(unsigned int source, unsigned int distance)
+    {
+        std::queue<unsigned int> queue;
+        hops[source] = distance;
+        queue.push(source);
+        while (!queue.empty())
+        {
+            const unsigned int v = queue.front();
+            queue.pop();
+            auto it = vertices[v]->neighborsIterator();
+            while (!it.end())
+            {
+                const unsigned int w = (*it)->getVertexId();
+                if (hops[v] + 1 < hops[w])
+                {
+                    hops[w] = hops[v] + 1;
+                    queue.push(w);
+                }
+                ++it;
+            }
+        }
+    }
+
+    const unsigned int cells;
+    // vertices by grid cell, row major
+    std::vector<std::vector<unsigned int>> grid;
+};
+
+const unsigned int GraphGenerator::HotModel::Unreachable;
+
 Graph* GraphGenerator::generateHotExtendedGraph(
     unsigned int m, unsigned int n, float xi, unsigned int q, float r, unsigned int t)
 {
-    auto graph = new Graph();
+    return generateHotExtendedGraph(m, n, xi, q, r, t, Random::seedFromRand());
+}
 
-    // Every time an edge is added, two entries are added in vertexIndexes, the two indexes of the
-    // nodes joined.
-    std::vector<unsigned int> vertexIndexes;
-    unsigned int root = 1;
+Graph* GraphGenerator::generateHotExtendedGraph(
+    unsigned int m, unsigned int n, float xi, unsigned int q, float r, unsigned int t,
+    std::uint64_t seed)
+{
+    std::unique_ptr<Graph> graph(new Graph());
+    HotModel model(graph.get(), n, seed);
 
-    vertexesPositions.clear();
     // Firts vertex
 
     // Step 1
 
-    addOriginalVertex(graph);
+    addOriginalVertex(model);
 
     // For each of the nodes we will be adding to the graph
     for (unsigned int i = 2; i <= n; i++)
     {
+        JobControl::progress(i, n);
+
         // Step 2
 
-        addFKPNode(i, graph, root, xi, &vertexIndexes, m);
+        addFKPNode(model, i, xi, m);
 
         // Step 3
 
-        addExtendedEdges(q, i, graph, root, r, &vertexIndexes);
+        addExtendedEdges(model, q, i, r);
 
         // Step 4
 
-        root = chooseNewRoot(i, t, root, vertexIndexes);
+        model.setRoot(chooseNewRoot(model, i, t));
     }
-    return graph;
+    return graph.release();
 }
 
 /**
         The main Vertex is created, added to the graph and a position is generated
 */
-void GraphGenerator::addOriginalVertex(Graph* graph)
+void GraphGenerator::addOriginalVertex(HotModel& model)
 {
-    Vertex* newVertex = new Vertex(1);
-    graph->addVertex(newVertex);
-    addVertexPosition();
+    model.addVertex();
 }
 
 /**
-        A new vertex is created and added. Then m edges are added according to the original FKP
-   function
-
-        TODO: Optimize this function using Voronoi Diagrams
+        A new vertex is created and added. Then it is joined to the m vertices with the lowest
+   w = euclidean distance to the new vertex + xi * hops to the root
 */
-void GraphGenerator::addFKPNode(
-    unsigned int vertexIndex,
-    Graph* graph,
-    unsigned int root,
-    float xi,
-    std::vector<unsigned int>* vertexIndexes,
-    unsigned int m)
+void GraphGenerator::addFKPNode(HotModel& model, unsigned int vertexIndex, float xi, unsigned int m)
 {
-    std::map<float, unsigned int> distance;
-
     // Creation of vertex
-    Vertex* newVertex = new Vertex(vertexIndex);
-    graph->addVertex(newVertex);
-    addVertexPosition();
+    model.addVertex();
 
+    std::vector<std::pair<double, unsigned int>> distance;
+    distance.reserve(vertexIndex - 1);
     for (unsigned int j = 1; j < vertexIndex; j++)
     {  // this for evaluated "w" for each vertex already in the graph
-        unsigned hopsDistance = graph->hops(
-            graph->getVertexById(j),
-            graph->getVertexById(root));  // distance between vertex evaluated and root vertex
-        float euclidianDistance = distanceBetweenVertex(
-            j, vertexIndex);  // Distance between vertex evaluated and new vertex
-
-        // Original FKP Algorithm chooses a new connection between the new vertex and the one with
-        // minimum W
-
-        float w = euclidianDistance + xi * hopsDistance;
-        distance[w] = j;  // stores 'w' as key of a map
-    }
-    addEdges(
-        graph, newVertex, distance, m,
-        vertexIndexes);  // m edges are added acording to the minimum distances
-    distance.clear();
+        const double w = model.distance(j, vertexIndex) + (double)xi * model.hops[j];
+        distance.push_back(std::make_pair(w, j));
+    }
+
+    // m edges are added acording to the minimum distances
+    const std::size_t edges = std::min<std::size_t>(m, distance.size());
+    std::partial_sort(distance.begin(), distance.begin() + edges, distance.end());
+    for (std::size_t k = 0; k < edges; k++)
+        model.addEdge(distance[k].second, vertexIndex);
 }
 
 /**
-        q edges are added according to the function in the paper
-
-        TODO: Optimize the complexity of the algorithm using Voronoi diagrams.
+        q edges are added according to the function in the paper: each one joins the pair of
+   vertices (j, k) that are not neighbours with the lowest
+   w = euclidean distance - (r / vertexIndex) * (hops to the root saved with the edge).
+   The saving is that of the farther endpoint and of the vertices below it in a BFS tree, see
+   HotModel::saved. It is at most reach[k] = (hops(k) - 1) * below(k) for the farther
+   endpoint k, so only pairs closer than the best w plus that much can win: the close pairs are
+   scanned in order of distance, and farther pairs are looked up through the grid, from their
+   farther endpoint, only when they may still win.
 */
 void GraphGenerator::addExtendedEdges(
-    unsigned int q,
-    unsigned int vertexIndex,
-    Graph* graph,
-    unsigned int root,
-    float r,
-    std::vector<unsigned int>* vertexIndexes)
+    HotModel& model, unsigned int q, unsigned int vertexIndex, float r)
 {
+    const double weight = (double)r / vertexIndex;
+
     // We will go through this function q times, adding q edges
     for (unsigned int qfinal = 0; qfinal < q; qfinal++)
     {
+        model.countBelow();
+        // reach[k]: the most hops an edge from k can save, when k is the farther endpoint
+        std::vector<unsigned long long> reach(vertexIndex + 1, 0);
+        unsigned long long maxReach = 0;
+        for (unsigned int k = 1; k <= vertexIndex; k++)
+        {
+            const unsigned int hk = model.hops[k];
+            if (hk != HotModel::Unreachable && hk > 1)
+                reach[k] = (unsigned long long)(hk - 1) * model.below[k];
+            maxReach = std::max(maxReach, reach[k]);
+        }
+        // w is at least the euclidean distance minus this
+        const double slack = weight * maxReach;
+
         // At the end of the loop we only add one edge, so we save the minimum distance and the
         // indexes of the nodes
-        float minDist = 0;
+        double minDist = std::numeric_limits<double>::infinity();
         unsigned int finalJ = 0;
         unsigned int finalK = 0;
-
-        // We loop through every combination of nodes
-        for (unsigned int j = 1; j <= vertexIndex; j++)
+        auto evaluate = [&](unsigned int j, unsigned int k, double euclidianDistance) {
+            const double w = euclidianDistance - weight * model.saved(j, k);
+            // We save only the minimum
+            if (w < minDist && !model.adjacent(j, k))
+            {
+                minDist = w;
+                finalJ = j;
+                finalK = k;
+            }
+        };
+
+        // The close pairs are scanned for the pairs whose farther endpoint saves at most
+        // lightSlack, and the vertices that can save more are looked up through the grid. A
+        // sixteenth of closeRadius keeps both the scanned pairs and those vertices few.
+        const double lightSlack = std::min(slack, model.closeRadius / 16);
+        auto it = model.closePairs.begin();
+        while (it != model.closePairs.end() && std::get<0>(*it) - lightSlack < minDist)
         {
-            for (unsigned int k = 1; k <= vertexIndex; k++)
+            const unsigned int j = std::get<1>(*it);
+            const unsigned int k = std::get<2>(*it);
+            // edges are never removed, so a joined pair is dropped for good
+            if (model.adjacent(j, k))
             {
-                // For each combination of nodes we calculate the function
-                float euclidianDistance = 0;
-                unsigned int HopsWithEdge = 0;
-                unsigned int HopsWithOutEdge = 0;
-                if (k != j && !graph->getVertexById(j)->isNeighbourOf(graph->getVertexById(k)))
-                {
-                    for (unsigned int l = 1; l <= vertexIndex; l++)
-                    {
-                        // We calculate the hops to the root with and without the edge
-                        HopsWithOutEdge =
-                            graph->hops(graph->getVertexById(l), graph->getVertexById(root)) +
-                            HopsWithOutEdge;  // Hops between evaluated vertex and root vertex
-                                              // without new edge
-                        graph->addEdge(
-                            graph->getVertexById(j),
-                            graph->getVertexById(
-                                k));  // Add new edges only for evaluation, later will be removed
-                        HopsWithEdge =
-                            graph->hops(graph->getVertexById(l), graph->getVertexById(root)) +
-                            HopsWithEdge;  // Hops between evaluated vertex and root vertex with new
-                                           // edge
-                        graph->removeEdge(
-                            graph->getVertexById(j),
-                            graph->getVertexById(k));  // remove the edge previously added
-                    }
-
-                    euclidianDistance = distanceBetweenVertex(j, k);
-                    float w =
-                        euclidianDistance + (r / vertexIndex) * (HopsWithEdge - HopsWithOutEdge);
-
-                    // We save only the minimum
-
-                    if (minDist == 0 || w < minDist)
-                    {
-                        minDist = w;
-                        finalJ = j;
-                        finalK = k;
-                    }
-                }
+                it = model.closePairs.erase(it);
+                continue;
             }
+            evaluate(j, k, std::get<0>(*it));
+            ++it;
         }
 
-        // Finally, we add a new edge
-
-        if (minDist != 0)
+        // when the close pairs are not enough every vertex is looked up
+        const bool all = minDist + lightSlack > model.closeRadius;
+        for (unsigned int k = 1; k <= vertexIndex; k++)
         {
-            vertexIndexes->push_back(finalJ);
-            vertexIndexes->push_back(finalK);
-            graph->addEdge(graph->getVertexById(finalJ), graph->getVertexById(finalK));
+            const double slackK = weight * reach[k];
+            if (!all && slackK <= lightSlack)
+                continue;
+            model.forEachNear(k, minDist + slackK, [&](unsigned int j) {
+                // a pair is looked up from its farther endpoint, or from the larger index
+                // when neither is farther
+                const unsigned int hj = model.hops[j];
+                const unsigned int hk = model.hops[k];
+                if (hj > hk || (hj == hk && j >= k))
+                    return;
+                const float euclidianDistance = model.distance(j, k);
+                if (euclidianDistance - slackK < minDist)
+                    evaluate(std::min(j, k), std::max(j, k), euclidianDistance);
+            });
         }
+
+        // Finally, we add a new edge
+        if (finalJ != 0)
+            model.addEdge(finalJ, finalK);
     }
 }
 
 /**
         A new root is choosen according to the parameter t and the indexes distribution
 */
-int GraphGenerator::chooseNewRoot(
-    unsigned int vertexIndex,
-    unsigned int t,
-    unsigned int root,
-    std::vector<unsigned int> vertexIndexes)
+unsigned int GraphGenerator::chooseNewRoot(
+    HotModel& model, unsigned int vertexIndex, unsigned int t)
 {
-    if ((vertexIndex - 1) % t == 0)
+    if (t > 0 && (vertexIndex - 1) % t == 0 && !model.vertexIndexes.empty())
     {
-        return vertexIndexes[rand() % vertexIndexes.size()];
+        return model.vertexIndexes[model.rng.below(model.vertexIndexes.size())];
     }
-    return root;
+    return model.root;
 }
 
-void GraphGenerator::addEdges(
-    Graph* graph,
-    Vertex* vertex,
-    std::map<float, unsigned int> distance,
-    unsigned int q,
-    std::vector<unsigned int>* vertexIndexes)
+Graph* GraphGenerator::generateMolloyReedGraph(std::string path, bool giantComponent)
 {
-    for (unsigned int k = 0; k < q && !distance.empty(); k++)
-    {  // Adding "q" new edges. The processes is similar to added vertex.
-        if (!graph->getVertexById(distance.begin()->second)->isNeighbourOf(vertex))
-        {
-            vertexIndexes->push_back(distance.begin()->second);
-            vertexIndexes->push_back(vertex->getVertexId());
-            graph->addEdge(graph->getVertexById(distance.begin()->second), vertex);
-            distance.erase(distance.begin());  // Remove the lowest value of w from the list,
-                                               // because was used previously. This process repeat
-                                               // "q" times.
-            if (distance.empty())
-                break;
-        }
-    }
+    return generateMolloyReedGraph(path, giantComponent, Random::seedFromRand());
 }
 
-float GraphGenerator::distanceBetweenVertex(unsigned int vertex1Id, unsigned int vertex2Id)
+Graph* GraphGenerator::generateMolloyReedGraph(
+    std::string path, bool giantComponent, std::uint64_t seed)
 {
-    return sqrt(
-        pow(vertexesPositions[vertex1Id - 1].x - vertexesPositions[vertex2Id - 1].x, 2) +
-        pow(vertexesPositions[vertex1Id - 1].y - vertexesPositions[vertex2Id - 1].y, 2));
-}
-
-void GraphGenerator::addVertexPosition()
-{
-    vertexesPositions.push_back(Position());
-    vertexesPositions.back().x = (float)rand() / RAND_MAX;
-    vertexesPositions.back().y = (float)rand() / RAND_MAX;
-}
-
-Graph* GraphGenerator::generateMolloyReedGraph(std::string path)
-{
-    Graph* graph = new Graph(false, false);
+    std::unique_ptr<Graph> graph(new Graph(false, false));
 
-    auto reader = new MolloyReedGraphReader<Graph, Vertex>();
-    reader->read(*graph, path);
-
-    delete reader;
+    MolloyReedGraphReader<Graph, Vertex> reader(seed, giantComponent);
+    reader.read(*graph, path);
 
-    return graph;
+    return graph.release();
 }
 
 /*
@@ -415,22 +887,22 @@ Graph* GraphGenerator::generateMolloyReedGraph(std::string path)
 
 inline double GraphGenerator::hiperbolicDistance(PolarPosition p1, PolarPosition p2)
 {
-    return acosh(
-        cosh(p1.r) * cosh(p2.r) -
-        sinh(p1.r) * sinh(p2.r) * cos(fmod(abs(p1.theta - p2.theta), PI)));
+    // angle between the points, in [0, pi]
+    const double angle = PI - std::fabs(PI - std::fabs(p1.theta - p2.theta));
+    return acosh(cosh(p1.r) * cosh(p2.r) - sinh(p1.r) * sinh(p2.r) * cos(angle));
 }
 
 /*
  * Computes random polar hyperbolic coordinates
  */
 inline GraphGenerator::PolarPosition GraphGenerator::getRandomHyperbolicCoordinates(
-    float a, double maxr)
+    Random& rng, float a, double maxr)
 {
     PolarPosition pos;
-    // generate theta in [0, 2pi]
-    pos.theta = ((double)rand() / (double)RAND_MAX) * 2 * PI;
-    // select a radius in (0, r)
-    double u = ((double)rand() / (double)RAND_MAX);
+    // generate theta in [0, 2pi)
+    pos.theta = rng.uniform() * 2 * PI;
+    // select a radius in [0, r)
+    double u = rng.uniform();
     pos.r = acosh(u * (cosh(maxr * a) - 1) + 1) / a;
     return pos;
 }
@@ -458,35 +930,76 @@ double GraphGenerator::getExpectedAvgNodeDeg(unsigned int i, float fa, float fc)
  * n is the total nodes number
  * a is the radial density of the graph.
  * c is the a parameter that determines the average degree of the graph.
+ * threads is the number of threads used to find the edges; 0 uses the hardware concurrency.
+ *
+ * Vertex i is placed in the disk of radius getMaxRadius(i) and joined to every previous vertex
+ * closer than that radius; a position that leaves it isolated is drawn again. Points are kept
+ * in HyperbolicBands, so only the arcs that can hold a neighbour are examined: positions are
+ * drawn in order, since each one depends on the previous ones, and the edges are then looked
+ * up for all the vertices in parallel.
  * */
-Graph* GraphGenerator::generateHiperbolicGraph(unsigned int n, float a, float c)
+Graph* GraphGenerator::generateHiperbolicGraph(
+    unsigned int n, float a, float c, unsigned int threads)
 {
-    Graph* graph = new Graph(false, false);
-    std::vector<PolarPosition> vPolarPos;
-    PolarPosition sentinel;
-    vPolarPos.push_back(sentinel);
+    return generateHiperbolicGraph(n, a, c, threads, Random::seedFromRand());
+}
+
+Graph* GraphGenerator::generateHiperbolicGraph(
+    unsigned int n, float a, float c, unsigned int threads, std::uint64_t seed)
+{
+    Random rng(seed);
+    std::vector<PolarPosition> vPolarPos(n + 1);
+    HyperbolicBands<GrowingBand> bands(getMaxRadius(n, a, c), a);
+
     for (unsigned int i = 1; i <= n; i++)
     {
-        Vertex* src = new Vertex(i);
-        graph->addVertex(src);
+        if (i % 1024 == 0)
+            JobControl::progress(i, n);
         // compute the current disk radius
-        double maxr = getMaxRadius(i, a, c);
-        bool hasNeighbours = false;
+        const double maxr = getMaxRadius(i, a, c);
         PolarPosition pos;
+        bool hasNeighbours = false;
         do
         {
-            pos = getRandomHyperbolicCoordinates(a, maxr);
-            for (unsigned int j = 1; j < i; j++)
-            {
-                PolarPosition other = vPolarPos[j];
-                if (hiperbolicDistance(pos, other) < maxr)
-                {
-                    hasNeighbours = true;
-                    graph->addEdge(src, graph->getVertexById(j));
-                }
-            }
+            pos = getRandomHyperbolicCoordinates(rng, a, maxr);
+            hasNeighbours = bands.forEachCandidate(pos.r, pos.theta, maxr, [&](unsigned int j) {
+                return hiperbolicDistance(pos, vPolarPos[j]) < maxr;
+            });
         } while (!hasNeighbours && i != 1);
-        vPolarPos.push_back(pos);
+        vPolarPos[i] = pos;
+        bands.insert(i, pos.r, pos.theta);
+    }
+
+    // previous[i]: the vertices before i closer than its disk radius. Vertices are taken by
+    // angle, so consecutive queries search nearby parts of the bands.
+    const HyperbolicBands<SortedBand> sorted(bands);
+    std::vector<unsigned int> byAngle(n);
+    for (unsigned int i = 0; i < n; i++)
+        byAngle[i] = i + 1;
+    std::sort(byAngle.begin(), byAngle.end(), [&](unsigned int i, unsigned int j) {
+        return vPolarPos[i].theta < vPolarPos[j].theta;
+    });
+    std::vector<std::vector<unsigned int>> previous(n + 1);
+    parallelFor(n, workerCount(threads, n), [&](unsigned int, std::size_t item) {
+        const unsigned int i = byAngle[item];
+        const double maxr = getMaxRadius(i, a, c);
+        sorted.forEachCandidate(vPolarPos[i].r, vPolarPos[i].theta, maxr, [&](unsigned int j) {
+            if (j < i && hiperbolicDistance(vPolarPos[i], vPolarPos[j]) < maxr)
+                previous[i].push_back(j);
+            return false;
+        });
+        std::sort(previous[i].begin(), previous[i].end());
+    });
+
+    Graph* graph = new Graph(false, false);
+    std::vector<Vertex*> vertices(n + 1);
+    for (unsigned int i = 1; i <= n; i++)
+    {
+        vertices[i] = new Vertex(i);
+        graph->addVertex(vertices[i]);
+        for (unsigned int j : previous[i])
+            graph->addEdgeUnchecked(vertices[i], vertices[j]);
+        std::vector<unsigned int>().swap(previous[i]);
     }
     return graph;
 }
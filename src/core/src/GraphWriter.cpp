@@ -3,118 +3,183 @@
 // Last modification: December 19th, 2012.
 
 #include <fstream>
+#include <unordered_map>
+#include <vector>
 
 #include "AdjacencyListGraph.h"
+#include "BufferedOutput.h"
+#include "GraphSnapshot.h"
 #include "GraphWriter.h"
 
 using namespace graphpp;
 
-bool GraphWriter::vertexWasVisited(unsigned int vertexId)
+namespace
 {
-    std::list<unsigned int>::iterator it =
-        find(this->visitedVertexes.begin(), this->visitedVertexes.end(), vertexId);
-    return it != this->visitedVertexes.end();
-}
-
-void GraphWriter::writeGraph(Graph *graph, std::string outputPath)
+/**
+ * Method: writeEdgeList
+ * ---------------------
+ * Description: writes graph as an edge list, "source destination" per line. Directed graphs
+ * write every arc. Undirected graphs write each edge from its end with the lower id, so an
+ * edge is written once without remembering the vertices already written; a loop is twice in
+ * the list of its vertex and is written for every second occurrence. writeWeight(file,
+ * vertex, position) appends whatever follows the destination of the position-th neighbour.
+ */
+template <class G, class V, class WriteWeight>
+void writeEdgeList(G *graph, const std::string &outputPath, WriteWeight writeWeight)
 {
-    std::ofstream destinationFile;
-    destinationFile.open(outputPath.c_str(), std::ios_base::out);
-
-    this->visitedVertexes.clear();
+    BufferedOutput destinationFile(outputPath);
+    const bool directed = graph->isDigraph();
 
     auto verticesIterator = graph->verticesIterator();
-
     while (!verticesIterator.end())
     {
-        Vertex *vertex = *verticesIterator;
+        V *vertex = *verticesIterator;
+        const unsigned int vertexId = vertex->getVertexId();
+        bool skipLoop = false;
 
         auto neighborsIterator = vertex->neighborsIterator();
-
-        while (!neighborsIterator.end())
+        for (std::size_t position = 0; !neighborsIterator.end(); ++neighborsIterator, ++position)
         {
-            Vertex *neighbor = *neighborsIterator;
-
-            if (!vertexWasVisited(neighbor->getVertexId()))
+            const unsigned int neighbourId = (*neighborsIterator)->getVertexId();
+            if (!directed && neighbourId <= vertexId)
             {
-                destinationFile << vertex->getVertexId() << " " << neighbor->getVertexId()
-                                << std::endl;
+                if (neighbourId < vertexId)
+                    continue;
+                skipLoop = !skipLoop;
+                if (!skipLoop)
+                    continue;
             }
 
-            neighborsIterator++;
+            destinationFile << vertexId << ' ' << neighbourId;
+            writeWeight(destinationFile, vertex, position);
+            destinationFile << '\n';
         }
 
-        this->visitedVertexes.push_back(vertex->getVertexId());
-        verticesIterator++;
+        ++verticesIterator;
     }
-
-    destinationFile.close();
 }
 
-// FIXME This should not have to be a separate method. writeGraph should be able to write
-// DirectedGraphs. Currently not able to convert/cast DirectedGraph to Graph (DONT KNOW WHY :()
-void GraphWriter::writeDirectedGraph(DirectedGraph *graph, std::string outputPath)
+void writeNoWeight(BufferedOutput &, const void *, std::size_t)
 {
-    std::ofstream destinationFile;
-    destinationFile.open(outputPath.c_str(), std::ios_base::out);
+}
 
-    this->visitedVertexes.clear();
+void writeBuffer(std::ofstream &destinationFile, std::vector<char> &buffer)
+{
+    destinationFile.write(buffer.data(), buffer.size());
+    buffer.clear();
+}
 
+/**
+ * Method: writeSnapshot
+ * ---------------------
+ * Description: writes graph in the GraphSnapshot layout, one section at a time.
+ * appendWeights(vertex, buffer) appends the weights of the neighbour list of vertex, for
+ * weighted graphs.
+ */
+template <class G, class V, class AppendWeights>
+void writeSnapshot(
+    G *graph, const std::string &outputPath, std::uint32_t flags, AppendWeights appendWeights)
+{
+    std::vector<V *> vertices;
+    std::unordered_map<const V *, GraphSnapshot::Id> positions;
+    std::uint64_t entries = 0;
     auto verticesIterator = graph->verticesIterator();
-
     while (!verticesIterator.end())
     {
-        Vertex *vertex = *verticesIterator;
+        positions[*verticesIterator] = vertices.size();
+        vertices.push_back(*verticesIterator);
+        entries += (*verticesIterator)->degree();
+        ++verticesIterator;
+    }
 
-        auto neighborsIterator = vertex->neighborsIterator();
+    if (graph->isDigraph())
+        flags |= GraphSnapshot::FlagDirected;
+    if (graph->isMultigraph())
+        flags |= GraphSnapshot::FlagMultigraph;
 
-        while (!neighborsIterator.end())
-        {
-            Vertex *neighbor = *neighborsIterator;
+    std::ofstream destinationFile;
+    destinationFile.open(outputPath.c_str(), std::ios_base::out | std::ios_base::binary);
 
-            if (!vertexWasVisited(neighbor->getVertexId()))
-            {
-                destinationFile << vertex->getVertexId() << " " << neighbor->getVertexId()
-                                << std::endl;
-            }
+    std::vector<char> buffer = GraphSnapshot::header(flags, vertices.size(), entries);
+    GraphSnapshot::Offset offset = 0;
+    GraphSnapshot::append(buffer, offset);
+    for (const V *vertex : vertices)
+    {
+        offset += vertex->degree();
+        GraphSnapshot::append(buffer, offset);
+    }
+    writeBuffer(destinationFile, buffer);
 
-            neighborsIterator++;
+    for (const V *vertex : vertices)
+        GraphSnapshot::append<GraphSnapshot::Id>(buffer, vertex->getVertexId());
+    writeBuffer(destinationFile, buffer);
+
+    for (V *vertex : vertices)
+    {
+        auto neighborsIterator = vertex->neighborsIterator();
+        while (!neighborsIterator.end())
+        {
+            GraphSnapshot::append(buffer, positions[static_cast<const V *>(*neighborsIterator)]);
+            ++neighborsIterator;
         }
+    }
+    buffer.resize(buffer.size() + GraphSnapshot::padding(vertices.size(), entries), 0);
+    writeBuffer(destinationFile, buffer);
 
-        this->visitedVertexes.push_back(vertex->getVertexId());
-        verticesIterator++;
+    if ((flags & GraphSnapshot::FlagWeighted) != 0)
+    {
+        for (V *vertex : vertices)
+            appendWeights(vertex, buffer);
+        writeBuffer(destinationFile, buffer);
     }
 
     destinationFile.close();
 }
 
-void GraphWriter::writeWeightedGraph(WeightedGraph *weightedGraph, std::string outputPath)
+void appendNoWeights(const void *, std::vector<char> &)
 {
-    std::ofstream destinationFile;
-    destinationFile.open(outputPath.c_str(), std::ios_base::out);
+}
+}  // namespace
 
-    auto verticesIterator = weightedGraph->verticesIterator();
+void GraphWriter::writeGraph(Graph *graph, std::string outputPath)
+{
+    writeEdgeList<Graph, Vertex>(graph, outputPath, writeNoWeight);
+}
 
-    while (!verticesIterator.end())
-    {
-        WeightedVertex *vertex = *verticesIterator;
+void GraphWriter::writeDirectedGraph(DirectedGraph *graph, std::string outputPath)
+{
+    writeEdgeList<DirectedGraph, DirectedVertex>(graph, outputPath, writeNoWeight);
+}
 
-        auto weightsIterator = vertex->weightsIterator();
+void GraphWriter::writeWeightedGraph(WeightedGraph *weightedGraph, std::string outputPath)
+{
+    writeEdgeList<WeightedGraph, WeightedVertex>(
+        weightedGraph, outputPath,
+        [](BufferedOutput &destinationFile, WeightedVertex *vertex, std::size_t position) {
+            destinationFile << ' ' << vertex->edgeWeightAt(position);
+        });
+}
 
-        while (!weightsIterator.end())
-        {
-            if (!vertexWasVisited(weightsIterator->first))
+void GraphWriter::writeGraphSnapshot(Graph *graph, std::string outputPath)
+{
+    writeSnapshot<Graph, Vertex>(graph, outputPath, 0, appendNoWeights);
+}
+
+void GraphWriter::writeWeightedGraphSnapshot(WeightedGraph *weightedGraph, std::string outputPath)
+{
+    writeSnapshot<WeightedGraph, WeightedVertex>(
+        weightedGraph, outputPath, GraphSnapshot::FlagWeighted,
+        [](WeightedVertex *vertex, std::vector<char> &buffer) {
+            auto weightsIterator = vertex->weightsIterator();
+            while (!weightsIterator.end())
             {
-                destinationFile << vertex->getVertexId() << " " << weightsIterator->first << " "
-                                << weightsIterator->second << std::endl;
+                GraphSnapshot::append<GraphSnapshot::Weight>(buffer, *weightsIterator);
+                ++weightsIterator;
             }
+        });
+}
 
-            weightsIterator++;
-        }
-
-        this->visitedVertexes.push_back(vertex->getVertexId());
-        verticesIterator++;
-    }
-
-    destinationFile.close();
+void GraphWriter::writeDirectedGraphSnapshot(DirectedGraph *graph, std::string outputPath)
+{
+    writeSnapshot<DirectedGraph, DirectedVertex>(graph, outputPath, 0, appendNoWeights);
 }
@@ -5,6 +5,8 @@
 #include <fstream>
 #include <ostream>
 #include <string>
+#include "BufferedOutput.h"
+#include "PropertyMap.h"
 #include "mili/mili.h"
 
 namespace ComplexNetsGui
@@ -18,9 +20,8 @@ public:
 
     static void exportPropertySet(const VariantsSet& set, const FilePath& data_path)
     {
-        std::ofstream destinationFile;
+        graphpp::BufferedOutput destinationFile(data_path);
         std::map<double, double> sortedMap;
-        destinationFile.open(data_path.c_str(), std::ios_base::out);
         VariantsSet::const_iterator it = set.begin();
 
         /*
@@ -36,22 +37,23 @@ public:
         std::map<double, double>::const_iterator itSorted = sortedMap.begin();
         while (itSorted != sortedMap.end())
         {
-            destinationFile << itSorted->first << " " << itSorted->second << std::endl;
+            destinationFile << itSorted->first << ' ' << itSorted->second << '\n';
             ++itSorted;
         }
+    }
 
-        destinationFile.close();
+    // same format as exportPropertySet, straight from the numbers and already sorted
+    template <class T>
+    static void exportSeries(const graphpp::PropertySeries<T>& series, const FilePath& data_path)
+    {
+        graphpp::BufferedOutput destinationFile(data_path);
+        for (const auto& entry : series)
+            destinationFile << entry.first << ' ' << double(entry.second) << '\n';
     }
 
     static void exportVectors(
         const std::vector<double> x, const std::vector<double> y, const FilePath& data_path)
     {
-        std::ofstream destinationFile;
-        std::map<double, double> sortedMap;
-        destinationFile.open(data_path.c_str(), std::ios_base::out);
-        std::vector<double>::const_iterator itx = x.begin();
-        std::vector<double>::const_iterator ity = y.begin();
-
         // if length of x != length of y, return error
         if (x.size() != y.size())
         {
@@ -59,14 +61,16 @@ public:
             return;
         }
 
-        while (*itx != *x.end())
+        graphpp::BufferedOutput destinationFile(data_path);
+        std::vector<double>::const_iterator itx = x.begin();
+        std::vector<double>::const_iterator ity = y.begin();
+
+        while (itx != x.end())
         {
-            destinationFile << *ity << " " << *itx << std::endl;
+            destinationFile << *ity << ' ' << *itx << '\n';
             ++itx;
             ++ity;
         }
-
-        destinationFile.close();
     }
 
     static void exportThreeVectors(
@@ -75,22 +79,18 @@ public:
         const std::vector<unsigned int> z,
         const FilePath& data_path)
     {
-        std::ofstream destinationFile;
-        destinationFile.open(data_path.c_str(), std::ios_base::out);
+        graphpp::BufferedOutput destinationFile(data_path);
         std::vector<double>::const_iterator itx = x.begin();
         std::vector<double>::const_iterator ity = y.begin();
         std::vector<unsigned int>::const_iterator itz = z.begin();
 
-        // if length of x != length of y, return error
-        while (*itx != *x.end())
+        while (itx != x.end())
         {
-            destinationFile << *itx << " " << *ity << " " << *itz << std::endl;
+            destinationFile << *itx << ' ' << *ity << ' ' << *itz << '\n';
             ++itx;
             ++ity;
             ++itz;
         }
-
-        destinationFile.close();
     }
 
     static void exportFourVectors(
@@ -100,24 +100,20 @@ public:
         const std::vector<double> z,
         const FilePath& data_path)
     {
-        std::ofstream destinationFile;
-        destinationFile.open(data_path.c_str(), std::ios_base::out);
+        graphpp::BufferedOutput destinationFile(data_path);
         std::vector<double>::const_iterator itw = w.begin();
         std::vector<double>::const_iterator itx = x.begin();
         std::vector<double>::const_iterator ity = y.begin();
         std::vector<double>::const_iterator itz = z.begin();
 
-        // if length of x != length of y, return error
-        while (*itx != *x.end())
+        while (itx != x.end())
         {
-            destinationFile << *itw << " " << *itx << " " << *ity << " " << *itz << std::endl;
+            destinationFile << *itw << ' ' << *itx << ' ' << *ity << ' ' << *itz << '\n';
             ++itw;
             ++itx;
             ++ity;
             ++itz;
         }
-
-        destinationFile.close();
     }
 };
 }  // namespace ComplexNetsGui
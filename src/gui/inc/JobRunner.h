@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+#include <functional>
+#include <memory>
+
+#include "JobControl.h"
+
+namespace ComplexNetsGui
+{
+/**
+ * Class: JobRunner
+ * ----------------
+ * Description: runs one long computation at a time on a worker thread, so that the window
+ * keeps repainting and can cancel it. The work runs under a graphpp::JobControl: cancel makes
+ * the next checkpoint of the core loops throw, and the progress of the current stage is polled
+ * and sent through jobProgress. The work must not touch widgets; it leaves its results where
+ * the done callback, which runs on the thread of the runner once the work is over, picks them
+ * up. Exactly one of jobFinished (followed by done), jobCancelled or jobFailed is emitted per
+ * job, after the runner is idle again, so done may start the next job.
+ */
+class JobRunner : public QObject
+{
+    Q_OBJECT
+public:
+    typedef std::function<void()> Work;
+    typedef std::function<void()> Done;
+
+    JobRunner(QObject* parent = nullptr);
+    // cancels the running job, if any, and waits for it
+    ~JobRunner();
+
+    /**
+     * Method: start
+     * -------------
+     * Description: starts running work on a worker thread
+     * @param title what the job does, e.g. "Computing betweenness"
+     * @returns false, without running anything, if another job is running
+     */
+    bool start(const QString& title, Work work, Done done);
+    bool busy() const;
+
+public slots:
+    void cancel();
+
+signals:
+    void jobStarted(const QString& title);
+    // percent of the current stage of the job
+    void jobProgress(int percent);
+    void jobFinished(const QString& title);
+    void jobCancelled(const QString& title);
+    void jobFailed(const QString& title, const QString& message);
+
+private slots:
+    void pollProgress();
+    void workerFinished();
+
+private:
+    class Worker;
+
+    Worker* worker = nullptr;
+    std::unique_ptr<graphpp::JobControl> job;
+    QString title;
+    Done done;
+    QTimer timer;
+};
+}  // namespace ComplexNetsGui
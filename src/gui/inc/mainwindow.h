@@ -5,6 +5,8 @@
 #pragma once
 
 #include <QtCore/QEvent>
+#include <cstdint>
+#include <functional>
 #include <QMainWindow>
 #include "GnuplotConsole.h"
 #include "mili/mili.h"
@@ -15,6 +17,7 @@
 #include "DirectedVertexAspect.h"
 #include "GraphWriter.h"
 #include "IGraphFactory.h"
+#include "MetricCache.h"
 #include "PropertyMap.h"
 #include "WeightedGraphAspect.h"
 #include "WeightedVertexAspect.h"
@@ -22,6 +25,10 @@
 #include "GnuplotConsole.h"
 #include "GrapherUtils.h"
 #include "IShellIndexNode.h"
+#include "JobRunner.h"
+
+class QProgressBar;
+class QPushButton;
 
 namespace Ui
 {
@@ -49,7 +56,8 @@ private:
     bool digraph;
     bool graphLoaded;
     Ui::MainWindow* ui;
-    graphpp::PropertyMap propertyMap;
+    // holds the metrics of the loaded network for its current version, see properties()
+    graphpp::MetricCache metricCache;
 
     graphpp::IGraphFactory<WeightedGraph, WeightedVertex>* weightedFactory = nullptr;
     graphpp::IGraphFactory<Graph, Vertex>* factory = nullptr;
@@ -57,16 +65,25 @@ private:
     Graph graph;
     WeightedGraph weightedGraph;
     DirectedGraph directedGraph;
+    // runs the long computations off the UI thread; declared after the graphs it reads, so it
+    // is destroyed (which cancels and waits for its job) before them
+    JobRunner jobs;
+    QProgressBar* progressBar;
+    QPushButton* cancelButton;
 
     bool directed_out = true;
     bool directed_in = false;
 
+    // the metrics computed on the loaded network, emptied when the network changes
+    graphpp::PropertyMap& properties();
     void computeDegreeDistribution();
     void computeClusteringCoefficient(QString vertexId);
     void computeCumulativeDegreeDistribution();
     void postComputeShellIndex(graphpp::ShellIndexType type, std::string prefix);
-    void computeShellIndex(graphpp::ShellIndexType type, std::string prefix);
-    void computeMaxClique(bool exact);
+    // the compute methods below run as a job and call then once the result is in properties()
+    void computeShellIndex(
+            graphpp::ShellIndexType type, std::string prefix, std::function<void()> then);
+    void computeMaxClique(bool exact, std::function<void()> then);
     void on_actionMaxClique_generic_triggered(bool);
     void on_action_maxClique_plotting_generic_triggered(bool exact);
     void on_actionExportMaxClique_distribution_generic_triggered(bool exact);
@@ -79,7 +96,9 @@ private:
     graphpp::Boxplotentry computeTotalBpEntriesShellIndex(std::string prefix);
 
     //    void computeMaxCliqueExact();
-    void computeBetweenness();
+    void computeBetweenness(std::function<void()> then);
+    void plotShellIndexVsDegree();
+    void plotBetweennessVsDegree();
     int LogBinningDialog();
     int ChooseDigraphDegreeDialog();
     void readGraph(const std::string path);
@@ -93,8 +112,13 @@ private:
     QString inputId(std::string const& label);
     int intInputId(std::string const& label, int defaultNum);
     double doubleInputId(std::string const& label, double defaultNum);
+    std::uint64_t seedInput();
 
 private slots:
+    void onJobStarted(const QString& title);
+    void onJobFinished();
+    void onJobCancelled();
+    void onJobFailed(const QString& title, const QString& message);
     void on_actionExportPowerLawDegreeDistribution_triggered();
     void on_actionExportNearest_Neighbors_Degree_vs_Degree_triggered();
     void on_actionExportShell_Index_vs_Degree_triggered();
@@ -0,0 +1,129 @@
+#include "JobRunner.h"
+
+#include <QtCore/QThread>
+#include <exception>
+
+using namespace ComplexNetsGui;
+
+class JobRunner::Worker : public QThread
+{
+public:
+    Worker(graphpp::JobControl* job, JobRunner::Work work) : job(job), work(std::move(work))
+    {
+    }
+
+    // read once the thread is over
+    bool cancelled = false;
+    bool failed = false;
+    QString error;
+
+protected:
+    void run() override
+    {
+        graphpp::JobControl::Scope scope(job);
+        try
+        {
+            work();
+        }
+        catch (const JobCancelled&)
+        {
+            cancelled = true;
+        }
+        catch (const std::exception& ex)
+        {
+            failed = true;
+            error = QString::fromUtf8(ex.what());
+        }
+        catch (...)
+        {
+            failed = true;
+            error = "Unknown error.";
+        }
+    }
+
+private:
+    graphpp::JobControl* job;
+    JobRunner::Work work;
+};
+
+JobRunner::JobRunner(QObject* parent) : QObject(parent)
+{
+    timer.setInterval(100);
+    QObject::connect(&timer, SIGNAL(timeout()), this, SLOT(pollProgress()));
+}
+
+JobRunner::~JobRunner()
+{
+    if (worker != nullptr)
+    {
+        job->cancel();
+        worker->wait();
+        delete worker;
+    }
+}
+
+bool JobRunner::start(const QString& title, Work work, Done done)
+{
+    if (busy())
+        return false;
+
+    job.reset(new graphpp::JobControl());
+    this->title = title;
+    this->done = std::move(done);
+    worker = new Worker(job.get(), std::move(work));
+    // queued: finished is emitted by the worker thread
+    QObject::connect(worker, SIGNAL(finished()), this, SLOT(workerFinished()));
+
+    emit jobStarted(title);
+    emit jobProgress(0);
+    worker->start();
+    timer.start();
+    return true;
+}
+
+bool JobRunner::busy() const
+{
+    return worker != nullptr;
+}
+
+void JobRunner::cancel()
+{
+    if (job)
+        job->cancel();
+}
+
+void JobRunner::pollProgress()
+{
+    if (job)
+        emit jobProgress(int(job->fraction() * 100));
+}
+
+void JobRunner::workerFinished()
+{
+    timer.stop();
+    // finished is emitted just before the thread ends
+    worker->wait();
+    const bool cancelled = worker->cancelled;
+    const bool failed = worker->failed;
+    const QString error = worker->error;
+    worker->deleteLater();
+    worker = nullptr;
+    job.reset();
+
+    // idle again before anyone hears of it
+    const QString finishedTitle = title;
+    Done finishedDone = std::move(done);
+    done = nullptr;
+
+    if (cancelled)
+        emit jobCancelled(finishedTitle);
+    else if (failed)
+        emit jobFailed(finishedTitle, error);
+    else
+    {
+        emit jobProgress(100);
+        emit jobFinished(finishedTitle);
+        if (finishedDone)
+            finishedDone();
+    }
+}
@@ -6,9 +6,12 @@
 #include <QFileDialog>
 #include <QInputDialog>
 #include <QMessageBox>
+#include <QProgressBar>
+#include <QPushButton>
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -21,10 +24,12 @@
 #include "DirectedGraphFactory.h"
 #include "GraphFactory.h"
 #include "GraphGenerator.h"
+#include "GraphSnapshot.h"
 #include "IBetweenness.h"
 #include "IGraphReader.h"
 #include "IShellIndex.h"
 #include "MaxClique.h"
+#include "TriangleCounter.h"
 #include "WeightedGraphFactory.h"
 #include "GnuplotConsole.h"
 #include "GraphLoadingValidationDialog.h"
@@ -43,6 +48,24 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
     ui->textBrowser->append(
             "<a href='https://github.com/ihameli/complexnets'>ComplexNets++ - GitHub</a>");
     ui->textBrowser->append("\n");
+
+    // shown while a job runs
+    progressBar = new QProgressBar(this);
+    progressBar->setRange(0, 100);
+    progressBar->setMaximumWidth(200);
+    progressBar->hide();
+    cancelButton = new QPushButton("Cancel", this);
+    cancelButton->hide();
+    ui->statusBar->addPermanentWidget(progressBar);
+    ui->statusBar->addPermanentWidget(cancelButton);
+    QObject::connect(cancelButton, SIGNAL(clicked()), &jobs, SLOT(cancel()));
+    QObject::connect(&jobs, SIGNAL(jobStarted(QString)), this, SLOT(onJobStarted(QString)));
+    QObject::connect(&jobs, SIGNAL(jobProgress(int)), progressBar, SLOT(setValue(int)));
+    QObject::connect(&jobs, SIGNAL(jobFinished(QString)), this, SLOT(onJobFinished()));
+    QObject::connect(&jobs, SIGNAL(jobCancelled(QString)), this, SLOT(onJobCancelled()));
+    QObject::connect(
+            &jobs, SIGNAL(jobFailed(QString, QString)), this,
+            SLOT(onJobFailed(QString, QString)));
 }
 
 MainWindow::~MainWindow() {
@@ -50,6 +73,32 @@ MainWindow::~MainWindow() {
     delete ui;
 }
 
+void MainWindow::onJobStarted(const QString &title) {
+    // the graphs must not change under the job
+    ui->menuBar->setEnabled(false);
+    ui->statusBar->showMessage(title + "...");
+    progressBar->show();
+    cancelButton->show();
+}
+
+void MainWindow::onJobFinished() {
+    ui->menuBar->setEnabled(true);
+    ui->statusBar->clearMessage();
+    progressBar->hide();
+    cancelButton->hide();
+}
+
+void MainWindow::onJobCancelled() {
+    onJobFinished();
+    ui->textBrowser->append("Action canceled by user.\n");
+}
+
+void MainWindow::onJobFailed(const QString &title, const QString &message) {
+    onJobFinished();
+    ui->textBrowser->append(title + " failed.");
+    ui->textBrowser->append(message);
+}
+
 void MainWindow::changeEvent(QEvent *e) {
     QMainWindow::changeEvent(e);
     switch (e->type()) {
@@ -78,7 +127,7 @@ void MainWindow::on_actionOpen_triggered() {
             graph = Graph();
             weightedGraph = WeightedGraph();
             this->deleteGraphFactory();
-            propertyMap.clear();
+            metricCache.clear();
             this->onNetworkUnload();
             ui->textBrowser->append("Done.\n");
         } else {
@@ -102,69 +151,64 @@ void MainWindow::on_actionOpen_triggered() {
         return;
     }
 
+    bool isWeighted = graphValidationDialog.isWeigthed();
     bool isDirected = graphValidationDialog.isDirected();
     bool isMultigraph = graphValidationDialog.isMultigraph();
     selectedFiles = fileDialog.selectedFiles();
-    this->onNetworkLoad(
-            graphValidationDialog.isWeigthed(), graphValidationDialog.isDirected(),
-            graphValidationDialog.isMultigraph());
-    buildGraphFactory(graphValidationDialog.isWeigthed(), graphValidationDialog.isDirected());
-    try {
-        std::string path = selectedFiles[0].toStdString();
-
+    QString file = selectedFiles[0];
+    std::string path = file.toStdString();
+
+    // read on a worker thread; a reading error (a missing file, a malformed line, ...) is
+    // reported by onJobFailed
+    struct Loaded {
+        Graph *graph = nullptr;
+        WeightedGraph *weightedGraph = nullptr;
+        DirectedGraph *directedGraph = nullptr;
+        ReadThroughput throughput;
+    };
+    auto loaded = std::make_shared<Loaded>();
+    jobs.start("Loading graph", [=]() {
+        if (isWeighted)
+            loaded->weightedGraph = GraphGenerator::getInstance()->generateWeightedGraphFromFile(
+                    path, isDirected, isMultigraph, 0, &loaded->throughput);
+        else if (isDirected)
+            loaded->directedGraph = GraphGenerator::getInstance()->generateDirectedGraphFromFile(
+                    path, isMultigraph, 0, &loaded->throughput);
+        else
+            loaded->graph = GraphGenerator::getInstance()->generateGraphFromFile(
+                    path, isDirected, isMultigraph, 0, &loaded->throughput);
+    }, [=]() {
+        this->onNetworkLoad(isWeighted, isDirected, isMultigraph);
+        buildGraphFactory(isWeighted, isDirected);
         if (this->weightedgraph) {
             graph = Graph(isDirected, isMultigraph);
-            weightedGraph = *(GraphGenerator::getInstance()->generateWeightedGraphFromFile(
-                    path, isDirected, isMultigraph));
+            weightedGraph = *loaded->weightedGraph;
         } else if (isDirected) {
             graph = Graph(isDirected, isMultigraph);
-            directedGraph =
-                    *(GraphGenerator::getInstance()->generateDirectedGraphFromFile(path, isMultigraph));
+            directedGraph = *loaded->directedGraph;
         } else {
-            graph = *(GraphGenerator::getInstance()->generateGraphFromFile(
-                    path, isDirected, isMultigraph));
+            graph = *loaded->graph;
             weightedGraph = WeightedGraph(isDirected, isMultigraph);
         }
-    }
-    catch (const FileNotFoundException &ex) {
-        ui->textBrowser->append("Error while loading graph.");
-        ui->textBrowser->append(ex.what());
-        onNetworkUnload();
-        return;
-    }
-    catch (const MalformedLineException &ex) {
-        ui->textBrowser->append("Error while loading graph.");
-        ui->textBrowser->append(ex.what());
-        onNetworkUnload();
-        return;
-    }
-    catch (const UnsignedIntegerMalformedException &ex) {
-        ui->textBrowser->append("Error while loading graph.");
-        ui->textBrowser->append(ex.what());
-        onNetworkUnload();
-        return;
-    }
-    catch (const MalformedDoubleException &ex) {
-        ui->textBrowser->append("Error while loading graph.");
-        onNetworkUnload();
-        ui->textBrowser->append(ex.what());
-        return;
-    }
-    catch (const DuplicatedEdgeLoading &ex) {
-        ui->textBrowser->append("Error while loading graph.");
-        onNetworkUnload();
-        ui->textBrowser->append(ex.what());
-        return;
-    }
-    QString text("Network loaded from file: ");
-    text.append(selectedFiles[0]);
-    text.append("\nAmount of vertices in the graph: ");
-    unsigned int verticesCount =
-            this->weightedgraph ? weightedGraph.verticesCount()
-                                : this->digraph ? directedGraph.verticesCount() : graph.verticesCount();
-    text.append(QString("%1").arg(verticesCount));
-    text.append(".\n");
-    ui->textBrowser->append(text);
+
+        QString text("Network loaded from file: ");
+        text.append(file);
+        text.append("\nAmount of vertices in the graph: ");
+        unsigned int verticesCount =
+                this->weightedgraph ? weightedGraph.verticesCount()
+                                    : this->digraph ? directedGraph.verticesCount()
+                                                    : graph.verticesCount();
+        text.append(QString("%1").arg(verticesCount));
+        text.append(".\n");
+        const ReadThroughput& throughput = loaded->throughput;
+        if (throughput.getEdgesCount() > 0) {
+            text.append(QString("Read %1 edges in %2 s (%3 edges per second).\n")
+                    .arg(qulonglong(throughput.getEdgesCount()))
+                    .arg(throughput.getSeconds())
+                    .arg(throughput.getEdgesPerSecond(), 0, 'f', 0));
+        }
+        ui->textBrowser->append(text);
+    });
 }
 
 void MainWindow::on_actionExportPowerLawDegreeDistribution_triggered() {
@@ -220,7 +264,7 @@ void MainWindow::on_actionClose_current_network_triggered() {
         graph = Graph();
         weightedGraph = WeightedGraph();
         this->deleteGraphFactory();
-        propertyMap.clear();
+        metricCache.clear();
         this->onNetworkUnload();
         ui->textBrowser->append("Done.\n");
     } else
@@ -407,6 +451,21 @@ double MainWindow::doubleInputId(std::string const &label, double defaultNum) {
         return defaultNum;
 }
 
+// Seed of a generated model; a random one unless the user types a number
+std::uint64_t MainWindow::seedInput() {
+    QInputDialog inputSeedDialog(this);
+    inputSeedDialog.setInputMode(QInputDialog::TextInput);
+    inputSeedDialog.setLabelText("seed:");
+    inputSeedDialog.setCancelButtonText("Default = random");
+    if (inputSeedDialog.exec()) {
+        bool ok = false;
+        const qulonglong seed = inputSeedDialog.textValue().trimmed().toULongLong(&ok);
+        if (ok)
+            return seed;
+    }
+    return Random::seedFromRand();
+}
+
 void MainWindow::on_actionExportMaxCliqueExact_distribution_triggered() {
     on_actionExportMaxClique_distribution_generic_triggered(true);
 }
@@ -424,7 +483,7 @@ void MainWindow::on_actionExportMaxClique_distribution_generic_triggered(bool ex
         return;
     }
 
-    if (!propertyMap.containsPropertySet(
+    if (!properties().containsPropertySet(
             exact ? "maxCliqueExactDistribution" : "maxCliqueAproxDistribution")) {
         ui->textBrowser->append(
                 "Max Clique has not been previously computed. Please go to Plot->MaxClique "
@@ -433,7 +492,7 @@ void MainWindow::on_actionExportMaxClique_distribution_generic_triggered(bool ex
     }
 
     grapherUtils.exportPropertySet(
-            propertyMap.getPropertySet(
+            properties().getPropertySet(
                     exact ? "maxCliqueExactDistribution" : "maxCliqueAproxDistribution"),
             ret);
     ui->textBrowser->append("Done.");
@@ -452,26 +511,32 @@ void MainWindow::on_action_maxClique_plotting_generic_triggered(bool exact) {
     unsigned int bins = 25;
     ui->textBrowser->append("Plotting maxClique distribution...");
 
-    this->computeMaxClique(exact);
+    this->computeMaxClique(exact, [this, exact, logBin, bins]() mutable {
+        if (!properties().containsPropertySet(
+                exact ? "maxCliqueExactDistribution" : "maxCliqueAproxDistribution")) {
+            ui->textBrowser->append("Calculation timed out.\n");
+            return;
+        }
 
-    if (LogBinningDialog() == QMessageBox::Yes) {
-        logBin = true;
-        bins = intInputId("bins:", 25);
-    }
+        if (LogBinningDialog() == QMessageBox::Yes) {
+            logBin = true;
+            bins = intInputId("bins:", 25);
+        }
 
-    bool ret = this->console->plotPropertySet(
-            propertyMap.getPropertySet(
-                    exact ? "maxCliqueExactDistribution" : "maxCliqueAproxDistribution"),
-            "maxCliqueDistribution", logBin, bins);
-    this->console->show();
-    this->activateWindow();
+        bool ret = this->console->plotPropertySet(
+                properties().getPropertySet(
+                        exact ? "maxCliqueExactDistribution" : "maxCliqueAproxDistribution"),
+                "maxCliqueDistribution", logBin, bins);
+        this->console->show();
+        this->activateWindow();
 
-    if (!ret) {
-        ui->textBrowser->append("An unexpected error has occured.\n");
-        return;
-    }
+        if (!ret) {
+            ui->textBrowser->append("An unexpected error has occured.\n");
+            return;
+        }
 
-    ui->textBrowser->append("Done.\n");
+        ui->textBrowser->append("Done.\n");
+    });
 }
 
 void MainWindow::on_actionMaxCliqueExact_triggered() {
@@ -488,61 +553,61 @@ void MainWindow::on_actionMaxClique_generic_triggered(bool exact) {
         return;
     }
 
-    QString ret;
-
-    this->computeMaxClique(exact);
-    if (exact && !propertyMap.containsPropertySet("maxCliqueExact")) {
-        ret.append("Calculation timed out.\n");
-        ui->textBrowser->append(ret);
-        return;
-    }
-    try {
-        std::string key = exact ? "maxCliqueExact" : "maxCliqueAprox";
-        int maxCliqueSize = propertyMap.getProperty<int>(key, "size");
-        std::list<int> list = propertyMap.getProperty<std::list<int>>(key, "list");
-        ui->textBrowser->append(exact ? "Exact Max clique" : "Aprox Max clique"
-                                                             "\nReference: José Ignacio Alvarez-Hamelin. "
-                                                             "Is it possible to find the maximum clique in general graphs? "
-                                                             "arXiv e-print, abs/1110.5355, Oct 2011.");
-        ret.append("Size is: ").append(to_string<int>(maxCliqueSize).c_str()).append(".\n");
-        ret.append("Clique is: ");
-        for (const auto &elem : list) {
-            ret.append(to_string<int>(elem).c_str()).append(" ");
+    this->computeMaxClique(exact, [this, exact]() {
+        QString ret;
+        if (exact && !properties().containsPropertySet("maxCliqueExact")) {
+            ret.append("Calculation timed out.\n");
+            ui->textBrowser->append(ret);
+            return;
         }
-        ret.append(".\n");
-        ui->textBrowser->append(ret);
-    }
-    catch (const BadElementName &ex) {
-        ret.append("'Max clique: property was not found.");
-        ui->textBrowser->append(ret);
-    }
+        try {
+            std::string key = exact ? "maxCliqueExact" : "maxCliqueAprox";
+            int maxCliqueSize = properties().getProperty<int>(key, "size");
+            std::list<int> list = properties().getProperty<std::list<int>>(key, "list");
+            ui->textBrowser->append(exact ? "Exact Max clique" : "Aprox Max clique"
+                                                                 "\nReference: José Ignacio Alvarez-Hamelin. "
+                                                                 "Is it possible to find the maximum clique in general graphs? "
+                                                                 "arXiv e-print, abs/1110.5355, Oct 2011.");
+            ret.append("Size is: ").append(to_string<int>(maxCliqueSize).c_str()).append(".\n");
+            ret.append("Clique is: ");
+            for (const auto &elem : list) {
+                ret.append(to_string<int>(elem).c_str()).append(" ");
+            }
+            ret.append(".\n");
+            ui->textBrowser->append(ret);
+        }
+        catch (const BadElementName &ex) {
+            ret.append("'Max clique: property was not found.");
+            ui->textBrowser->append(ret);
+        }
+    });
 }
 
 void MainWindow::on_actionBetweenness_triggered() {
-    QString ret;
+    this->computeBetweenness([this]() {
+        QString ret;
 
-    this->computeBetweenness();
-
-    graphpp::Boxplotentry entry;
-    if (!propertyMap.containsProperty("BetweennessBPMean", to_string(0))) {
-        entry = this->computeTotalBpEntriesBetweenness();
-        propertyMap.addProperty<double>("BetweennessBPMean", to_string(0), entry.mean);
-        propertyMap.addProperty<double>("BetweennessBPMin", to_string(0), entry.min);
-        propertyMap.addProperty<double>("BetweennessBPQ1", to_string(0), entry.Q1);
-        propertyMap.addProperty<double>("BetweennessBPQ2", to_string(0), entry.Q2);
-        propertyMap.addProperty<double>("BetweennessBPQ3", to_string(0), entry.Q3);
-        propertyMap.addProperty<double>("BetweennessBPMax", to_string(0), entry.max);
-    } else {
-        ret.append("Data already calculated. \n");
-        entry.mean = propertyMap.getProperty<double>("BetweennessBPMean", to_string(0));
-        entry.min = propertyMap.getProperty<double>("BetweennessBPMin", to_string(0));
-        entry.Q1 = propertyMap.getProperty<double>("BetweennessBPQ1", to_string(0));
-        entry.Q2 = propertyMap.getProperty<double>("BetweennessBPQ2", to_string(0));
-        entry.Q3 = propertyMap.getProperty<double>("BetweennessBPQ3", to_string(0));
-        entry.max = propertyMap.getProperty<double>("BetweennessBPMax", to_string(0));
-    }
+        graphpp::Boxplotentry entry;
+        if (!properties().containsProperty("BetweennessBPMean", to_string(0))) {
+            entry = this->computeTotalBpEntriesBetweenness();
+            properties().addProperty<double>("BetweennessBPMean", to_string(0), entry.mean);
+            properties().addProperty<double>("BetweennessBPMin", to_string(0), entry.min);
+            properties().addProperty<double>("BetweennessBPQ1", to_string(0), entry.Q1);
+            properties().addProperty<double>("BetweennessBPQ2", to_string(0), entry.Q2);
+            properties().addProperty<double>("BetweennessBPQ3", to_string(0), entry.Q3);
+            properties().addProperty<double>("BetweennessBPMax", to_string(0), entry.max);
+        } else {
+            ret.append("Data already calculated. \n");
+            entry.mean = properties().getProperty<double>("BetweennessBPMean", to_string(0));
+            entry.min = properties().getProperty<double>("BetweennessBPMin", to_string(0));
+            entry.Q1 = properties().getProperty<double>("BetweennessBPQ1", to_string(0));
+            entry.Q2 = properties().getProperty<double>("BetweennessBPQ2", to_string(0));
+            entry.Q3 = properties().getProperty<double>("BetweennessBPQ3", to_string(0));
+            entry.max = properties().getProperty<double>("BetweennessBPMax", to_string(0));
+        }
 
-    ui->textBrowser->append(entry.str().c_str());
+        ui->textBrowser->append(entry.str().c_str());
+    });
 }
 
 void MainWindow::on_actionShell_index_triggered() {
@@ -552,16 +617,21 @@ void MainWindow::on_actionShell_index_triggered() {
         if (this->weightedgraph) {
 //            this->computeShellIndex(ShellIndexTypeWeightedEqualPopulation, "Weighted Equal Population");
 //            this->postComputeShellIndex(ShellIndexTypeWeightedEqualPopulation,"Weighted Equal Population");
-            this->computeShellIndex(ShellIndexTypeWeightedEqualStrength, "Weighted Equal Strength");
-            this->postComputeShellIndex(ShellIndexTypeWeightedEqualStrength,"Weighted Equal Strength");
+            this->computeShellIndex(
+                    ShellIndexTypeWeightedEqualStrength, "Weighted Equal Strength", [this]() {
+                this->postComputeShellIndex(ShellIndexTypeWeightedEqualStrength,"Weighted Equal Strength");
+            });
         } else if (this->digraph) {
-            this->computeShellIndex(ShellIndexTypeInDegree, "In Degree");
-            this->postComputeShellIndex(ShellIndexTypeInDegree, "In Degree");
-            this->computeShellIndex(ShellIndexTypeOutDegree, "Out Degree");
-            this->postComputeShellIndex(ShellIndexTypeOutDegree, "Out Degree");
+            this->computeShellIndex(ShellIndexTypeInDegree, "In Degree", [this]() {
+                this->postComputeShellIndex(ShellIndexTypeInDegree, "In Degree");
+                this->computeShellIndex(ShellIndexTypeOutDegree, "Out Degree", [this]() {
+                    this->postComputeShellIndex(ShellIndexTypeOutDegree, "Out Degree");
+                });
+            });
         } else {
-            this->computeShellIndex(ShellIndexTypeSimple, "Simple Graph");
-            this->postComputeShellIndex(ShellIndexTypeSimple, "Simple Graph");
+            this->computeShellIndex(ShellIndexTypeSimple, "Simple Graph", [this]() {
+                this->postComputeShellIndex(ShellIndexTypeSimple, "Simple Graph");
+            });
         }
     }
 }
@@ -575,7 +645,7 @@ void MainWindow::postComputeShellIndex(graphpp::ShellIndexType type, std::string
             ret.append("Looking for all the vertexes starting from 1\n");
             unsigned int i = 1;
             while (true) {
-                vertexShellIndex = propertyMap.getProperty<unsigned int>(
+                vertexShellIndex = properties().getProperty<unsigned int>(
                         prefix + "shellIndex", to_string<unsigned int>(i));
                 ret.append("Shell index for vertex ").append(to_string<int>(i).c_str());
                 ret.append(" is: ")
@@ -590,22 +660,22 @@ void MainWindow::postComputeShellIndex(graphpp::ShellIndexType type, std::string
     } else {
         try {
             graphpp::Boxplotentry entry;
-            if (!propertyMap.containsProperty(prefix + "ShellIndexBPMean", to_string(0))) {
+            if (!properties().containsProperty(prefix + "ShellIndexBPMean", to_string(0))) {
                 entry = this->computeTotalBpEntriesShellIndex(prefix);
-                propertyMap.addProperty<double>(prefix + "ShellIndexBPMean", to_string(0), entry.mean);
-                propertyMap.addProperty<double>(prefix + "ShellIndexBPMin", to_string(0), entry.min);
-                propertyMap.addProperty<double>(prefix + "ShellIndexBPQ1", to_string(0), entry.Q1);
-                propertyMap.addProperty<double>(prefix + "ShellIndexBPQ2", to_string(0), entry.Q2);
-                propertyMap.addProperty<double>(prefix + "ShellIndexBPQ3", to_string(0), entry.Q3);
-                propertyMap.addProperty<double>(prefix + "ShellIndexBPMax", to_string(0), entry.max);
+                properties().addProperty<double>(prefix + "ShellIndexBPMean", to_string(0), entry.mean);
+                properties().addProperty<double>(prefix + "ShellIndexBPMin", to_string(0), entry.min);
+                properties().addProperty<double>(prefix + "ShellIndexBPQ1", to_string(0), entry.Q1);
+                properties().addProperty<double>(prefix + "ShellIndexBPQ2", to_string(0), entry.Q2);
+                properties().addProperty<double>(prefix + "ShellIndexBPQ3", to_string(0), entry.Q3);
+                properties().addProperty<double>(prefix + "ShellIndexBPMax", to_string(0), entry.max);
             } else {
                 ret.append("Data already calculated. \n");
-                entry.mean = propertyMap.getProperty<double>(prefix + "ShellIndexBPMean", to_string(0));
-                entry.min = propertyMap.getProperty<double>(prefix + "ShellIndexBPMin", to_string(0));
-                entry.Q1 = propertyMap.getProperty<double>(prefix + "ShellIndexBPQ1", to_string(0));
-                entry.Q2 = propertyMap.getProperty<double>(prefix + "ShellIndexBPQ2", to_string(0));
-                entry.Q3 = propertyMap.getProperty<double>(prefix + "ShellIndexBPQ3", to_string(0));
-                entry.max = propertyMap.getProperty<double>(prefix + "ShellIndexBPMax", to_string(0));
+                entry.mean = properties().getProperty<double>(prefix + "ShellIndexBPMean", to_string(0));
+                entry.min = properties().getProperty<double>(prefix + "ShellIndexBPMin", to_string(0));
+                entry.Q1 = properties().getProperty<double>(prefix + "ShellIndexBPQ1", to_string(0));
+                entry.Q2 = properties().getProperty<double>(prefix + "ShellIndexBPQ2", to_string(0));
+                entry.Q3 = properties().getProperty<double>(prefix + "ShellIndexBPQ3", to_string(0));
+                entry.max = properties().getProperty<double>(prefix + "ShellIndexBPMax", to_string(0));
             }
 
             QString qStringprefix = QString::fromStdString("Shell index with strategy: "+prefix);
@@ -639,115 +709,139 @@ void MainWindow::postComputeShellIndex(graphpp::ShellIndexType type, std::string
     }
 }
 
-void MainWindow::computeShellIndex(graphpp::ShellIndexType type, std::string prefix) {
-    if (propertyMap.containsPropertySet(prefix + "shellIndex"))
+void MainWindow::computeShellIndex(
+        graphpp::ShellIndexType type, std::string prefix, std::function<void()> then) {
+    if (properties().containsPropertySet(prefix + "shellIndex")) {
+        then();
         return;
+    }
 
     ui->textBrowser->append("Shell index has not been previously computed. Computing now.");
 
-    if (this->weightedgraph) {
-        auto shellIndex = weightedFactory->createShellIndex(weightedGraph, type);
-        auto it = shellIndex->iterator();
-
-        while (!it.end()) {
-            propertyMap.addProperty<unsigned int>(
-                    prefix + "shellIndex", to_string<unsigned int>(it->first), it->second);
-            ++it;
-        }
-        delete shellIndex;
-    } else if (this->digraph) {
-        auto shellIndex = directedFactory->createShellIndex(directedGraph, type);
+    // computed on a worker thread, stored in properties() on this one
+    auto values = std::make_shared<std::vector<std::pair<unsigned int, unsigned int>>>();
+    auto collect = [values](auto *shellIndex) {
         auto it = shellIndex->iterator();
 
         while (!it.end()) {
-            propertyMap.addProperty<unsigned int>(
-                    prefix + "shellIndex", to_string<unsigned int>(it->first), it->second);
+            values->emplace_back(it->first, it->second);
             ++it;
         }
         delete shellIndex;
-    } else {
-        auto shellIndex = factory->createShellIndex(graph, ShellIndexTypeSimple);
-        auto it = shellIndex->iterator();
-
-        while (!it.end()) {
-            propertyMap.addProperty<unsigned int>(
-                    prefix + "shellIndex", to_string<unsigned int>(it->first), it->second);
-            ++it;
-        }
-        delete shellIndex;
-    }
-
-}
-
-void MainWindow::computeMaxClique(bool exact) {
-    if (propertyMap.containsPropertySet(exact ? "maxCliqueExact" : "maxCliqueAprox"))
+    };
+    jobs.start("Computing shell index", [this, type, collect]() {
+        if (this->weightedgraph)
+            collect(weightedFactory->createShellIndex(weightedGraph, type));
+        else if (this->digraph)
+            collect(directedFactory->createShellIndex(directedGraph, type));
+        else
+            collect(factory->createShellIndex(graph, ShellIndexTypeSimple));
+    }, [this, prefix, values, then]() {
+        for (const auto &value : *values)
+            properties().addProperty<unsigned int>(
+                    prefix + "shellIndex", to_string<unsigned int>(value.first), value.second);
+        then();
+    });
+}
+
+void MainWindow::computeMaxClique(bool exact, std::function<void()> then) {
+    if (properties().containsPropertySet(exact ? "maxCliqueExact" : "maxCliqueAprox")) {
+        then();
         return;
+    }
 
     ui->textBrowser->append(exact ? "Exact Max clique" : "Aprox Max clique");
     ui->textBrowser->append(" has not been previously computed. Computing now.");
     if (this->weightedgraph) {
         ui->textBrowser->append("Max clique for weighted graphs is not supported.");
         return;
-    } else {
-        int timeout = 0;
-        if (exact) {
-            timeout = intInputId("Time out (seconds):", 0);
-        }
-        IMaxClique<Graph, Vertex> *maxClique =
-                exact ? (IMaxClique<Graph, Vertex> *) factory->createExactMaxClique(graph, timeout)
-                      : (IMaxClique<Graph, Vertex> *) factory->createMaxClique(graph);
+    }
 
-        if (maxClique->finished()) {
-            std::list<int> ids = maxClique->getMaxCliqueList();
-            propertyMap.addProperty<int>(
-                    exact ? "maxCliqueExact" : "maxCliqueAprox", "size", ids.size());
-            propertyMap.addProperty<std::list<int>>(
-                    exact ? "maxCliqueExact" : "maxCliqueAprox", "list", ids);
+    int timeout = 0;
+    if (exact) {
+        timeout = intInputId("Time out (seconds):", 0);
+    }
+
+    // computed on a worker thread, stored in properties() on this one
+    struct Result {
+        bool finished = false;
+        std::list<int> ids;
+        std::vector<std::pair<int, double>> distribution;
+    };
+    auto result = std::make_shared<Result>();
+    jobs.start(exact ? "Computing the exact max clique" : "Computing the max clique",
+               [this, exact, timeout, result]() {
+        std::unique_ptr<IMaxClique<Graph, Vertex>> maxClique(
+                exact ? (IMaxClique<Graph, Vertex> *) factory->createExactMaxClique(graph, timeout)
+                      : (IMaxClique<Graph, Vertex> *) factory->createMaxClique(graph));
 
+        result->finished = maxClique->finished();
+        if (result->finished) {
+            result->ids = maxClique->getMaxCliqueList();
             auto it = maxClique->distIterator();
             while (!it.end()) {
-                propertyMap.addProperty<double>(
-                        exact ? "maxCliqueExactDistribution" : "maxCliqueAproxDistribution",
-                        to_string<int>(it->first), it->second);
+                result->distribution.emplace_back(it->first, it->second);
                 it++;
             }
         }
+    }, [this, exact, result, then]() {
+        if (result->finished) {
+            properties().addProperty<int>(
+                    exact ? "maxCliqueExact" : "maxCliqueAprox", "size", result->ids.size());
+            properties().addProperty<std::list<int>>(
+                    exact ? "maxCliqueExact" : "maxCliqueAprox", "list", result->ids);
+
+            for (const auto &value : result->distribution)
+                properties().addProperty<double>(
+                        exact ? "maxCliqueExactDistribution" : "maxCliqueAproxDistribution",
+                        to_string<int>(value.first), value.second);
+        }
+        then();
+    });
+}
 
-        delete maxClique;
-    }
+PropertyMap &MainWindow::properties() {
+    const std::uint64_t version =
+            std::max({graph.getVersion(), weightedGraph.getVersion(), directedGraph.getVersion()});
+    // the property names carry the directed flags, so the key does not
+    return metricCache.get<PropertyMap>(
+            {"properties", "", false, false, version}, [](PropertyMap &) {});
 }
 
-void MainWindow::computeBetweenness() {
-    if (propertyMap.containsPropertySet("betweenness"))
+void MainWindow::computeBetweenness(std::function<void()> then) {
+    if (properties().containsPropertySet("betweenness")) {
+        then();
         return;
+    }
 
     ui->textBrowser->append("Betweenness has not been previously computed. Computing now.");
 
-    if (this->weightedgraph) {
-        auto betweenness = weightedFactory->createBetweenness(weightedGraph);
+    // computed on a worker thread, stored in properties() on this one
+    auto values = std::make_shared<std::vector<std::pair<unsigned int, double>>>();
+    auto collect = [values](auto *betweenness) {
         auto it = betweenness->iterator();
 
         while (!it.end()) {
-            propertyMap.addProperty<double>(
-                    "betweenness", to_string<unsigned int>(it->first), it->second);
+            values->emplace_back(it->first, it->second);
             ++it;
         }
         delete betweenness;
-    } else {
-        auto betweenness = factory->createBetweenness(graph);
-        auto it = betweenness->iterator();
-
-        while (!it.end()) {
-            propertyMap.addProperty<double>(
-                    "betweenness", to_string<unsigned int>(it->first), it->second);
-            ++it;
-        }
-        delete betweenness;
-    }
+    };
+    jobs.start("Computing betweenness", [this, collect]() {
+        if (this->weightedgraph)
+            collect(weightedFactory->createBetweenness(weightedGraph));
+        else
+            collect(factory->createBetweenness(graph));
+    }, [this, values, then]() {
+        for (const auto &value : *values)
+            properties().addProperty<double>(
+                    "betweenness", to_string<unsigned int>(value.first), value.second);
+        then();
+    });
 }
 
 void MainWindow::computeDegreeDistribution() {
-    if (propertyMap.containsPropertySet("degreeDistribution") || this->digraph)
+    if (properties().containsPropertySet("degreeDistribution") || this->digraph)
         return;
 
     if (this->weightedgraph) {
@@ -755,9 +849,9 @@ void MainWindow::computeDegreeDistribution() {
         auto it = degreeDistribution->iterator();
 
         while (!it.end()) {
-            propertyMap.addProperty<double>(
+            properties().addProperty<double>(
                     "degreeDistribution", to_string<double>(it->first), it->second);
-            propertyMap.addProperty<double>(
+            properties().addProperty<double>(
                     "degreeDistributionProbability", to_string<double>(it->first),
                     it->second / (double) weightedGraph.verticesCount());
             ++it;
@@ -773,25 +867,25 @@ void MainWindow::computeDegreeDistribution() {
 
         while (!it.end() || !it2.end() || !it3.end()) {
             if (!it.end()) {
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "inDegreeDistribution", to_string<unsigned int>(it->first), it->second);
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "inDegreeDistributionProbability", to_string<unsigned int>(it->first),
                         it->second / (double) directedGraph.verticesCount());
                 ++it;
             }
             if (!it2.end()) {
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "outDegreeDistribution", to_string<unsigned int>(it2->first), it2->second);
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "outDegreeDistributionProbability", to_string<unsigned int>(it2->first),
                         it2->second / (double) directedGraph.verticesCount());
                 ++it2;
             }
             if (!it3.end()) {
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "inOutDegreeDistribution", to_string<unsigned int>(it3->first), it3->second);
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "inOutDegreeDistributionProbability", to_string<unsigned int>(it3->first),
                         it3->second / (double) directedGraph.verticesCount());
                 ++it3;
@@ -803,9 +897,9 @@ void MainWindow::computeDegreeDistribution() {
         auto it = degreeDistribution->iterator();
 
         while (!it.end()) {
-            propertyMap.addProperty<double>(
+            properties().addProperty<double>(
                     "degreeDistribution", to_string<unsigned int>(it->first), it->second);
-            propertyMap.addProperty<double>(
+            properties().addProperty<double>(
                     "degreeDistributionProbability", to_string<unsigned int>(it->first),
                     it->second / (double) graph.verticesCount());
             ++it;
@@ -827,39 +921,39 @@ void MainWindow::on_actionDegree_distribution_triggered() {
     QString ret;
     unsigned int degreeAmount;
     if (!this->digraph && !degree.isEmpty()) {
-        if (!propertyMap.containsPropertySet("degreeDistribution")) {
+        if (!properties().containsPropertySet("degreeDistribution")) {
             ui->textBrowser->append(
                     "Degree distribution has not been previously computed. Computing now.");
             this->computeDegreeDistribution();
         }
         try {
-            // degreeAmount = propertyMap.getProperty<unsigned int>("degreeDistribution",
+            // degreeAmount = properties().getProperty<unsigned int>("degreeDistribution",
             // degree.toStdString());
             // ret.append("Degree distribution for degree ").append(degree);
             // ret.append(" is: ").append(to_string<unsigned
             // int>(degreeAmount).c_str()).append(".\n");
             // ui->textBrowser->append(ret);
             graphpp::Boxplotentry entry;
-            if (!propertyMap.containsProperty("degreeDistributionBPMean", to_string(0))) {
+            if (!properties().containsProperty("degreeDistributionBPMean", to_string(0))) {
                 entry = this->computeTotalBpEntriesDegreeDistribution();
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "degreeDistributionBPMean", to_string(0), entry.mean);
-                propertyMap.addProperty<double>("degreeDistributionBPMin", to_string(0), entry.min);
-                propertyMap.addProperty<double>("degreeDistributionBPQ1", to_string(0), entry.Q1);
-                propertyMap.addProperty<double>("degreeDistributionBPQ2", to_string(0), entry.Q2);
-                propertyMap.addProperty<double>("degreeDistributionBPQ3", to_string(0), entry.Q3);
-                propertyMap.addProperty<double>("degreeDistributionBPMax", to_string(0), entry.max);
+                properties().addProperty<double>("degreeDistributionBPMin", to_string(0), entry.min);
+                properties().addProperty<double>("degreeDistributionBPQ1", to_string(0), entry.Q1);
+                properties().addProperty<double>("degreeDistributionBPQ2", to_string(0), entry.Q2);
+                properties().addProperty<double>("degreeDistributionBPQ3", to_string(0), entry.Q3);
+                properties().addProperty<double>("degreeDistributionBPMax", to_string(0), entry.max);
             } else {
                 ret.append("Data already calculated. \n");
                 entry.mean =
-                        propertyMap.getProperty<double>("degreeDistributionBPMean", to_string(0));
+                        properties().getProperty<double>("degreeDistributionBPMean", to_string(0));
                 entry.min =
-                        propertyMap.getProperty<double>("degreeDistributionBPMin", to_string(0));
-                entry.Q1 = propertyMap.getProperty<double>("degreeDistributionBPQ1", to_string(0));
-                entry.Q2 = propertyMap.getProperty<double>("degreeDistributionBPQ2", to_string(0));
-                entry.Q3 = propertyMap.getProperty<double>("degreeDistributionBPQ3", to_string(0));
+                        properties().getProperty<double>("degreeDistributionBPMin", to_string(0));
+                entry.Q1 = properties().getProperty<double>("degreeDistributionBPQ1", to_string(0));
+                entry.Q2 = properties().getProperty<double>("degreeDistributionBPQ2", to_string(0));
+                entry.Q3 = properties().getProperty<double>("degreeDistributionBPQ3", to_string(0));
                 entry.max =
-                        propertyMap.getProperty<double>("degreeDistributionBPMax", to_string(0));
+                        properties().getProperty<double>("degreeDistributionBPMax", to_string(0));
             }
 
             ui->textBrowser->append(entry.str().c_str());
@@ -870,13 +964,13 @@ void MainWindow::on_actionDegree_distribution_triggered() {
         }
     }
     if (this->digraph && !outDegree.isEmpty()) {
-        if (!propertyMap.containsPropertySet("outDegreeDistribution")) {
+        if (!properties().containsPropertySet("outDegreeDistribution")) {
             ui->textBrowser->append(
                     "Degree distribution has not been previously computed. Computing now.");
             this->computeDegreeDistribution();
         }
         try {
-            unsigned int outDegreeAmount = propertyMap.getProperty<unsigned int>(
+            unsigned int outDegreeAmount = properties().getProperty<unsigned int>(
                     "outDegreeDistribution", outDegree.toStdString());
             ret.append("Out-Degree distribution for degree ").append(outDegree);
             ret.append(" is: ")
@@ -892,7 +986,7 @@ void MainWindow::on_actionDegree_distribution_triggered() {
 
         ret = "";
         try {
-            unsigned int inDegreeAmount = propertyMap.getProperty<unsigned int>(
+            unsigned int inDegreeAmount = properties().getProperty<unsigned int>(
                     "inDegreeDistribution", inDegree.toStdString());
             ret.append("In-Degree distribution for degree ").append(inDegree);
             ret.append(" is: ")
@@ -912,7 +1006,7 @@ void MainWindow::on_actionDegree_distribution_plotting_triggered() {
     unsigned int bins = 25;
     ui->textBrowser->append("Plotting degree distribution...");
 
-    if (!this->digraph || !propertyMap.containsPropertySet("degreeDistribution")) {
+    if (!this->digraph || !properties().containsPropertySet("degreeDistribution")) {
         ui->textBrowser->append(
                 "Degree distribution has not been previously computed. Computing now.");
         this->computeDegreeDistribution();
@@ -924,11 +1018,11 @@ void MainWindow::on_actionDegree_distribution_plotting_triggered() {
     if (!this->digraph) {
         if (logBin) {
             ret = this->console->plotPropertySet(
-                    propertyMap.getPropertySet("degreeDistribution"), "degreeDistribution", logBin,
+                    properties().getPropertySet("degreeDistribution"), "degreeDistribution", logBin,
                     bins);
         } else {
             ret = this->console->plotPropertySet(
-                    propertyMap.getPropertySet("degreeDistributionProbability"), "degreeDistribution",
+                    properties().getPropertySet("degreeDistributionProbability"), "degreeDistribution",
                     logBin, bins);
         }
     } else {
@@ -944,12 +1038,12 @@ void MainWindow::on_actionDegree_distribution_plotting_triggered() {
 
         if (logBin) {
             ret =
-                    this->console->plotPropertySet(propertyMap.getPropertySet(key), key, logBin, bins);
+                    this->console->plotPropertySet(properties().getPropertySet(key), key, logBin, bins);
             this->console->show();
             this->activateWindow();
         } else {
             ret = this->console->plotPropertySet(
-                    propertyMap.getPropertySet(key + "Probability"), key, logBin, bins);
+                    properties().getPropertySet(key + "Probability"), key, logBin, bins);
             this->console->show();
             this->activateWindow();
         }
@@ -985,13 +1079,13 @@ void MainWindow::on_actionClustering_coefficient_triggered() {
         key += directedPostfix;
     }
 
-    if (!propertyMap.containsProperty("clusteringCoeficientForVertex", key)) {
+    if (!properties().containsProperty("clusteringCoeficientForVertex", key)) {
         ui->textBrowser->append("Clustering coefficient has not been previously computed.");
         if (this->weightedgraph) {
             WeightedVertex *vertex;
             if ((vertex = weightedGraph.getVertexById(vertexId)) != nullptr) {
                 auto clusteringCoefficient = weightedFactory->createClusteringCoefficient();
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "clusteringCoeficientForVertex",
                         to_string<unsigned int>(vertex->getVertexId()),
                         clusteringCoefficient->vertexClusteringCoefficient(vertex));
@@ -1001,7 +1095,7 @@ void MainWindow::on_actionClustering_coefficient_triggered() {
             DirectedVertex *vertex;
             if ((vertex = directedGraph.getVertexById(vertexId)) != nullptr) {
                 auto clusteringCoefficient = directedFactory->createClusteringCoefficient();
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "clusteringCoeficientForVertex",
                         to_string<unsigned int>(vertex->getVertexId()) + directedPostfix,
                         clusteringCoefficient->vertexClusteringCoefficient(
@@ -1013,7 +1107,7 @@ void MainWindow::on_actionClustering_coefficient_triggered() {
             if ((vertex = graph.getVertexById(vertexId)) != nullptr) {
                 // IClusteringCoefficient<Graph, Vertex>* clusteringCoefficient =
                 // factory->createClusteringCoefficient();
-                // propertyMap.addProperty<double>("clusteringCoeficientForVertex",
+                // properties().addProperty<double>("clusteringCoeficientForVertex",
                 // to_string<unsigned int>(vertex->getVertexId()),
                 // clusteringCoefficient->vertexClusteringCoefficient(vertex));
                 // delete clusteringCoefficient;
@@ -1029,35 +1123,35 @@ void MainWindow::on_actionClustering_coefficient_triggered() {
             //    key += directedPostfix;
             //}
             graphpp::Boxplotentry entry;
-            if (!propertyMap.containsProperty("ClusteringCoefficientBPMean", to_string(0))) {
+            if (!properties().containsProperty("ClusteringCoefficientBPMean", to_string(0))) {
                 this->computeDegreeDistribution();
                 entry = this->computeTotalBpEntries();
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "ClusteringCoefficientBPMean", to_string(0), entry.mean);
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "ClusteringCoefficientBPMin", to_string(0), entry.min);
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "ClusteringCoefficientBPQ1", to_string(0), entry.Q1);
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "ClusteringCoefficientBPQ2", to_string(0), entry.Q2);
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "ClusteringCoefficientBPQ3", to_string(0), entry.Q3);
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "ClusteringCoefficientBPMax", to_string(0), entry.max);
             } else {
                 ret.append("Data already calculated. \n");
-                entry.mean = propertyMap.getProperty<double>(
+                entry.mean = properties().getProperty<double>(
                         "ClusteringCoefficientBPMean", to_string(0));
                 entry.min =
-                        propertyMap.getProperty<double>("ClusteringCoefficientBPMin", to_string(0));
+                        properties().getProperty<double>("ClusteringCoefficientBPMin", to_string(0));
                 entry.Q1 =
-                        propertyMap.getProperty<double>("ClusteringCoefficientBPQ1", to_string(0));
+                        properties().getProperty<double>("ClusteringCoefficientBPQ1", to_string(0));
                 entry.Q2 =
-                        propertyMap.getProperty<double>("ClusteringCoefficientBPQ2", to_string(0));
+                        properties().getProperty<double>("ClusteringCoefficientBPQ2", to_string(0));
                 entry.Q3 =
-                        propertyMap.getProperty<double>("ClusteringCoefficientBPQ3", to_string(0));
+                        properties().getProperty<double>("ClusteringCoefficientBPQ3", to_string(0));
                 entry.max =
-                        propertyMap.getProperty<double>("ClusteringCoefficientBPMax", to_string(0));
+                        properties().getProperty<double>("ClusteringCoefficientBPMax", to_string(0));
             }
 
             ui->textBrowser->append(entry.str().c_str());
@@ -1097,14 +1191,14 @@ void MainWindow::on_actionNearest_neighbors_degree_triggered() {
         key += directedPostfix;
     }
 
-    if (!propertyMap.containsProperty("nearestNeighborsDegreeForVertex", key)) {
+    if (!properties().containsProperty("nearestNeighborsDegreeForVertex", key)) {
         ui->textBrowser->append(
                 "Nearest neighbors degree has not been previously computed. Computing now.");
         if (this->weightedgraph) {
             WeightedVertex *vertex;
             if ((vertex = weightedGraph.getVertexById(vertexId)) != nullptr) {
                 auto nearestNeighborsDegree = weightedFactory->createNearestNeighborsDegree();
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "nearestNeighborsDegreeForVertex",
                         to_string<unsigned int>(vertex->getVertexId()),
                         nearestNeighborsDegree->meanDegreeForVertex(vertex));
@@ -1114,7 +1208,7 @@ void MainWindow::on_actionNearest_neighbors_degree_triggered() {
             DirectedVertex *vertex;
             if ((vertex = directedGraph.getVertexById(vertexId)) != nullptr) {
                 auto nearestNeighborsDegree = directedFactory->createNearestNeighborsDegree();
-                propertyMap.addProperty<double>(
+                properties().addProperty<double>(
                         "nearestNeighborsDegreeForVertex",
                         to_string<unsigned int>(vertex->getVertexId()) + directedPostfix,
                         nearestNeighborsDegree->meanDegreeForVertex(
@@ -1126,7 +1220,7 @@ void MainWindow::on_actionNearest_neighbors_degree_triggered() {
             if ((vertex = graph.getVertexById(vertexId)) != nullptr) {
                 // INearestNeighborsDegree<Graph, Vertex>* nearestNeighborsDegree =
                 // factory->createNearestNeighborsDegree();
-                // propertyMap.addProperty<double>("nearestNeighborsDegreeForVertex",
+                // properties().addProperty<double>("nearestNeighborsDegreeForVertex",
                 // to_string<unsigned int>(vertex->getVertexId()),
                 // nearestNeighborsDegree->meanDegreeForVertex(vertex));
                 // delete nearestNeighborsDegree;
@@ -1138,23 +1232,23 @@ void MainWindow::on_actionNearest_neighbors_degree_triggered() {
         try {
             graphpp::Boxplotentry entry;
 
-            if (!propertyMap.containsProperty("KnnBPMean", to_string(0))) {
+            if (!properties().containsProperty("KnnBPMean", to_string(0))) {
                 this->computeDegreeDistribution();
                 entry = this->computeTotalBpEntriesKnn();
-                propertyMap.addProperty<double>("KnnBPMean", to_string(0), entry.mean);
-                propertyMap.addProperty<double>("KnnBPMin", to_string(0), entry.min);
-                propertyMap.addProperty<double>("KnnBPQ1", to_string(0), entry.Q1);
-                propertyMap.addProperty<double>("KnnBPQ2", to_string(0), entry.Q2);
-                propertyMap.addProperty<double>("KnnBPQ3", to_string(0), entry.Q3);
-                propertyMap.addProperty<double>("KnnBPMax", to_string(0), entry.max);
+                properties().addProperty<double>("KnnBPMean", to_string(0), entry.mean);
+                properties().addProperty<double>("KnnBPMin", to_string(0), entry.min);
+                properties().addProperty<double>("KnnBPQ1", to_string(0), entry.Q1);
+                properties().addProperty<double>("KnnBPQ2", to_string(0), entry.Q2);
+                properties().addProperty<double>("KnnBPQ3", to_string(0), entry.Q3);
+                properties().addProperty<double>("KnnBPMax", to_string(0), entry.max);
             } else {
                 ret.append("Data already calculated. \n");
-                entry.mean = propertyMap.getProperty<double>("KnnBPMean", to_string(0));
-                entry.min = propertyMap.getProperty<double>("KnnBPMin", to_string(0));
-                entry.Q1 = propertyMap.getProperty<double>("KnnBPQ1", to_string(0));
-                entry.Q2 = propertyMap.getProperty<double>("KnnBPQ2", to_string(0));
-                entry.Q3 = propertyMap.getProperty<double>("KnnBPQ3", to_string(0));
-                entry.max = propertyMap.getProperty<double>("KnnBPMax", to_string(0));
+                entry.mean = properties().getProperty<double>("KnnBPMean", to_string(0));
+                entry.min = properties().getProperty<double>("KnnBPMin", to_string(0));
+                entry.Q1 = properties().getProperty<double>("KnnBPQ1", to_string(0));
+                entry.Q2 = properties().getProperty<double>("KnnBPQ2", to_string(0));
+                entry.Q3 = properties().getProperty<double>("KnnBPQ3", to_string(0));
+                entry.max = properties().getProperty<double>("KnnBPMax", to_string(0));
             }
 
             ui->textBrowser->append(entry.str().c_str());
@@ -1184,7 +1278,7 @@ void MainWindow::on_actionClustering_Coefficient_vs_Degree_triggered() {
 
     std::string ccKey = "clusteringCoeficientForDegree" + directedPostfix;
 
-    if (!propertyMap.containsPropertySet(ccKey)) {
+    if (!properties().containsPropertySet(ccKey)) {
         ui->textBrowser->append("Some data missing.\n");
         this->computeDegreeDistribution();
 
@@ -1198,7 +1292,7 @@ void MainWindow::on_actionClustering_Coefficient_vs_Degree_triggered() {
                 key = "outDegreeDistribution";
         }
 
-        VariantsSet &degrees = propertyMap.getPropertySet(key);
+        VariantsSet &degrees = properties().getPropertySet(key);
         VariantsSet::const_iterator it = degrees.begin();
 
         if (this->weightedgraph) {
@@ -1206,7 +1300,7 @@ void MainWindow::on_actionClustering_Coefficient_vs_Degree_triggered() {
             while (it != degrees.end()) {
                 cc = clusteringCoefficient->clusteringCoefficient(
                         weightedGraph, from_string<unsigned int>(it->first));
-                propertyMap.addProperty<double>(ccKey, it->first, cc);
+                properties().addProperty<double>(ccKey, it->first, cc);
                 ++it;
             }
             delete clusteringCoefficient;
@@ -1215,7 +1309,7 @@ void MainWindow::on_actionClustering_Coefficient_vs_Degree_triggered() {
             while (it != degrees.end()) {
                 cc = clusteringCoefficient->clusteringCoefficient(
                         directedGraph, from_string<unsigned int>(it->first), directed_out, directed_in);
-                propertyMap.addProperty<double>(ccKey, it->first, cc);
+                properties().addProperty<double>(ccKey, it->first, cc);
                 ++it;
             }
             delete clusteringCoefficient;
@@ -1224,13 +1318,13 @@ void MainWindow::on_actionClustering_Coefficient_vs_Degree_triggered() {
             while (it != degrees.end()) {
                 cc = clusteringCoefficient->clusteringCoefficient(
                         graph, from_string<unsigned int>(it->first));
-                propertyMap.addProperty<double>(ccKey, it->first, cc);
+                properties().addProperty<double>(ccKey, it->first, cc);
                 ++it;
             }
             delete clusteringCoefficient;
         }
     }
-    ret = this->console->plotPropertySet(propertyMap.getPropertySet(ccKey), ccKey);
+    ret = this->console->plotPropertySet(properties().getPropertySet(ccKey), ccKey);
     this->console->show();
     this->activateWindow();
     if (!ret)
@@ -1252,7 +1346,7 @@ void MainWindow::on_actionNearest_Neighbors_Degree_vs_Degree_triggered() {
 
     std::string nnKey = "nearestNeighborDegreeForDegree" + directedPostfix;
 
-    if (!propertyMap.containsPropertySet(nnKey)) {
+    if (!properties().containsPropertySet(nnKey)) {
         this->computeDegreeDistribution();
 
         std::string key = "degreeDistribution";
@@ -1266,7 +1360,7 @@ void MainWindow::on_actionNearest_Neighbors_Degree_vs_Degree_triggered() {
             }
         }
 
-        VariantsSet &degrees = propertyMap.getPropertySet(key);
+        VariantsSet &degrees = properties().getPropertySet(key);
         VariantsSet::const_iterator it = degrees.begin();
 
         if (this->weightedgraph) {
@@ -1274,7 +1368,7 @@ void MainWindow::on_actionNearest_Neighbors_Degree_vs_Degree_triggered() {
             while (it != degrees.end()) {
                 knn = nearestNeighborDegree->meanDegree(
                         weightedGraph, from_string<unsigned int>(it->first));
-                propertyMap.addProperty<double>(nnKey, it->first, knn);
+                properties().addProperty<double>(nnKey, it->first, knn);
                 ++it;
             }
             delete nearestNeighborDegree;
@@ -1283,7 +1377,7 @@ void MainWindow::on_actionNearest_Neighbors_Degree_vs_Degree_triggered() {
             while (it != degrees.end()) {
                 knn = nearestNeighborDegree->meanDegree(
                         directedGraph, from_string<unsigned int>(it->first), directed_out, directed_in);
-                propertyMap.addProperty<double>(nnKey, it->first, knn);
+                properties().addProperty<double>(nnKey, it->first, knn);
                 ++it;
             }
             delete nearestNeighborDegree;
@@ -1292,13 +1386,13 @@ void MainWindow::on_actionNearest_Neighbors_Degree_vs_Degree_triggered() {
             while (it != degrees.end()) {
                 knn =
                         nearestNeighborDegree->meanDegree(graph, from_string<unsigned int>(it->first));
-                propertyMap.addProperty<double>(nnKey, it->first, knn);
+                properties().addProperty<double>(nnKey, it->first, knn);
                 ++it;
             }
             delete nearestNeighborDegree;
         }
     }
-    ret = this->console->plotPropertySet(propertyMap.getPropertySet(nnKey), nnKey);
+    ret = this->console->plotPropertySet(properties().getPropertySet(nnKey), nnKey);
     this->console->show();
     this->activateWindow();
     if (!ret)
@@ -1312,14 +1406,17 @@ void MainWindow::on_actionShell_Index_vs_Degree_triggered() {
         ui->textBrowser->append("Shell index for weighted graphs is not supported.");
         return;
     }
-    this->computeShellIndex(ShellIndexTypeSimple, "simple");
+    this->computeShellIndex(ShellIndexTypeSimple, "simple", [this]() { plotShellIndexVsDegree(); });
+}
+
+void MainWindow::plotShellIndexVsDegree() {
     this->computeDegreeDistribution();
     double shellAuxAcum;
     unsigned int degreeAmount, vertedId;
     int ret;
     VariantsSet shellIndexVsDegree;
-    VariantsSet &shellIndex = propertyMap.getPropertySet("simpleshellIndex");
-    VariantsSet &degreeDistribution = propertyMap.getPropertySet("degreeDistribution");
+    VariantsSet &shellIndex = properties().getPropertySet("simpleshellIndex");
+    VariantsSet &degreeDistribution = properties().getPropertySet("degreeDistribution");
     VariantsSet::const_iterator it = degreeDistribution.begin();
     VariantsSet::const_iterator shellIt = shellIndex.begin();
     VariantsSet::const_iterator shellVsDegreeIt;
@@ -1351,7 +1448,7 @@ void MainWindow::on_actionShell_Index_vs_Degree_triggered() {
     }
     shellVsDegreeIt = shellIndexVsDegree.begin();
     while (shellVsDegreeIt != shellIndexVsDegree.end()) {
-        propertyMap.addProperty<double>(
+        properties().addProperty<double>(
                 "shellIndexVsDegree", shellVsDegreeIt->first,
                 from_string<double>(shellVsDegreeIt->second));
         ++shellVsDegreeIt;
@@ -1365,14 +1462,17 @@ void MainWindow::on_actionShell_Index_vs_Degree_triggered() {
 }
 
 void MainWindow::on_actionBetweenness_vs_Degree_triggered() {
-    this->computeBetweenness();
+    this->computeBetweenness([this]() { plotBetweennessVsDegree(); });
+}
+
+void MainWindow::plotBetweennessVsDegree() {
     this->computeDegreeDistribution();
     double betweennessAuxAcum;
     unsigned int degreeAmount;
     int ret;
     VariantsSet betweennessVsDegree;
-    VariantsSet &betweenness = propertyMap.getPropertySet("betweenness");
-    VariantsSet &degreeDistribution = propertyMap.getPropertySet("degreeDistribution");
+    VariantsSet &betweenness = properties().getPropertySet("betweenness");
+    VariantsSet &degreeDistribution = properties().getPropertySet("degreeDistribution");
     VariantsSet::const_iterator it = degreeDistribution.begin();
     VariantsSet::const_iterator betwennessIt = betweenness.begin();
     VariantsSet::const_iterator betweennessVsDegreeIt;
@@ -1409,7 +1509,7 @@ void MainWindow::on_actionBetweenness_vs_Degree_triggered() {
 
     betweennessVsDegreeIt = betweennessVsDegree.begin();
     while (betweennessVsDegreeIt != betweennessVsDegree.end()) {
-        propertyMap.addProperty<double>(
+        properties().addProperty<double>(
                 "betweennessVsDegree", betweennessVsDegreeIt->first,
                 from_string<double>(betweennessVsDegreeIt->second));
         ++betweennessVsDegreeIt;
@@ -1437,8 +1537,8 @@ void MainWindow::on_actionExportNearest_Neighbors_Degree_vs_Degree_triggered() {
 
         std::string nnKey = "nearestNeighborDegreeForDegree" + directedPostfix;
 
-        if (propertyMap.containsPropertySet(nnKey)) {
-            grapherUtils.exportPropertySet(propertyMap.getPropertySet(nnKey), ret);
+        if (properties().containsPropertySet(nnKey)) {
+            grapherUtils.exportPropertySet(properties().getPropertySet(nnKey), ret);
             ui->textBrowser->append("Done.");
         } else
             ui->textBrowser->append(
@@ -1453,8 +1553,8 @@ void MainWindow::on_actionExportShell_Index_vs_Degree_triggered() {
     ui->textBrowser->append("Exporting Shell Index vs Degree...");
     ret = this->getSavePath();
     if (!ret.empty()) {
-        if (propertyMap.containsPropertySet("shellIndexVsDegree")) {
-            grapherUtils.exportPropertySet(propertyMap.getPropertySet("shellIndexVsDegree"), ret);
+        if (properties().containsPropertySet("shellIndexVsDegree")) {
+            grapherUtils.exportPropertySet(properties().getPropertySet("shellIndexVsDegree"), ret);
             ui->textBrowser->append("Done.");
         } else
             ui->textBrowser->append(
@@ -1479,8 +1579,8 @@ void MainWindow::on_actionExportClustering_Coefficient_vs_Degree_triggered() {
 
         std::string ccKey = "clusteringCoeficientForDegree" + directedPostfix;
 
-        if (propertyMap.containsPropertySet(ccKey)) {
-            grapherUtils.exportPropertySet(propertyMap.getPropertySet(ccKey), ret);
+        if (properties().containsPropertySet(ccKey)) {
+            grapherUtils.exportPropertySet(properties().getPropertySet(ccKey), ret);
             ui->textBrowser->append("Done.");
         } else
             ui->textBrowser->append(
@@ -1497,18 +1597,18 @@ void MainWindow::on_actionExportDegree_distribution_triggered() {
     std::string filename = ret;
     if (!ret.empty()) {
         if (!this->digraph) {
-            if (propertyMap.containsPropertySet("degreeDistributionProbability")) {
+            if (properties().containsPropertySet("degreeDistributionProbability")) {
                 grapherUtils.exportPropertySet(
-                        propertyMap.getPropertySet("degreeDistributionProbability"), ret);
+                        properties().getPropertySet("degreeDistributionProbability"), ret);
                 ui->textBrowser->append("Done.");
             } else
                 ui->textBrowser->append(
                         "Degree Distribution has not been previously computed. Please go to "
                         "Plot->Degree Distribution first.");
         } else {
-            if (propertyMap.containsPropertySet("outDegreeDistributionProbability")) {
+            if (properties().containsPropertySet("outDegreeDistributionProbability")) {
                 grapherUtils.exportPropertySet(
-                        propertyMap.getPropertySet("outDegreeDistributionProbability"),
+                        properties().getPropertySet("outDegreeDistributionProbability"),
                         ret.append("_out_degree"));
                 std::string text = "Out-Degree Distribution was exported to ";
                 text.append(ret.append("_out_degree"));
@@ -1519,9 +1619,9 @@ void MainWindow::on_actionExportDegree_distribution_triggered() {
                         "Degree Distribution has not been previously computed. Please go to "
                         "Plot->Degree Distribution first.");
 
-            if (propertyMap.containsPropertySet("inDegreeDistributionProbability")) {
+            if (properties().containsPropertySet("inDegreeDistributionProbability")) {
                 grapherUtils.exportPropertySet(
-                        propertyMap.getPropertySet("inDegreeDistributionProbability"),
+                        properties().getPropertySet("inDegreeDistributionProbability"),
                         filename.append("_in_degree"));
                 std::string text = "In-Degree Distribution was exported to ";
                 text.append(filename.append("_in_degree"));
@@ -1541,8 +1641,8 @@ void MainWindow::on_actionExportBetweenness_vs_Degree_triggered() {
     ui->textBrowser->append("Exporting Betweenness vs Degree...");
     ret = this->getSavePath();
     if (!ret.empty()) {
-        if (propertyMap.containsPropertySet("betweennessVsDegree")) {
-            grapherUtils.exportPropertySet(propertyMap.getPropertySet("betweennessVsDegree"), ret);
+        if (properties().containsPropertySet("betweennessVsDegree")) {
+            grapherUtils.exportPropertySet(properties().getPropertySet("betweennessVsDegree"), ret);
             ui->textBrowser->append("Done.");
         } else
             ui->textBrowser->append(
@@ -1559,8 +1659,13 @@ void MainWindow::on_actionExport_current_network_triggered() {
     if (!ret.empty()) {
         if (this->graphLoaded) {
             GraphWriter *graphWriter = new GraphWriter();
-            if (this->weightedgraph)
+            const bool snapshot = GraphSnapshot::hasExtension(ret);
+            if (this->weightedgraph && snapshot)
+                graphWriter->writeWeightedGraphSnapshot(&(this->weightedGraph), ret);
+            else if (this->weightedgraph)
                 graphWriter->writeWeightedGraph(&(this->weightedGraph), ret);
+            else if (snapshot)
+                graphWriter->writeGraphSnapshot(&(this->graph), ret);
             else
                 graphWriter->writeGraph(&(this->graph), ret);
 
@@ -1619,13 +1724,17 @@ void MainWindow::on_actionNewErdosRenyi_triggered() {
 
     int n = intInputId("n:", 1000);
     double p = doubleInputId("p:", 0.01);
-    QString ret;
+    std::uint64_t seed = seedInput();
 
-    try {
+    // generated on a worker thread; the current network stays if the job is cancelled
+    auto generated = std::make_shared<Graph *>(nullptr);
+    jobs.start("Generating an Erdos-Renyi network", [=]() {
+        *generated = GraphGenerator::getInstance()->generateErdosRenyiGraph(n, p, true, 0, seed);
+    }, [=]() {
         this->onNetworkLoad(false, false, false);
         buildGraphFactory(false, false);
 
-        graph = *(GraphGenerator::getInstance()->generateErdosRenyiGraph(n, p));
+        graph = **generated;
 
         QString text("Network created using Erdos-Renyi algorithm");
         text.append(
@@ -1635,44 +1744,49 @@ void MainWindow::on_actionNewErdosRenyi_triggered() {
         text.append(QString("%1").arg(n));
         text.append("\np: ");
         text.append(QString("%1").arg(p));
+        text.append("\nseed: ");
+        text.append(QString::number(seed));
         text.append("\nAmount of vertices in the graph: ");
         unsigned int verticesCount = graph.verticesCount();
         text.append(QString("%1").arg(verticesCount));
         text.append(".\n");
         text.append("Done.\n");
         ui->textBrowser->append(text);
-    }
-    catch (const BadElementName &ex) {
-        ret.append("Error ").append(".\n");
-        ui->textBrowser->append(ret);
-    }
+    });
 }
 
 void MainWindow::on_actionNewHiperbolic_triggered() {
     if (!closeCurrentGraph())
         return;
-    QString ret;
     unsigned int n = intInputId("n:", 10000);
     double a = doubleInputId("a:", 0.75);
     double deg = doubleInputId("deg:", 0.0014);
-
-    try {
+    std::uint64_t seed = seedInput();
+
+    QString header("Creating a network using a Papadopoulos hyperbolic graph algorithm...");
+    header.append("\nexpected avg node deg: ");
+    header.append(
+            QString("%1").arg(GraphGenerator::getInstance()->getExpectedAvgNodeDeg(n, a, deg)));
+
+    // generated on a worker thread; the current network stays if the job is cancelled
+    auto generated = std::make_shared<Graph *>(nullptr);
+    jobs.start("Generating a hyperbolic network", [=]() {
+        *generated = GraphGenerator::getInstance()->generateHiperbolicGraph(n, a, deg, 0, seed);
+    }, [=]() {
         this->onNetworkLoad(false, false, false);
         buildGraphFactory(false, false);
 
-        QString text("Creating a network using a Papadopoulos hyperbolic graph algorithm...");
-        text.append("\nexpected avg node deg: ");
-        text.append(
-                QString("%1").arg(GraphGenerator::getInstance()->getExpectedAvgNodeDeg(n, a, deg)));
-
-        graph = *(GraphGenerator::getInstance()->generateHiperbolicGraph(n, a, deg));
+        graph = **generated;
 
+        QString text(header);
         text.append("\nn: ");
         text.append(QString("%1").arg(n));
         text.append("\na: ");
         text.append(QString("%1").arg(a));
         text.append("\ndeg: ");
         text.append(QString("%1").arg(deg));
+        text.append("\nseed: ");
+        text.append(QString::number(seed));
 
         text.append("\nAmount of vertices in the graph: ");
         unsigned int verticesCount = graph.verticesCount();
@@ -1680,11 +1794,7 @@ void MainWindow::on_actionNewHiperbolic_triggered() {
         text.append(".\n");
         text.append("Done.\n");
         ui->textBrowser->append(text);
-    }
-    catch (const BadElementName &ex) {
-        ret.append("Error ").append(".\n");
-        ui->textBrowser->append(ret);
-    }
+    });
 }
 
 void MainWindow::on_actionNewBarabasiAlbert_triggered() {
@@ -1694,26 +1804,30 @@ void MainWindow::on_actionNewBarabasiAlbert_triggered() {
     QString inputM_0 = inputId("m_0:");
     QString inputM = inputId("m:");
     QString inputN = inputId("n:");
-    QString ret;
+    std::uint64_t seed = seedInput();
 
     unsigned int m_0 = 4;
     unsigned int m = 2;
     unsigned int n = 1000;
 
-    try {
-        this->onNetworkLoad(false, false, false);
-        buildGraphFactory(false, false);
+    if (!inputM_0.isEmpty())
+        m_0 = inputM_0.toInt();
+    if (!inputM.isEmpty())
+        m = inputM.toInt();
+    if (!inputN.isEmpty())
+        n = inputN.toInt();
 
-        if (!inputM_0.isEmpty())
-            m_0 = inputM_0.toInt();
-        if (!inputM.isEmpty())
-            m = inputM.toInt();
-        if (!inputN.isEmpty())
-            n = inputN.toInt();
+    m_0 = std::max(m_0, m);
 
-        m_0 = std::max(m_0, m);
+    // generated on a worker thread; the current network stays if the job is cancelled
+    auto generated = std::make_shared<Graph *>(nullptr);
+    jobs.start("Generating a Barabasi-Albert network", [=]() {
+        *generated = GraphGenerator::getInstance()->generateBarabasiAlbertGraph(m_0, m, n, seed);
+    }, [=]() {
+        this->onNetworkLoad(false, false, false);
+        buildGraphFactory(false, false);
 
-        graph = *(GraphGenerator::getInstance()->generateBarabasiAlbertGraph(m_0, m, n));
+        graph = **generated;
 
         QString text("Network created using Barabasi-Albert algorithm");
         text.append(
@@ -1725,17 +1839,15 @@ void MainWindow::on_actionNewBarabasiAlbert_triggered() {
         text.append(QString("%1").arg(m));
         text.append("\nn: ");
         text.append(QString("%1").arg(n));
+        text.append("\nseed: ");
+        text.append(QString::number(seed));
         text.append("\nAmount of vertices in the graph: ");
         unsigned int verticesCount = graph.verticesCount();
         text.append(QString("%1").arg(verticesCount));
         text.append(".\n");
         text.append("Done.\n");
         ui->textBrowser->append(text);
-    }
-    catch (const BadElementName &ex) {
-        ret.append("Error ").append(".\n");
-        ui->textBrowser->append(ret);
-    }
+    });
 }
 
 void MainWindow::on_actionNewExtendedHOT_triggered() {
@@ -1747,7 +1859,7 @@ void MainWindow::on_actionNewExtendedHOT_triggered() {
     QString inputXI = inputId("xi:");
     QString inputQ = inputId("q:");
     QString inputT = inputId("T:");
-    QString ret;
+    std::uint64_t seed = seedInput();
 
     // The default parameters are taken from the paper
     // (http://cnet.fi.uba.ar/ignacio.alvarez-hamelin/pdf/model_internet_jiah_ns.pdf)
@@ -1759,22 +1871,27 @@ void MainWindow::on_actionNewExtendedHOT_triggered() {
     float r = xi;
     unsigned int t = 1;
 
-    try {
+    if (!inputN.isEmpty())
+        n = inputN.toInt();
+    if (!inputM.isEmpty())
+        m = inputM.toInt();
+    if (!inputXI.isEmpty())
+        xi = inputXI.toInt();
+    if (!inputQ.isEmpty())
+        q = inputQ.toInt();
+    if (!inputT.isEmpty())
+        t = inputT.toInt();
+
+    // generated on a worker thread; the current network stays if the job is cancelled
+    auto generated = std::make_shared<Graph *>(nullptr);
+    jobs.start("Generating a HOT extended network", [=]() {
+        *generated = GraphGenerator::getInstance()->generateHotExtendedGraph(
+                m, n, xi, q, r, t, seed);
+    }, [=]() {
         this->onNetworkLoad(false, false, false);
         buildGraphFactory(false, false);
 
-        if (!inputN.isEmpty())
-            n = inputN.toInt();
-        if (!inputM.isEmpty())
-            m = inputM.toInt();
-        if (!inputXI.isEmpty())
-            xi = inputXI.toInt();
-        if (!inputQ.isEmpty())
-            q = inputQ.toInt();
-        if (!inputT.isEmpty())
-            t = inputT.toInt();
-
-        graph = *(GraphGenerator::getInstance()->generateHotExtendedGraph(m, n, xi, q, r, t));
+        graph = **generated;
 
         QString text("Network created using HOT extended Algorithm");
         text.append(
@@ -1793,17 +1910,15 @@ void MainWindow::on_actionNewExtendedHOT_triggered() {
         text.append(QString("%1").arg(q));
         text.append("\nT: ");
         text.append(QString("%1").arg(t));
+        text.append("\nseed: ");
+        text.append(QString::number(seed));
         text.append("\nVertex count:");
         unsigned int verticesCount = graph.verticesCount();
         text.append(QString("%1").arg(verticesCount));
         text.append(".\n");
         text.append("Done.\n");
         ui->textBrowser->append(text);
-    }
-    catch (const BadElementName &ex) {
-        ret.append("Error ").append(".\n");
-        ui->textBrowser->append(ret);
-    }
+    });
 }
 
 void MainWindow::on_actionNewMolloyReed_triggered() {
@@ -1816,18 +1931,24 @@ void MainWindow::on_actionNewMolloyReed_triggered() {
     fileDialog.setDirectory(QDir::homePath());
     QStringList selectedFiles;
 
-    QString ret;
     if (fileDialog.exec()) {
-        try {
+        std::uint64_t seed = seedInput();
+        selectedFiles = fileDialog.selectedFiles();
+        QString file = selectedFiles[0];
+        std::string path = file.toStdString();
+
+        // generated on a worker thread; a reading error is reported by onJobFailed
+        auto generated = std::make_shared<Graph *>(nullptr);
+        jobs.start("Generating a Molloy-Reed network", [=]() {
+            *generated = GraphGenerator::getInstance()->generateMolloyReedGraph(path, false, seed);
+        }, [=]() {
             this->onNetworkLoad(false, false, false);
             buildGraphFactory(false, false);
 
-            selectedFiles = fileDialog.selectedFiles();
-            std::string path = selectedFiles[0].toStdString();
-            graph = *(GraphGenerator::getInstance()->generateMolloyReedGraph(path));
+            graph = **generated;
 
             QString text("Network created using Molloy-Reed algorithm using the file: ");
-            text.append(selectedFiles[0]);
+            text.append(file);
             text.append(
                     "\nReference: M. Molloy and B. Reed, A critical point for random graphs with a "
                     "given degree sequence,Random Struct. Algorithms, 6 (1995), 161-179.");
@@ -1835,25 +1956,15 @@ void MainWindow::on_actionNewMolloyReed_triggered() {
                     "\nReference: M. Molloy and B. Reed, The size of the giant component of a "
                     "random graph with a given degree distribution, Combinatorics, Probab. "
                     "Comput., 7factory (1998), 295-305.");
+            text.append("\nseed: ");
+            text.append(QString::number(seed));
             text.append("\nAmount of vertices in the graph: ");
             unsigned int verticesCount = graph.verticesCount();
             text.append(QString("%1").arg(verticesCount));
             text.append(".\n");
             text.append("Done.\n");
             ui->textBrowser->append(text);
-        }
-        catch (const FileNotFoundException &ex) {
-            ui->textBrowser->append("Error while loading graph.");
-            ui->textBrowser->append(ex.what());
-            onNetworkUnload();
-            return;
-        }
-        catch (const UnsignedIntegerMalformedException &ex) {
-            ui->textBrowser->append("Error while loading graph.");
-            ui->textBrowser->append(ex.what());
-            onNetworkUnload();
-            return;
-        }
+        });
     }
 }
 
@@ -1871,7 +1982,7 @@ void MainWindow::computeCumulativeDegreeDistribution() {
             key = "outDegreeDistribution";
     }
 
-    VariantsSet &degrees = propertyMap.getPropertySet(key);
+    VariantsSet &degrees = properties().getPropertySet(key);
     VariantsSet::const_iterator transferIt = degrees.begin();
 
     std::map<unsigned int, double> myMap;
@@ -1883,21 +1994,27 @@ void MainWindow::computeCumulativeDegreeDistribution() {
         ++transferIt;
     }
 
+    PropertySeries<double> &cumulative =
+            properties().series<double>("cumulativeDegreeDistribution");
+    PropertySeries<double> &cumulativeProbability =
+            properties().series<double>("cumulativeDegreeDistributionProbability");
+    cumulative.clear();
+    cumulativeProbability.clear();
+    cumulative.reserve(myMap.size());
+    cumulativeProbability.reserve(myMap.size());
+
     double cumulate = 0;
     for (const auto &key : myMap) {
         cumulate += key.second;
-        propertyMap.addProperty<double>(
-                "cumulativeDegreeDistribution", to_string<unsigned int>(key.first), cumulate);
-        propertyMap.addProperty<double>(
-                "cumulativeDegreeDistributionProbability", to_string<unsigned int>(key.first),
-                cumulate / total);
+        cumulative.set(key.first, cumulate);
+        cumulativeProbability.set(key.first, cumulate / total);
     }
 }
 
 void MainWindow::on_actionCumulativeDegree_distribution_plotting_triggered() {
     bool ret = false;
     ui->textBrowser->append("Plotting Cumulative Degree Distribution...");
-    if (!propertyMap.containsPropertySet("cumulativeDegreeDistribution") || this->digraph) {
+    if (!properties().containsPropertySet("cumulativeDegreeDistribution") || this->digraph) {
         ui->textBrowser->append(
                 "Cumulative Degree distribution has not been previously computed. Computing now.");
         this->computeCumulativeDegreeDistribution();
@@ -1905,7 +2022,7 @@ void MainWindow::on_actionCumulativeDegree_distribution_plotting_triggered() {
 
     ui->textBrowser->append("Done.\n");
     ret = this->console->plotPropertySet(
-            propertyMap.getPropertySet("cumulativeDegreeDistributionProbability"),
+            properties().getPropertySet("cumulativeDegreeDistributionProbability"),
             "cumulativeDegreeDistribution");
     this->console->show();
     this->activateWindow();
@@ -1919,9 +2036,9 @@ void MainWindow::on_actionExportCumulativeDegree_distribution_triggered() {
     ret = this->getSavePath();
     std::string filename = ret;
     if (!ret.empty()) {
-        if (propertyMap.containsPropertySet("cumulativeDegreeDistributionProbability")) {
-            grapherUtils.exportPropertySet(
-                    propertyMap.getPropertySet("cumulativeDegreeDistributionProbability"), ret);
+        if (properties().containsPropertySet("cumulativeDegreeDistributionProbability")) {
+            grapherUtils.exportSeries(
+                    properties().series<double>("cumulativeDegreeDistributionProbability"), ret);
             ui->textBrowser->append("Done.");
         } else {
             ui->textBrowser->append(
@@ -1942,7 +2059,7 @@ void MainWindow::on_actionBoxplotCC_triggered() {
 
     ui->textBrowser->append("Initializing boxplot for Clustering Coefficient...");
 
-    if (!propertyMap.containsPropertySet("degreeDistribution")) {
+    if (!properties().containsPropertySet("degreeDistribution")) {
         ui->textBrowser->append(
                 "Degree distribution has not been previously computed. Computing now.");
         this->computeDegreeDistribution();
@@ -1968,37 +2085,16 @@ void MainWindow::on_actionBoxplotCC_triggered() {
 }
 
 std::vector<graphpp::Boxplotentry> MainWindow::computeBpentries() {
-    VariantsSet &degrees = propertyMap.getPropertySet("degreeDistribution");
+    VariantsSet &degrees = properties().getPropertySet("degreeDistribution");
     VariantsSet::const_iterator it = degrees.begin();
-    auto clusteringCoefficient = factory->createClusteringCoefficient();
-    double cc = 0;
+    // one triangle count for the whole graph, read back per degree
+    const TriangleCounter triangles(graph);
     std::vector<graphpp::Boxplotentry> bpentries;
     while (it != degrees.end()) {
-        // this calculates the Mean CC for a degree. I think it's unnecesary..
-        cc = clusteringCoefficient->clusteringCoefficient(
-                graph, from_string<unsigned int>(it->first));
-
-        // Starting here: instead of calling a function at ClusteringCoefficient.h, I've put
-        // everything here because the other way was not working.
-
-        Graph &g = graph;
         unsigned int d = from_string<unsigned int>(it->first);
-        auto vit = g.verticesIterator();
-        std::vector<double> clusteringCoefs;
+        const double cc = triangles.meanClustering(d);
+        const std::vector<double> &clusteringCoefs = triangles.clusteringForDegree(d);
 
-        while (!vit.end()) {
-            Vertex *v = *vit;
-
-            if (v->degree() == d) {
-                double c = clusteringCoefficient->vertexClusteringCoefficient(v);
-                clusteringCoefs.push_back(c);
-            }
-
-            ++vit;
-        }
-        // to here
-
-        std::sort(begin(clusteringCoefs), end(clusteringCoefs));
         graphpp::Boxplotentry entry;
         if (clusteringCoefs.size() > 0) {
             entry.degree = d;
@@ -2016,7 +2112,6 @@ std::vector<graphpp::Boxplotentry> MainWindow::computeBpentries() {
         }
 
         bpentries.push_back(entry);
-        clusteringCoefs.clear();
 
         ++it;
     }
@@ -2029,28 +2124,28 @@ graphpp::Boxplotentry MainWindow::computeTotalBpEntries() {
     Graph &g = graph;
     auto vit = g.verticesIterator();
     std::vector<double> clusteringCoefs;
-    auto clusteringCoefficient = factory->createClusteringCoefficient();
+    const TriangleCounter triangles(g);
     double coefSums = 0.0;
     unsigned int count = 0;
     double oldCoef;
-    int degree_exists = propertyMap.containsPropertySet("clusteringCoeficientForDegreeO") ? 1 : 0;
+    int degree_exists = properties().containsPropertySet("clusteringCoeficientForDegreeO") ? 1 : 0;
 
     while (!vit.end()) {
         Vertex *v = *vit;
-        if (!propertyMap.containsProperty(
+        if (!properties().containsProperty(
                 "clusteringCoeficientForDegreeO", to_string<unsigned int>(v->degree()))) {
             oldCoef = 0;
         } else {
-            oldCoef = propertyMap.getProperty<double>(
+            oldCoef = properties().getProperty<double>(
                     "clusteringCoeficientForDegreeO", to_string<unsigned int>(v->degree()));
         }
-        double c = clusteringCoefficient->vertexClusteringCoefficient(v);
-        propertyMap.addProperty<double>(
+        double c = triangles.clustering(v->getVertexId());
+        properties().addProperty<double>(
                 "clusteringCoeficientForVertex", to_string<unsigned int>(v->getVertexId()), c);
         if (degree_exists == 0)
-            propertyMap.addProperty<double>(
+            properties().addProperty<double>(
                     "clusteringCoeficientForDegreeO", to_string<unsigned int>(v->degree()),
-                    oldCoef + (c / propertyMap.getProperty<double>(
+                    oldCoef + (c / properties().getProperty<double>(
                             "degreeDistribution", to_string<unsigned int>(v->degree()))));
         clusteringCoefs.push_back(c);
         coefSums += c;
@@ -2085,24 +2180,24 @@ graphpp::Boxplotentry MainWindow::computeTotalBpEntriesKnn() {
     unsigned int count = 0;
 
     double oldCoef;
-    int degree_exists = propertyMap.containsPropertySet("nearestNeighborDegreeForDegreeO") ? 1 : 0;
+    int degree_exists = properties().containsPropertySet("nearestNeighborDegreeForDegreeO") ? 1 : 0;
 
     while (!vit.end()) {
         Vertex *v = *vit;
-        if (!propertyMap.containsProperty(
+        if (!properties().containsProperty(
                 "nearestNeighborDegreeForDegreeO", to_string<unsigned int>(v->degree()))) {
             oldCoef = 0;
         } else {
-            oldCoef = propertyMap.getProperty<double>(
+            oldCoef = properties().getProperty<double>(
                     "nearestNeighborDegreeForDegreeO", to_string<unsigned int>(v->degree()));
         }
         auto c = nearestNeighborDegree->meanDegreeForVertex(v);
-        propertyMap.addProperty<double>(
+        properties().addProperty<double>(
                 "nearestNeighborDegreeForVertex", to_string<unsigned int>(v->getVertexId()), c);
         if (degree_exists == 0)
-            propertyMap.addProperty<double>(
+            properties().addProperty<double>(
                     "nearestNeighborDegreeForDegreeO", to_string<unsigned int>(v->degree()),
-                    oldCoef + (c / propertyMap.getProperty<double>(
+                    oldCoef + (c / properties().getProperty<double>(
                             "degreeDistribution", to_string<unsigned int>(v->degree()))));
         nnCoefs.push_back(c);
         coefSums += c;
@@ -2132,17 +2227,12 @@ graphpp::Boxplotentry MainWindow::computeTotalBpEntriesBetweenness() {
     Graph &g = graph;
     auto vit = g.verticesIterator();
     std::vector<double> bCoefs;
-
-    auto betweenness = factory->createBetweenness(g);
-    // TODO: replace with smart pointer
-    delete betweenness;
-
     double coefSums = 0.0;
     unsigned int count = 0;
 
     while (!vit.end()) {
         Vertex *v = *vit;
-        double c = propertyMap.getProperty<double>(
+        double c = properties().getProperty<double>(
                 "betweenness", to_string<unsigned int>(v->getVertexId()));
         bCoefs.push_back(c);
         coefSums += c;
@@ -2218,7 +2308,7 @@ graphpp::Boxplotentry MainWindow::computeTotalBpEntriesShellIndex(std::string pr
             // If the iterator works correctly, the next id will always be greater than the current one
             if(v->getVertexId() > lastVertexId){
                 int c =
-                        propertyMap.getProperty<int>(prefix + "shellIndex", to_string<unsigned int>(v->getVertexId()));
+                        properties().getProperty<int>(prefix + "shellIndex", to_string<unsigned int>(v->getVertexId()));
                 bCoefs.push_back(c);
                 coefSums += c;
                 count++;
@@ -2233,7 +2323,7 @@ graphpp::Boxplotentry MainWindow::computeTotalBpEntriesShellIndex(std::string pr
         while (!vit.end()) {
             Vertex *v = *vit;
             int c =
-                    propertyMap.getProperty<int>(prefix + "shellIndex", to_string<unsigned int>(v->getVertexId()));
+                    properties().getProperty<int>(prefix + "shellIndex", to_string<unsigned int>(v->getVertexId()));
             bCoefs.push_back(c);
             coefSums += c;
             ++vit;
@@ -2247,7 +2337,7 @@ graphpp::Boxplotentry MainWindow::computeTotalBpEntriesShellIndex(std::string pr
         while (!vit.end()) {
             Vertex *v = *vit;
             int c =
-                    propertyMap.getProperty<int>(prefix + "shellIndex", to_string<unsigned int>(v->getVertexId()));
+                    properties().getProperty<int>(prefix + "shellIndex", to_string<unsigned int>(v->getVertexId()));
             bCoefs.push_back(c);
             coefSums += c;
             ++vit;
@@ -2280,7 +2370,7 @@ void MainWindow::computeClusteringCoefficient(QString vertexId) {
         if ((vertex = weightedGraph.getVertexById(
                 from_string<unsigned int>(vertexId.toStdString()))) != nullptr) {
             auto clusteringCoefficient = weightedFactory->createClusteringCoefficient();
-            propertyMap.addProperty<double>(
+            properties().addProperty<double>(
                     "clusteringCoeficientForVertex", to_string<unsigned int>(vertex->getVertexId()),
                     clusteringCoefficient->vertexClusteringCoefficient(vertex));
             delete clusteringCoefficient;
@@ -2290,7 +2380,7 @@ void MainWindow::computeClusteringCoefficient(QString vertexId) {
         if ((vertex = graph.getVertexById(from_string<unsigned int>(vertexId.toStdString()))) !=
             nullptr) {
             auto clusteringCoefficient = factory->createClusteringCoefficient();
-            propertyMap.addProperty<double>(
+            properties().addProperty<double>(
                     "clusteringCoeficientForVertex", to_string<unsigned int>(vertex->getVertexId()),
                     clusteringCoefficient->vertexClusteringCoefficient(vertex));
             delete clusteringCoefficient;
@@ -2305,7 +2395,7 @@ void MainWindow::on_actionExportCCBoxplot_triggered() {
     ui->textBrowser->append("Exporting Clustering Coefficient boxplot data...");
     ret = this->getSavePath();
     if (!ret.empty()) {
-        if (!propertyMap.containsPropertySet("degreeDistribution")) {
+        if (!properties().containsPropertySet("degreeDistribution")) {
             ui->textBrowser->append(
                     "Degree distribution has not been previously computed. Computing now.");
             this->computeDegreeDistribution();
@@ -2353,7 +2443,7 @@ void MainWindow::on_actionBoxplotNearestNeighborsDegree_triggered() {
 
     ui->textBrowser->append("Initializing boxplot for Nearest Neighbors Degree...");
 
-    if (!propertyMap.containsPropertySet("degreeDistribution")) {
+    if (!properties().containsPropertySet("degreeDistribution")) {
         ui->textBrowser->append(
                 "Degree distribution has not been previously computed. Computing now.");
         this->computeDegreeDistribution();
@@ -2379,7 +2469,7 @@ void MainWindow::on_actionBoxplotNearestNeighborsDegree_triggered() {
 }
 
 std::vector<graphpp::Boxplotentry> MainWindow::computeBpentriesKnn() {
-    VariantsSet &degrees = propertyMap.getPropertySet("degreeDistribution");
+    VariantsSet &degrees = properties().getPropertySet("degreeDistribution");
     VariantsSet::const_iterator it = degrees.begin();
     auto nearestNeighborDegree = factory->createNearestNeighborsDegree();
     double nnd = 0;
@@ -2444,7 +2534,7 @@ void MainWindow::on_actionExportKnnBoxplot_triggered() {
     ui->textBrowser->append("Exporting Nearest Neighbors Degree boxplot data...");
     ret = this->getSavePath();
     if (!ret.empty()) {
-        if (!propertyMap.containsPropertySet("degreeDistribution")) {
+        if (!properties().containsPropertySet("degreeDistribution")) {
             ui->textBrowser->append(
                     "Degree distribution has not been previously computed. Computing now.");
             this->computeDegreeDistribution();
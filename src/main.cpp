@@ -3,6 +3,7 @@
 // Last modification: December 16th, 2015.
 
 #include <QtWidgets/QApplication>
+#include <cerrno>
 #include <cstdlib>
 #include <ctime>
 
@@ -55,6 +56,54 @@ int main(int argc, char* argv[])
             ERROR_EXIT;
         }
 
+        if (args_info->seed_given)
+        {
+            char* end = nullptr;
+            errno = 0;
+            const unsigned long long seed = strtoull(args_info->seed_arg, &end, 10);
+            if (errno != 0 || *args_info->seed_arg == '-' || *end != '\0' ||
+                end == args_info->seed_arg)
+            {
+                usageErrorMessage("The seed must be a non-negative integer.");
+                ERROR_EXIT;
+            }
+            state->setSeed(seed);
+        }
+
+        if (args_info->ensemble_given)
+        {
+            VALIDATE_POS(args_info->ensemble_arg);
+
+            if (args_info->input_file_given)
+            {
+                usageErrorMessage("An ensemble needs a model to generate, not an input file.");
+                ERROR_EXIT;
+            }
+
+            if (!args_info->ddist_output_given && !args_info->clustering_output_given &&
+                !args_info->knn_output_given)
+            {
+                usageErrorMessage(
+                        "An ensemble exports the degree distribution, the clustering coefficient "
+                        "or the nearest neighbors degree. Specify one of their outputs.");
+                ERROR_EXIT;
+            }
+
+            if (args_info->betweenness_given || args_info->ddist_given ||
+                args_info->clustering_given || args_info->knn_given || args_info->shell_given ||
+                args_info->maxCliqueExact_given || args_info->maxCliqueAprox_given ||
+                args_info->print_deg_given)
+            {
+                usageErrorMessage(
+                        "An ensemble only exports aggregated outputs. The analyses of a single "
+                        "graph cannot be combined with it.");
+                ERROR_EXIT;
+            }
+
+            // the realizations are generated by the ensemble, the graph itself is not needed
+            state->setModelOnly(true);
+        }
+
         if (args_info->input_file_given)
         {
             if (args_info->erdos_given || args_info->barabasi_given || args_info->hot_given ||
@@ -83,8 +132,13 @@ int main(int argc, char* argv[])
 
             try
             {
-                state->readGraphFromFile(path.c_str());
+                const graphpp::ReadThroughput throughput = state->readGraphFromFile(path.c_str());
                 std::cout << "Succesfully read graph from file " + path + "\n";
+                if (throughput.getEdgesCount() > 0)
+                    std::cout << "Read " << throughput.getEdgesCount() << " edges in "
+                              << throughput.getSeconds() << " s ("
+                              << (unsigned long long)throughput.getEdgesPerSecond()
+                              << " edges/s)\n";
             }
             catch (const FileNotFoundException& e)
             {
@@ -272,6 +326,15 @@ int main(int argc, char* argv[])
             ERROR_EXIT;
         }
 
+        if (!args_info->input_file_given)
+            std::cout << "Random seed: " + to_string(state->getSeed()) + "\n";
+
+        if (args_info->betweenness_approx_given)
+        {
+            VALIDATE_POS(args_info->betweenness_approx_arg);
+            state->setBetweennessSamples(args_info->betweenness_approx_arg);
+        }
+
         if (args_info->betweenness_given)
         {
             int vertex_id = args_info->betweenness_arg;
@@ -470,7 +533,37 @@ int main(int argc, char* argv[])
         {
             std::string path = args_info->output_file_arg;
 
-            if (args_info->betweenness_output_given || args_info->ddist_output_given ||
+            if (args_info->ensemble_given)
+            {
+                typedef graphpp::Ensemble<Graph, Vertex> GraphEnsemble;
+                unsigned int metric;
+                std::string functionMessage;
+
+                // the same precedence as the outputs of a single graph
+                if (args_info->ddist_output_given)
+                {
+                    metric = GraphEnsemble::DegreeDistribution;
+                    functionMessage = "degreeDistribution";
+                }
+                else if (args_info->clustering_output_given)
+                {
+                    metric = GraphEnsemble::ClusteringVsDegree;
+                    functionMessage = "clustering coefficient";
+                }
+                else
+                {
+                    metric = GraphEnsemble::NearestNeighborsDegreeVsDegree;
+                    functionMessage = "nearest neighbors degree";
+                }
+
+                state->exportEnsemble(
+                        path, args_info->ensemble_arg, metric, args_info->log_bin_given,
+                        args_info->log_bin_arg);
+                std::cout << "Succesfully exported " + functionMessage + " of " +
+                             to_string(args_info->ensemble_arg) + " realizations in output file " +
+                             path + ".\n";
+            }
+            else if (args_info->betweenness_output_given || args_info->ddist_output_given ||
                 args_info->clustering_output_given || args_info->maxCliqueExact_output_given ||
                 args_info->maxCliqueAprox_output_given || args_info->knn_output_given ||
                 args_info->shell_output_given)
@@ -1,5 +1,7 @@
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
 #include <set>
 #include <vector>
 #include <list>
@@ -392,5 +394,97 @@ TEST_F(AdjacencyListGraphTest, VectorContainsVertexTest)
     ASSERT_EQ(v->getVertexId(), 4);
 }
 
+TEST_F(AdjacencyListGraphTest, SparseIdsLookupTest)
+{
+    IndexedGraph g;
+    const unsigned int ids[] = {7, 3000000000u, 5, 123456789, 1024, 0};
+
+    for (unsigned int id : ids)
+        g.addVertex(new Vertex(id));
+
+    for (unsigned int id : ids)
+    {
+        Vertex* v = g.getVertexById(id);
+        ASSERT_TRUE(NULL != v);
+        ASSERT_EQ(v->getVertexId(), id);
+    }
+
+    ASSERT_TRUE(NULL == g.getVertexById(6));
+    ASSERT_TRUE(NULL == g.getVertexById(123456788));
 }
 
+TEST_F(AdjacencyListGraphTest, RemoveVertexLookupTest)
+{
+    VectorGraph g;
+    Vertex* v = new Vertex(1);
+    Vertex* n1 = new Vertex(2);
+    Vertex* far = new Vertex(1000000);
+
+    g.addVertex(v);
+    g.addVertex(n1);
+    g.addVertex(far);
+    g.addEdge(v, n1);
+    g.addEdge(v, far);
+
+    g.removeVertex(far);
+    ASSERT_TRUE(NULL == g.getVertexById(1000000));
+    ASSERT_FALSE(v->isNeighbourOf(far));
+    delete far;
+
+    g.removeVertex(n1);
+    ASSERT_TRUE(NULL == g.getVertexById(2));
+    ASSERT_EQ(g.getVertexById(1), v);
+    delete n1;
+
+    Vertex* readded = new Vertex(2);
+    g.addVertex(readded);
+    ASSERT_EQ(g.getVertexById(2), readded);
+}
+
+TEST_F(AdjacencyListGraphTest, VersionTest)
+{
+    IndexedGraph g;
+    IndexedGraph other;
+    ASSERT_NE(g.getVersion(), other.getVersion());
+
+    Vertex* v1 = new Vertex(1);
+    Vertex* v2 = new Vertex(2);
+    Vertex* v3 = new Vertex(3);
+
+    // every change takes a version no graph had before
+    uint64_t version = max(g.getVersion(), other.getVersion());
+    auto changed = [&]() {
+        const bool ret = g.getVersion() > version;
+        version = g.getVersion();
+        return ret;
+    };
+
+    g.addVertex(v1);
+    ASSERT_TRUE(changed());
+    g.addVertex(v2);
+    g.addVertex(v3);
+    ASSERT_TRUE(changed());
+    g.addEdge(v1, v2);
+    ASSERT_TRUE(changed());
+    ASSERT_THROW(g.addEdge(v1, v2), DuplicateEdge);
+    ASSERT_FALSE(changed());
+    g.addEdgeUnchecked(v2, v3);
+    ASSERT_TRUE(changed());
+
+    // lookups and removing a missing edge leave it alone
+    g.getVertexById(1);
+    g.removeEdge(v1, v3);
+    ASSERT_FALSE(changed());
+    g.removeEdge(v1, v2);
+    ASSERT_TRUE(changed());
+
+    g.removeVertex(v1);
+    delete v1;
+    ASSERT_TRUE(changed());
+    g.removeVerticesIf([](const Vertex* v) { return v->getVertexId() == 9; });
+    ASSERT_FALSE(changed());
+    g.removeVerticesIf([](const Vertex* v) { return v->getVertexId() == 3; });
+    ASSERT_TRUE(changed());
+}
+
+}
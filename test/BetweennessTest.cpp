@@ -83,5 +83,123 @@ TEST_F(BetweennessTest , BetweennessTest)
     }
 }
 
+TEST_F(BetweennessTest, ThreadCountDoesNotChangeResultTest)
+{
+    VectorGraph g;
+    const unsigned int n = 60;
+
+    // a ring with chords, so that there are many equal length paths
+    for (unsigned int id = 1; id <= n; ++id)
+        g.addVertex(new Vertex(id));
+    for (unsigned int id = 1; id <= n; ++id)
+    {
+        g.addEdge(g.getVertexById(id), g.getVertexById(id % n + 1));
+        if (id % 3 == 0 && id <= n / 2)
+            g.addEdge(g.getVertexById(id), g.getVertexById((id + n / 2 - 1) % n + 1));
+    }
+
+    Betweenness<VectorGraph, Vertex> serial(g, 1);
+    Betweenness<VectorGraph, Vertex> parallel(g, 4);
+
+    auto serialIt = serial.iterator();
+    auto parallelIt = parallel.iterator();
+    while (!serialIt.end())
+    {
+        ASSERT_FALSE(parallelIt.end());
+        ASSERT_EQ(serialIt->first, parallelIt->first);
+        ASSERT_NEAR(serialIt->second, parallelIt->second, 1e-6);
+        ++serialIt;
+        ++parallelIt;
+    }
+    ASSERT_TRUE(parallelIt.end());
+}
+
+TEST_F(BetweennessTest, StarAndTriangleValuesTest)
+{
+    IndexedGraph ig;
+    Vertex* x = new Vertex(1);
+    Vertex* v1 = new Vertex(2);
+    Vertex* v2 = new Vertex(3);
+    Vertex* v3 = new Vertex(4);
+    Vertex* v4 = new Vertex(5);
+
+    ig.addVertex(x);
+    ig.addVertex(v1);
+    ig.addVertex(v2);
+    ig.addVertex(v3);
+    ig.addVertex(v4);
+
+    ig.addEdge(x, v1);
+    ig.addEdge(x, v2);
+    ig.addEdge(x, v3);
+    ig.addEdge(v1, v2);
+    ig.addEdge(x, v4);
+
+    Betweenness<IndexedGraph, Vertex> betweenness(ig, 2);
+    auto it = betweenness.iterator();
+
+    // every path between {2,3}, 4 and 5 goes through 1, counted in both directions
+    const double expected[] = {10.0, 0.0, 0.0, 0.0, 0.0};
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+        ASSERT_FALSE(it.end());
+        ASSERT_EQ(it->first, i + 1);
+        ASSERT_NEAR(it->second, expected[i], 1e-9);
+        ++it;
+    }
+}
+
+TEST_F(BetweennessTest, SampledBetweennessTest)
+{
+    VectorGraph g;
+    const unsigned int n = 40;
+
+    for (unsigned int id = 1; id <= n; ++id)
+        g.addVertex(new Vertex(id));
+    for (unsigned int id = 1; id <= n; ++id)
+        g.addEdge(g.getVertexById(id), g.getVertexById(id % n + 1));
+
+    typedef Betweenness<VectorGraph, Vertex>::Sample Sample;
+
+    // sampling every vertex is the exact computation
+    Betweenness<VectorGraph, Vertex> exact(g);
+    Betweenness<VectorGraph, Vertex> full(g, Sample::fromCount(g, n));
+    auto exactIt = exact.iterator();
+    auto fullIt = full.iterator();
+    while (!exactIt.end())
+    {
+        ASSERT_EQ(exactIt->first, fullIt->first);
+        ASSERT_NEAR(exactIt->second, fullIt->second, 1e-6);
+        ++exactIt;
+        ++fullIt;
+    }
+
+    // same seed, same pivots
+    Sample a = Sample::fromCount(g, 10, 42);
+    Sample b = Sample::fromCount(g, 10, 42);
+    ASSERT_EQ(a.getPivots().size(), 10u);
+    ASSERT_TRUE(a.getPivots() == b.getPivots());
+    ASSERT_NEAR(a.getScale(), 4.0, 1e-9);
+
+    // on a ring every vertex has the same betweenness, the estimate is the sum over the
+    // pivots scaled up, so its mean over all vertices is exact
+    Betweenness<VectorGraph, Vertex> sampled(g, a);
+    double exactSum = 0.0;
+    double sampledSum = 0.0;
+    auto sumIt = exact.iterator();
+    auto sampledIt = sampled.iterator();
+    while (!sumIt.end())
+    {
+        exactSum += sumIt->second;
+        sampledSum += sampledIt->second;
+        ++sumIt;
+        ++sampledIt;
+    }
+    ASSERT_NEAR(sampledSum, exactSum, 1e-6);
+
+    ASSERT_EQ(Sample::samplesFor(0.1, 0.1, 1000000), 841u);
+    ASSERT_EQ(Sample::samplesFor(0.1, 0.1, 100), 100u);
+}
+
 }
 
@@ -3,12 +3,14 @@
 #include <set>
 #include <vector>
 #include <list>
+#include <map>
 
 #include "AdjacencyListVertex.h"
 #include "AdjacencyListGraph.h"
 #include "GraphExceptions.h"
 #include "ClusteringCoefficient.h"
 #include "GraphReader.h"
+#include "TriangleCounter.h"
 
 namespace clusterCoefficientTest
 {
@@ -182,5 +184,69 @@ TEST_F(ClusteringCoefficientTest, RealWorldTest)
     
     ASSERT_TRUE(fabs(c - 0.3583333) <  epsilon);
 }
+
+TEST_F(ClusteringCoefficientTest, TriangleCounterCliqueTest)
+{
+    // K4 on 1..4 plus a tail 4-5
+    IndexedGraph g;
+    for (unsigned int id = 1; id <= 5; ++id)
+        g.addVertex(new Vertex(id));
+    for (unsigned int a = 1; a <= 4; ++a)
+        for (unsigned int b = a + 1; b <= 4; ++b)
+            g.addEdge(g.getVertexById(a), g.getVertexById(b));
+    g.addEdge(g.getVertexById(4), g.getVertexById(5));
+
+    TriangleCounter triangles(g);
+
+    ASSERT_EQ(triangles.triangles(1), 3u);
+    ASSERT_EQ(triangles.triangles(4), 3u);
+    ASSERT_EQ(triangles.triangles(5), 0u);
+    ASSERT_EQ(triangles.triangles(42), 0u);
+    ASSERT_DOUBLE_EQ(triangles.clustering(1), 1.0);
+    ASSERT_DOUBLE_EQ(triangles.clustering(4), 0.5);
+    ASSERT_DOUBLE_EQ(triangles.meanClustering(3), 1.0);
+    ASSERT_EQ(triangles.clusteringForDegree(3).size(), 3u);
+    ASSERT_TRUE(triangles.clusteringForDegree(7).empty());
+}
+
+TEST_F(ClusteringCoefficientTest, TriangleCounterMatchesVertexCountTest)
+{
+    VectorGraph g(false, false);
+    GraphReader<VectorGraph, Vertex> graphReader;
+    graphReader.read(g, "TestTrees/AS_CAIDA_2008.txt");
+
+    // the single vertex path, before any whole graph pass is cached
+    ClusteringCoefficient<VectorGraph, Vertex> single;
+    std::map<unsigned int, double> sums;
+    std::map<unsigned int, unsigned int> counts;
+    std::map<unsigned int, double> expected;
+    auto it = g.verticesIterator();
+    while (!it.end())
+    {
+        Vertex* v = *it;
+        expected[v->getVertexId()] = single.vertexClusteringCoefficient(v);
+        sums[v->degree()] += expected[v->getVertexId()];
+        ++counts[v->degree()];
+        ++it;
+    }
+
+    TriangleCounter triangles(g, 1);
+    TriangleCounter parallelTriangles(g, 4);
+    ClusteringCoefficient<VectorGraph, Vertex> clustering;
+    const double epsilon = 1e-12;
+
+    for (const auto& entry : expected)
+    {
+        ASSERT_NEAR(triangles.clustering(entry.first), entry.second, epsilon);
+        ASSERT_EQ(triangles.triangles(entry.first), parallelTriangles.triangles(entry.first));
+    }
+    for (const auto& entry : counts)
+        ASSERT_NEAR(
+            clustering.clusteringCoefficient(g, entry.first), sums[entry.first] / entry.second,
+            epsilon);
+    // now served from the cached pass
+    ASSERT_NEAR(
+        clustering.vertexClusteringCoefficient(g.getVertexById(174)), 0.01141431, 0.001);
+}
 }
 
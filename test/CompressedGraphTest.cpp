@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <set>
+#include <vector>
+#include <list>
+
+#include "AdjacencyListVertex.h"
+#include "AdjacencyListGraph.h"
+#include "Betweenness.h"
+#include "ClusteringCoefficient.h"
+#include "CompressedGraph.h"
+#include "CompressedGraphReader.h"
+#include "DegreeDistribution.h"
+#include "GraphExceptions.h"
+#include "GraphReader.h"
+#include "NearestNeighborsDegree.h"
+#include "ShellIndex.h"
+#include "WeightedGraphAspect.h"
+#include "WeightedVertexAspect.h"
+
+namespace compressedGraphTest
+{
+
+using namespace graphpp;
+using namespace std;
+using ::testing::Test;
+
+class CompressedGraphTest : public Test
+{
+
+protected:
+
+    CompressedGraphTest() { }
+
+    virtual ~CompressedGraphTest() { }
+
+
+    virtual void SetUp()
+    {
+        // Two triangles joined by a path, plus a pendant vertex and an isolated one.
+        unsigned int edges[][2] = {{1, 2}, {2, 3}, {3, 1}, {3, 4}, {4, 5}, {5, 6}, {6, 7},
+                                   {7, 5}, {7, 8}};
+        for (unsigned int id = 1; id <= 9; ++id)
+            ig.addVertex(new Vertex(id));
+        for (auto& e : edges)
+            ig.addEdge(ig.getVertexById(e[0]), ig.getVertexById(e[1]));
+    }
+
+    virtual void TearDown()
+    {
+
+    }
+public:
+    typedef AdjacencyListVertex Vertex;
+    typedef AdjacencyListGraph<Vertex> IndexedGraph;
+    typedef AdjacencyListGraph<Vertex, vector<Vertex*> > VectorGraph;
+
+    IndexedGraph ig;
+};
+
+
+TEST_F(CompressedGraphTest, BuildFromAdjacencyListGraph)
+{
+    CompressedGraph cg(ig);
+
+    ASSERT_EQ(cg.verticesCount(), ig.verticesCount());
+    ASSERT_EQ(cg.edgesCount(), 18u);
+
+    auto it = ig.verticesIterator();
+    while (!it.end())
+    {
+        CompressedVertex* v = cg.getVertexById((*it)->getVertexId());
+        ASSERT_TRUE(v != nullptr);
+        ASSERT_EQ(v->degree(), (*it)->degree());
+        ASSERT_EQ(cg.getIds()[v->getIndex()], v->getVertexId());
+
+        // neighbors are sorted by id
+        unsigned int previous = 0;
+        auto neighbors = v->neighborsIterator();
+        while (!neighbors.end())
+        {
+            ASSERT_TRUE((*neighbors)->getVertexId() > previous);
+            ASSERT_TRUE((*it)->isNeighbourOf(ig.getVertexById((*neighbors)->getVertexId())));
+            ASSERT_TRUE(v->isNeighbourOf(*neighbors));
+            previous = (*neighbors)->getVertexId();
+            ++neighbors;
+        }
+        ++it;
+    }
+
+    ASSERT_TRUE(cg.getVertexById(10) == nullptr);
+    ASSERT_FALSE(cg.getVertexById(1)->isNeighbourOf(cg.getVertexById(4)));
+}
+
+TEST_F(CompressedGraphTest, FromEdgesDropsRepeatedEdges)
+{
+    std::vector<CompressedGraph::Edge> edges = {{10, 20}, {20, 10}, {10, 30}, {10, 20}};
+    CompressedGraph cg = CompressedGraph::fromEdges(edges, {40});
+
+    ASSERT_EQ(cg.verticesCount(), 4u);
+    ASSERT_EQ(cg.getVertexById(10)->degree(), 2u);
+    ASSERT_EQ(cg.getVertexById(20)->degree(), 1u);
+    ASSERT_EQ(cg.getVertexById(40)->degree(), 0u);
+
+    CompressedGraph multi = CompressedGraph::fromEdges(edges, {}, false, true);
+    ASSERT_EQ(multi.getVertexById(10)->degree(), 4u);
+
+    CompressedGraph directed = CompressedGraph::fromEdges(edges, {}, true, false);
+    ASSERT_EQ(directed.getVertexById(10)->degree(), 2u);
+    ASSERT_EQ(directed.getVertexById(20)->degree(), 1u);
+    ASSERT_EQ(directed.getVertexById(30)->degree(), 0u);
+}
+
+TEST_F(CompressedGraphTest, CopyKeepsVerticesBound)
+{
+    CompressedGraph original(ig);
+    CompressedGraph copy = original;
+    original = CompressedGraph();
+
+    ASSERT_EQ(copy.verticesCount(), 9u);
+    ASSERT_EQ(copy.getVertexById(3)->degree(), 3u);
+    ASSERT_TRUE(copy.getVertexById(3)->isNeighbourOf(copy.getVertexById(4)));
+}
+
+TEST_F(CompressedGraphTest, MetricsMatchAdjacencyListGraph)
+{
+    CompressedGraph cg(ig);
+    double epsilon = 0.001;
+
+    Betweenness<IndexedGraph, Vertex> expectedBetweenness(ig);
+    Betweenness<CompressedGraph, CompressedVertex> betweenness(cg);
+    auto expectedIt = expectedBetweenness.iterator();
+    auto it = betweenness.iterator();
+    while (!expectedIt.end())
+    {
+        ASSERT_FALSE(it.end());
+        ASSERT_EQ(it->first, expectedIt->first);
+        ASSERT_NEAR(it->second, expectedIt->second, epsilon);
+        ++it;
+        ++expectedIt;
+    }
+
+    ClusteringCoefficient<IndexedGraph, Vertex> expectedClustering;
+    ClusteringCoefficient<CompressedGraph, CompressedVertex> clustering;
+    NearestNeighborsDegree<IndexedGraph, Vertex> expectedKnn;
+    NearestNeighborsDegree<CompressedGraph, CompressedVertex> knn;
+    for (unsigned int id = 1; id <= 9; ++id)
+    {
+        ASSERT_NEAR(
+            clustering.vertexClusteringCoefficient(cg.getVertexById(id)),
+            expectedClustering.vertexClusteringCoefficient(ig.getVertexById(id)), epsilon);
+        ASSERT_NEAR(
+            knn.meanDegreeForVertex(cg.getVertexById(id)),
+            expectedKnn.meanDegreeForVertex(ig.getVertexById(id)), epsilon);
+    }
+    ASSERT_NEAR(
+        clustering.clusteringCoefficient(cg, 2), expectedClustering.clusteringCoefficient(ig, 2),
+        epsilon);
+
+    ShellIndex<IndexedGraph, Vertex> expectedShellIndex(ig, ShellIndexTypeSimple);
+    ShellIndex<CompressedGraph, CompressedVertex> shellIndex(cg, ShellIndexTypeSimple);
+    auto expectedShellIt = expectedShellIndex.iterator();
+    auto shellIt = shellIndex.iterator();
+    while (!expectedShellIt.end())
+    {
+        ASSERT_EQ(shellIt->first, expectedShellIt->first);
+        ASSERT_EQ(shellIt->second, expectedShellIt->second);
+        ++shellIt;
+        ++expectedShellIt;
+    }
+}
+
+TEST_F(CompressedGraphTest, RealWorldReaderTest)
+{
+    VectorGraph* g = new VectorGraph(false, false);
+    GraphReader<VectorGraph, Vertex> graphReader;
+    graphReader.read(*g, "TestTrees/AS_CAIDA_2008.txt");
+
+    CompressedGraph cg;
+    CompressedGraphReader<CompressedGraph, CompressedVertex> compressedReader;
+    compressedReader.read(cg, "TestTrees/AS_CAIDA_2008.txt");
+
+    ASSERT_EQ(cg.verticesCount(), g->verticesCount());
+
+    DegreeDistribution<VectorGraph, Vertex> expectedDistribution(*g);
+    DegreeDistribution<CompressedGraph, CompressedVertex> distribution(cg);
+    auto expectedIt = expectedDistribution.iterator();
+    auto it = distribution.iterator();
+    while (!expectedIt.end())
+    {
+        ASSERT_EQ(it->first, expectedIt->first);
+        ASSERT_EQ(it->second, expectedIt->second);
+        ++it;
+        ++expectedIt;
+    }
+
+    ClusteringCoefficient<CompressedGraph, CompressedVertex> clustering;
+    double epsilon = 0.001;
+    ASSERT_NEAR(clustering.vertexClusteringCoefficient(cg.getVertexById(3)), 0.6666667, epsilon);
+    ASSERT_NEAR(
+        clustering.vertexClusteringCoefficient(cg.getVertexById(174)), 0.01141431, epsilon);
+    ASSERT_NEAR(
+        clustering.vertexClusteringCoefficient(cg.getVertexById(23148)), 0.3583333, epsilon);
+
+    delete g;
+}
+
+TEST_F(CompressedGraphTest, WeightsFollowNeighbors)
+{
+    typedef WeightedVertexAspect<Vertex> WeightedVertex;
+    typedef WeightedGraphAspect<WeightedVertex, AdjacencyListGraph<WeightedVertex> > WeightedGraph;
+
+    WeightedGraph wg;
+    for (unsigned int id = 1; id <= 4; ++id)
+        wg.addVertex(new WeightedVertex(id));
+    wg.addEdge(wg.getVertexById(3), wg.getVertexById(1), 2.5);
+    wg.addEdge(wg.getVertexById(1), wg.getVertexById(2), 1.0);
+    wg.addEdge(wg.getVertexById(4), wg.getVertexById(1), 7.0);
+
+    CompressedGraph cg(wg);
+    ASSERT_TRUE(cg.isWeighted());
+    ASSERT_EQ(cg.getWeights().size(), cg.edgesCount());
+
+    CompressedVertex* v = cg.getVertexById(1);
+    ASSERT_NEAR(v->edgeWeight(cg.getVertexById(2)), 1.0, 1e-9);
+    ASSERT_NEAR(v->edgeWeight(cg.getVertexById(3)), 2.5, 1e-9);
+    ASSERT_NEAR(v->edgeWeight(cg.getVertexById(4)), 7.0, 1e-9);
+    ASSERT_NEAR(cg.getVertexById(4)->edgeWeight(v), 7.0, 1e-9);
+
+    ASSERT_FALSE(CompressedGraph(ig).isWeighted());
+
+    std::vector<CompressedGraph::Edge> edges = {{1, 2}, {2, 1}};
+    CompressedGraph merged = CompressedGraph::fromWeightedEdges(edges, {3.0, 4.0}, {});
+    ASSERT_EQ(merged.getVertexById(1)->degree(), 1u);
+    ASSERT_NEAR(merged.getVertexById(1)->edgeWeight(merged.getVertexById(2)), 3.0, 1e-9);
+}
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <queue>
+#include <set>
+#include <vector>
+
+#include "ConnectedComponents.h"
+#include "GraphReader.h"
+#include "typedefs.h"
+
+namespace connectedComponentsTest
+{
+
+using namespace graphpp;
+using namespace std;
+using ::testing::Test;
+
+class ConnectedComponentsTest : public Test
+{
+protected:
+
+    ConnectedComponentsTest() { }
+
+    virtual ~ConnectedComponentsTest() { }
+
+    virtual void SetUp()
+    {
+
+    }
+
+    virtual void TearDown()
+    {
+
+    }
+
+    // adds vertices 0..n-1 and the given edges
+    static void build(
+        Graph& g, unsigned int n, const vector<pair<unsigned int, unsigned int>>& edges)
+    {
+        for (unsigned int i = 0; i < n; ++i)
+            g.addVertex(new Vertex(i));
+        for (const auto& edge : edges)
+            g.addEdge(g.getVertexById(edge.first), g.getVertexById(edge.second));
+    }
+
+    // size of the component of v, with a BFS that keeps its own visited set
+    static unsigned int bfsSize(Vertex* v)
+    {
+        set<Vertex*> visited;
+        queue<Vertex*> pending;
+        visited.insert(v);
+        pending.push(v);
+        while (!pending.empty())
+        {
+            auto it = pending.front()->neighborsIterator();
+            pending.pop();
+            while (!it.end())
+            {
+                if (visited.insert(*it).second)
+                    pending.push(*it);
+                ++it;
+            }
+        }
+        return visited.size();
+    }
+};
+
+TEST_F(ConnectedComponentsTest, LabelsTest)
+{
+    // a path 0-4-2, an isolated 1 and a square 3-5-6-7
+    Graph g;
+    build(g, 8, {{0, 4}, {4, 2}, {3, 5}, {5, 6}, {6, 7}, {7, 3}});
+
+    ConnectedComponents<Graph, Vertex> components(g);
+    ASSERT_EQ(3u, components.componentsCount());
+    ASSERT_EQ(vector<unsigned int>({0, 1, 0, 2, 0, 2, 2, 2}), components.componentLabels());
+    ASSERT_EQ(vector<unsigned int>({3, 1, 4}), components.componentSizes());
+    ASSERT_EQ(2u, components.giantComponent());
+    ASSERT_EQ(4u, components.giantComponentSize());
+    ASSERT_EQ(0u, components.component(g.getVertexById(2)));
+
+    // ties go to the lowest label
+    Graph twins;
+    build(twins, 4, {{2, 3}, {0, 1}});
+    ConnectedComponents<Graph, Vertex> twinComponents(twins);
+    ASSERT_EQ(0u, twinComponents.giantComponent());
+
+    Graph empty;
+    ConnectedComponents<Graph, Vertex> none(empty);
+    ASSERT_EQ(0u, none.componentsCount());
+    ASSERT_EQ(0u, none.giantComponentSize());
+    none.keepGiantComponent(empty);
+    ASSERT_EQ(0u, empty.verticesCount());
+}
+
+TEST_F(ConnectedComponentsTest, KeepGiantComponentTest)
+{
+    Graph g;
+    build(g, 8, {{0, 4}, {4, 2}, {3, 5}, {5, 6}, {6, 7}, {7, 3}, {5, 7}});
+
+    ConnectedComponents<Graph, Vertex> components(g);
+    components.keepGiantComponent(g);
+
+    ASSERT_EQ(4u, g.verticesCount());
+    ASSERT_TRUE(g.getVertexById(0) == nullptr);
+    ASSERT_TRUE(g.getVertexById(1) == nullptr);
+    ASSERT_EQ(3u, g.getVertexById(5)->degree());
+    ASSERT_EQ(2u, g.getVertexById(6)->degree());
+
+    vector<unsigned int> ids;
+    auto it = g.verticesIterator();
+    while (!it.end())
+    {
+        ids.push_back((*it)->getVertexId());
+        ++it;
+    }
+    ASSERT_EQ(vector<unsigned int>({3, 5, 6, 7}), ids);
+}
+
+TEST_F(ConnectedComponentsTest, RemoveVerticesIfTest)
+{
+    // removing the middle of a path cuts the edges on both sides
+    Graph g;
+    build(g, 5, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {1, 3}});
+
+    g.removeVerticesIf([](const Vertex* v) { return v->getVertexId() % 2 == 0; });
+    ASSERT_EQ(2u, g.verticesCount());
+    Vertex* one = g.getVertexById(1);
+    Vertex* three = g.getVertexById(3);
+    ASSERT_EQ(1u, one->degree());
+    ASSERT_EQ(1u, three->degree());
+    ASSERT_TRUE(one->isNeighbourOf(three));
+
+    // directed: arcs into removed vertices go away too
+    Graph directed(true);
+    build(directed, 3, {{0, 1}, {1, 2}, {2, 0}});
+    directed.removeVerticesIf([](const Vertex* v) { return v->getVertexId() == 2; });
+    ASSERT_EQ(1u, directed.getVertexById(0)->degree());
+    ASSERT_EQ(0u, directed.getVertexById(1)->degree());
+}
+
+TEST_F(ConnectedComponentsTest, MatchesTraversalTest)
+{
+    Graph g;
+    GraphReader<Graph, Vertex> reader;
+    reader.read(g, "TestTrees/ER_1000.txt");
+
+    ConnectedComponents<Graph, Vertex> components(g);
+    set<unsigned int> traversed;
+    unsigned int total = 0;
+    for (unsigned int size : components.componentSizes())
+        total += size;
+    ASSERT_EQ(g.verticesCount(), total);
+
+    auto it = g.verticesIterator();
+    while (!it.end())
+    {
+        const unsigned int label = components.component(*it);
+        if (traversed.insert(label).second)
+        {
+            ASSERT_EQ(components.componentSizes()[label], bfsSize(*it));
+        }
+        auto neighbors = (*it)->neighborsIterator();
+        while (!neighbors.end())
+        {
+            ASSERT_EQ(label, components.component(*neighbors));
+            ++neighbors;
+        }
+        ++it;
+    }
+}
+
+}
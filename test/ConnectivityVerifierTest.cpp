@@ -4,6 +4,7 @@
 //
 #include <gtest/gtest.h>
 #include "ConnectivityVerifier.h"
+#include "typedefs.h"
 
 
 namespace connectivityVerifierTest
@@ -57,5 +58,24 @@ namespace connectivityVerifierTest
         ASSERT_EQ(1, connectivityVerifier.vertexesInComponent.size());
         ASSERT_EQ(3, connectivityVerifier.vertexesLeft.size());
     }
+
+    TEST_F(ConnectivityVerifierTestFixture, BiggestComponentTest){
+        // a triangle 0-1-2, an edge 3-4 and an isolated 5
+        Graph g;
+        for (unsigned int i = 0; i < 6; ++i)
+            g.addVertex(new Vertex(i));
+        g.addEdge(g.getVertexById(3), g.getVertexById(4));
+        g.addEdge(g.getVertexById(0), g.getVertexById(1));
+        g.addEdge(g.getVertexById(1), g.getVertexById(2));
+        g.addEdge(g.getVertexById(2), g.getVertexById(0));
+
+        connectivityVerifier.getBiggestComponent(&g);
+
+        ASSERT_EQ(3, g.verticesCount());
+        ASSERT_TRUE(g.getVertexById(3) == nullptr);
+        ASSERT_EQ(2, g.getVertexById(0)->degree());
+        ASSERT_EQ(list<unsigned int>({0, 1, 2}), connectivityVerifier.vertexesInComponent);
+        ASSERT_EQ(0, connectivityVerifier.vertexesLeft.size());
+    }
 }
 
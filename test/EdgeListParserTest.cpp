@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "EdgeListParser.h"
+#include "GraphReader.h"
+#include "WeightedGraphReader.h"
+#include "TestUtils.h"
+#include "typedefs.h"
+
+namespace edgeListParserTest
+{
+
+using namespace graphpp;
+using namespace std;
+using namespace testUtils;
+using ::testing::Test;
+
+class EdgeListParserTest : public Test
+{
+protected:
+
+    EdgeListParserTest() { }
+
+    virtual ~EdgeListParserTest() { }
+
+    virtual void SetUp()
+    {
+
+    }
+
+    virtual void TearDown()
+    {
+        remove(FileName);
+    }
+
+    static vector<EdgeListParser::Line> parse(const string& text, bool weighted)
+    {
+        EdgeListParser parser(text.data(), text.data() + text.size(), weighted);
+        vector<EdgeListParser::Line> ret;
+        EdgeListParser::Line line;
+        while (parser.next(line))
+            ret.push_back(line);
+        return ret;
+    }
+
+    static const char* const FileName;
+};
+
+const char* const EdgeListParserTest::FileName = "edgeListParserTest.tmp";
+
+TEST_F(EdgeListParserTest, ParsesEdgesAndIsolatedVerticesTest)
+{
+    const auto lines = parse("1 2\n\n  3\t4  \r\n5\r\n\t\n6 7", false);
+    ASSERT_EQ(4u, lines.size());
+
+    ASSERT_TRUE(lines[0].isEdge);
+    ASSERT_EQ(1u, lines[0].source);
+    ASSERT_EQ(2u, lines[0].destination);
+    ASSERT_EQ(1u, lines[0].number);
+
+    ASSERT_TRUE(lines[1].isEdge);
+    ASSERT_EQ(3u, lines[1].source);
+    ASSERT_EQ(4u, lines[1].destination);
+    ASSERT_EQ(3u, lines[1].number);
+
+    ASSERT_FALSE(lines[2].isEdge);
+    ASSERT_EQ(5u, lines[2].source);
+    ASSERT_EQ(4u, lines[2].number);
+
+    ASSERT_TRUE(lines[3].isEdge);
+    ASSERT_EQ(6u, lines[3].source);
+    ASSERT_EQ(7u, lines[3].destination);
+    ASSERT_EQ(6u, lines[3].number);
+}
+
+TEST_F(EdgeListParserTest, ParsesWeightsTest)
+{
+    const auto lines = parse("1 2 0.5\n2 3 25e-1\n3 4 1.5E+2\n4 5\n", true);
+    ASSERT_EQ(4u, lines.size());
+    ASSERT_DOUBLE_EQ(0.5, lines[0].weight);
+    ASSERT_DOUBLE_EQ(2.5, lines[1].weight);
+    ASSERT_DOUBLE_EQ(150.0, lines[2].weight);
+    ASSERT_DOUBLE_EQ(0.0, lines[3].weight);
+}
+
+TEST_F(EdgeListParserTest, ReportsLineOfMalformedInputTest)
+{
+    try
+    {
+        parse("1 2\n2 3 4\n", false);
+        FAIL();
+    }
+    catch (const MalformedLineException& ex)
+    {
+        ASSERT_NE(string::npos, string(ex.what()).find("Line: 2"));
+    }
+
+    ASSERT_THROW(parse("1 2\n\n2 x\n", false), UnsignedIntegerMalformedException);
+    ASSERT_THROW(parse("4294967296 1\n", false), UnsignedIntegerMalformedException);
+    ASSERT_THROW(parse("1 2 3ex\n", true), MalformedDoubleException);
+}
+
+TEST_F(EdgeListParserTest, GraphReaderLoadsFileTest)
+{
+    writeFile(FileName, "1 2\r\n2 3\r\n3 1\r\n1 2\r\n4\r\n");
+
+    Graph g;
+    GraphReader<Graph, Vertex> reader;
+    reader.read(g, FileName);
+
+    ASSERT_EQ(4u, g.verticesCount());
+    ASSERT_EQ(2u, g.getVertexById(1)->degree());
+    ASSERT_EQ(0u, g.getVertexById(4)->degree());
+    ASSERT_EQ(6u, reader.getLineNumber());
+}
+
+TEST_F(EdgeListParserTest, GraphReaderRepeatedEdgesTest)
+{
+    writeFile(FileName, "1 2\n2 1\n2 3\n1 2\n3 3\n3 3\n");
+
+    Graph simple;
+    GraphReader<Graph, Vertex> reader;
+    reader.read(simple, FileName);
+    ASSERT_EQ(1u, simple.getVertexById(1)->degree());
+    ASSERT_EQ(2u, simple.getVertexById(2)->degree());
+
+    Graph multigraph(false, true);
+    reader.read(multigraph, FileName);
+    ASSERT_EQ(3u, multigraph.getVertexById(1)->degree());
+
+    DirectedGraph directed;
+    GraphReader<DirectedGraph, DirectedVertex> directedReader;
+    directedReader.read(directed, FileName);
+    ASSERT_EQ(1u, directed.getVertexById(1)->outDegree());
+    ASSERT_EQ(1u, directed.getVertexById(1)->inDegree());
+
+    // a graph with edges already: the ones read are checked against them
+    writeFile(FileName, "2 3\n3 4\n");
+    reader.read(simple, FileName);
+    ASSERT_EQ(2u, simple.getVertexById(2)->degree());
+    ASSERT_EQ(1u, simple.getVertexById(4)->degree());
+}
+
+TEST_F(EdgeListParserTest, WeightedGraphReaderLoadsFileTest)
+{
+    writeFile(FileName, "1 2 0.5\n2 3 1.5\n");
+
+    WeightedGraph g;
+    WeightedGraphReader<WeightedGraph, WeightedVertex> reader;
+    reader.read(g, FileName);
+
+    ASSERT_EQ(3u, g.verticesCount());
+    ASSERT_DOUBLE_EQ(2.0, g.getVertexById(2)->strength());
+
+    writeFile(FileName, "1 2 0.5\n2 3 1.5\n2 1 1\n");
+    WeightedGraph h;
+    try
+    {
+        reader.read(h, FileName);
+        FAIL();
+    }
+    catch (const DuplicatedEdgeLoading& ex)
+    {
+        ASSERT_NE(string::npos, string(ex.what()).find("Line: 3"));
+    }
+}
+
+TEST_F(EdgeListParserTest, MissingFileTest)
+{
+    Graph g;
+    GraphReader<Graph, Vertex> reader;
+    ASSERT_THROW(reader.read(g, "doesNotExist.txt"), FileNotFoundException);
+}
+
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "ClusteringCoefficient.h"
+#include "Ensemble.h"
+#include "GraphGenerator.h"
+#include "NearestNeighborsDegree.h"
+#include "Random.h"
+#include "typedefs.h"
+
+namespace ensembleTest
+{
+
+using namespace graphpp;
+using namespace std;
+using ::testing::Test;
+
+class EnsembleTest : public Test
+{
+protected:
+
+    typedef Ensemble<Graph, Vertex> GraphEnsemble;
+
+    EnsembleTest() { }
+
+    virtual ~EnsembleTest() { }
+
+    virtual void SetUp()
+    {
+
+    }
+
+    virtual void TearDown()
+    {
+
+    }
+
+    static Graph* barabasi(uint64_t seed)
+    {
+        return GraphGenerator::getInstance()->generateBarabasiAlbertGraph(3, 2, 300, seed);
+    }
+};
+
+TEST_F(EnsembleTest, RunningStatisticsTest)
+{
+    const vector<double> values = {4.0, 7.0, 13.0, 16.0, 1e9 + 4.0, 1e9 + 7.0};
+
+    RunningStatistics all;
+    RunningStatistics first;
+    RunningStatistics second;
+    for (unsigned int i = 0; i < values.size(); i++)
+    {
+        all.add(values[i]);
+        (i < 2 ? first : second).add(values[i]);
+    }
+
+    double mean = 0;
+    for (double value : values)
+        mean += value;
+    mean /= values.size();
+    double variance = 0;
+    for (double value : values)
+        variance += (value - mean) * (value - mean);
+    variance /= values.size() - 1;
+
+    ASSERT_EQ(6u, all.count());
+    ASSERT_NEAR(mean, all.mean(), mean * 1e-12);
+    ASSERT_NEAR(variance, all.variance(), variance * 1e-12);
+
+    first.merge(second);
+    ASSERT_EQ(6u, first.count());
+    ASSERT_NEAR(mean, first.mean(), mean * 1e-12);
+    ASSERT_NEAR(variance, first.variance(), variance * 1e-12);
+
+    // padding with zeros is the same as adding them
+    RunningStatistics padded;
+    RunningStatistics added;
+    padded.add(3.0);
+    added.add(3.0);
+    padded.padWithZeros(4);
+    for (unsigned int i = 0; i < 3; i++)
+        added.add(0.0);
+    ASSERT_EQ(4u, padded.count());
+    ASSERT_DOUBLE_EQ(added.mean(), padded.mean());
+    ASSERT_DOUBLE_EQ(added.variance(), padded.variance());
+
+    RunningStatistics single;
+    single.add(5.0);
+    ASSERT_EQ(0.0, single.variance());
+}
+
+TEST_F(EnsembleTest, SingleRealizationTest)
+{
+    // one realization gives the metrics of that graph, with the seed drawn from Random(seed)
+    const uint64_t seed = 5;
+    GraphEnsemble ensemble(barabasi);
+    ensemble.run(1, seed, 1);
+
+    Graph* g = barabasi(Random(seed)());
+    map<unsigned int, unsigned int> degrees;
+    auto it = g->verticesIterator();
+    while (!it.end())
+    {
+        degrees[(*it)->degree()]++;
+        ++it;
+    }
+
+    ClusteringCoefficient<Graph, Vertex> clustering;
+    NearestNeighborsDegree<Graph, Vertex> knn;
+    ASSERT_EQ(degrees.size(), ensemble.degreeDistribution().size());
+    ASSERT_EQ(degrees.size(), ensemble.clusteringVsDegree().size());
+    ASSERT_EQ(degrees.size(), ensemble.nearestNeighborsDegreeVsDegree().size());
+    for (const auto& entry : degrees)
+    {
+        const RunningStatistics& probability = ensemble.degreeDistribution().at(entry.first);
+        ASSERT_EQ(1u, probability.count());
+        ASSERT_DOUBLE_EQ(entry.second / double(g->verticesCount()), probability.mean());
+        ASSERT_NEAR(
+            clustering.clusteringCoefficient(*g, entry.first),
+            ensemble.clusteringVsDegree().at(entry.first).mean(), 1e-12);
+        ASSERT_NEAR(
+            knn.meanDegree(*g, entry.first),
+            ensemble.nearestNeighborsDegreeVsDegree().at(entry.first).mean(), 1e-9);
+    }
+    delete g;
+}
+
+TEST_F(EnsembleTest, ThreadsTest)
+{
+    const unsigned int realizations = 12;
+    GraphEnsemble sequential(barabasi);
+    GraphEnsemble parallel(barabasi, GraphEnsemble::DegreeDistribution);
+    sequential.run(realizations, 9, 1);
+    parallel.run(realizations, 9, 4);
+
+    ASSERT_EQ(realizations, parallel.realizationsCount());
+    ASSERT_TRUE(parallel.clusteringVsDegree().empty());
+    ASSERT_TRUE(parallel.nearestNeighborsDegreeVsDegree().empty());
+    ASSERT_EQ(sequential.degreeDistribution().size(), parallel.degreeDistribution().size());
+
+    double total = 0;
+    for (const auto& entry : parallel.degreeDistribution())
+    {
+        const RunningStatistics& expected = sequential.degreeDistribution().at(entry.first);
+        ASSERT_EQ(realizations, entry.second.count());
+        ASSERT_NEAR(expected.mean(), entry.second.mean(), 1e-12);
+        ASSERT_NEAR(expected.variance(), entry.second.variance(), 1e-12);
+        total += entry.second.mean();
+    }
+    // every realization is a distribution, and so is their mean
+    ASSERT_NEAR(1.0, total, 1e-12);
+
+    // the summed vertices of each degree agree with the mean distribution
+    uint64_t vertices = 0;
+    for (const auto& entry : parallel.degreeCounts())
+    {
+        ASSERT_NEAR(
+            parallel.degreeDistribution().at(entry.first).mean() * realizations * 300,
+            entry.second, 1e-6);
+        vertices += entry.second;
+    }
+    ASSERT_EQ(parallel.degreeDistribution().size(), parallel.degreeCounts().size());
+    ASSERT_EQ(realizations * 300u, vertices);
+
+    // only the realizations with a degree count for its clustering
+    for (const auto& entry : sequential.clusteringVsDegree())
+        ASSERT_LE(entry.second.count(), realizations);
+    ASSERT_EQ(realizations, sequential.clusteringVsDegree().at(2).count());
+}
+
+}
@@ -0,0 +1,501 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "GraphGenerator.h"
+#include "MolloyReedGraphReader.h"
+#include "Random.h"
+#include "TestUtils.h"
+#include "typedefs.h"
+
+namespace graphGeneratorTest
+{
+
+using namespace graphpp;
+using namespace std;
+using namespace testUtils;
+using ::testing::Test;
+
+class GraphGeneratorTest : public Test
+{
+protected:
+
+    GraphGeneratorTest() { }
+
+    virtual ~GraphGeneratorTest() { }
+
+    virtual void SetUp()
+    {
+
+    }
+
+    virtual void TearDown()
+    {
+        remove(DegreesFileName);
+    }
+
+    /*
+     * The hyperbolic model as the original quadratic scan: every new point against every
+     * previous one, drawing the same random values as GraphGenerator
+     */
+    static vector<vector<unsigned int>> hyperbolicReference(
+        unsigned int n, float a, float c, uint64_t seed)
+    {
+        Random rng(seed);
+        const double pi = atan(1) * 4;
+        vector<double> radius(n + 1);
+        vector<double> angle(n + 1);
+        vector<vector<unsigned int>> neighbors(n + 1);
+        for (unsigned int i = 1; i <= n; i++)
+        {
+            const double maxr = log((double)i / c) / a;
+            vector<unsigned int> found;
+            do
+            {
+                angle[i] = rng.uniform() * 2 * pi;
+                const double u = rng.uniform();
+                radius[i] = acosh(u * (cosh(maxr * a) - 1) + 1) / a;
+                found.clear();
+                for (unsigned int j = 1; j < i; j++)
+                {
+                    const double delta = pi - fabs(pi - fabs(angle[i] - angle[j]));
+                    const double distance = acosh(
+                        cosh(radius[i]) * cosh(radius[j]) -
+                        sinh(radius[i]) * sinh(radius[j]) * cos(delta));
+                    if (distance < maxr)
+                        found.push_back(j);
+                }
+            } while (found.empty() && i != 1);
+            for (unsigned int j : found)
+            {
+                neighbors[i].push_back(j);
+                neighbors[j].push_back(i);
+            }
+        }
+
+        vector<vector<unsigned int>> ret;
+        for (unsigned int i = 1; i <= n; i++)
+        {
+            ret.push_back(vector<unsigned int>(1, i));
+            ret.back().insert(ret.back().end(), neighbors[i].begin(), neighbors[i].end());
+        }
+        return ret;
+    }
+
+    /*
+     * The HOT Extended model by brute force: the hops and the BFS tree are recomputed for
+     * every extra edge, which is the pair with the lowest w among all the pairs, drawing the
+     * same random values as GraphGenerator
+     */
+    static vector<vector<unsigned int>> hotReference(
+        unsigned int m, unsigned int n, float xi, unsigned int q, float r, unsigned int t,
+        uint64_t seed)
+    {
+        Random rng(seed);
+        vector<float> x(n + 1);
+        vector<float> y(n + 1);
+        vector<vector<unsigned int>> neighbors(n + 1);
+        vector<unsigned int> joined;
+        unsigned int root = 1;
+        auto distance = [&](unsigned int j, unsigned int k) -> float {
+            return sqrt(pow(x[j] - x[k], 2) + pow(y[j] - y[k], 2));
+        };
+        auto join = [&](unsigned int j, unsigned int k) {
+            neighbors[j].push_back(k);
+            neighbors[k].push_back(j);
+            joined.push_back(j);
+            joined.push_back(k);
+        };
+        // hops to the root, and the reached vertices in BFS order
+        auto bfs = [&](vector<unsigned int>& order) {
+            vector<unsigned int> hops(n + 1, UINT_MAX);
+            hops[root] = 0;
+            order.assign(1, root);
+            for (size_t next = 0; next < order.size(); next++)
+                for (unsigned int w : neighbors[order[next]])
+                    if (hops[w] == UINT_MAX)
+                    {
+                        hops[w] = hops[order[next]] + 1;
+                        order.push_back(w);
+                    }
+            return hops;
+        };
+
+        for (unsigned int i = 1; i <= n; i++)
+        {
+            x[i] = (float)rng.uniform();
+            y[i] = (float)rng.uniform();
+            if (i == 1)
+                continue;
+
+            vector<unsigned int> order;
+            vector<unsigned int> hops = bfs(order);
+            vector<pair<double, unsigned int>> candidates;
+            for (unsigned int j = 1; j < i; j++)
+                candidates.push_back(make_pair(distance(j, i) + (double)xi * hops[j], j));
+            sort(candidates.begin(), candidates.end());
+            for (unsigned int e = 0; e < m && e < candidates.size(); e++)
+                join(candidates[e].second, i);
+
+            const double weight = (double)r / i;
+            for (unsigned int e = 0; e < q; e++)
+            {
+                hops = bfs(order);
+                // the parent of v is its first neighbour one hop closer to the root
+                vector<unsigned long long> below(n + 1, 1);
+                for (auto v = order.rbegin(); v != order.rend(); ++v)
+                    for (unsigned int w : neighbors[*v])
+                        if (hops[*v] > 0 && hops[w] + 1 == hops[*v])
+                        {
+                            below[w] += below[*v];
+                            break;
+                        }
+
+                double best = numeric_limits<double>::infinity();
+                unsigned int bestJ = 0;
+                unsigned int bestK = 0;
+                for (unsigned int j = 1; j <= i; j++)
+                    for (unsigned int k = j + 1; k <= i; k++)
+                    {
+                        if (find(neighbors[j].begin(), neighbors[j].end(), k) !=
+                            neighbors[j].end())
+                            continue;
+                        unsigned long long saved = 0;
+                        if (hops[j] != UINT_MAX && hops[k] != UINT_MAX)
+                        {
+                            const unsigned int gap = max(hops[j], hops[k]) - min(hops[j], hops[k]);
+                            if (gap > 1)
+                                saved = (gap - 1) * below[hops[j] < hops[k] ? k : j];
+                        }
+                        const double w = distance(j, k) - weight * saved;
+                        if (w < best)
+                        {
+                            best = w;
+                            bestJ = j;
+                            bestK = k;
+                        }
+                    }
+                if (bestJ != 0)
+                    join(bestJ, bestK);
+            }
+
+            if (t > 0 && (i - 1) % t == 0 && !joined.empty())
+                root = joined[rng.below(joined.size())];
+        }
+
+        vector<vector<unsigned int>> ret;
+        for (unsigned int i = 1; i <= n; i++)
+        {
+            ret.push_back(vector<unsigned int>(1, i));
+            ret.back().insert(ret.back().end(), neighbors[i].begin(), neighbors[i].end());
+        }
+        return ret;
+    }
+
+    static unsigned int edgesCount(Graph& g)
+    {
+        unsigned int degrees = 0;
+        auto it = g.verticesIterator();
+        while (!it.end())
+        {
+            degrees += (*it)->degree();
+            ++it;
+        }
+        return degrees / 2;
+    }
+
+    static const char* const DegreesFileName;
+};
+
+const char* const GraphGeneratorTest::DegreesFileName = "graphGeneratorTest.degrees";
+
+TEST_F(GraphGeneratorTest, ErdosRenyiEdgesTest)
+{
+    const unsigned int n = 2000;
+    const float p = 0.01;
+    srand(1);
+    Graph* g = GraphGenerator::getInstance()->generateErdosRenyiGraph(n, p, false);
+    ASSERT_EQ(n, g->verticesCount());
+
+    // within 5 standard deviations of n (n - 1) / 2 * p
+    const double pairs = n * (n - 1) / 2.0;
+    const double expected = pairs * p;
+    ASSERT_LT(fabs(edgesCount(*g) - expected), 5 * sqrt(expected * (1 - p)));
+
+    // neither loops nor repeated edges: the neighbours are increasing
+    for (const auto& row : adjacency(*g))
+    {
+        for (size_t i = 2; i < row.size(); ++i)
+            ASSERT_LT(row[i - 1], row[i]);
+        for (size_t i = 1; i < row.size(); ++i)
+            ASSERT_NE(row[0], row[i]);
+    }
+    delete g;
+}
+
+TEST_F(GraphGeneratorTest, ErdosRenyiThreadsTest)
+{
+    srand(7);
+    Graph* sequential = GraphGenerator::getInstance()->generateErdosRenyiGraph(500, 0.05, false, 1);
+    srand(7);
+    Graph* parallel = GraphGenerator::getInstance()->generateErdosRenyiGraph(500, 0.05, false, 4);
+    ASSERT_EQ(adjacency(*sequential), adjacency(*parallel));
+
+    srand(8);
+    Graph* other = GraphGenerator::getInstance()->generateErdosRenyiGraph(500, 0.05, false, 4);
+    ASSERT_NE(adjacency(*sequential), adjacency(*other));
+    delete sequential;
+    delete parallel;
+    delete other;
+}
+
+TEST_F(GraphGeneratorTest, SeedTest)
+{
+    // an explicit seed reproduces every model, whatever rand() is doing
+    GraphGenerator* generator = GraphGenerator::getInstance();
+    const uint64_t seed = 0x123456789abcdefull;
+    Graph* graphs[2][4];
+    for (unsigned int run = 0; run < 2; run++)
+    {
+        srand(run);
+        graphs[run][0] = generator->generateErdosRenyiGraph(300, 0.02, false, run + 1, seed);
+        graphs[run][1] = generator->generateHiperbolicGraph(300, 0.75, 0.05, run + 1, seed);
+        graphs[run][2] = generator->generateHotExtendedGraph(1, 100, 2, 1, 1, 10, seed);
+        graphs[run][3] = generator->generateBarabasiAlbertGraph(3, 2, 300, seed);
+    }
+    for (unsigned int model = 0; model < 4; model++)
+    {
+        ASSERT_EQ(adjacency(*graphs[0][model]), adjacency(*graphs[1][model]));
+        delete graphs[0][model];
+        delete graphs[1][model];
+    }
+
+    Graph* g = generator->generateErdosRenyiGraph(300, 0.02, false, 1, seed);
+    Graph* other = generator->generateErdosRenyiGraph(300, 0.02, false, 1, seed + 1);
+    ASSERT_NE(adjacency(*g), adjacency(*other));
+    delete g;
+    delete other;
+}
+
+TEST_F(GraphGeneratorTest, ErdosRenyiLimitsTest)
+{
+    Graph* empty = GraphGenerator::getInstance()->generateErdosRenyiGraph(100, 0, false);
+    ASSERT_EQ(100u, empty->verticesCount());
+    ASSERT_EQ(0u, edgesCount(*empty));
+    delete empty;
+
+    Graph* complete = GraphGenerator::getInstance()->generateErdosRenyiGraph(60, 1, false);
+    ASSERT_EQ(60u * 59 / 2, edgesCount(*complete));
+    delete complete;
+
+    Graph* none = GraphGenerator::getInstance()->generateErdosRenyiGraph(0, 0.5, false);
+    ASSERT_EQ(0u, none->verticesCount());
+    delete none;
+}
+
+TEST_F(GraphGeneratorTest, ErdosRenyiBiggestComponentTest)
+{
+    // well above the 1 / n threshold the giant component holds most of the vertices
+    srand(3);
+    Graph* g = GraphGenerator::getInstance()->generateErdosRenyiGraph(400, 0.01);
+    ASSERT_GE(g->verticesCount(), 200u);
+    ASSERT_LT(g->verticesCount(), 400u);
+    delete g;
+}
+
+TEST_F(GraphGeneratorTest, BarabasiAlbertEdgesTest)
+{
+    const unsigned int m_0 = 5;
+    const unsigned int m = 3;
+    const unsigned int n = 3000;
+    Graph* g = GraphGenerator::getInstance()->generateBarabasiAlbertGraph(m_0, m, n, 42);
+    ASSERT_EQ(n, g->verticesCount());
+    ASSERT_EQ(m_0 * (m_0 - 1) / 2 + m * (n - m_0), edgesCount(*g));
+
+    unsigned int maxDegree = 0;
+    for (const auto& row : adjacency(*g))
+    {
+        ASSERT_GE(row.size() - 1, row[0] <= m_0 ? m_0 - 1 : m);
+        maxDegree = max(maxDegree, (unsigned int)row.size() - 1);
+
+        vector<unsigned int> neighbors(row.begin() + 1, row.end());
+        sort(neighbors.begin(), neighbors.end());
+        ASSERT_TRUE(adjacent_find(neighbors.begin(), neighbors.end()) == neighbors.end());
+        ASSERT_TRUE(find(neighbors.begin(), neighbors.end(), row[0]) == neighbors.end());
+    }
+    // preferential attachment grows hubs far above the mean degree
+    ASSERT_GT(maxDegree, 10 * m);
+    delete g;
+}
+
+TEST_F(GraphGeneratorTest, BarabasiAlbertSeedTest)
+{
+    GraphGenerator* generator = GraphGenerator::getInstance();
+    Graph* g = generator->generateBarabasiAlbertGraph(4, 2, 500, 1ull << 40);
+    Graph* same = generator->generateBarabasiAlbertGraph(4, 2, 500, 1ull << 40);
+    Graph* other = generator->generateBarabasiAlbertGraph(4, 2, 500, 1);
+    ASSERT_EQ(adjacency(*g), adjacency(*same));
+    ASSERT_NE(adjacency(*g), adjacency(*other));
+    delete g;
+    delete same;
+    delete other;
+}
+
+TEST_F(GraphGeneratorTest, BarabasiAlbertFewVerticesTest)
+{
+    // the first vertices cannot find m distinct targets and take all there are
+    Graph* g = GraphGenerator::getInstance()->generateBarabasiAlbertGraph(2, 5, 20, 3);
+    ASSERT_EQ(20u, g->verticesCount());
+    ASSERT_EQ(1u + 2 + 3 + 4 + 5 + 5 * 14, edgesCount(*g));
+    delete g;
+}
+
+
+TEST_F(GraphGeneratorTest, HyperbolicReferenceTest)
+{
+    const float parameters[][2] = {{0.75, 0.0014}, {1, 0.5}, {0.6, 0.05}};
+    for (const auto& parameter : parameters)
+    {
+        const auto expected = hyperbolicReference(1500, parameter[0], parameter[1], 11);
+        Graph* g = GraphGenerator::getInstance()->generateHiperbolicGraph(
+            1500, parameter[0], parameter[1], 0, 11);
+        ASSERT_EQ(expected, adjacency(*g));
+        delete g;
+    }
+}
+
+TEST_F(GraphGeneratorTest, HyperbolicThreadsTest)
+{
+    GraphGenerator* generator = GraphGenerator::getInstance();
+    srand(5);
+    Graph* sequential = generator->generateHiperbolicGraph(3000, 0.75, 0.0014, 1);
+    srand(5);
+    Graph* parallel = generator->generateHiperbolicGraph(3000, 0.75, 0.0014, 4);
+    ASSERT_EQ(adjacency(*sequential), adjacency(*parallel));
+
+    // every vertex but the first has a neighbour
+    auto it = sequential->verticesIterator();
+    while (!it.end())
+    {
+        ASSERT_TRUE((*it)->getVertexId() == 1 || (*it)->degree() > 0);
+        ++it;
+    }
+    delete sequential;
+    delete parallel;
+}
+
+
+TEST_F(GraphGeneratorTest, HotExtendedTest)
+{
+    const unsigned int m = 2;
+    const unsigned int n = 400;
+    const unsigned int q = 1;
+    GraphGenerator* generator = GraphGenerator::getInstance();
+    srand(9);
+    Graph* g = generator->generateHotExtendedGraph(m, n, 2, q, 1, 20);
+    srand(9);
+    Graph* same = generator->generateHotExtendedGraph(m, n, 2, q, 1, 20);
+    ASSERT_EQ(n, g->verticesCount());
+    ASSERT_EQ(adjacency(*g), adjacency(*same));
+
+    // vertex 2 takes one edge and no extra one, vertex 3 closes a triangle, later vertices
+    // always find a pair of vertices that are not neighbours
+    ASSERT_EQ(1 + 2 + (m + q) * (n - 3), edgesCount(*g));
+
+    // connected, without loops nor repeated edges
+    for (const auto& row : adjacency(*g))
+    {
+        ASSERT_GT(row.size(), 1u);
+        vector<unsigned int> neighbors(row.begin() + 1, row.end());
+        sort(neighbors.begin(), neighbors.end());
+        ASSERT_TRUE(adjacent_find(neighbors.begin(), neighbors.end()) == neighbors.end());
+        ASSERT_TRUE(find(neighbors.begin(), neighbors.end(), row[0]) == neighbors.end());
+    }
+    vector<bool> reached(n + 1, false);
+    vector<unsigned int> pending(1, 1);
+    reached[1] = true;
+    unsigned int count = 1;
+    while (!pending.empty())
+    {
+        Vertex* v = g->getVertexById(pending.back());
+        pending.pop_back();
+        auto it = v->neighborsIterator();
+        while (!it.end())
+        {
+            const unsigned int id = (*it)->getVertexId();
+            if (!reached[id])
+            {
+                reached[id] = true;
+                pending.push_back(id);
+                count++;
+            }
+            ++it;
+        }
+    }
+    ASSERT_EQ(n, count);
+    delete g;
+    delete same;
+}
+
+TEST_F(GraphGeneratorTest, HotExtendedReferenceTest)
+{
+    // the hop term from negligible to dominant, with one or two extra edges and root changes
+    GraphGenerator* generator = GraphGenerator::getInstance();
+    const float rs[] = {0.03f, 1, 30};
+    for (float r : rs)
+        for (unsigned int q = 1; q <= 2; q++)
+        {
+            Graph* g = generator->generateHotExtendedGraph(1, 150, 0.5f, q, r, 3, 17);
+            ASSERT_EQ(hotReference(1, 150, 0.5f, q, r, 3, 17), adjacency(*g));
+            delete g;
+        }
+}
+
+TEST_F(GraphGeneratorTest, MolloyReedDegreesTest)
+{
+    // 2000 vertices of degree 1, 1000 of degree 2, 500 of degree 4 and 10 of degree 50
+    {
+        ofstream file(DegreesFileName);
+        file << "1 2000\n2 1000\n\n4 500\n50 10\n";
+    }
+
+    MolloyReedGraphReader<Graph, Vertex> reader(17);
+    Graph g(false, false);
+    reader.read(g, DegreesFileName);
+    ASSERT_EQ(3510u, g.verticesCount());
+    ASSERT_EQ(0u, reader.getUnpairedStubs());
+
+    // degrees are kept, and there are neither loops nor repeated edges
+    for (const auto& row : adjacency(g))
+    {
+        const unsigned int id = row[0];
+        const unsigned int expected = id < 2000 ? 1 : id < 3000 ? 2 : id < 3500 ? 4 : 50;
+        ASSERT_EQ(expected, row.size() - 1);
+
+        vector<unsigned int> neighbors(row.begin() + 1, row.end());
+        sort(neighbors.begin(), neighbors.end());
+        ASSERT_TRUE(adjacent_find(neighbors.begin(), neighbors.end()) == neighbors.end());
+        ASSERT_TRUE(find(neighbors.begin(), neighbors.end(), id) == neighbors.end());
+    }
+
+    GraphGenerator* generator = GraphGenerator::getInstance();
+    Graph* same = generator->generateMolloyReedGraph(DegreesFileName, false, 17);
+    ASSERT_EQ(adjacency(g), adjacency(*same));
+    delete same;
+
+    // the degree 1 vertices paired together are left out of the giant component
+    Graph* giant = generator->generateMolloyReedGraph(DegreesFileName, true, 17);
+    ASSERT_LT(giant->verticesCount(), 3510u);
+    ASSERT_GT(giant->verticesCount(), 1755u);
+    delete giant;
+}
+
+}
@@ -0,0 +1,260 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "GraphGenerator.h"
+#include "GraphReader.h"
+#include "GraphSnapshot.h"
+#include "GraphWriter.h"
+#include "SnapshotGraphReader.h"
+#include "SnapshotWeightedGraphReader.h"
+#include "TestUtils.h"
+#include "typedefs.h"
+
+namespace graphSnapshotTest
+{
+
+using namespace graphpp;
+using namespace std;
+using namespace testUtils;
+using ::testing::Test;
+
+class GraphSnapshotTest : public Test
+{
+protected:
+
+    GraphSnapshotTest() { }
+
+    virtual ~GraphSnapshotTest() { }
+
+    virtual void SetUp()
+    {
+
+    }
+
+    virtual void TearDown()
+    {
+        remove(FileName);
+    }
+
+    static const char* const FileName;
+};
+
+const char* const GraphSnapshotTest::FileName = "graphSnapshotTest.cngraph";
+
+TEST_F(GraphSnapshotTest, RoundTripTest)
+{
+    Graph expected;
+    GraphReader<Graph, Vertex> textReader;
+    textReader.read(expected, "TestTrees/AS_CAIDA_2008.txt");
+
+    GraphWriter writer;
+    writer.writeGraphSnapshot(&expected, FileName);
+    ASSERT_TRUE(GraphSnapshot::isSnapshot(FileName));
+    ASSERT_FALSE(GraphSnapshot::isSnapshot("TestTrees/AS_CAIDA_2008.txt"));
+
+    Graph g;
+    SnapshotGraphReader<Graph, Vertex> reader;
+    reader.read(g, FileName);
+    ASSERT_EQ(adjacency(expected), adjacency(g));
+
+    // the generator picks the snapshot reader by itself
+    Graph* generated =
+        GraphGenerator::getInstance()->generateGraphFromFile(FileName, false, false);
+    ASSERT_EQ(adjacency(expected), adjacency(*generated));
+    delete generated;
+}
+
+TEST_F(GraphSnapshotTest, LayoutTest)
+{
+    // a triangle and an isolated vertex: 4 vertices, 6 entries
+    Graph g;
+    Vertex* vertices[4];
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        vertices[i] = new Vertex(10 + i);
+        g.addVertex(vertices[i]);
+    }
+    g.addEdge(vertices[0], vertices[1]);
+    g.addEdge(vertices[1], vertices[2]);
+    g.addEdge(vertices[2], vertices[0]);
+
+    GraphWriter writer;
+    writer.writeGraphSnapshot(&g, FileName);
+
+    const string bytes = fileContents(FileName);
+    ASSERT_EQ(32u + 5 * 8 + (4 + 6) * 4, bytes.size());
+    ASSERT_EQ(string("CNGRAPH\0", 8), bytes.substr(0, 8));
+
+    GraphSnapshot snapshot(FileName);
+    ASSERT_EQ(4u, snapshot.verticesCount());
+    ASSERT_EQ(6u, snapshot.entriesCount());
+    ASSERT_FALSE(snapshot.isDirected());
+    ASSERT_FALSE(snapshot.isWeighted());
+    ASSERT_EQ(13u, snapshot.id(3));
+    ASSERT_EQ(6u, snapshot.offset(3));
+    ASSERT_EQ(6u, snapshot.offset(4));
+    ASSERT_EQ(1u, snapshot.neighbor(0));
+    ASSERT_EQ(2u, snapshot.neighbor(1));
+}
+
+TEST_F(GraphSnapshotTest, WeightedRoundTripTest)
+{
+    WeightedGraph expected;
+    WeightedVertex* vertices[5];
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+        vertices[i] = new WeightedVertex(i + 1);
+        expected.addVertex(vertices[i]);
+    }
+    expected.addEdge(vertices[0], vertices[1], 0.5);
+    expected.addEdge(vertices[0], vertices[2], 1.25);
+    expected.addEdge(vertices[3], vertices[1], 3e10);
+
+    GraphWriter writer;
+    writer.writeWeightedGraphSnapshot(&expected, FileName);
+
+    WeightedGraph g;
+    SnapshotWeightedGraphReader<WeightedGraph, WeightedVertex> reader;
+    reader.read(g, FileName);
+    ASSERT_EQ(adjacency(expected), adjacency(g));
+    ASSERT_DOUBLE_EQ(1.75, g.getVertexById(1)->strength());
+    ASSERT_DOUBLE_EQ(3e10 + 0.5, g.getVertexById(2)->strength());
+    ASSERT_DOUBLE_EQ(1.25, g.getVertexById(3)->edgeWeightByNeighbour(1));
+
+    // weights are ignored by the unweighted reader and required by the weighted one
+    Graph unweighted;
+    SnapshotGraphReader<Graph, Vertex> unweightedReader;
+    unweightedReader.read(unweighted, FileName);
+    ASSERT_EQ(adjacency(expected), adjacency(unweighted));
+
+    writer.writeGraphSnapshot(&unweighted, FileName);
+    WeightedGraph missing;
+    ASSERT_THROW(reader.read(missing, FileName), MalformedSnapshotException);
+}
+
+TEST_F(GraphSnapshotTest, DirectedRoundTripTest)
+{
+    DirectedGraph expected;
+    GraphReader<DirectedGraph, DirectedVertex> textReader;
+    textReader.read(expected, "TestTrees/DirectedTree.txt");
+
+    GraphWriter writer;
+    writer.writeDirectedGraphSnapshot(&expected, FileName);
+    ASSERT_TRUE(GraphSnapshot(FileName).isDirected());
+
+    DirectedGraph g;
+    SnapshotGraphReader<DirectedGraph, DirectedVertex> reader;
+    reader.read(g, FileName);
+    ASSERT_EQ(adjacency(expected), adjacency(g));
+
+    auto it = expected.verticesIterator();
+    while (!it.end())
+    {
+        DirectedVertex* v = g.getVertexById((*it)->getVertexId());
+        ASSERT_EQ((*it)->inDegree(), v->inDegree());
+        ASSERT_EQ((*it)->outDegree(), v->outDegree());
+        ++it;
+    }
+
+    // read into an undirected multigraph every arc becomes an edge
+    Graph undirected(false, true);
+    SnapshotGraphReader<Graph, Vertex> undirectedReader;
+    undirectedReader.read(undirected, FileName);
+    auto directedIt = expected.verticesIterator();
+    while (!directedIt.end())
+    {
+        Vertex* v = undirected.getVertexById((*directedIt)->getVertexId());
+        ASSERT_EQ((*directedIt)->inOutDegree(), v->degree());
+        ++directedIt;
+    }
+}
+
+TEST_F(GraphSnapshotTest, MultigraphTest)
+{
+    // 1-2 twice, 2-3 and two loops on 3
+    Graph multigraph(false, true);
+    vector<Vertex*> vertices;
+    for (unsigned int id = 1; id <= 3; ++id)
+    {
+        vertices.push_back(new Vertex(id));
+        multigraph.addVertex(vertices.back());
+    }
+    multigraph.addEdge(vertices[0], vertices[1]);
+    multigraph.addEdge(vertices[1], vertices[0]);
+    multigraph.addEdge(vertices[1], vertices[2]);
+    multigraph.addEdge(vertices[2], vertices[2]);
+    multigraph.addEdge(vertices[2], vertices[2]);
+
+    GraphWriter writer;
+    writer.writeGraphSnapshot(&multigraph, FileName);
+    SnapshotGraphReader<Graph, Vertex> reader;
+
+    Graph copy(false, true);
+    reader.read(copy, FileName);
+    ASSERT_EQ(adjacency(multigraph), adjacency(copy));
+
+    // a simple graph keeps one copy of each edge, as if read from an edge list
+    Graph simple;
+    reader.read(simple, FileName);
+    ASSERT_FALSE(simple.isMultigraph());
+    writeFile(FileName, "1 2\n2 1\n2 3\n3 3\n3 3\n");
+    Graph expected;
+    GraphReader<Graph, Vertex> textReader;
+    textReader.read(expected, FileName);
+    ASSERT_EQ(adjacency(expected), adjacency(simple));
+
+    // weighted readers refuse repeated edges
+    WeightedGraph weightedMultigraph(false, true);
+    WeightedVertex* a = new WeightedVertex(1);
+    WeightedVertex* b = new WeightedVertex(2);
+    weightedMultigraph.addVertex(a);
+    weightedMultigraph.addVertex(b);
+    weightedMultigraph.addEdge(a, b, 1.0);
+    weightedMultigraph.addEdge(a, b, 2.0);
+    writer.writeWeightedGraphSnapshot(&weightedMultigraph, FileName);
+
+    SnapshotWeightedGraphReader<WeightedGraph, WeightedVertex> weightedReader;
+    WeightedGraph weightedCopy(false, true);
+    weightedReader.read(weightedCopy, FileName);
+    ASSERT_DOUBLE_EQ(3.0, weightedCopy.getVertexById(1)->strength());
+    WeightedGraph weightedSimple;
+    ASSERT_THROW(weightedReader.read(weightedSimple, FileName), DuplicatedEdgeLoading);
+}
+
+TEST_F(GraphSnapshotTest, MalformedTest)
+{
+    Graph g;
+    Vertex* a = new Vertex(1);
+    Vertex* b = new Vertex(2);
+    g.addVertex(a);
+    g.addVertex(b);
+    g.addEdge(a, b);
+
+    GraphWriter writer;
+    writer.writeGraphSnapshot(&g, FileName);
+    const string bytes = fileContents(FileName);
+    SnapshotGraphReader<Graph, Vertex> reader;
+
+    writeFile(FileName, bytes.substr(0, bytes.size() - 4));
+    Graph truncated;
+    ASSERT_THROW(reader.read(truncated, FileName), MalformedSnapshotException);
+
+    string version = bytes;
+    version[8] = 2;
+    writeFile(FileName, version);
+    Graph newer;
+    ASSERT_THROW(reader.read(newer, FileName), MalformedSnapshotException);
+
+    // neighbour position out of range
+    string neighbor = bytes;
+    neighbor[32 + 3 * 8 + 2 * 4] = 7;
+    writeFile(FileName, neighbor);
+    Graph corrupt;
+    ASSERT_THROW(reader.read(corrupt, FileName), MalformedSnapshotException);
+
+    ASSERT_THROW(reader.read(corrupt, "doesNotExist.cngraph"), FileNotFoundException);
+}
+
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef COMPLEXNETS_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "GraphReader.h"
+#include "GraphWriter.h"
+#include "WeightedGraphReader.h"
+#include "TestUtils.h"
+#include "typedefs.h"
+
+namespace graphWriterTest
+{
+
+using namespace graphpp;
+using namespace std;
+using namespace testUtils;
+using ::testing::Test;
+
+class GraphWriterTest : public Test
+{
+protected:
+
+    GraphWriterTest() { }
+
+    virtual ~GraphWriterTest() { }
+
+    virtual void SetUp()
+    {
+
+    }
+
+    virtual void TearDown()
+    {
+        remove(FileName);
+        remove(CompressedFileName);
+    }
+
+    static const char* const FileName;
+    static const char* const CompressedFileName;
+};
+
+const char* const GraphWriterTest::FileName = "graphWriterTest.txt";
+const char* const GraphWriterTest::CompressedFileName = "graphWriterTest.txt.gz";
+
+TEST_F(GraphWriterTest, WritesEachEdgeOnceTest)
+{
+    Graph expected;
+    GraphReader<Graph, Vertex> reader;
+    reader.read(expected, "TestTrees/AS_CAIDA_2008.txt");
+
+    GraphWriter writer;
+    writer.writeGraph(&expected, FileName);
+
+    Graph g;
+    reader.read(g, FileName);
+    ASSERT_EQ(sortedAdjacency(expected), sortedAdjacency(g));
+
+    unsigned int degrees = 0;
+    auto it = expected.verticesIterator();
+    while (!it.end())
+    {
+        degrees += (*it)->degree();
+        ++it;
+    }
+    const string text = fileContents(FileName);
+    ASSERT_EQ(degrees / 2, (unsigned int)count(text.begin(), text.end(), '\n'));
+}
+
+TEST_F(GraphWriterTest, LoopsAndRepeatedEdgesTest)
+{
+    Graph g(false, true);
+    Vertex* a = new Vertex(2);
+    Vertex* b = new Vertex(1);
+    g.addVertex(a);
+    g.addVertex(b);
+    g.addEdge(a, a);
+    g.addEdge(a, b);
+    g.addEdge(b, a);
+
+    GraphWriter writer;
+    writer.writeGraph(&g, FileName);
+    ASSERT_EQ("1 2\n1 2\n2 2\n", fileContents(FileName));
+}
+
+TEST_F(GraphWriterTest, DirectedWritesEveryArcTest)
+{
+    DirectedGraph g;
+    DirectedVertex* a = new DirectedVertex(1);
+    DirectedVertex* b = new DirectedVertex(2);
+    g.addVertex(a);
+    g.addVertex(b);
+    g.addEdge(a, b);
+    g.addEdge(b, a);
+
+    GraphWriter writer;
+    writer.writeDirectedGraph(&g, FileName);
+    ASSERT_EQ("1 2\n2 1\n", fileContents(FileName));
+}
+
+TEST_F(GraphWriterTest, WeightedTest)
+{
+    WeightedGraph g;
+    WeightedVertex* a = new WeightedVertex(1);
+    WeightedVertex* b = new WeightedVertex(2);
+    WeightedVertex* c = new WeightedVertex(3);
+    g.addVertex(a);
+    g.addVertex(b);
+    g.addVertex(c);
+    g.addEdge(b, a, 0.5);
+    g.addEdge(c, a, 2.25);
+    g.addEdge(b, c, 1e-7);
+
+    GraphWriter writer;
+    writer.writeWeightedGraph(&g, FileName);
+    ASSERT_EQ("1 2 0.5\n1 3 2.25\n2 3 1e-07\n", fileContents(FileName));
+
+    WeightedGraph read;
+    WeightedGraphReader<WeightedGraph, WeightedVertex> reader;
+    reader.read(read, FileName);
+    ASSERT_DOUBLE_EQ(2.75, read.getVertexById(1)->strength());
+    ASSERT_DOUBLE_EQ(2.25 + 1e-7, read.getVertexById(3)->strength());
+}
+
+#ifdef COMPLEXNETS_HAVE_ZLIB
+TEST_F(GraphWriterTest, CompressedTest)
+{
+    Graph g;
+    GraphReader<Graph, Vertex> reader;
+    reader.read(g, "TestTrees/ER_1000.txt");
+
+    GraphWriter writer;
+    writer.writeGraph(&g, FileName);
+    writer.writeGraph(&g, CompressedFileName);
+
+    const string plain = fileContents(FileName);
+    ASSERT_LT(fileContents(CompressedFileName).size(), plain.size());
+
+    gzFile file = gzopen(CompressedFileName, "rb");
+    ASSERT_TRUE(file != nullptr);
+    string inflated;
+    char buffer[4096];
+    int read;
+    while ((read = gzread(file, buffer, sizeof(buffer))) > 0)
+        inflated.append(buffer, read);
+    gzclose(file);
+    ASSERT_EQ(plain, inflated);
+}
+#endif
+
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "IndexedHeap.h"
+
+namespace indexedHeapTest
+{
+
+using namespace graphpp;
+using namespace std;
+using ::testing::Test;
+
+class IndexedHeapTest : public Test
+{
+protected:
+
+    IndexedHeapTest() { }
+
+    virtual ~IndexedHeapTest() { }
+
+    virtual void SetUp()
+    {
+
+    }
+
+    virtual void TearDown()
+    {
+
+    }
+};
+
+TEST_F(IndexedHeapTest, PopsInKeyOrderTest)
+{
+    const unsigned int n = 500;
+    IndexedHeap<double> heap(n);
+    vector<double> keys(n);
+
+    srand(7);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        keys[i] = rand() % 1000;
+        heap.push(i, keys[i]);
+    }
+
+    // lower half of the keys
+    for (unsigned int i = 0; i < n; i += 2)
+    {
+        keys[i] /= 2;
+        heap.decreaseKey(i, keys[i]);
+    }
+
+    double previous = -1;
+    unsigned int popped = 0;
+    while (!heap.empty())
+    {
+        unsigned int item = heap.top();
+        ASSERT_EQ(heap.pop(), item);
+        ASSERT_FALSE(heap.contains(item));
+        ASSERT_TRUE(keys[item] >= previous);
+        previous = keys[item];
+        ++popped;
+    }
+    ASSERT_EQ(popped, n);
+}
+
+TEST_F(IndexedHeapTest, ClearAndReuseTest)
+{
+    IndexedHeap<int> heap(10);
+
+    heap.push(3, 30);
+    heap.push(7, 70);
+    heap.pushOrDecrease(7, 10);
+    ASSERT_EQ(heap.size(), 2u);
+    ASSERT_EQ(heap.top(), 7u);
+
+    heap.clear();
+    ASSERT_TRUE(heap.empty());
+    ASSERT_FALSE(heap.contains(3));
+    ASSERT_FALSE(heap.contains(7));
+
+    heap.pushOrDecrease(3, 5);
+    heap.push(9, 1);
+    ASSERT_EQ(heap.pop(), 9u);
+    ASSERT_EQ(heap.pop(), 3u);
+    ASSERT_TRUE(heap.empty());
+}
+
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "Betweenness.h"
+#include "GraphGenerator.h"
+#include "JobControl.h"
+#include "Parallel.h"
+#include "typedefs.h"
+
+namespace jobControlTest
+{
+
+using namespace graphpp;
+using namespace std;
+using ::testing::Test;
+
+class JobControlTest : public Test
+{
+protected:
+
+    JobControlTest() { }
+
+    virtual ~JobControlTest() { }
+
+    virtual void SetUp()
+    {
+
+    }
+
+    virtual void TearDown()
+    {
+
+    }
+};
+
+TEST_F(JobControlTest, WithoutJobTest)
+{
+    ASSERT_TRUE(JobControl::current() == nullptr);
+    JobControl::checkpoint();
+    JobControl::progress(1, 2);
+
+    atomic<unsigned int> calls(0);
+    parallelFor(1000, 4, [&](unsigned int, size_t) { calls++; });
+    ASSERT_EQ(1000u, calls.load());
+}
+
+TEST_F(JobControlTest, ProgressTest)
+{
+    JobControl job;
+    ASSERT_EQ(0.0, job.fraction());
+    {
+        JobControl::Scope scope(&job);
+        ASSERT_EQ(&job, JobControl::current());
+
+        // the workers run the job of the caller
+        atomic<unsigned int> withJob(0);
+        parallelFor(1000, 4, [&](unsigned int, size_t) {
+            if (JobControl::current() == &job)
+                withJob++;
+        });
+        ASSERT_EQ(1000u, withJob.load());
+        ASSERT_GT(job.fraction(), 0.0);
+
+        JobControl::progress(1, 4);
+        ASSERT_EQ(0.25, job.fraction());
+    }
+    ASSERT_TRUE(JobControl::current() == nullptr);
+}
+
+TEST_F(JobControlTest, CancelTest)
+{
+    JobControl job;
+    JobControl::Scope scope(&job);
+    atomic<unsigned int> calls(0);
+
+    // cancelled from the body: the items not yet started are skipped
+    ASSERT_THROW(
+        parallelFor(100000, 4, [&](unsigned int, size_t i) {
+            calls++;
+            if (i == 10)
+                job.cancel();
+        }),
+        JobCancelled);
+    ASSERT_LT(calls.load(), 100000u);
+    ASSERT_TRUE(job.cancelled());
+
+    calls = 0;
+    ASSERT_THROW(parallelFor(10, 2, [&](unsigned int, size_t) { calls++; }), JobCancelled);
+    ASSERT_EQ(0u, calls.load());
+    ASSERT_THROW(JobControl::checkpoint(), JobCancelled);
+    ASSERT_THROW(
+        GraphGenerator::getInstance()->generateBarabasiAlbertGraph(3, 2, 10000, 1), JobCancelled);
+}
+
+TEST_F(JobControlTest, ExceptionTest)
+{
+    // the first exception of any thread reaches the caller
+    atomic<unsigned int> calls(0);
+    ASSERT_THROW(
+        parallelFor(100000, 4, [&](unsigned int, size_t i) {
+            calls++;
+            if (i == 5)
+                throw runtime_error("item 5");
+        }),
+        runtime_error);
+    ASSERT_LT(calls.load(), 100000u);
+}
+
+TEST_F(JobControlTest, CancelFromAnotherThreadTest)
+{
+    unique_ptr<Graph> g(GraphGenerator::getInstance()->generateBarabasiAlbertGraph(3, 2, 20000, 7));
+    JobControl job;
+    bool cancelled = false;
+
+    thread worker([&]() {
+        JobControl::Scope scope(&job);
+        try
+        {
+            Betweenness<Graph, Vertex> betweenness(*g);
+        }
+        catch (const JobCancelled&)
+        {
+            cancelled = true;
+        }
+    });
+
+    while (job.fraction() == 0.0)
+        this_thread::sleep_for(chrono::milliseconds(1));
+    job.cancel();
+    worker.join();
+
+    ASSERT_TRUE(cancelled);
+    ASSERT_LT(job.fraction(), 1.0);
+}
+
+}
@@ -3,6 +3,8 @@
 //
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <random>
 #include <set>
 #include <vector>
 #include <list>
@@ -10,6 +12,7 @@
 #include "AdjacencyListVertex.h"
 #include "AdjacencyListGraph.h"
 #include "GraphExceptions.h"
+#include "JobControl.h"
 #include "MaxClique.h"
 #include "GraphReader.h"
 
@@ -45,6 +48,23 @@ namespace maxCliqueTest
         typedef AdjacencyListGraph<Vertex, list<Vertex*> > ListGraph;
         typedef AdjacencyListGraph<Vertex, vector<Vertex*> > VectorGraph;
 
+        // G(n, p) with vertices 1..n, plus a clique on the first cliqueSize of them
+        static void randomGraph(IndexedGraph& g, unsigned int n, double p, unsigned int cliqueSize,
+                                unsigned int seed)
+        {
+            mt19937 gen(seed);
+            bernoulli_distribution edge(p);
+            vector<Vertex*> vertices;
+            for (unsigned int i = 1; i <= n; i++) {
+                vertices.push_back(new Vertex(i));
+                g.addVertex(vertices.back());
+            }
+            for (unsigned int i = 0; i < n; i++)
+                for (unsigned int j = i + 1; j < n; j++)
+                    if ((j < cliqueSize) || edge(gen))
+                        g.addEdge(vertices[i], vertices[j]);
+        }
+
     };
 
 
@@ -117,4 +137,119 @@ namespace maxCliqueTest
         ASSERT_TRUE(*it == 3);
 
     }
+    TEST_F(MaxCliqueTest , MaxCliqueExactTest) {
+        IndexedGraph ig;
+        Vertex *x = new Vertex(1);
+        Vertex *v1 = new Vertex(2);
+        Vertex *v2 = new Vertex(3);
+        Vertex *v3 = new Vertex(4);
+        Vertex *v4 = new Vertex(5);
+
+        ig.addVertex(x);
+        ig.addVertex(v1);
+        ig.addVertex(v2);
+        ig.addVertex(v3);
+        ig.addVertex(v4);
+
+        ig.addEdge(x, v1);
+        ig.addEdge(x, v2);
+        ig.addEdge(x, v3);
+        ig.addEdge(v1, v2);
+        ig.addEdge(x, v4);
+
+        MaxCliqueExact<IndexedGraph, Vertex> maxClique(ig, 60);
+
+        ASSERT_TRUE(maxClique.finished());
+        ASSERT_EQ(3, maxClique.getMaxCliqueSize(x));
+        ASSERT_EQ(3, maxClique.getMaxCliqueSize(v1));
+        ASSERT_EQ(3, maxClique.getMaxCliqueSize(v2));
+        ASSERT_EQ(2, maxClique.getMaxCliqueSize(v3));
+        ASSERT_EQ(2, maxClique.getMaxCliqueSize(v4));
+
+        std::list<int> list = maxClique.getMaxCliqueList();
+        list.sort();
+        ASSERT_EQ((std::list<int> {1, 2, 3}), list);
+
+        unsigned int vertices = 0;
+        for (auto it = maxClique.distIterator(); !it.end(); it++)
+            vertices += it->second;
+        ASSERT_EQ(5u, vertices);
+    }
+
+    TEST_F(MaxCliqueTest , MaxCliqueExactBruteForceTest) {
+        const unsigned int n = 18;
+        for (unsigned int seed = 1; seed <= 5; seed++) {
+            IndexedGraph ig;
+            randomGraph(ig, n, 0.5, 0, seed);
+
+            vector<unsigned int> adjacency(n, 0);
+            for (unsigned int i = 0; i < n; i++) {
+                auto it = ig.getVertexById(i + 1)->neighborsIterator();
+                while (!it.end()) {
+                    adjacency[i] |= 1u << ((*it)->getVertexId() - 1);
+                    it++;
+                }
+            }
+            vector<int> expected(n, 1);
+            for (unsigned int set = 1; set < (1u << n); set++) {
+                int size = 0;
+                bool clique = true;
+                for (unsigned int i = 0; i < n && clique; i++)
+                    if (set & (1u << i)) {
+                        size++;
+                        clique = (set & ~(1u << i) & ~adjacency[i]) == 0;
+                    }
+                if (clique)
+                    for (unsigned int i = 0; i < n; i++)
+                        if (set & (1u << i))
+                            expected[i] = max(expected[i], size);
+            }
+
+            MaxCliqueExact<IndexedGraph, Vertex> maxClique(ig, 60);
+            ASSERT_TRUE(maxClique.finished());
+            for (unsigned int i = 0; i < n; i++)
+                ASSERT_EQ(expected[i], maxClique.getMaxCliqueSize(ig.getVertexById(i + 1)));
+
+            std::list<int> list = maxClique.getMaxCliqueList();
+            ASSERT_EQ(*max_element(expected.begin(), expected.end()), int(list.size()));
+            for (int a : list)
+                for (int b : list) {
+                    if (a != b) {
+                        ASSERT_TRUE(adjacency[a - 1] & (1u << (b - 1)));
+                    }
+                }
+        }
+    }
+
+    TEST_F(MaxCliqueTest , MaxCliqueExactPlantedTest) {
+        IndexedGraph ig;
+        randomGraph(ig, 1000, 0.03, 12, 3);
+
+        MaxCliqueExact<IndexedGraph, Vertex> maxClique(ig, 60);
+
+        ASSERT_TRUE(maxClique.finished());
+        std::list<int> list = maxClique.getMaxCliqueList();
+        list.sort();
+        std::list<int> planted;
+        for (int i = 1; i <= 12; i++)
+            planted.push_back(i);
+        ASSERT_EQ(planted, list);
+        for (int i = 1; i <= 12; i++)
+            ASSERT_EQ(12, maxClique.getMaxCliqueSize(ig.getVertexById(i)));
+    }
+
+    TEST_F(MaxCliqueTest , MaxCliqueExactTimeoutTest) {
+        IndexedGraph ig;
+        randomGraph(ig, 200, 0.9, 0, 5);
+
+        // out of time before the first vertex: the best known is a single vertex
+        MaxCliqueExact<IndexedGraph, Vertex> maxClique(ig, 0);
+        ASSERT_FALSE(maxClique.finished());
+        ASSERT_FALSE(maxClique.getMaxCliqueList().empty());
+
+        JobControl job;
+        JobControl::Scope scope(&job);
+        job.cancel();
+        ASSERT_THROW((MaxCliqueExact<IndexedGraph, Vertex>(ig, 60)), JobCancelled);
+    }
 }
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "MetricCache.h"
+#include "PropertyMap.h"
+#include "typedefs.h"
+
+namespace metricCacheTest
+{
+
+using namespace graphpp;
+using namespace std;
+using ::testing::Test;
+
+class MetricCacheTest : public Test
+{
+protected:
+
+    MetricCacheTest() { }
+
+    virtual ~MetricCacheTest() { }
+
+    virtual void SetUp()
+    {
+
+    }
+
+    virtual void TearDown()
+    {
+
+    }
+
+    static MetricCache::Key key(const string& metric, uint64_t version)
+    {
+        return MetricCache::Key{metric, "", false, false, version};
+    }
+};
+
+TEST_F(MetricCacheTest, LookupTest)
+{
+    MetricCache cache;
+    unsigned int computed = 0;
+    auto compute = [&computed](unsigned int& value) { value = ++computed; };
+
+    ASSERT_FALSE(cache.contains(key("metric", 1)));
+    ASSERT_EQ(1u, cache.get<unsigned int>(key("metric", 1), compute));
+    ASSERT_TRUE(cache.contains(key("metric", 1)));
+    ASSERT_EQ(1u, cache.get<unsigned int>(key("metric", 1), compute));
+    ASSERT_EQ(1u, computed);
+
+    // the parameters and the flags make other results
+    MetricCache::Key other = key("metric", 1);
+    other.parameters = "samples=10";
+    ASSERT_EQ(2u, cache.get<unsigned int>(other, compute));
+    other = key("metric", 1);
+    other.directedIn = true;
+    ASSERT_EQ(3u, cache.get<unsigned int>(other, compute));
+    ASSERT_EQ(4u, cache.get<unsigned int>(key("other", 1), compute));
+    ASSERT_EQ(4u, cache.size());
+    ASSERT_EQ(1u, cache.get<unsigned int>(key("metric", 1), compute));
+
+    ASSERT_THROW(cache.get<double>(key("metric", 1), [](double&) {}), PropertyTypeMismatch);
+
+    cache.clear();
+    ASSERT_EQ(0u, cache.size());
+    ASSERT_EQ(5u, cache.get<unsigned int>(key("metric", 1), compute));
+}
+
+TEST_F(MetricCacheTest, VersionTest)
+{
+    MetricCache cache;
+    unsigned int computed = 0;
+    auto compute = [&computed](unsigned int& value) { value = ++computed; };
+
+    ASSERT_EQ(1u, cache.get<unsigned int>(key("metric", 1), compute));
+    // a new version replaces the result of the old one
+    ASSERT_EQ(2u, cache.get<unsigned int>(key("metric", 2), compute));
+    ASSERT_FALSE(cache.contains(key("metric", 1)));
+    ASSERT_EQ(1u, cache.size());
+    ASSERT_EQ(3u, cache.get<unsigned int>(key("metric", 1), compute));
+}
+
+TEST_F(MetricCacheTest, GraphChangesTest)
+{
+    // a cached per-vertex degree, which must follow the changes of the graph
+    WeightedGraph g;
+    MetricCache cache;
+    auto degrees = [&g, &cache]() -> VertexProperty<unsigned int>& {
+        return cache.get<VertexProperty<unsigned int>>(
+            MetricCache::Key{"degree", "", false, false, g.getVersion()},
+            [&g](VertexProperty<unsigned int>& degree) {
+                auto it = g.verticesIterator();
+                while (!it.end())
+                {
+                    degree.set((*it)->getVertexId(), (*it)->degree());
+                    ++it;
+                }
+            });
+    };
+
+    WeightedVertex* v1 = new WeightedVertex(1);
+    WeightedVertex* v2 = new WeightedVertex(2);
+    WeightedVertex* v3 = new WeightedVertex(3);
+    g.addVertex(v1);
+    g.addVertex(v2);
+    ASSERT_EQ(0u, degrees().get(1));
+    ASSERT_FALSE(degrees().contains(3));
+
+    g.addVertex(v3);
+    ASSERT_TRUE(degrees().contains(3));
+    g.addEdge(v1, v2, 1.5);
+    ASSERT_EQ(1u, degrees().get(1));
+    g.addEdgeUnchecked(v1, v3, 2.0);
+    ASSERT_EQ(2u, degrees().get(1));
+    g.removeEdge(v1, v2);
+    ASSERT_EQ(1u, degrees().get(1));
+    ASSERT_EQ(0u, degrees().get(2));
+
+    // unchanged graph, same result
+    ASSERT_EQ(&degrees(), &degrees());
+    ASSERT_EQ(1u, cache.size());
+}
+
+}
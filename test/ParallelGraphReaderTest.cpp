@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "GraphGenerator.h"
+#include "GraphReader.h"
+#include "GraphWriter.h"
+#include "ParallelGraphReader.h"
+#include "ParallelWeightedGraphReader.h"
+#include "WeightedGraphReader.h"
+#include "TestUtils.h"
+#include "typedefs.h"
+
+namespace parallelGraphReaderTest
+{
+
+using namespace graphpp;
+using namespace std;
+using namespace testUtils;
+using ::testing::Test;
+
+class ParallelGraphReaderTest : public Test
+{
+protected:
+
+    ParallelGraphReaderTest() { }
+
+    virtual ~ParallelGraphReaderTest() { }
+
+    virtual void SetUp()
+    {
+
+    }
+
+    virtual void TearDown()
+    {
+        remove(FileName);
+    }
+
+    static const char* const FileName;
+};
+
+const char* const ParallelGraphReaderTest::FileName = "parallelGraphReaderTest.tmp";
+
+TEST_F(ParallelGraphReaderTest, MatchesSequentialReaderTest)
+{
+    Graph expected;
+    GraphReader<Graph, Vertex> sequential;
+    sequential.read(expected, "TestTrees/AS_CAIDA_2008.txt");
+
+    for (unsigned int threads : {1u, 2u, 4u, 7u})
+    {
+        Graph g;
+        ParallelGraphReader<Graph, Vertex> reader(threads);
+        reader.read(g, "TestTrees/AS_CAIDA_2008.txt");
+
+        ASSERT_EQ(adjacency(expected), adjacency(g));
+        ASSERT_EQ(sequential.getLineNumber(), reader.getLineNumber());
+        ASSERT_GT(reader.getEdgesCount(), 0u);
+    }
+}
+
+TEST_F(ParallelGraphReaderTest, RepeatedEdgesTest)
+{
+    // enough lines for several chunks, every edge twice in opposite directions
+    stringstream text;
+    for (unsigned int i = 1; i <= 3000; ++i)
+        text << i << " " << i + 1 << "\n";
+    for (unsigned int i = 1; i <= 3000; ++i)
+        text << i + 1 << "\t" << i << "\r\n";
+    writeFile(FileName, text.str());
+
+    Graph simple;
+    ParallelGraphReader<Graph, Vertex> reader(4);
+    reader.read(simple, FileName);
+    ASSERT_EQ(3001u, simple.verticesCount());
+    ASSERT_EQ(2u, simple.getVertexById(2)->degree());
+    ASSERT_EQ(6000u, reader.getEdgesCount());
+
+    Graph multigraph(false, true);
+    reader.read(multigraph, FileName);
+    ASSERT_EQ(4u, multigraph.getVertexById(2)->degree());
+
+    DirectedGraph directed;
+    ParallelGraphReader<DirectedGraph, DirectedVertex> directedReader(4);
+    directedReader.read(directed, FileName);
+    ASSERT_EQ(2u, directed.getVertexById(2)->outDegree());
+    ASSERT_EQ(2u, directed.getVertexById(2)->inDegree());
+}
+
+TEST_F(ParallelGraphReaderTest, WeightedTest)
+{
+    stringstream text;
+    for (unsigned int i = 1; i <= 3000; ++i)
+        text << i << " " << i + 1 << " " << i << "e-3\n";
+    writeFile(FileName, text.str());
+
+    WeightedGraph expected;
+    WeightedGraphReader<WeightedGraph, WeightedVertex> sequential;
+    sequential.read(expected, FileName);
+
+    WeightedGraph g;
+    ParallelWeightedGraphReader<WeightedGraph, WeightedVertex> reader(4);
+    reader.read(g, FileName);
+    ASSERT_EQ(adjacency(expected), adjacency(g));
+    ASSERT_DOUBLE_EQ(0.003, g.getVertexById(2)->strength());
+
+    text << "2000 1999 1\n";
+    writeFile(FileName, text.str());
+    WeightedGraph repeated;
+    try
+    {
+        reader.read(repeated, FileName);
+        FAIL();
+    }
+    catch (const DuplicatedEdgeLoading& ex)
+    {
+        ASSERT_NE(string::npos, string(ex.what()).find("Line: 3001"));
+    }
+}
+
+TEST_F(ParallelGraphReaderTest, ReportsFirstMalformedLineTest)
+{
+    stringstream text;
+    for (unsigned int i = 1; i <= 5000; ++i)
+    {
+        if (i == 1234 || i == 4321)
+            text << i << " x\n";
+        else
+            text << i << " " << i + 1 << "\n";
+    }
+    writeFile(FileName, text.str());
+
+    Graph g;
+    ParallelGraphReader<Graph, Vertex> reader(4);
+    try
+    {
+        reader.read(g, FileName);
+        FAIL();
+    }
+    catch (const UnsignedIntegerMalformedException& ex)
+    {
+        ASSERT_NE(string::npos, string(ex.what()).find("Line: 1234"));
+    }
+}
+
+TEST_F(ParallelGraphReaderTest, ThroughputTest)
+{
+    writeFile(FileName, "1 2\n2 3\n3\n1 2\n");
+
+    Graph g;
+    GraphReader<Graph, Vertex> sequential;
+    sequential.read(g, FileName);
+    ASSERT_EQ(3u, sequential.getEdgesCount());
+    ASSERT_GT(sequential.getEdgesPerSecond(), 0.0);
+
+    // the generator hands over what the reader measured
+    ReadThroughput throughput;
+    Graph* generated =
+        GraphGenerator::getInstance()->generateGraphFromFile(FileName, false, false, 2, &throughput);
+    ASSERT_EQ(3u, throughput.getEdgesCount());
+    ASSERT_GT(throughput.getEdgesPerSecond(), 0.0);
+
+    // snapshots are not edge lists: nothing is reported
+    GraphWriter writer;
+    writer.writeGraphSnapshot(generated, FileName);
+    delete generated;
+    generated =
+        GraphGenerator::getInstance()->generateGraphFromFile(FileName, false, false, 2, &throughput);
+    ASSERT_EQ(0u, throughput.getEdgesCount());
+    ASSERT_EQ(0.0, throughput.getEdgesPerSecond());
+    delete generated;
+}
+
+TEST_F(ParallelGraphReaderTest, EmptyFileTest)
+{
+    writeFile(FileName, "");
+
+    Graph g;
+    ParallelGraphReader<Graph, Vertex> reader(4);
+    reader.read(g, FileName);
+    ASSERT_EQ(0u, g.verticesCount());
+    ASSERT_EQ(1u, reader.getLineNumber());
+}
+
+}
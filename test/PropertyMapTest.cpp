@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <utility>
+#include <vector>
+
 #include "PropertyMap.h"
 
 namespace propertyMapTest
@@ -25,5 +28,88 @@ TEST(PropertyMapTest, BasicTest)
     ASSERT_FALSE(map.containsProperty("foo", "bar"));
 }
 
+TEST(PropertyMapTest, SeriesTest)
+{
+    PropertySeries<double> series;
+    series.set(2, 0.5);
+    series.set(9, 0.25);
+    series.set(10, 0.125);
+    series.set(1, 1.0);
+    series[9] += 1.0;
+    series[3] += 2.0;
+
+    // numeric order, not string order
+    vector<pair<unsigned int, double>> entries(series.begin(), series.end());
+    ASSERT_EQ(
+        (vector<pair<unsigned int, double>>(
+            {{1, 1.0}, {2, 0.5}, {3, 2.0}, {9, 1.25}, {10, 0.125}})),
+        entries);
+    ASSERT_TRUE(series.contains(10));
+    ASSERT_FALSE(series.contains(4));
+    ASSERT_TRUE(series.find(4) == nullptr);
+    ASSERT_EQ(1.25, series.get(9));
+    ASSERT_THROW(series.get(11), BadElementName);
+}
+
+TEST(PropertyMapTest, VertexPropertyTest)
+{
+    VertexProperty<unsigned int> property;
+    property.set(5, 3);
+    property.set(0, 7);
+    property.set(5, 4);
+
+    ASSERT_EQ(2u, property.size());
+    ASSERT_TRUE(property.contains(0));
+    ASSERT_FALSE(property.contains(1));
+    ASSERT_FALSE(property.contains(100));
+    ASSERT_EQ(4u, property.get(5));
+    ASSERT_THROW(property.get(3), BadElementName);
+
+    vector<pair<unsigned int, unsigned int>> visited;
+    property.forEach([&visited](unsigned int id, unsigned int value) {
+        visited.push_back({id, value});
+    });
+    ASSERT_EQ((vector<pair<unsigned int, unsigned int>>({{0, 7}, {5, 4}})), visited);
+}
+
+TEST(PropertyMapTest, TypedColumnsTest)
+{
+    PropertyMap map;
+
+    PropertySeries<double>& series = map.series<double>("knn");
+    series.set(10, 2.5);
+    series.set(9, 1.5);
+    map.vertexProperty<unsigned int>("shellIndex").set(3, 2);
+
+    ASSERT_EQ(&series, &map.series<double>("knn"));
+    ASSERT_TRUE(map.containsPropertySet("knn"));
+    ASSERT_TRUE(map.containsProperty("knn", "9"));
+    ASSERT_FALSE(map.containsProperty("knn", "8"));
+    ASSERT_FALSE(map.containsProperty("knn", "nine"));
+    ASSERT_EQ(2.5, map.getProperty<double>("knn", "10"));
+    ASSERT_EQ(2u, map.getProperty<unsigned int>("shellIndex", "3"));
+
+    // the string view follows the column
+    VariantsSet& view = map.getPropertySet("knn");
+    ASSERT_EQ(2u, view.size());
+    ASSERT_EQ(1.5, view.get_element<double>("9"));
+    series.set(11, 3.5);
+    ASSERT_EQ(3u, map.getPropertySet("knn").size());
+
+    // a name holds a single kind of property
+    map.addProperty<int>("foo", "bar", 2);
+    ASSERT_THROW(map.series<double>("foo"), PropertyTypeMismatch);
+    ASSERT_THROW(map.series<unsigned int>("knn"), PropertyTypeMismatch);
+    ASSERT_THROW(map.vertexProperty<double>("knn"), PropertyTypeMismatch);
+    ASSERT_THROW(map.addProperty<double>("knn", "12", 1.0), PropertyTypeMismatch);
+
+    map.deleteProperty("knn");
+    ASSERT_FALSE(map.containsPropertySet("knn"));
+    ASSERT_TRUE(map.series<unsigned int>("knn").empty());
+
+    map.clear();
+    ASSERT_FALSE(map.containsPropertySet("shellIndex"));
+    ASSERT_FALSE(map.containsPropertySet("foo"));
 }
 
+}
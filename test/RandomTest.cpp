@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "Random.h"
+
+namespace randomTest
+{
+
+using namespace graphpp;
+using namespace std;
+using ::testing::Test;
+
+class RandomTest : public Test
+{
+protected:
+
+    RandomTest() { }
+
+    virtual ~RandomTest() { }
+
+    virtual void SetUp()
+    {
+
+    }
+
+    virtual void TearDown()
+    {
+
+    }
+};
+
+TEST_F(RandomTest, ReferenceTest)
+{
+    // the reference xoshiro256** with its state filled by splitmix64 from 42
+    Random rng(42);
+    ASSERT_EQ(1546998764402558742ull, rng());
+    ASSERT_EQ(6990951692964543102ull, rng());
+    rng.jump();
+    ASSERT_EQ(6818771422820058410ull, rng());
+}
+
+TEST_F(RandomTest, StreamsTest)
+{
+    vector<Random> streams = Random(7).streams(3);
+    ASSERT_EQ(3u, streams.size());
+
+    Random first(7);
+    Random second(7);
+    second.jump();
+    ASSERT_EQ(first(), streams[0]());
+    ASSERT_EQ(second(), streams[1]());
+
+    set<uint64_t> draws;
+    for (Random& stream : streams)
+        for (unsigned int i = 0; i < 100; i++)
+            draws.insert(stream());
+    ASSERT_EQ(300u, draws.size());
+}
+
+TEST_F(RandomTest, RangesTest)
+{
+    Random rng(0);
+    double sum = 0;
+    vector<unsigned int> counts(6, 0);
+    const unsigned int draws = 60000;
+    for (unsigned int i = 0; i < draws; i++)
+    {
+        const double u = rng.uniform();
+        ASSERT_GE(u, 0.0);
+        ASSERT_LT(u, 1.0);
+        sum += u;
+
+        const uint64_t face = rng.below(6);
+        ASSERT_LT(face, 6u);
+        counts[face]++;
+    }
+    ASSERT_NEAR(0.5, sum / draws, 0.01);
+    for (unsigned int count : counts)
+        ASSERT_NEAR(draws / 6.0, count, 500);
+}
+
+}
@@ -3,11 +3,16 @@
 #include <set>
 #include <vector>
 #include <list>
+#include <map>
 
 #include "AdjacencyListVertex.h"
 #include "AdjacencyListGraph.h"
 #include "GraphExceptions.h"
+#include "GraphFactory.h"
+#include "GraphReader.h"
+#include "ParallelShellIndex.h"
 #include "ShellIndex.h"
+#include "typedefs.h"
 
 namespace betweennessTest
 {
@@ -83,5 +88,54 @@ TEST_F(ShellIndexTest , ShellIndexTest)
     }
 }
 
+TEST_F(ShellIndexTest , DirectedShellIndexTest)
+{
+    // a cycle 1 -> 2 -> 3 -> 1, with 4 -> 1 and an isolated 5
+    ::DirectedGraph g;
+    for (unsigned int id = 1; id <= 5; ++id)
+        g.addVertex(new DirectedVertex(id));
+    g.addEdge(g.getVertexById(1), g.getVertexById(2));
+    g.addEdge(g.getVertexById(2), g.getVertexById(3));
+    g.addEdge(g.getVertexById(3), g.getVertexById(1));
+    g.addEdge(g.getVertexById(4), g.getVertexById(1));
+
+    ShellIndex<::DirectedGraph, DirectedVertex> in(g, ShellIndexTypeInDegree);
+    ShellIndex<::DirectedGraph, DirectedVertex> out(g, ShellIndexTypeOutDegree);
+
+    std::map<unsigned int, unsigned int> inCore, outCore;
+    for (auto it = in.iterator(); !it.end(); ++it)
+        inCore[it->first] = it->second;
+    for (auto it = out.iterator(); !it.end(); ++it)
+        outCore[it->first] = it->second;
+
+    typedef std::map<unsigned int, unsigned int> Cores;
+    ASSERT_EQ(inCore, (Cores{{1, 1}, {2, 1}, {3, 1}, {4, 0}, {5, 0}}));
+    ASSERT_EQ(outCore, (Cores{{1, 1}, {2, 1}, {3, 1}, {4, 1}, {5, 0}}));
+}
+
+TEST_F(ShellIndexTest , ParallelMatchesSequentialTest)
+{
+    Graph g;
+    GraphReader<Graph, Vertex> graphReader;
+    graphReader.read(g, "TestTrees/AS_CAIDA_2008.txt");
+
+    ShellIndex<Graph, Vertex> sequential(g, ShellIndexTypeSimple);
+    std::map<unsigned int, unsigned int> expected;
+    for (auto it = sequential.iterator(); !it.end(); ++it)
+        expected[it->first] = it->second;
+
+    GraphFactory<Graph, Vertex> factory;
+    for (unsigned int threads : {1u, 2u, 4u})
+    {
+        IShellIndex<Graph, Vertex>* shellIndex =
+            factory.createShellIndex(g, ShellIndexTypeSimple, threads);
+        std::map<unsigned int, unsigned int> cores;
+        for (auto it = shellIndex->iterator(); !it.end(); ++it)
+            cores[it->first] = it->second;
+        delete shellIndex;
+        ASSERT_EQ(cores, expected);
+    }
+}
+
 }
 
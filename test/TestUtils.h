@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/**
+ * Helpers shared by the tests that write graph files and compare the graphs read back.
+ */
+namespace testUtils
+{
+typedef std::vector<std::vector<unsigned int>> Adjacency;
+
+/**
+ * Method: writeFile
+ * -----------------
+ * Description: replaces the file with the given bytes
+ */
+inline void writeFile(const char* path, const std::string& bytes)
+{
+    std::ofstream file(path, std::ios_base::binary);
+    file << bytes;
+}
+
+/**
+ * Method: fileContents
+ * --------------------
+ * @returns the bytes of the file, empty if it cannot be read
+ */
+inline std::string fileContents(const char* path)
+{
+    std::ifstream file(path, std::ios_base::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/**
+ * Method: adjacency
+ * -----------------
+ * @returns one row per vertex, its id followed by the ids of its neighbours, with vertices
+ * and neighbours in container order
+ */
+template <class G>
+Adjacency adjacency(G& g)
+{
+    Adjacency ret;
+    auto it = g.verticesIterator();
+    while (!it.end())
+    {
+        std::vector<unsigned int> row(1, (*it)->getVertexId());
+        auto neighbors = (*it)->neighborsIterator();
+        while (!neighbors.end())
+        {
+            row.push_back((*neighbors)->getVertexId());
+            ++neighbors;
+        }
+        ret.push_back(row);
+        ++it;
+    }
+    return ret;
+}
+
+/**
+ * Method: sortedAdjacency
+ * -----------------------
+ * @returns like adjacency, with the neighbours of every vertex sorted by id
+ */
+template <class G>
+Adjacency sortedAdjacency(G& g)
+{
+    Adjacency ret = adjacency(g);
+    for (auto& row : ret)
+        std::sort(row.begin() + 1, row.end());
+    return ret;
+}
+}  // namespace testUtils
@@ -85,4 +85,34 @@ namespace weightedClusterCoefficientTest {
             ++it;
         }
     }
+
+    TEST_F(WeightedBetweennessTest, WeightedBetweennessValuesTest)
+    {
+        WeightedGraph g;
+        for (unsigned int id = 1; id <= 6; ++id)
+            g.addVertex(new Vertex(id));
+
+        g.addEdge(g.getVertexById(1), g.getVertexById(2), 4);
+        g.addEdge(g.getVertexById(1), g.getVertexById(3), 1);
+        g.addEdge(g.getVertexById(1), g.getVertexById(4), 4);
+        g.addEdge(g.getVertexById(1), g.getVertexById(5), 2);
+        g.addEdge(g.getVertexById(2), g.getVertexById(3), 2);
+        g.addEdge(g.getVertexById(5), g.getVertexById(6), 1);
+
+        // 1-3-2 is shorter than the direct 1-2 edge, so 3 carries every path to 2
+        const double expected[] = {16.0, 0.0, 8.0, 0.0, 8.0, 0.0};
+
+        for (unsigned int threads = 1; threads <= 4; threads *= 2)
+        {
+            WeightedBetweenness<WeightedGraph, Vertex> betweenness(g, threads);
+            auto it = betweenness.iterator();
+            for (unsigned int i = 0; i < 6; ++i)
+            {
+                ASSERT_FALSE(it.end());
+                ASSERT_EQ(it->first, i + 1);
+                ASSERT_NEAR(it->second, expected[i], 1e-9);
+                ++it;
+            }
+        }
+    }
 }
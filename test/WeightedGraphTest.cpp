@@ -82,4 +82,42 @@ namespace weightedGraphTest {
         ASSERT_TRUE(x->edgeWeight(v4) == 2);
         ASSERT_TRUE(v4->edgeWeight(v5) == 1);
     }
+
+    TEST_F(WeightedGraphTest , RemoveEdgeKeepsWeightsAlignedTest)
+    {
+        WeightedGraph g;
+        Vertex* x = new Vertex(1);
+        Vertex* v1 = new Vertex(2);
+        Vertex* v2 = new Vertex(3);
+        Vertex* v3 = new Vertex(4);
+
+        g.addVertex(x);
+        g.addVertex(v1);
+        g.addVertex(v2);
+        g.addVertex(v3);
+
+        g.addEdge(x, v1, 4);
+        g.addEdge(x, v2, 1.5);
+        g.addEdge(x, v3, 3);
+        ASSERT_DOUBLE_EQ(x->strength(), 8.5);
+
+        g.removeEdge(x, v2);
+
+        ASSERT_EQ(x->degree(), 2u);
+        ASSERT_DOUBLE_EQ(x->strength(), 7);
+        ASSERT_DOUBLE_EQ(v2->strength(), 0);
+        ASSERT_TRUE(x->edgeWeight(v2) == 0);
+        ASSERT_TRUE(x->edgeWeight(v3) == 3);
+        ASSERT_TRUE(x->edgeWeightByNeighbour(4) == 3);
+
+        // weights follow the neighbours slot by slot
+        auto neighbours = x->neighborsIterator();
+        auto weights = x->weightsIterator();
+        for (unsigned int slot = 0; !neighbours.end(); ++slot, ++neighbours, ++weights)
+        {
+            ASSERT_TRUE(*weights == x->edgeWeight(static_cast<Vertex*>(*neighbours)));
+            ASSERT_TRUE(*weights == x->edgeWeightAt(slot));
+        }
+        ASSERT_TRUE(weights.end());
+    }
 }